@@ -13,7 +13,8 @@
 #include <Luna/Runtime/UniquePtr.hpp>
 #include <Luna/Runtime/Mutex.hpp>
 #include <Luna/Runtime/Random.hpp>
-#include <Luna/Runtime/SelfIndexedHashMap.hpp>
+#include <Luna/Runtime/HashMap.hpp>
+#include <Luna/Runtime/SelfIndexedFlatHashMap.hpp>
 #include "AssetType.hpp"
 #include <Luna/Runtime/Module.hpp>
 #include <Luna/VFS/VFS.hpp>
@@ -21,6 +22,7 @@
 #include <Luna/VariantUtils/JSON.hpp>
 #include <Luna/Runtime/Reflection.hpp>
 #include <Luna/VariantUtils/VariantUtils.hpp>
+#include <Luna/Runtime/Profiler.hpp>
 
 namespace Luna
 {
@@ -33,8 +35,9 @@ namespace Luna
                 return v->guid;
             }
         };
+        profiler_counter_t g_loaded_assets_counter = nullptr;
         Ref<IMutex> g_assets_mutex;
-        SelfIndexedHashMap<Guid, UniquePtr<AssetEntry>, AssetEntryExtractKey> g_assets;
+        SelfIndexedFlatHashMap<Guid, UniquePtr<AssetEntry>, AssetEntryExtractKey> g_assets;
         HashMap<Path, asset_t> g_asset_path_mapping;
         void init_asset_registry()
         {
@@ -43,7 +46,7 @@ namespace Luna
                 luproperty(AssetMetaFile, Name, type)
                 });
             set_serializable<AssetMetaFile>();
-            g_assets_mutex = new_mutex();
+            g_assets_mutex = new_mutex("Asset/Assets");
         }
         void close_asset_registry()
         {
@@ -168,7 +171,7 @@ namespace Luna
                     {
                         luexp(recursive_load_asset_meta(path, assets));
                     }
-                    else if(path.extension() == "meta")
+                    else if(path.extension() == luname("meta"))
                     {
                         lulet(meta_file, internal_load_asset_meta(path));
                         AssetMetaUpdateInfo info;
@@ -548,11 +551,12 @@ namespace Luna
                 }
             }
             lucatchret;
-            entry->data = data;
+            entry->set_data(ObjRef(data));
             return ok;
         }
         LUNA_ASSET_API RV load_asset(asset_t asset, bool force_reload)
         {
+            luprofile_function();
             lucheck_msg(asset.handle, "Asset handle must not be null!");
             AssetEntry* entry = (AssetEntry*)asset.handle;
             LockGuard g(entry->lock);
@@ -584,7 +588,7 @@ namespace Luna
                     luthrow(set_error(BasicError::not_supported(), "Asset loading is not implemented by asset %s", type.c_str()));
                 }
                 g = entry->lock;
-                entry->data = data;
+                entry->set_data(data);
                 entry->loading = false;
                 g.unlock();
             }
@@ -625,7 +629,7 @@ namespace Luna
                     luthrow(set_error(BasicError::not_supported(), "Asset default data loading is not implemented by asset %s", entry->type.c_str()));
                 }
                 g = entry->lock;
-                entry->data = data;
+                entry->set_data(data);
                 entry->loading = false;
                 g.unlock();
             }
@@ -701,6 +705,7 @@ namespace Luna
             }
             virtual RV on_init() override
             {
+                g_loaded_assets_counter = get_profiler_counter("Asset/Loaded Assets", ProfilerCounterType::gauge);
                 init_asset_type();
                 init_asset_registry();
                 register_struct_type<asset_t>({});
@@ -12,6 +12,7 @@
 #include <Luna/Runtime/SpinLock.hpp>
 #include <Luna/Runtime/Mutex.hpp>
 #include <Luna/Runtime/Signal.hpp>
+#include <Luna/Runtime/Profiler.hpp>
 
 namespace Luna
 {
@@ -24,6 +25,9 @@ namespace Luna
             Name type;
         };
 
+        // The gauge that counts assets whose data are loaded.
+        extern profiler_counter_t g_loaded_assets_counter;
+
         // Maps to `asset_t`
         struct AssetEntry
         {
@@ -35,11 +39,21 @@ namespace Luna
             SpinLock lock;
             AssetEntry() :
                 loading(false) {}
+            ~AssetEntry()
+            {
+                if(data) luprofile_counter_add(g_loaded_assets_counter, -1.0);
+            }
+            void set_data(const ObjRef& new_data)
+            {
+                i32 delta = (i32)new_data.valid() - (i32)data.valid();
+                data = new_data;
+                if(delta) luprofile_counter_add(g_loaded_assets_counter, (f64)delta);
+            }
             void reset()
             {
                 type.reset();
                 path.clear();
-                data.reset();
+                set_data(ObjRef());
                 loading = false;
             }
         };
@@ -15,6 +15,8 @@ namespace Luna
 {
     namespace ECS
     {
+        profiler_counter_t g_live_entities_counter = nullptr;
+
         struct ECSModule : public Module
         {
             virtual const c8* get_name() override { return "ECS"; }
@@ -24,6 +26,7 @@ namespace Luna
             }
             virtual RV on_init() override
             {
+                g_live_entities_counter = get_profiler_counter("ECS/Live Entities", ProfilerCounterType::gauge);
                 register_boxed_type<World>();
                 impl_interface_for_type<World, IWorld>();
                 return ok;
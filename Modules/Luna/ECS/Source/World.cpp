@@ -12,6 +12,7 @@
 #include "World.hpp"
 #include <Luna/Runtime/Random.hpp>
 #include <Luna/Runtime/Log.hpp>
+#include <Luna/Runtime/InlineVector.hpp>
 namespace Luna
 {
     namespace ECS
@@ -73,14 +74,17 @@ namespace Luna
                         m_entity_id_allocator.free_id(id);
                     }
                 }
+                m_num_entities -= cluster->m_size;
+                luprofile_counter_add(g_live_entities_counter, -(f64)cluster->m_size);
                 // Remove cluster directly.
                 m_clusters.erase(iter);
             }
         }
         void World::find_clusters(Span<const typeinfo_t> components, Span<const tag_t> tags, Vector<Cluster*>& out_clusters)
         {
-            Array<typeinfo_t> components_arr(components.data(), components.size());
-            Array<tag_t> tags_arr(tags.data(), tags.size());
+            luprofile_function();
+            InlineVector<typeinfo_t, 16> components_arr(components.begin(), components.end());
+            InlineVector<tag_t, 16> tags_arr(tags.begin(), tags.end());
             sort(components_arr.begin(), components_arr.end());
             sort(tags_arr.begin(), tags_arr.end());
             auto components_span = components_arr.cspan();
@@ -94,6 +98,7 @@ namespace Luna
         }
         void World::find_clusters(const Function<bool(Cluster* cluster)>& filter, Vector<Cluster*>& out_clusters)
         {
+            luprofile_function();
             for(auto& cluster : m_clusters)
             {
                 if(filter(cluster.get()))
@@ -104,6 +109,7 @@ namespace Luna
         }
         entity_id_t World::new_entity(Cluster* target_cluster, EntityAddress* out_address)
         {
+            luprofile_function();
             entity_id_t id = m_entity_id_allocator.allocate_id();
             // add entity record.
             usize cluster_index = target_cluster->allocate_entry();
@@ -117,6 +123,8 @@ namespace Luna
             ent.m_cluster = target_cluster;
             ent.m_index = cluster_index;
             target_cluster->m_chunks[cluster_index / CLUSTER_CHUNK_CAPACITY].m_entities[cluster_index % CLUSTER_CHUNK_CAPACITY] = id;
+            ++m_num_entities;
+            luprofile_counter_add(g_live_entities_counter, 1.0);
             if(out_address)
             {
                 out_address->cluster = target_cluster;
@@ -138,6 +146,8 @@ namespace Luna
                 // Remove record.
                 record->m_cluster = nullptr;
                 m_entity_id_allocator.free_id(entity);
+                --m_num_entities;
+                luprofile_counter_add(g_live_entities_counter, -1.0);
             }
         }
         void World::delete_all_entities()
@@ -158,6 +168,8 @@ namespace Luna
                 }
             }
             m_clusters.clear();
+            luprofile_counter_add(g_live_entities_counter, -(f64)m_num_entities);
+            m_num_entities = 0;
         }
         R<EntityAddress> World::get_entity_address(entity_id_t entity)
         {
@@ -237,6 +249,7 @@ namespace Luna
         }
         R<EntityAddress> World::set_entity_cluster(entity_id_t entity, Cluster* new_cluster)
         {
+            luprofile_function();
             auto record = get_entity_record(entity);
             if (!record)
             {
@@ -15,6 +15,7 @@
 #include <Luna/Runtime/SpinLock.hpp>
 #include <Luna/Runtime/RingDeque.hpp>
 #include <Luna/Runtime/SelfIndexedHashMap.hpp>
+#include <Luna/Runtime/Profiler.hpp>
 
 namespace Luna
 {
@@ -85,6 +86,9 @@ namespace Luna
             }
         };
 
+        //! The gauge that counts live entities of all worlds.
+        extern profiler_counter_t g_live_entities_counter;
+
         struct World : public IWorld
         {
             lustruct("ECS::World", "{945066F9-0292-46DC-8659-41D1C5874EA6}");
@@ -93,6 +97,13 @@ namespace Luna
             //! Entity allocation and management.
             EntityIdAllocator m_entity_id_allocator;
             Vector<EntityRecord> m_entities;
+            //! The number of live entities in this world.
+            usize m_num_entities = 0;
+
+            ~World()
+            {
+                luprofile_counter_add(g_live_entities_counter, -(f64)m_num_entities);
+            }
 
             //! Clusters managed by this world.
             SelfIndexedHashMap<ClusterType, UniquePtr<Cluster>, ClusterExtractKey> m_clusters;
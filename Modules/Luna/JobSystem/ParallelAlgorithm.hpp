@@ -0,0 +1,426 @@
+/*!
+* This file is a portion of LunaSDK.
+* For conditions of distribution and use, see the disclaimer
+* and license in LICENSE.txt
+*
+* @file ParallelAlgorithm.hpp
+* @author JXMaster
+* @date 2026/10/18
+* @brief Parallel versions of algorithms that run on the job system.
+*/
+#pragma once
+#include "JobSystem.hpp"
+#include <Luna/Runtime/Algorithm.hpp>
+#include <Luna/Runtime/MemoryUtils.hpp>
+
+namespace Luna
+{
+    namespace JobSystem
+    {
+        //! @addtogroup JobSystem
+        //! @{
+
+        //! The maximum number of chunks one parallel algorithm splits the range into.
+        constexpr usize MAX_PARALLEL_CHUNKS = 64;
+
+        //! The default minimum number of elements processed by one chunk of @ref parallel_transform,
+        //! @ref parallel_reduce and @ref parallel_inclusive_scan.
+        constexpr usize DEFAULT_PARALLEL_GRAIN_SIZE = 4096;
+
+        //! The default minimum number of elements processed by one chunk of @ref parallel_sort and @ref parallel_stable_sort.
+        constexpr usize DEFAULT_PARALLEL_SORT_GRAIN_SIZE = 16384;
+
+        //! @}
+
+        namespace Impl
+        {
+            // The number of chunks only depends on the number of elements rather than the number of worker threads,
+            // so that results are the same on all platforms even if the operation is not exactly associative.
+            inline usize get_num_parallel_chunks(usize size, usize grain_size)
+            {
+                if (!grain_size) grain_size = 1;
+                return min(size / grain_size, MAX_PARALLEL_CHUNKS);
+            }
+
+            inline usize get_parallel_chunk_begin(usize size, usize num_chunks, usize chunk)
+            {
+                return (usize)((u64)size * chunk / num_chunks);
+            }
+
+            template <typename _Func>
+            struct ParallelChunkJob
+            {
+                _Func* func;
+                usize chunk;
+
+                static void run(void* params)
+                {
+                    ParallelChunkJob* job = (ParallelChunkJob*)params;
+                    (*job->func)(job->chunk);
+                }
+            };
+
+            // Calls `func(chunk)` for every chunk in [0, `num_chunks`) in parallel, and waits for all of them to finish.
+            // The first chunk is executed on the current thread.
+            template <typename _Func>
+            inline void parallel_for_chunks(usize num_chunks, _Func& func)
+            {
+                luassert(num_chunks <= MAX_PARALLEL_CHUNKS);
+                using job_t = ParallelChunkJob<_Func>;
+                job_id_t jobs[MAX_PARALLEL_CHUNKS];
+                for (usize i = 1; i < num_chunks; ++i)
+                {
+                    job_t* job = (job_t*)new_job(job_t::run, sizeof(job_t), alignof(job_t));
+                    job->func = &func;
+                    job->chunk = i;
+                    jobs[i] = submit_job(job);
+                }
+                func(0);
+                for (usize i = 1; i < num_chunks; ++i)
+                {
+                    wait_job(jobs[i]);
+                }
+            }
+
+            // Gets the number of elements taken from `a` when merging `a` and `b` stably, so that the first `k`
+            // merged elements are `a[0, i)` and `b[0, k - i)`.
+            template <typename _Ty, typename _Compare>
+            inline usize merge_co_rank(usize k, const _Ty* a, usize a_size, const _Ty* b, usize b_size, _Compare& comp)
+            {
+                usize lo = k > b_size ? k - b_size : 0;
+                usize hi = min(k, a_size);
+                while (lo < hi)
+                {
+                    usize mid = (lo + hi) / 2;
+                    // Elements in `a` are placed before equal elements in `b`.
+                    if (!comp(b[k - mid - 1], a[mid])) lo = mid + 1;
+                    else hi = mid;
+                }
+                return lo;
+            }
+
+            struct ParallelMergeTask
+            {
+                usize a_begin;
+                usize a_end;
+                usize b_begin;
+                usize b_end;
+                usize dst_begin;
+            };
+
+            template <typename _Ty, typename _Compare>
+            inline void parallel_merge_relocate(_Ty* src, _Ty* dst, const ParallelMergeTask& task, _Compare& comp)
+            {
+                _Ty* a = src + task.a_begin;
+                _Ty* a_end = src + task.a_end;
+                _Ty* b = src + task.b_begin;
+                _Ty* b_end = src + task.b_end;
+                _Ty* d = dst + task.dst_begin;
+                while (a != a_end && b != b_end)
+                {
+                    if (comp(*b, *a)) copy_relocate(d++, b++);
+                    else copy_relocate(d++, a++);
+                }
+                while (a != a_end) copy_relocate(d++, a++);
+                while (b != b_end) copy_relocate(d++, b++);
+            }
+
+            template <bool _Stable, typename _RandomIt, typename _Compare>
+            inline void parallel_sort(_RandomIt first, _RandomIt last, _Compare& comp, usize grain_size)
+            {
+                using value_type = typename iterator_traits<_RandomIt>::value_type;
+                usize size = (usize)(last - first);
+                usize num_chunks = get_num_parallel_chunks(size, grain_size);
+                if (num_chunks < 2)
+                {
+                    if (_Stable) stable_sort(first, last, comp);
+                    else sort(first, last, comp);
+                    return;
+                }
+                // Uses power-of-two chunks so that chunks can be merged in pairs.
+                while (num_chunks & (num_chunks - 1)) num_chunks &= num_chunks - 1;
+                value_type* data = &(*first);
+                // Sorts every chunk.
+                auto sort_chunk = [&](usize chunk)
+                {
+                    value_type* begin = data + get_parallel_chunk_begin(size, num_chunks, chunk);
+                    value_type* end = data + get_parallel_chunk_begin(size, num_chunks, chunk + 1);
+                    if (_Stable) stable_sort(begin, end, comp);
+                    else sort(begin, end, comp);
+                };
+                parallel_for_chunks(num_chunks, sort_chunk);
+                // Merges sorted runs in pairs. Every merge is split into tasks with equal number of output elements,
+                // so that all rounds are executed by `num_chunks` tasks.
+                usize alignment = alignof(value_type) > MAX_ALIGN ? alignof(value_type) : 0;
+                value_type* buffer = (value_type*)memalloc(sizeof(value_type) * size, alignment);
+                value_type* src = data;
+                value_type* dst = buffer;
+                ParallelMergeTask tasks[MAX_PARALLEL_CHUNKS];
+                for (usize width = 1; width < num_chunks; width *= 2)
+                {
+                    usize tasks_per_merge = width * 2;
+                    for (usize merge = 0; merge < num_chunks; merge += tasks_per_merge)
+                    {
+                        usize a_begin = get_parallel_chunk_begin(size, num_chunks, merge);
+                        usize b_begin = get_parallel_chunk_begin(size, num_chunks, merge + width);
+                        usize b_end = get_parallel_chunk_begin(size, num_chunks, merge + tasks_per_merge);
+                        usize a_size = b_begin - a_begin;
+                        usize b_size = b_end - b_begin;
+                        usize merge_size = a_size + b_size;
+                        // Split points are computed before any element is relocated.
+                        usize prev_i = 0;
+                        usize prev_k = 0;
+                        for (usize t = 0; t < tasks_per_merge; ++t)
+                        {
+                            usize k = merge_size * (t + 1) / tasks_per_merge;
+                            usize i = (t + 1 == tasks_per_merge) ? a_size : merge_co_rank(k, src + a_begin, a_size, src + b_begin, b_size, comp);
+                            ParallelMergeTask& task = tasks[merge + t];
+                            task.a_begin = a_begin + prev_i;
+                            task.a_end = a_begin + i;
+                            task.b_begin = b_begin + (prev_k - prev_i);
+                            task.b_end = b_begin + (k - i);
+                            task.dst_begin = a_begin + prev_k;
+                            prev_i = i;
+                            prev_k = k;
+                        }
+                    }
+                    auto merge_chunk = [&](usize chunk)
+                    {
+                        parallel_merge_relocate(src, dst, tasks[chunk], comp);
+                    };
+                    parallel_for_chunks(num_chunks, merge_chunk);
+                    swap(src, dst);
+                }
+                if (src != data)
+                {
+                    auto relocate_chunk = [&](usize chunk)
+                    {
+                        usize begin = get_parallel_chunk_begin(size, num_chunks, chunk);
+                        usize end = get_parallel_chunk_begin(size, num_chunks, chunk + 1);
+                        for (usize i = begin; i < end; ++i) copy_relocate(data + i, src + i);
+                    };
+                    parallel_for_chunks(num_chunks, relocate_chunk);
+                }
+                memfree(buffer, alignment);
+            }
+        }
+
+        //! @addtogroup JobSystem
+        //! @{
+
+        //! Sorts the elements in the range in non-descending order using worker threads of the job system.
+        //! The order of equal elements is not guaranteed to be preserved.
+        //! @param[in] first The iterator to the first element of the range.
+        //! @param[in] last The iterator to the one-past-last element of the range.
+        //! @param[in] comp The user-defined comparision function object, which returns `true` if the first argument is less than the second.
+        //! @param[in] grain_size The minimum number of elements sorted by one job. If the range contains less than
+        //! `grain_size * 2` elements, the range is sorted on the current thread by @ref sort.
+        //! @remark The range is split into chunks that are sorted by @ref sort in parallel, then sorted chunks are merged
+        //! in pairs, where every merge is also split into jobs. One temporary buffer for all elements is allocated.
+        //!
+        //! The number of chunks only depends on the size of the range, so the result is the same for every call
+        //! regardless of the number of worker threads.
+        //! @par Valid Usage
+        //! * The job system module must be initialized.
+        //! * Elements in the range must be stored contiguously, like elements of arrays, @ref Vector and @ref Span.
+        //! * `comp` must have the following function signature: `bool comp(const Type& a, const Type& b)`, where `Type` is the value type of `_RandomIt`,
+        //! and must be safe to be called from multiple threads.
+        template <typename _RandomIt, typename _Compare>
+        void parallel_sort(_RandomIt first, _RandomIt last, _Compare comp, usize grain_size = DEFAULT_PARALLEL_SORT_GRAIN_SIZE)
+        {
+            Impl::parallel_sort<false>(first, last, comp, grain_size);
+        }
+
+        //! Sorts the elements in the range in non-descending order using worker threads of the job system.
+        //! The order of equal elements is not guaranteed to be preserved.
+        //! @param[in] first The iterator to the first element of the range.
+        //! @param[in] last The iterator to the one-past-last element of the range.
+        //! @remark See @ref parallel_sort for details.
+        template <typename _RandomIt>
+        void parallel_sort(_RandomIt first, _RandomIt last)
+        {
+            parallel_sort(first, last, Luna::Impl::SortLess());
+        }
+
+        //! Sorts the elements in the range in non-descending order using worker threads of the job system.
+        //! The order of equal elements is preserved.
+        //! @param[in] first The iterator to the first element of the range.
+        //! @param[in] last The iterator to the one-past-last element of the range.
+        //! @param[in] comp The user-defined comparision function object, which returns `true` if the first argument is less than the second.
+        //! @param[in] grain_size The minimum number of elements sorted by one job. If the range contains less than
+        //! `grain_size * 2` elements, the range is sorted on the current thread by @ref stable_sort.
+        //! @remark This behaves the same as @ref parallel_sort, except that chunks are sorted by @ref stable_sort.
+        //! @par Valid Usage
+        //! * The job system module must be initialized.
+        //! * Elements in the range must be stored contiguously, like elements of arrays, @ref Vector and @ref Span.
+        //! * `comp` must have the following function signature: `bool comp(const Type& a, const Type& b)`, where `Type` is the value type of `_RandomIt`,
+        //! and must be safe to be called from multiple threads.
+        template <typename _RandomIt, typename _Compare>
+        void parallel_stable_sort(_RandomIt first, _RandomIt last, _Compare comp, usize grain_size = DEFAULT_PARALLEL_SORT_GRAIN_SIZE)
+        {
+            Impl::parallel_sort<true>(first, last, comp, grain_size);
+        }
+
+        //! Sorts the elements in the range in non-descending order using worker threads of the job system.
+        //! The order of equal elements is preserved.
+        //! @param[in] first The iterator to the first element of the range.
+        //! @param[in] last The iterator to the one-past-last element of the range.
+        //! @remark See @ref parallel_stable_sort for details.
+        template <typename _RandomIt>
+        void parallel_stable_sort(_RandomIt first, _RandomIt last)
+        {
+            parallel_stable_sort(first, last, Luna::Impl::SortLess());
+        }
+
+        //! Applies the given function to every element in the range and stores the result to another range using
+        //! worker threads of the job system.
+        //! @param[in] first The iterator to the first element of the source range.
+        //! @param[in] last The iterator to the one-past-last element of the source range.
+        //! @param[in] d_first The iterator to the first element of the destination range. This may be equal to `first`.
+        //! @param[in] op The unary operation function to be applied.
+        //! @param[in] grain_size The minimum number of elements processed by one job. If the range contains less than
+        //! `grain_size * 2` elements, the range is processed on the current thread.
+        //! @return Returns the iterator to the one-past-last element of the destination range.
+        //! @par Valid Usage
+        //! * The job system module must be initialized.
+        //! * `op` must have the following function signature: `Ret op(const Type& v)`, where `Type` is the value type of `_RandomIt1`,
+        //! and `Ret` must be assignable to the value type of `_RandomIt2`. `op` must be safe to be called from multiple threads.
+        template <typename _RandomIt1, typename _RandomIt2, typename _UnaryOp>
+        _RandomIt2 parallel_transform(_RandomIt1 first, _RandomIt1 last, _RandomIt2 d_first, _UnaryOp op, usize grain_size = DEFAULT_PARALLEL_GRAIN_SIZE)
+        {
+            usize size = (usize)(last - first);
+            usize num_chunks = Impl::get_num_parallel_chunks(size, grain_size);
+            if (num_chunks < 2)
+            {
+                for (; first != last; ++first, ++d_first) *d_first = op(*first);
+                return d_first;
+            }
+            auto transform_chunk = [&](usize chunk)
+            {
+                usize begin = Impl::get_parallel_chunk_begin(size, num_chunks, chunk);
+                usize end = Impl::get_parallel_chunk_begin(size, num_chunks, chunk + 1);
+                for (usize i = begin; i < end; ++i) d_first[i] = op(first[i]);
+            };
+            Impl::parallel_for_chunks(num_chunks, transform_chunk);
+            return d_first + size;
+        }
+
+        //! Reduces the range using the given binary operation using worker threads of the job system.
+        //! @param[in] first The iterator to the first element of the range.
+        //! @param[in] last The iterator to the one-past-last element of the range.
+        //! @param[in] init The initial value of the reduction.
+        //! @param[in] op The binary operation function to be applied.
+        //! @param[in] grain_size The minimum number of elements processed by one job. If the range contains less than
+        //! `grain_size * 2` elements, the range is processed on the current thread.
+        //! @return Returns the reduction result.
+        //! @remark The range is split into chunks that are reduced in parallel, then the results of chunks are reduced
+        //! with `init` in order on the current thread. The number of chunks only depends on the size of the range, so the
+        //! result is the same for every call even if `op` is not exactly associative, like the addition of floating-point numbers.
+        //! @par Valid Usage
+        //! * The job system module must be initialized.
+        //! * `op` must be associative, must be safe to be called from multiple threads, and must be callable with both of the 
+        //! following function signatures: `_Ty op(const _Ty& a, const Type& b)` to reduce elements of one chunk, where `Type` is 
+        //! the value type of `_RandomIt`, and `_Ty op(const _Ty& a, const _Ty& b)` to combine results of chunks.
+        //! * The value type of `_RandomIt` must be convertible to `_Ty`.
+        template <typename _RandomIt, typename _Ty, typename _BinaryOp>
+        _Ty parallel_reduce(_RandomIt first, _RandomIt last, _Ty init, _BinaryOp op, usize grain_size = DEFAULT_PARALLEL_GRAIN_SIZE)
+        {
+            usize size = (usize)(last - first);
+            usize num_chunks = Impl::get_num_parallel_chunks(size, grain_size);
+            if (num_chunks < 2)
+            {
+                for (; first != last; ++first) init = op(move(init), *first);
+                return init;
+            }
+            Unconstructed<_Ty> results[MAX_PARALLEL_CHUNKS];
+            auto reduce_chunk = [&](usize chunk)
+            {
+                usize begin = Impl::get_parallel_chunk_begin(size, num_chunks, chunk);
+                usize end = Impl::get_parallel_chunk_begin(size, num_chunks, chunk + 1);
+                _Ty result = first[begin];
+                for (usize i = begin + 1; i < end; ++i) result = op(move(result), first[i]);
+                results[chunk].construct(move(result));
+            };
+            Impl::parallel_for_chunks(num_chunks, reduce_chunk);
+            for (usize i = 0; i < num_chunks; ++i)
+            {
+                init = op(move(init), results[i].get());
+                results[i].destruct();
+            }
+            return init;
+        }
+
+        //! Computes the inclusive prefix scan of the range using the given binary operation using worker threads
+        //! of the job system.
+        //! @param[in] first The iterator to the first element of the source range.
+        //! @param[in] last The iterator to the one-past-last element of the source range.
+        //! @param[in] d_first The iterator to the first element of the destination range. This may be equal to `first`.
+        //! @param[in] op The binary operation function to be applied.
+        //! @param[in] grain_size The minimum number of elements processed by one job. If the range contains less than
+        //! `grain_size * 2` elements, the range is processed on the current thread.
+        //! @return Returns the iterator to the one-past-last element of the destination range.
+        //! @remark The `i`th element of the destination range is the result of `op` applied to the first `i + 1` elements of
+        //! the source range. The range is split into chunks, the sum of every chunk is computed in parallel, then the prefix sums
+        //! of chunks are computed on the current thread, and then every chunk is scanned in parallel again. The number of chunks only
+        //! depends on the size of the range, so the result is the same for every call even if `op` is not exactly associative.
+        //! @par Valid Usage
+        //! * The job system module must be initialized.
+        //! * `op` must be associative, must have the following function signature: `Type op(const Type& a, const Type& b)`,
+        //! where `Type` is the value type of `_RandomIt1`, and must be safe to be called from multiple threads.
+        template <typename _RandomIt1, typename _RandomIt2, typename _BinaryOp>
+        _RandomIt2 parallel_inclusive_scan(_RandomIt1 first, _RandomIt1 last, _RandomIt2 d_first, _BinaryOp op, usize grain_size = DEFAULT_PARALLEL_GRAIN_SIZE)
+        {
+            using value_type = typename iterator_traits<_RandomIt1>::value_type;
+            usize size = (usize)(last - first);
+            if (!size) return d_first;
+            usize num_chunks = Impl::get_num_parallel_chunks(size, grain_size);
+            if (num_chunks < 2)
+            {
+                value_type sum = *first;
+                *d_first = sum;
+                for (usize i = 1; i < size; ++i)
+                {
+                    sum = op(move(sum), first[i]);
+                    d_first[i] = sum;
+                }
+                return d_first + size;
+            }
+            // Computes the sum of every chunk except the last one.
+            Unconstructed<value_type> sums[MAX_PARALLEL_CHUNKS];
+            auto reduce_chunk = [&](usize chunk)
+            {
+                usize begin = Impl::get_parallel_chunk_begin(size, num_chunks, chunk);
+                usize end = Impl::get_parallel_chunk_begin(size, num_chunks, chunk + 1);
+                value_type sum = first[begin];
+                for (usize i = begin + 1; i < end; ++i) sum = op(move(sum), first[i]);
+                sums[chunk].construct(move(sum));
+            };
+            Impl::parallel_for_chunks(num_chunks - 1, reduce_chunk);
+            // Converts sums to the prefix sum of chunks.
+            for (usize i = 1; i < num_chunks - 1; ++i)
+            {
+                sums[i].get() = op(sums[i - 1].get(), sums[i].get());
+            }
+            auto scan_chunk = [&](usize chunk)
+            {
+                usize begin = Impl::get_parallel_chunk_begin(size, num_chunks, chunk);
+                usize end = Impl::get_parallel_chunk_begin(size, num_chunks, chunk + 1);
+                value_type sum = chunk ? op(sums[chunk - 1].get(), first[begin]) : value_type(first[begin]);
+                d_first[begin] = sum;
+                for (usize i = begin + 1; i < end; ++i)
+                {
+                    sum = op(move(sum), first[i]);
+                    d_first[i] = sum;
+                }
+            };
+            Impl::parallel_for_chunks(num_chunks, scan_chunk);
+            for (usize i = 0; i < num_chunks - 1; ++i)
+            {
+                sums[i].destruct();
+            }
+            return d_first + size;
+        }
+
+        //! @}
+    }
+}
@@ -15,13 +15,14 @@
 #include <Luna/Runtime/Signal.hpp>
 #include <Luna/Runtime/Random.hpp>
 #include <Luna/Runtime/Module.hpp>
+#include <Luna/Runtime/Profiler.hpp>
 
 namespace Luna
 {
     namespace JobSystem
     {
         // Used to record job states even when the job context is destroyed.
-        static SpinLock g_job_state_map_lock;
+        static SpinLock g_job_state_map_lock("JobSystem/Job State Map");
         static job_id_t g_next_job_id;
         static RingDeque<u64> g_job_state_map;
         static usize g_job_state_map_offset;
@@ -137,19 +138,21 @@ namespace Luna
 
         struct WorkerThreadContext
         {
-            SpinLock m_lock;
+            SpinLock m_lock { "JobSystem/Worker Job Queue" };
             RingDeque<JobHeader*> m_jobs;
             Ref<ISignal> m_wake_signal;
             bool m_thread_dead = false;
         };
 
-        static SpinLock g_worker_thread_contexts_lock;
+        static SpinLock g_worker_thread_contexts_lock("JobSystem/Worker Thread Contexts");
         static Vector<WorkerThreadContext*> g_worker_thread_contexts;
         static Vector<Ref<IThread>> g_worker_threads;
-        static SpinLock g_sleep_worker_threads_lock;
+        static SpinLock g_sleep_worker_threads_lock("JobSystem/Sleep Worker Threads");
         static Vector<WorkerThreadContext*> g_sleep_worker_threads;
         static opaque_t g_worker_thread_tls;
         static bool g_job_system_exiting;
+        static profiler_counter_t g_queued_jobs_counter;
+        static profiler_counter_t g_executed_jobs_counter;
 
         static void worker_thread_tls_dtor(void* params)
         {
@@ -163,6 +166,8 @@ namespace Luna
         {
             init_job_state_map();
             g_job_system_exiting = false;
+            g_queued_jobs_counter = get_profiler_counter("JobSystem/Queued Jobs", ProfilerCounterType::gauge);
+            g_executed_jobs_counter = get_profiler_counter("JobSystem/Executed Jobs", ProfilerCounterType::counter);
             g_worker_thread_tls = tls_alloc(worker_thread_tls_dtor);
             // Emit worker threads.
             u32 processor_count = get_processors_count();
@@ -247,7 +252,11 @@ namespace Luna
                         steal_ctx->m_jobs.pop_front();
                     }
                     steal_ctx->m_lock.unlock();
-                    if (job) return job;
+                    if (job)
+                    {
+                        luprofile_counter_add(g_queued_jobs_counter, -1.0);
+                        return job;
+                    }
                     ++i;
                 }
             }
@@ -274,6 +283,7 @@ namespace Luna
                 JobHeader* job = ctx->m_jobs.back();
                 ctx->m_jobs.pop_back();
                 ctx->m_lock.unlock();
+                luprofile_counter_add(g_queued_jobs_counter, -1.0);
                 return job;
             }
         }
@@ -298,6 +308,7 @@ namespace Luna
         {
             job->m_func(job->get_params());
             finish_job(job);
+            luprofile_counter_add(g_executed_jobs_counter, 1.0);
         }
         static void worker_thread_sleep()
         {
@@ -330,6 +341,7 @@ namespace Luna
             job_id_t id = allocate_job_id();
             job->m_id = id;
             WorkerThreadContext* ctx = get_current_thread_worker_context();
+            luprofile_counter_add(g_queued_jobs_counter, 1.0);
             LockGuard lock(ctx->m_lock);
             ctx->m_jobs.push_back(job);
             // Wake up one worker thread if any.
@@ -17,6 +17,8 @@ namespace Luna
 {
     namespace RG
     {
+        profiler_counter_t g_transient_memory_counter = nullptr;
+
         struct RGModule : public Module
         {
             virtual const c8* get_name() override { return "RG"; }
@@ -26,16 +28,14 @@ namespace Luna
             }
             virtual RV on_init() override
             {
+                g_transient_memory_counter = get_profiler_counter("RG/Transient Memory Bytes", ProfilerCounterType::gauge);
                 register_boxed_type<RenderGraph>();
                 impl_interface_for_type<RenderGraph, IRenderGraph, IRenderPassContext, IRenderGraphCompiler>();
-                g_render_pass_types_mtx = new_mutex();
                 return ok;
             }
             virtual void on_close() override
             {
                 g_render_pass_types.clear();
-                g_render_pass_types.shrink_to_fit();
-                g_render_pass_types_mtx.reset();
             }
         };
     }
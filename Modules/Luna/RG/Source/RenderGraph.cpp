@@ -11,6 +11,8 @@
 #define LUNA_RG_API LUNA_EXPORT
 #include "RenderGraph.hpp"
 #include "RenderPass.hpp"
+#include <Luna/Runtime/Profiler.hpp>
+#include <Luna/Runtime/InlineVector.hpp>
 
 namespace Luna
 {
@@ -67,6 +69,8 @@ namespace Luna
                 m_resource_data.resize(m_desc.resources.size());
                 m_pass_data.clear();
                 m_pass_data.resize(m_desc.passes.size());
+                m_enabled_passes.clear();
+                m_enabled_passes.resize(m_desc.passes.size());
                 m_enable_time_profiling = config.enable_time_profiling;
                 Vector<ResourceTrackData> resource_track_data(m_resource_data.size());
                 // Initialize pass data and resource track data.
@@ -88,21 +92,22 @@ namespace Luna
                     {
                         for(usize pass : resource_track_data[i].write_passes)
                         {
-                            m_pass_data[pass].m_enabled = true;
+                            m_enabled_passes.set(pass);
                         }
                     }
                 }
                 // Scan the pass queue in reverse order, all passes that write to input resources of enabled passes should also be enabled.
                 for(usize i = 0; i < m_desc.passes.size(); ++i)
                 {
-                    auto& pass = m_pass_data[m_desc.passes.size() - i - 1];
-                    if(pass.m_enabled)
+                    usize pass_index = m_desc.passes.size() - i - 1;
+                    auto& pass = m_pass_data[pass_index];
+                    if(m_enabled_passes.test(pass_index))
                     {
                         for(auto r : pass.m_input_resources)
                         {
                             for(usize prior_pass : resource_track_data[r.second].write_passes)
                             {
-                                m_pass_data[prior_pass].m_enabled = true;
+                                m_enabled_passes.set(prior_pass);
                             }
                         }
                     }
@@ -110,7 +115,7 @@ namespace Luna
                 // Determine transient resource lifetime.
                 for (auto& i : m_desc.input_connections)
                 {
-                    if (m_pass_data[i.pass].m_enabled)
+                    if (m_enabled_passes.test(i.pass))
                     {
                         auto& res = resource_track_data[i.resource];
                         res.first_access = min(res.first_access, i.pass);
@@ -119,7 +124,7 @@ namespace Luna
                 }
                 for (auto& i : m_desc.output_connections)
                 {
-                    if (m_pass_data[i.pass].m_enabled)
+                    if (m_enabled_passes.test(i.pass))
                     {
                         auto& res = resource_track_data[i.resource];
                         res.first_access = min(res.first_access, i.pass);
@@ -132,21 +137,21 @@ namespace Luna
                     m_resource_data[i].m_resource_desc = m_desc.resources[i].desc;
                 }
                 // Compile every node in execution order.
-                u32 num_enabled_passes = 0;
-                for(usize i = 0; i < m_desc.passes.size(); ++i)
+                u32 num_enabled_passes = (u32)m_enabled_passes.count();
+                for(usize i = m_enabled_passes.find_first(); i != USIZE_MAX; i = m_enabled_passes.find_next(i + 1))
                 {
                     m_current_compile_pass = i;
-                    if(m_pass_data[i].m_enabled)
-                    {
-                        ++num_enabled_passes;
-                        MutexGuard guard(g_render_pass_types_mtx);
-                        auto iter = g_render_pass_types.find(m_desc.passes[i].type);
-                        if(iter == g_render_pass_types.end())
+                    render_pass_compile_func_t* compile = nullptr;
+                    ObjRef userdata;
+                    if(!g_render_pass_types.visit(m_desc.passes[i].type, [&compile, &userdata](const RenderPassTypeDesc& desc)
                         {
-                            return set_error(BasicError::not_found(), "Render pass type \"%s\" is not found.", m_desc.passes[i].type.c_str());
-                        }
-                        luexp(iter->compile(iter->userdata.get(), this));
+                            compile = desc.compile;
+                            userdata = desc.userdata;
+                        }))
+                    {
+                        return set_error(BasicError::not_found(), "Render pass type \"%s\" is not found.", m_desc.passes[i].type.c_str());
                     }
+                    luexp(compile(userdata.get(), this));
                 }
                 // Resolve transient resource lifetime.
                 for(usize i = 0; i < resource_track_data.size(); ++i)
@@ -202,28 +207,27 @@ namespace Luna
         void RenderGraph::get_enabled_render_passes(Vector<usize>& render_passes)
         {
             render_passes.clear();
-            for (usize i = 0; i < m_pass_data.size(); ++i)
+            render_passes.reserve(m_enabled_passes.count());
+            m_enabled_passes.for_each_set_bit([&render_passes](usize i)
             {
-                if (m_pass_data[i].m_enabled)
-                {
-                    render_passes.push_back(i);
-                }
-            }
+                render_passes.push_back(i);
+            });
         }
         RV RenderGraph::execute(RHI::ICommandBuffer* cmdbuf)
         {
+            luprofile_function();
             lutry
             {
                 m_transient_memory.clear();
+                m_transient_memory_size = 0;
                 m_cmdbuf = cmdbuf;
                 m_current_time_query_index = 0;
-                for(usize i = 0; i < m_pass_data.size(); ++i)
+                for(usize i = m_enabled_passes.find_first(); i != USIZE_MAX; i = m_enabled_passes.find_next(i + 1))
                 {
                     auto& data = m_pass_data[i];
-                    if(!data.m_enabled) continue;
                     // Allocates resources.
-                    Vector<RHI::BufferBarrier> buffer_barriers;
-                    Vector<RHI::TextureBarrier> texture_barriers;
+                    InlineVector<RHI::BufferBarrier, 8> buffer_barriers;
+                    InlineVector<RHI::TextureBarrier, 8> texture_barriers;
                     for(usize h : data.m_create_resources)
                     {
                         auto& res = m_resource_data[h];
@@ -266,6 +270,8 @@ namespace Luna
                     }
                     ++m_current_time_query_index;
                 }
+                luprofile_counter_add(g_transient_memory_counter, (f64)m_transient_memory_size - (f64)m_reported_transient_memory_size);
+                m_reported_transient_memory_size = m_transient_memory_size;
             }
             lucatchret;
             return ok;
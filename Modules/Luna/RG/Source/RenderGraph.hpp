@@ -9,10 +9,15 @@
 */
 #pragma once
 #include "../RenderGraph.hpp"
+#include <Luna/Runtime/Profiler.hpp>
+#include <Luna/Runtime/Bitset.hpp>
 namespace Luna
 {
     namespace RG
     {
+        // The gauge that measures device memory allocated for transient resources by all render graphs.
+        extern profiler_counter_t g_transient_memory_counter;
+
         struct RenderGraph : IRenderGraph, IRenderGraphCompiler, IRenderPassContext
         {
             lustruct("RG::RenderGraph", "{feefd806-4b82-48cd-b350-f8fc9387fc65}");
@@ -30,7 +35,6 @@ namespace Luna
                 Vector<usize> m_create_resources;
                 Vector<usize> m_release_resources;
                 Ref<IRenderPass> m_render_pass;
-                bool m_enabled = false;
             };
             struct ResourceData
             {
@@ -38,6 +42,8 @@ namespace Luna
                 Ref<RHI::IResource> m_resource;
             };
             Vector<PassData> m_pass_data;
+            // Bit `i` is set if the pass `i` is required to produce output resources.
+            Bitset<> m_enabled_passes;
             Vector<ResourceData> m_resource_data;
             bool m_enable_time_profiling;
 
@@ -55,6 +61,14 @@ namespace Luna
             usize m_current_pass;
 
             Vector<Ref<RHI::IDeviceMemory>> m_transient_memory;
+            // The size of device memory allocated for transient resources in the current execution.
+            u64 m_transient_memory_size = 0;
+            // The size reported to `g_transient_memory_counter` by the last execution.
+            u64 m_reported_transient_memory_size = 0;
+            ~RenderGraph()
+            {
+                luprofile_counter_add(g_transient_memory_counter, -(f64)m_reported_transient_memory_size);
+            }
             R<Ref<RHI::IResource>> allocate_transient_resource(const ResourceDesc& desc)
             {
                 // Try to reuse one memory block.
@@ -103,6 +117,7 @@ namespace Luna
                         if (failed(r)) return r.errcode();
                         ret = r.get();
                     }
+                    m_transient_memory_size += ret->get_memory()->get_size();
                 }
                 return ret;
             }
@@ -15,30 +15,26 @@ namespace Luna
 {
     namespace RG
     {
-        SelfIndexedHashMap<Name, RenderPassTypeDesc, RenderPassTypeDescExtractKey> g_render_pass_types;
-        Ref<IMutex> g_render_pass_types_mtx;
+        ConcurrentHashMap<Name, RenderPassTypeDesc> g_render_pass_types;
 
         LUNA_RG_API void register_render_pass_type(const RenderPassTypeDesc& desc)
         {
-            MutexGuard guard(g_render_pass_types_mtx);
-            g_render_pass_types.insert(desc);
+            g_render_pass_types.insert(desc.name, desc);
         }
 
         LUNA_RG_API void get_render_pass_types(Vector<Name>& out_render_pass_types)
         {
-            MutexGuard guard(g_render_pass_types_mtx);
-            for(auto& i : g_render_pass_types)
+            g_render_pass_types.for_each([&out_render_pass_types](const Name& name, const RenderPassTypeDesc&)
             {
-                out_render_pass_types.push_back(i.name);
-            }
+                out_render_pass_types.push_back(name);
+            });
         }
 
         LUNA_RG_API R<RenderPassTypeDesc> get_render_pass_type_desc(const Name& render_pass)
         {
-            MutexGuard guard(g_render_pass_types_mtx);
-            auto iter = g_render_pass_types.find(render_pass);
-            if(iter == g_render_pass_types.end()) return BasicError::not_found();
-            return *iter;
+            RenderPassTypeDesc desc;
+            if(!g_render_pass_types.find(render_pass, desc)) return BasicError::not_found();
+            return desc;
         }
     }
 }
\ No newline at end of file
@@ -9,21 +9,13 @@
 */
 #pragma once
 #include "../RenderPass.hpp"
-#include <Luna/Runtime/SelfIndexedHashMap.hpp>
-#include <Luna/Runtime/Mutex.hpp>
+#include <Luna/Runtime/ConcurrentHashMap.hpp>
 
 namespace Luna
 {
     namespace RG
     {
-        struct RenderPassTypeDescExtractKey
-        {
-            const Name& operator()(const RenderPassTypeDesc& rhs) const
-            {
-                return rhs.name;
-            }
-        };
-        extern SelfIndexedHashMap<Name, RenderPassTypeDesc, RenderPassTypeDescExtractKey> g_render_pass_types;
-        extern Ref<IMutex> g_render_pass_types_mtx;
+        // Render pass types are looked up when every render graph is compiled, possibly from multiple threads.
+        extern ConcurrentHashMap<Name, RenderPassTypeDesc> g_render_pass_types;
     }
 }
\ No newline at end of file
@@ -64,7 +64,7 @@ namespace Luna
     {
         usize operator()(const RHI::SubresourceIndex& value)
         {
-            return memhash(&value, sizeof(RHI::SubresourceIndex));
+            return hash_bytes(&value, sizeof(RHI::SubresourceIndex));
         }
     };
 }
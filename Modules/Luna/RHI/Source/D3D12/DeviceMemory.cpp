@@ -28,7 +28,7 @@ namespace Luna
         DeviceMemory::~DeviceMemory()
         {
 #ifdef LUNA_MEMORY_PROFILER_ENABLED
-            memory_profiler_deallocate(m_allocation.Get());
+            memory_profiler_deallocate(m_allocation.Get(), get_size());
 #endif
         }
     }
@@ -32,7 +32,7 @@ namespace Luna
         DeviceMemory::~DeviceMemory()
         {
 #ifdef LUNA_MEMORY_PROFILER_ENABLED
-            if(m_heap) memory_profiler_deallocate(m_heap.get());
+            if(m_heap) memory_profiler_deallocate(m_heap.get(), m_size);
 #endif
         }
     }
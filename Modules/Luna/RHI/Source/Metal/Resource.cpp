@@ -54,7 +54,7 @@ namespace Luna
         Buffer::~Buffer()
         {
 #ifdef LUNA_MEMORY_PROFILER_ENABLED
-            if(!m_memory->m_heap) memory_profiler_deallocate(m_buffer.get());
+            if(!m_memory->m_heap) memory_profiler_deallocate(m_buffer.get(), m_memory->get_size());
 #endif
         }
         RV Buffer::map(usize read_begin, usize read_end, void** data)
@@ -113,7 +113,7 @@ namespace Luna
         Texture::~Texture()
         {
 #ifdef LUNA_MEMORY_PROFILER_ENABLED
-            if(m_memory && !m_memory->m_heap) memory_profiler_deallocate(m_texture.get());
+            if(m_memory && !m_memory->m_heap) memory_profiler_deallocate(m_texture.get(), m_memory->get_size());
 #endif
         }
         bool compare_texture_view_desc(const TextureViewDesc& lhs, const TextureViewDesc& rhs)
@@ -33,7 +33,7 @@ namespace Luna
             if (m_allocation != VK_NULL_HANDLE)
             {
 #ifdef LUNA_MEMORY_PROFILER_ENABLED
-                memory_profiler_deallocate(&m_allocation);
+                memory_profiler_deallocate(&m_allocation, get_size());
 #endif
                 vmaFreeMemory(m_device->m_allocator, m_allocation);
                 m_allocation = VK_NULL_HANDLE;
@@ -385,28 +385,386 @@ namespace Luna
         return f; // implicit move since C++11
     }
 
-    //! Sorts the elements in the range in non-descending order. The order of equal elements is not guaranteed to be preserved.
-    //! @param[in] first The iterator to the first element of the range.
-    //! @param[in] last The iterator to the one-past-last element of the range.
-    template <typename _RandomIt>
-    void sort(_RandomIt first, _RandomIt last)
+    namespace Impl
     {
-        if (first + 1 >= last) return;
-        _RandomIt i = first;
-        _RandomIt j = last - 1;
-        _RandomIt flag = first;
-        while (i < j)
+        // Ranges smaller than this are sorted by insertion sort.
+        constexpr isize SORT_INSERTION_THRESHOLD = 24;
+        // Ranges larger than this use the pseudomedian of 9 elements as pivot rather than the median of 3.
+        constexpr isize SORT_NINTHER_THRESHOLD = 128;
+        // The maximum number of elements moved by `partial_insertion_sort` before it gives up.
+        constexpr usize SORT_PARTIAL_INSERTION_LIMIT = 8;
+        // Temporary buffers larger than this are allocated from heap rather than from stack.
+        constexpr usize SORT_STACK_SIZE_THRESHOLD = 4096;
+
+        struct SortLess
+        {
+            template <typename _Ty1, typename _Ty2>
+            bool operator()(const _Ty1& lhs, const _Ty2& rhs) const
+            {
+                return lhs < rhs;
+            }
+        };
+
+        inline u32 sort_log2(usize n)
+        {
+            u32 r = 0;
+            while (n >>= 1) ++r;
+            return r;
+        }
+
+        template <typename _RandomIt, typename _Compare>
+        inline void insertion_sort(_RandomIt begin, _RandomIt end, _Compare& comp)
+        {
+            using value_type = typename iterator_traits<_RandomIt>::value_type;
+            if (begin == end) return;
+            for (_RandomIt cur = begin + 1; cur != end; ++cur)
+            {
+                _RandomIt sift = cur;
+                _RandomIt sift_1 = cur - 1;
+                if (comp(*sift, *sift_1))
+                {
+                    value_type tmp(move(*sift));
+                    do
+                    {
+                        *sift-- = move(*sift_1);
+                    } while (sift != begin && comp(tmp, *--sift_1));
+                    *sift = move(tmp);
+                }
+            }
+        }
+
+        // Same as `insertion_sort`, but assumes that the element before `begin` is not greater than any element 
+        // in the range, so the boundary check can be omitted.
+        template <typename _RandomIt, typename _Compare>
+        inline void unguarded_insertion_sort(_RandomIt begin, _RandomIt end, _Compare& comp)
+        {
+            using value_type = typename iterator_traits<_RandomIt>::value_type;
+            if (begin == end) return;
+            for (_RandomIt cur = begin + 1; cur != end; ++cur)
+            {
+                _RandomIt sift = cur;
+                _RandomIt sift_1 = cur - 1;
+                if (comp(*sift, *sift_1))
+                {
+                    value_type tmp(move(*sift));
+                    do
+                    {
+                        *sift-- = move(*sift_1);
+                    } while (comp(tmp, *--sift_1));
+                    *sift = move(tmp);
+                }
+            }
+        }
+
+        // Tries to sort the range by insertion sort, gives up and returns `false` if too many elements are moved.
+        template <typename _RandomIt, typename _Compare>
+        inline bool partial_insertion_sort(_RandomIt begin, _RandomIt end, _Compare& comp)
+        {
+            using value_type = typename iterator_traits<_RandomIt>::value_type;
+            if (begin == end) return true;
+            usize limit = 0;
+            for (_RandomIt cur = begin + 1; cur != end; ++cur)
+            {
+                _RandomIt sift = cur;
+                _RandomIt sift_1 = cur - 1;
+                if (comp(*sift, *sift_1))
+                {
+                    value_type tmp(move(*sift));
+                    do
+                    {
+                        *sift-- = move(*sift_1);
+                    } while (sift != begin && comp(tmp, *--sift_1));
+                    *sift = move(tmp);
+                    limit += (usize)(cur - sift);
+                    if (limit > SORT_PARTIAL_INSERTION_LIMIT) return false;
+                }
+            }
+            return true;
+        }
+
+        template <typename _RandomIt, typename _Compare>
+        inline void sort2(_RandomIt a, _RandomIt b, _Compare& comp)
+        {
+            if (comp(*b, *a)) swap(*a, *b);
+        }
+
+        template <typename _RandomIt, typename _Compare>
+        inline void sort3(_RandomIt a, _RandomIt b, _RandomIt c, _Compare& comp)
+        {
+            sort2(a, b, comp);
+            sort2(b, c, comp);
+            sort2(a, b, comp);
+        }
+
+        template <typename _RandomIt, typename _Compare>
+        inline void heap_sift_down(_RandomIt begin, isize size, isize i, _Compare& comp)
+        {
+            using value_type = typename iterator_traits<_RandomIt>::value_type;
+            value_type tmp(move(*(begin + i)));
+            while (true)
+            {
+                isize child = i * 2 + 1;
+                if (child >= size) break;
+                if (child + 1 < size && comp(*(begin + child), *(begin + (child + 1)))) ++child;
+                if (!comp(tmp, *(begin + child))) break;
+                *(begin + i) = move(*(begin + child));
+                i = child;
+            }
+            *(begin + i) = move(tmp);
+        }
+
+        template <typename _RandomIt, typename _Compare>
+        inline void heap_sort(_RandomIt begin, _RandomIt end, _Compare& comp)
         {
-            while (*flag < *j && i < j) --j;
-            while (!(*flag < *i) && i < j) ++i;
-            if (i < j)
+            isize size = end - begin;
+            for (isize i = size / 2; i > 0; --i)
+            {
+                heap_sift_down(begin, size, i - 1, comp);
+            }
+            for (isize i = size - 1; i > 0; --i)
             {
-                swap(*i, *j);
+                swap(*begin, *(begin + i));
+                heap_sift_down(begin, i, 0, comp);
             }
         }
-        swap(*i, *flag);
-        sort(first, i);
-        sort(i + 1, last);
+
+        // Partitions the range using `*begin` as pivot. Elements equal to the pivot are put in the right partition.
+        // Returns the position of the pivot, and whether the range was already partitioned.
+        // The range must contain at least 3 elements, and the median of 3 must be at `begin`.
+        template <typename _RandomIt, typename _Compare>
+        inline Pair<_RandomIt, bool> partition_right(_RandomIt begin, _RandomIt end, _Compare& comp)
+        {
+            using value_type = typename iterator_traits<_RandomIt>::value_type;
+            value_type pivot(move(*begin));
+            _RandomIt first = begin;
+            _RandomIt last = end;
+            // The median of 3 guarantees that one element not less than the pivot exists.
+            while (comp(*++first, pivot));
+            // If no element is moved, the left boundary must be checked.
+            if (first - 1 == begin)
+            {
+                while (first < last && !comp(*--last, pivot));
+            }
+            else
+            {
+                while (!comp(*--last, pivot));
+            }
+            bool already_partitioned = first >= last;
+            while (first < last)
+            {
+                swap(*first, *last);
+                while (comp(*++first, pivot));
+                while (!comp(*--last, pivot));
+            }
+            _RandomIt pivot_pos = first - 1;
+            *begin = move(*pivot_pos);
+            *pivot_pos = move(pivot);
+            return make_pair(pivot_pos, already_partitioned);
+        }
+
+        // Partitions the range using `*begin` as pivot. Elements equal to the pivot are put in the left partition.
+        // This is used when the pivot equals to the element before the range, so that all elements equal to the 
+        // pivot are gathered and never be sorted again.
+        template <typename _RandomIt, typename _Compare>
+        inline _RandomIt partition_left(_RandomIt begin, _RandomIt end, _Compare& comp)
+        {
+            using value_type = typename iterator_traits<_RandomIt>::value_type;
+            value_type pivot(move(*begin));
+            _RandomIt first = begin;
+            _RandomIt last = end;
+            while (comp(pivot, *--last));
+            if (last + 1 == end)
+            {
+                while (first < last && !comp(pivot, *++first));
+            }
+            else
+            {
+                while (!comp(pivot, *++first));
+            }
+            while (first < last)
+            {
+                swap(*first, *last);
+                while (comp(pivot, *--last));
+                while (!comp(pivot, *++first));
+            }
+            _RandomIt pivot_pos = last;
+            *begin = move(*pivot_pos);
+            *pivot_pos = move(pivot);
+            return pivot_pos;
+        }
+
+        // The pattern-defeating quicksort. `bad_allowed` is the number of highly unbalanced partitions allowed 
+        // before switching to heap sort, which bounds the worst case to O(n log n).
+        template <typename _RandomIt, typename _Compare>
+        inline void pdqsort_loop(_RandomIt begin, _RandomIt end, _Compare& comp, u32 bad_allowed, bool leftmost)
+        {
+            while (true)
+            {
+                isize size = end - begin;
+                if (size < SORT_INSERTION_THRESHOLD)
+                {
+                    if (leftmost) insertion_sort(begin, end, comp);
+                    else unguarded_insertion_sort(begin, end, comp);
+                    return;
+                }
+                // Choose pivot and move it to `begin`.
+                isize s2 = size / 2;
+                if (size > SORT_NINTHER_THRESHOLD)
+                {
+                    sort3(begin, begin + s2, end - 1, comp);
+                    sort3(begin + 1, begin + (s2 - 1), end - 2, comp);
+                    sort3(begin + 2, begin + (s2 + 1), end - 3, comp);
+                    sort3(begin + (s2 - 1), begin + s2, begin + (s2 + 1), comp);
+                    swap(*begin, *(begin + s2));
+                }
+                else
+                {
+                    sort3(begin + s2, begin, end - 1, comp);
+                }
+                // If the pivot equals to the element before the range, which is the pivot of the parent partition,
+                // all elements equal to the pivot can be excluded.
+                if (!leftmost && !comp(*(begin - 1), *begin))
+                {
+                    begin = partition_left(begin, end, comp) + 1;
+                    continue;
+                }
+                auto part = partition_right(begin, end, comp);
+                _RandomIt pivot_pos = part.first;
+                bool already_partitioned = part.second;
+                isize l_size = pivot_pos - begin;
+                isize r_size = end - (pivot_pos + 1);
+                bool highly_unbalanced = l_size < size / 8 || r_size < size / 8;
+                if (highly_unbalanced)
+                {
+                    if (--bad_allowed == 0)
+                    {
+                        heap_sort(begin, end, comp);
+                        return;
+                    }
+                    // Shuffle some elements to break patterns that cause unbalanced partitions.
+                    if (l_size >= SORT_INSERTION_THRESHOLD)
+                    {
+                        swap(*begin, *(begin + l_size / 4));
+                        swap(*(pivot_pos - 1), *(pivot_pos - l_size / 4));
+                        if (l_size > SORT_NINTHER_THRESHOLD)
+                        {
+                            swap(*(begin + 1), *(begin + (l_size / 4 + 1)));
+                            swap(*(begin + 2), *(begin + (l_size / 4 + 2)));
+                            swap(*(pivot_pos - 2), *(pivot_pos - (l_size / 4 + 1)));
+                            swap(*(pivot_pos - 3), *(pivot_pos - (l_size / 4 + 2)));
+                        }
+                    }
+                    if (r_size >= SORT_INSERTION_THRESHOLD)
+                    {
+                        swap(*(pivot_pos + 1), *(pivot_pos + (1 + r_size / 4)));
+                        swap(*(end - 1), *(end - r_size / 4));
+                        if (r_size > SORT_NINTHER_THRESHOLD)
+                        {
+                            swap(*(pivot_pos + 2), *(pivot_pos + (2 + r_size / 4)));
+                            swap(*(pivot_pos + 3), *(pivot_pos + (3 + r_size / 4)));
+                            swap(*(end - 2), *(end - (1 + r_size / 4)));
+                            swap(*(end - 3), *(end - (2 + r_size / 4)));
+                        }
+                    }
+                }
+                else
+                {
+                    // If the range was already partitioned, it may be already sorted, try insertion sort.
+                    if (already_partitioned && partial_insertion_sort(begin, pivot_pos, comp) &&
+                        partial_insertion_sort(pivot_pos + 1, end, comp)) return;
+                }
+                // Recurses into the left partition and loops on the right partition.
+                pdqsort_loop(begin, pivot_pos, comp, bad_allowed, leftmost);
+                begin = pivot_pos + 1;
+                leftmost = false;
+            }
+        }
+
+        template <typename _RandomIt, typename _Compare>
+        inline void merge_sort(_RandomIt begin, _RandomIt end, typename iterator_traits<_RandomIt>::value_type* buffer, _Compare& comp)
+        {
+            using value_type = typename iterator_traits<_RandomIt>::value_type;
+            isize size = end - begin;
+            if (size < SORT_INSERTION_THRESHOLD)
+            {
+                insertion_sort(begin, end, comp);
+                return;
+            }
+            _RandomIt mid = begin + size / 2;
+            merge_sort(begin, mid, buffer, comp);
+            merge_sort(mid, end, buffer, comp);
+            // Skip merging if two halves are already in order.
+            if (!comp(*mid, *(mid - 1))) return;
+            // Moves the left half to the buffer, then merges the buffer and the right half to the range.
+            isize l_size = mid - begin;
+            for (isize i = 0; i < l_size; ++i)
+            {
+                new (buffer + i) value_type(move(*(begin + i)));
+            }
+            value_type* l = buffer;
+            value_type* l_end = buffer + l_size;
+            _RandomIt r = mid;
+            _RandomIt dst = begin;
+            while (l != l_end && r != end)
+            {
+                // Takes from the left half if elements are equal, so that the order of equal elements is preserved.
+                if (comp(*r, *l)) *dst++ = move(*r++);
+                else *dst++ = move(*l++);
+            }
+            while (l != l_end) *dst++ = move(*l++);
+            for (isize i = 0; i < l_size; ++i)
+            {
+                buffer[i].~value_type();
+            }
+        }
+
+        template <usize _Size> struct RadixSortKey {};
+        template <> struct RadixSortKey<1> { using type = u8; };
+        template <> struct RadixSortKey<2> { using type = u16; };
+        template <> struct RadixSortKey<4> { using type = u32; };
+        template <> struct RadixSortKey<8> { using type = u64; };
+
+        // Maps one integer, enumeration or floating-point value to one unsigned integer with the same order.
+        template <typename _Ty>
+        inline typename RadixSortKey<sizeof(_Ty)>::type to_radix_sort_key(_Ty v)
+        {
+            using key_type = typename RadixSortKey<sizeof(_Ty)>::type;
+            constexpr key_type sign_bit = (key_type)((key_type)1 << (sizeof(_Ty) * 8 - 1));
+            if constexpr (is_floating_point_v<_Ty>)
+            {
+                // Flips all bits of negative values, and only the sign bit of positive values.
+                key_type bits;
+                memcpy(&bits, &v, sizeof(_Ty));
+                return (key_type)(bits ^ ((bits & sign_bit) ? (key_type)~(key_type)0 : sign_bit));
+            }
+            else if constexpr (is_enum_v<_Ty>)
+            {
+                return to_radix_sort_key((underlying_type_t<_Ty>)v);
+            }
+            else
+            {
+                static_assert(is_integral_v<_Ty>, "The radix sort key must be one integer, enumeration or floating-point type.");
+                if constexpr (is_signed_v<_Ty>) return (key_type)((key_type)v ^ sign_bit);
+                else return (key_type)v;
+            }
+        }
+
+        template <typename _Ty>
+        inline void radix_sort_relocate(_Ty* dst, _Ty* src)
+        {
+            if constexpr (is_trivially_relocatable_v<_Ty>)
+            {
+                memcpy(static_cast<void*>(dst), static_cast<const void*>(src), sizeof(_Ty));
+            }
+            else
+            {
+                new (dst) _Ty(move(*src));
+                src->~_Ty();
+            }
+        }
+
+        // Radix sort is slower than comparison sort for small ranges because it needs to clear and scan histograms.
+        constexpr usize RADIX_SORT_THRESHOLD = 64;
     }
 
     //! Sorts the elements in the range in non-descending order. The order of equal elements is not guaranteed to be preserved.
@@ -415,25 +773,154 @@ namespace Luna
     //! @param[in] comp The user-defined comparision function object, which returns `true` if the first argument is less than the second.
     //! @par Valid Usage
     //! * `comp` must have the following function signature: `bool comp(const Type& a, const Type& b)`, where `Type` is the value type of `_RandomIt`.
+    //! @remark This function uses pattern-defeating quicksort, which runs in O(n) time for sorted, reverse-sorted and 
+    //! all-equal ranges, and falls back to heap sort when too many unbalanced partitions are found, so that 
+    //! the worst-case time is O(n log n) and the recursion depth is O(log n). No memory is allocated.
     template <typename _RandomIt, typename _Compare>
     void sort(_RandomIt first, _RandomIt last, _Compare comp)
     {
-        if (first + 1 >= last) return;
-        _RandomIt i = first;
-        _RandomIt j = last - 1;
-        _RandomIt flag = first;
-        while (i < j)
+        if (last - first < 2) return;
+        Impl::pdqsort_loop(first, last, comp, Impl::sort_log2((usize)(last - first)), true);
+    }
+
+    //! Sorts the elements in the range in non-descending order. The order of equal elements is not guaranteed to be preserved.
+    //! @param[in] first The iterator to the first element of the range.
+    //! @param[in] last The iterator to the one-past-last element of the range.
+    //! @remark See @ref sort for details.
+    template <typename _RandomIt>
+    void sort(_RandomIt first, _RandomIt last)
+    {
+        sort(first, last, Impl::SortLess());
+    }
+
+    //! Sorts the elements in the range in non-descending order. The order of equal elements is preserved.
+    //! @param[in] first The iterator to the first element of the range.
+    //! @param[in] last The iterator to the one-past-last element of the range.
+    //! @param[in] comp The user-defined comparision function object, which returns `true` if the first argument is less than the second.
+    //! @par Valid Usage
+    //! * `comp` must have the following function signature: `bool comp(const Type& a, const Type& b)`, where `Type` is the value type of `_RandomIt`.
+    //! @remark This function uses merge sort, which runs in O(n log n) time and allocates one temporary buffer for half 
+    //! of the elements.
+    template <typename _RandomIt, typename _Compare>
+    void stable_sort(_RandomIt first, _RandomIt last, _Compare comp)
+    {
+        using value_type = typename iterator_traits<_RandomIt>::value_type;
+        isize size = last - first;
+        if (size < 2) return;
+        if (size < Impl::SORT_INSERTION_THRESHOLD)
+        {
+            Impl::insertion_sort(first, last, comp);
+            return;
+        }
+        StackAllocator salloc;
+        usize buffer_size_bytes = sizeof(value_type) * (usize)(size / 2);
+        usize alignment = alignof(value_type) > MAX_ALIGN ? alignof(value_type) : 0;
+        value_type* buffer;
+        if (buffer_size_bytes > Impl::SORT_STACK_SIZE_THRESHOLD) buffer = (value_type*)memalloc(buffer_size_bytes, alignment);
+        else buffer = (value_type*)salloc.allocate(buffer_size_bytes, alignment);
+        Impl::merge_sort(first, last, buffer, comp);
+        if (buffer_size_bytes > Impl::SORT_STACK_SIZE_THRESHOLD) memfree(buffer, alignment);
+    }
+
+    //! Sorts the elements in the range in non-descending order. The order of equal elements is preserved.
+    //! @param[in] first The iterator to the first element of the range.
+    //! @param[in] last The iterator to the one-past-last element of the range.
+    //! @remark See @ref stable_sort for details.
+    template <typename _RandomIt>
+    void stable_sort(_RandomIt first, _RandomIt last)
+    {
+        stable_sort(first, last, Impl::SortLess());
+    }
+
+    //! Sorts the elements in the range by keys in non-descending order using LSD radix sort. The order of elements
+    //! with equal keys is preserved.
+    //! @param[in] first The iterator to the first element of the range.
+    //! @param[in] last The iterator to the one-past-last element of the range.
+    //! @param[in] key_func The user-defined function object that returns the sort key of one element. The key must be one
+    //! integer, enumeration or floating-point value.
+    //! @par Valid Usage
+    //! * `key_func` must have the following function signature: `Key key_func(const Type& v)`, where `Type` is the value type of `_RandomIt`.
+    //! * Elements in the range must be stored contiguously, like elements of arrays, @ref Vector and @ref Span.
+    //! @remark This function runs in O(n * k) time, where `k` is the size of the key in bytes. Byte passes where all elements 
+    //! have the same digit are skipped, so sorting by 64-bit keys whose high bytes are all equal costs the same as 
+    //! sorting by smaller keys. One temporary buffer for all elements is allocated, and elements are relocated between the
+    //! range and the buffer, so `key_func` may be called on the same element at different addresses.
+    //! 
+    //! Negative zero is ordered before positive zero, and NaN values are ordered by their bit patterns.
+    template <typename _RandomIt, typename _KeyFunc>
+    void radix_sort(_RandomIt first, _RandomIt last, _KeyFunc key_func)
+    {
+        using value_type = typename iterator_traits<_RandomIt>::value_type;
+        using key_type = decay_t<decltype(key_func(*first))>;
+        constexpr usize num_passes = sizeof(key_type);
+        usize size = (usize)(last - first);
+        if (size < 2) return;
+        if (size < Impl::RADIX_SORT_THRESHOLD)
+        {
+            stable_sort(first, last, [&key_func](const value_type& lhs, const value_type& rhs)
+            {
+                return Impl::to_radix_sort_key(key_func(lhs)) < Impl::to_radix_sort_key(key_func(rhs));
+            });
+            return;
+        }
+        StackAllocator salloc;
+        usize* histograms = (usize*)salloc.allocate(sizeof(usize) * 256 * num_passes);
+        memset(histograms, 0, sizeof(usize) * 256 * num_passes);
+        usize buffer_size_bytes = sizeof(value_type) * size;
+        usize alignment = alignof(value_type) > MAX_ALIGN ? alignof(value_type) : 0;
+        value_type* buffer;
+        if (buffer_size_bytes > Impl::SORT_STACK_SIZE_THRESHOLD) buffer = (value_type*)memalloc(buffer_size_bytes, alignment);
+        else buffer = (value_type*)salloc.allocate(buffer_size_bytes, alignment);
+        value_type* src = &(*first);
+        value_type* dst = buffer;
+        // Computes histograms of all passes in one scan.
+        for (usize i = 0; i < size; ++i)
+        {
+            auto key = Impl::to_radix_sort_key(key_func(src[i]));
+            for (usize pass = 0; pass < num_passes; ++pass)
+            {
+                ++histograms[pass * 256 + ((key >> (pass * 8)) & 0xFF)];
+            }
+        }
+        for (usize pass = 0; pass < num_passes; ++pass)
+        {
+            usize* offsets = histograms + pass * 256;
+            usize shift = pass * 8;
+            if (offsets[(Impl::to_radix_sort_key(key_func(src[0])) >> shift) & 0xFF] == size) continue;
+            usize offset = 0;
+            for (usize digit = 0; digit < 256; ++digit)
+            {
+                usize count = offsets[digit];
+                offsets[digit] = offset;
+                offset += count;
+            }
+            for (usize i = 0; i < size; ++i)
+            {
+                usize digit = (usize)((Impl::to_radix_sort_key(key_func(src[i])) >> shift) & 0xFF);
+                Impl::radix_sort_relocate(dst + offsets[digit], src + i);
+                ++offsets[digit];
+            }
+            swap(src, dst);
+        }
+        if (src != &(*first))
         {
-            while (comp(*flag, *j) && i < j) --j;
-            while (!comp(*flag, *i) && i < j) ++i;
-            if (i < j)
+            for (usize i = 0; i < size; ++i)
             {
-                swap(*i, *j);
+                Impl::radix_sort_relocate(dst + i, src + i);
             }
         }
-        swap(*i, *flag);
-        sort(first, i, comp);
-        sort(i + 1, last, comp);
+        if (buffer_size_bytes > Impl::SORT_STACK_SIZE_THRESHOLD) memfree(buffer, alignment);
+    }
+
+    //! Sorts integer, enumeration or floating-point elements in the range in non-descending order using LSD radix sort.
+    //! @param[in] first The iterator to the first element of the range.
+    //! @param[in] last The iterator to the one-past-last element of the range.
+    //! @remark See @ref radix_sort for details.
+    template <typename _RandomIt>
+    void radix_sort(_RandomIt first, _RandomIt last)
+    {
+        using value_type = typename iterator_traits<_RandomIt>::value_type;
+        radix_sort(first, last, [](const value_type& v) { return v; });
     }
 
     //! Finds the first element in the range such that `value < element` is `true`.
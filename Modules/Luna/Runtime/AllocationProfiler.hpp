@@ -0,0 +1,107 @@
+/*!
+* This file is a portion of LunaSDK.
+* For conditions of distribution and use, see the disclaimer
+* and license in LICENSE.txt
+*
+* @file AllocationProfiler.hpp
+* @author JXMaster
+* @date 2026/10/18
+*/
+#pragma once
+#include "Vector.hpp"
+#include "String.hpp"
+#include "Name.hpp"
+
+#ifndef LUNA_RUNTIME_API
+#define LUNA_RUNTIME_API
+#endif
+
+namespace Luna
+{
+    //! @addtogroup RuntimeProfiler
+    //! @{
+
+    //! The maximum number of stack frames recorded for one sampled allocation.
+    constexpr u32 MAX_ALLOCATION_SAMPLE_FRAMES = 32;
+
+    //! Describes live memory allocated from one call site.
+    struct AllocationSite
+    {
+        //! The hash of the call stack, memory type and memory domain of this site.
+        //! Sites in different profiles with the same ID refer to the same call site.
+        u64 id = 0;
+        //! The call stack frames that can be resolved by @ref stack_backtrace_symbols, from innermost to outermost.
+        Vector<opaque_t> frames;
+        //! The memory type set by @ref memory_profiler_set_memory_type, or empty if not set.
+        Name type;
+        //! The memory domain set by @ref memory_profiler_set_memory_domain, or empty if not set.
+        Name domain;
+        //! The estimated number of live bytes allocated from this site.
+        i64 bytes = 0;
+        //! The estimated number of live memory blocks allocated from this site.
+        i64 count = 0;
+        //! The number of sampled blocks used to compute the estimation.
+        i64 samples = 0;
+    };
+
+    //! Represents one snapshot of live allocations captured by the allocation profiler.
+    struct AllocationProfile
+    {
+        //! The sampling interval in bytes when this profile is captured.
+        usize sampling_interval = 0;
+        //! The timestamp when this profile is captured, in ticks returned by @ref get_ticks.
+        u64 timestamp = 0;
+        //! The call sites, sorted by @ref AllocationSite::bytes in descending order.
+        Vector<AllocationSite> sites;
+    };
+
+    //! Enables or disables the sampling allocation profiler.
+    //! @details The sampling allocation profiler records the call stack of about one allocation every `interval` bytes
+    //! allocated by @ref memalloc and @ref memrealloc, and tracks the sampled block until it is freed. Allocations that are
+    //! not sampled only decrement one thread-local counter, so the profiler can be kept enabled in production builds.
+    //!
+    //! Every block is sampled with probability `1 - exp(-size / interval)`, and the live bytes and counts of call sites
+    //! are estimated from sampled blocks with the reverse probability.
+    //! @param[in] interval The average number of bytes between two samples. Specify `0` to disable the profiler.
+    //! Blocks sampled before the profiler is disabled are still tracked until they are freed.
+    LUNA_RUNTIME_API void set_allocation_sampling_interval(usize interval);
+
+    //! Gets the sampling interval of the sampling allocation profiler.
+    //! @return Returns the sampling interval in bytes, or `0` if the profiler is disabled.
+    LUNA_RUNTIME_API usize get_allocation_sampling_interval();
+
+    //! Captures one snapshot of live sampled allocations, aggregated by call site, memory type and memory domain.
+    //! @return Returns the captured profile.
+    LUNA_RUNTIME_API AllocationProfile capture_allocation_profile();
+
+    //! Computes the difference between two allocation profiles.
+    //! @param[in] base The earlier profile.
+    //! @param[in] current The later profile.
+    //! @return Returns one profile whose sites store `current - base` for every call site. Sites whose values do not change
+    //! are omitted.
+    LUNA_RUNTIME_API AllocationProfile diff_allocation_profiles(const AllocationProfile& base, const AllocationProfile& current);
+
+    //! Encodes one allocation profile to JSON.
+    //! @details The output object has the following layout:
+    //! ```json
+    //! {
+    //!     "sampling_interval" : 524288,
+    //!     "timestamp" : 123456789,
+    //!     "sites" : [
+    //!         {
+    //!             "id" : "0x...", "type" : "...", "domain" : "...",
+    //!             "bytes" : 1024, "count" : 2, "samples" : 1,
+    //!             "frames" : [ "0x...", ... ],
+    //!             "symbols" : [ "...", ... ]
+    //!         }
+    //!     ]
+    //! }
+    //! ```
+    //! @param[in] profile The profile to encode.
+    //! @param[in] resolve_symbols Whether to resolve symbolic names of frames using @ref stack_backtrace_symbols. If this
+    //! is `false`, the `symbols` array is not written.
+    //! @return Returns the encoded JSON string.
+    LUNA_RUNTIME_API String allocation_profile_to_json(const AllocationProfile& profile, bool resolve_symbols = true);
+
+    //! @}
+}
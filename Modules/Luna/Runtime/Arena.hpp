@@ -0,0 +1,248 @@
+/*!
+* This file is a portion of LunaSDK.
+* For conditions of distribution and use, see the disclaimer
+* and license in LICENSE.txt
+*
+* @file Arena.hpp
+* @author JXMaster
+* @date 2026/10/18
+*/
+#pragma once
+#include "Memory.hpp"
+#include "MemoryUtils.hpp"
+#include "SpinLock.hpp"
+#include "Algorithm.hpp"
+
+namespace Luna
+{
+    //! @addtogroup RuntimeMemory
+    //! @{
+
+    //! A linear arena that allocates memory by bumping one cursor in chained memory blocks.
+    //! @details Memory allocated from one arena cannot be freed individually. Instead, all memory allocated from one arena
+    //! is freed at once by calling @ref Arena::reset, which only resets the cursor to the first block and keeps all blocks
+    //! for reuse, so resetting the arena is O(1) and does not touch the heap. This is suitable for temporary allocations
+    //! whose lifetime is bound to one frame or one pass, like temporary collections built every frame.
+    //!
+    //! When the current block is exhausted, the arena moves to the next block in the chain, or allocates one new block from
+    //! @ref memalloc if there is no block that can hold the allocation. Allocations larger than the block size are allocated
+    //! from dedicated blocks.
+    //!
+    //! If the arena is created with `thread_safe` set to `true`, @ref Arena::allocate can be called from multiple threads
+    //! concurrently. Allocations in the same block are served by one atomic compare-and-exchange operation, and moving to
+    //! the next block is protected by one spin lock. @ref Arena::reset and @ref Arena::release are never thread-safe.
+    class Arena
+    {
+    public:
+        //! The default size of one block.
+        static constexpr usize DEFAULT_BLOCK_SIZE = 64_kb;
+
+        //! Constructs one arena.
+        //! @param[in] block_size The size of one block in bytes, including the block header.
+        //! @param[in] thread_safe Whether @ref allocate can be called from multiple threads concurrently.
+        Arena(usize block_size = DEFAULT_BLOCK_SIZE, bool thread_safe = false) :
+            m_block_size(block_size),
+            m_thread_safe(thread_safe) {}
+        Arena(const Arena&) = delete;
+        Arena(Arena&&) = delete;
+        Arena& operator=(const Arena&) = delete;
+        Arena& operator=(Arena&&) = delete;
+        ~Arena()
+        {
+            release();
+        }
+        //! Allocates memory from the arena.
+        //! @param[in] size The size, in bytes, of the memory to allocate.
+        //! @param[in] alignment Optional. The alignment requirement of the memory to allocate. If this is `0`,
+        //! the memory is aligned to @ref MAX_ALIGN.
+        //! @return Returns one pointer to the allocated memory. Returns `nullptr` if `size` is `0` or if
+        //! the memory allocation failed.
+        //! @par Valid Usage
+        //! * If `alignment` is not `0`, `alignment` **must** be powers of 2 (like 32, 64, 128, 256, etc).
+        void* allocate(usize size, usize alignment = 0)
+        {
+            if (!size) return nullptr;
+            if (!alignment) alignment = MAX_ALIGN;
+            if (!m_thread_safe)
+            {
+                usize addr = align_upper(m_cursor, alignment);
+                if (m_current && addr + size <= block_end(m_current))
+                {
+                    m_cursor = addr + size;
+                    return (void*)addr;
+                }
+                return allocate_from_next_block(size, alignment);
+            }
+            while (true)
+            {
+                // Reads the block before the cursor. The cursor is always updated after the block, so if the cursor
+                // does not lie in the block, the block is being changed and we should try again.
+                Block* block = *((Block* volatile*)&m_current);
+                usize cursor = *((volatile usize*)&m_cursor);
+                if (block && cursor >= block_begin(block) && cursor <= block_end(block))
+                {
+                    usize addr = align_upper(cursor, alignment);
+                    if (addr + size <= block_end(block))
+                    {
+                        if (atom_compare_exchange_usize(&m_cursor, addr + size, cursor) == cursor)
+                        {
+                            return (void*)addr;
+                        }
+                        continue;
+                    }
+                }
+                LockGuard guard(m_lock);
+                if (m_current != block) continue;
+                return allocate_from_next_block(size, alignment);
+            }
+        }
+        //! Frees all memory allocated from this arena, and keeps all blocks so that they can be reused.
+        //! @par Valid Usage
+        //! * This must not be called when other threads are allocating memory from this arena.
+        void reset()
+        {
+            m_current = m_first;
+            m_cursor = m_first ? block_begin(m_first) : 0;
+        }
+        //! Frees all memory allocated from this arena, and frees all blocks.
+        //! @par Valid Usage
+        //! * This must not be called when other threads are allocating memory from this arena.
+        void release()
+        {
+            Block* block = m_first;
+            while (block)
+            {
+                Block* next = block->next;
+                memfree(block);
+                block = next;
+            }
+            m_first = nullptr;
+            m_current = nullptr;
+            m_cursor = 0;
+        }
+        //! Gets the total size of all blocks owned by this arena.
+        usize get_capacity() const
+        {
+            usize r = 0;
+            for (Block* block = m_first; block; block = block->next) r += block->size;
+            return r;
+        }
+        //! Gets the number of bytes used in all blocks before the current cursor, including padding and
+        //! unused bytes at the end of exhausted blocks, but not including block headers.
+        usize get_used_size() const
+        {
+            if (!m_current) return 0;
+            usize r = 0;
+            for (Block* block = m_first; block != m_current; block = block->next) r += block_end(block) - block_begin(block);
+            return r + (m_cursor - block_begin(m_current));
+        }
+        //! Checks whether this arena is thread-safe.
+        bool is_thread_safe() const
+        {
+            return m_thread_safe;
+        }
+    private:
+        struct alignas(MAX_ALIGN) Block
+        {
+            Block* next;
+            usize size;
+        };
+        static usize block_begin(Block* block)
+        {
+            return (usize)(block + 1);
+        }
+        static usize block_end(Block* block)
+        {
+            return (usize)block + block->size;
+        }
+        void* allocate_from_next_block(usize size, usize alignment)
+        {
+            // Skips blocks that are too small for this allocation.
+            Block* prev = m_current;
+            Block* block = m_current ? m_current->next : m_first;
+            while (block && align_upper(block_begin(block), alignment) + size > block_end(block))
+            {
+                prev = block;
+                block = block->next;
+            }
+            if (!block)
+            {
+                usize block_size = max(m_block_size, sizeof(Block) + size + (alignment > MAX_ALIGN ? alignment : 0));
+                block = (Block*)memalloc(block_size);
+                if (!block) return nullptr;
+                block->size = block_size;
+                block->next = nullptr;
+                if (prev) prev->next = block;
+                else m_first = block;
+            }
+            usize addr = align_upper(block_begin(block), alignment);
+            // Updates the block first, see comments in `allocate`.
+            *((Block* volatile*)&m_current) = block;
+            *((volatile usize*)&m_cursor) = addr + size;
+            return (void*)addr;
+        }
+
+        Block* m_first = nullptr;
+        Block* m_current = nullptr;
+        usize m_cursor = 0;
+        usize m_block_size;
+        SpinLock m_lock;
+        bool m_thread_safe;
+    };
+
+    //! The allocator that allocates memory from one @ref Arena, which can be used as the `_Alloc` template argument of
+    //! containers defined in Runtime module.
+    //! @details Memory allocated from this allocator is freed when the arena is reset or released, @ref deallocate does
+    //! nothing. The arena must be valid when any container that uses this allocator is alive.
+    //!
+    //! One default-constructed allocator is not bound to any arena, and allocates memory from @ref memalloc and frees memory
+    //! by @ref memfree. Containers create their allocators by default construction when being copy-constructed, so copying
+    //! one container whose allocator is bound to one arena creates one container that allocates from the heap.
+    class ArenaAllocator
+    {
+    public:
+        //! Constructs one allocator that is not bound to any arena.
+        ArenaAllocator() :
+            m_arena(nullptr) {}
+        //! Constructs one allocator that allocates memory from the specified arena.
+        //! @param[in] arena The arena to allocate memory from.
+        ArenaAllocator(Arena& arena) :
+            m_arena(&arena) {}
+        //! Allocates memory for the specified number of elements.
+        //! @param[in] n The number of elements to allocate memory for.
+        //! @return Returns the allocated memory. The returned memory is uninitialized.
+        //! If the allocation fails, returns `nullptr`.
+        template <typename _Ty>
+        _Ty* allocate(usize n = 1)
+        {
+            if (!m_arena) return (_Ty*)memalloc(sizeof(_Ty) * n, alignof(_Ty));
+            return (_Ty*)m_arena->allocate(sizeof(_Ty) * n, alignof(_Ty));
+        }
+        //! Deallocates memory allocated from @ref allocate.
+        //! @details This does nothing if the allocator is bound to one arena.
+        //! @param[in] ptr The memory pointer returned by @ref allocate.
+        //! @param[in] n The number of elements earler passed to @ref allocate.
+        template <typename _Ty>
+        void deallocate(_Ty* ptr, usize n = 1)
+        {
+            if (!m_arena) memfree(ptr, alignof(_Ty));
+        }
+        //! Gets the arena this allocator is bound to.
+        Arena* get_arena() const
+        {
+            return m_arena;
+        }
+        bool operator==(const ArenaAllocator& rhs)
+        {
+            return m_arena == rhs.m_arena;
+        }
+        bool operator!=(const ArenaAllocator& rhs)
+        {
+            return m_arena != rhs.m_arena;
+        }
+    private:
+        Arena* m_arena;
+    };
+
+    //! @}
+}
@@ -140,6 +140,20 @@ namespace Luna
     //! @return Returns the value of the variable before this operation took place.
     template <typename _Ty>
     _Ty* atom_exchange_pointer(_Ty* volatile* target, void* value);
+    //! Atomically reads the value of the variable with acquire semantics.
+    //! @details Memory operations after this operation in the current thread cannot be reordered before this operation, so
+    //! all writes performed by other threads before they release the read value are visible after this operation.
+    //! @param[in] src The pointer to the variable to read.
+    //! @return Returns the value of the variable.
+    template <typename _Ty>
+    _Ty* atom_load_acquire_pointer(_Ty* const volatile* src);
+    //! Atomically replaces the value of the variable with the value provided with release semantics.
+    //! @details Memory operations before this operation in the current thread cannot be reordered after this operation, so
+    //! threads that read the value by @ref atom_load_acquire_pointer can see all writes performed before this operation.
+    //! @param[in] dst The pointer to the variable that needs to be changed.
+    //! @param[in] value The value that needs to be set to the variable.
+    template <typename _Ty>
+    void atom_store_release_pointer(_Ty* volatile* dst, void* value);
     //! Atomically replace the value of the variable with the value provided.
     //! @details This operation cannot be interrupted by system thread switching.
     //! @param[in] dst The pointer to the variable that needs to be changed.
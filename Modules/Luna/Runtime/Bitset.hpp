@@ -0,0 +1,470 @@
+/*!
+* This file is a portion of LunaSDK.
+* For conditions of distribution and use, see the disclaimer
+* and license in LICENSE.txt
+*
+* @file Bitset.hpp
+* @author JXMaster
+* @date 2026/10/18
+*/
+#pragma once
+#include "Vector.hpp"
+
+#if defined(LUNA_PLATFORM_X86_64) || (defined(LUNA_PLATFORM_X86) && (defined(__SSE2__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)))
+#define LUNA_BITSET_SSE2
+#include <emmintrin.h>
+#elif defined(LUNA_PLATFORM_ARM64)
+#define LUNA_BITSET_NEON
+#include <arm_neon.h>
+#endif
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+namespace Luna
+{
+    namespace Impl
+    {
+        inline u32 bitset_popcount(u64 v)
+        {
+#ifdef _MSC_VER
+#ifdef LUNA_PLATFORM_64BIT
+            return (u32)__popcnt64(v);
+#else
+            return (u32)__popcnt((u32)v) + (u32)__popcnt((u32)(v >> 32));
+#endif
+#else
+            return (u32)__builtin_popcountll(v);
+#endif
+        }
+
+        inline u32 bitset_count_trailing_zeros(u64 v)
+        {
+#ifdef _MSC_VER
+#ifdef LUNA_PLATFORM_64BIT
+            unsigned long r;
+            _BitScanForward64(&r, v);
+            return (u32)r;
+#else
+            unsigned long r;
+            if (_BitScanForward(&r, (u32)v)) return (u32)r;
+            _BitScanForward(&r, (u32)(v >> 32));
+            return (u32)r + 32;
+#endif
+#else
+            return (u32)__builtin_ctzll(v);
+#endif
+        }
+
+        enum class BitsetOp : u8
+        {
+            bit_and,
+            bit_or,
+            bit_xor,
+            bit_and_not,
+        };
+
+        template <BitsetOp _Op>
+        inline u64 bitset_op(u64 lhs, u64 rhs)
+        {
+            if constexpr (_Op == BitsetOp::bit_and) return lhs & rhs;
+            else if constexpr (_Op == BitsetOp::bit_or) return lhs | rhs;
+            else if constexpr (_Op == BitsetOp::bit_xor) return lhs ^ rhs;
+            else return lhs & ~rhs;
+        }
+
+#if defined(LUNA_BITSET_SSE2)
+        template <BitsetOp _Op>
+        inline __m128i bitset_op(__m128i lhs, __m128i rhs)
+        {
+            if constexpr (_Op == BitsetOp::bit_and) return _mm_and_si128(lhs, rhs);
+            else if constexpr (_Op == BitsetOp::bit_or) return _mm_or_si128(lhs, rhs);
+            else if constexpr (_Op == BitsetOp::bit_xor) return _mm_xor_si128(lhs, rhs);
+            else return _mm_andnot_si128(rhs, lhs);
+        }
+#elif defined(LUNA_BITSET_NEON)
+        template <BitsetOp _Op>
+        inline uint64x2_t bitset_op(uint64x2_t lhs, uint64x2_t rhs)
+        {
+            if constexpr (_Op == BitsetOp::bit_and) return vandq_u64(lhs, rhs);
+            else if constexpr (_Op == BitsetOp::bit_or) return vorrq_u64(lhs, rhs);
+            else if constexpr (_Op == BitsetOp::bit_xor) return veorq_u64(lhs, rhs);
+            else return vbicq_u64(lhs, rhs);
+        }
+#endif
+
+        //! Computes `dst[i] = dst[i] op src[i]` for `num_words` words, processing 4 words per iteration
+        //! using SIMD instructions when available.
+        template <BitsetOp _Op>
+        inline void bitset_apply(u64* dst, const u64* src, usize num_words)
+        {
+            usize i = 0;
+#if defined(LUNA_BITSET_SSE2)
+            for (; i + 4 <= num_words; i += 4)
+            {
+                __m128i a0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dst + i));
+                __m128i a1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dst + i + 2));
+                __m128i b0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+                __m128i b1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i + 2));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), bitset_op<_Op>(a0, b0));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i + 2), bitset_op<_Op>(a1, b1));
+            }
+#elif defined(LUNA_BITSET_NEON)
+            for (; i + 4 <= num_words; i += 4)
+            {
+                uint64x2_t a0 = vld1q_u64(dst + i);
+                uint64x2_t a1 = vld1q_u64(dst + i + 2);
+                uint64x2_t b0 = vld1q_u64(src + i);
+                uint64x2_t b1 = vld1q_u64(src + i + 2);
+                vst1q_u64(dst + i, bitset_op<_Op>(a0, b0));
+                vst1q_u64(dst + i + 2, bitset_op<_Op>(a1, b1));
+            }
+#endif
+            for (; i < num_words; ++i)
+            {
+                dst[i] = bitset_op<_Op>(dst[i], src[i]);
+            }
+        }
+    }
+
+    //! @addtogroup RuntimeContainer
+    //! @{
+
+    //! A resizable array of bits.
+    //! @details Bits are stored in 64-bit words, so that bitwise operations between bitsets, counting set bits and
+    //! finding set bits process 64 bits per operation. Bitwise operations between two bitsets use SSE2 or NEON
+    //! instructions when available.
+    //!
+    //! Bits beyond @ref size in the last word are always `0`.
+    template <typename _Alloc = Allocator>
+    class Bitset
+    {
+    public:
+        using allocator_type = _Alloc;
+        using word_type = u64;
+        //! The number of bits in one word.
+        static constexpr usize WORD_BITS = 64;
+
+        //! Constructs an empty bitset.
+        Bitset() :
+            m_size(0) {}
+        //! Constructs an empty bitset with an custom allocator.
+        //! @param[in] alloc The allocator to use. The allocator object will be copy-constructed into the bitset.
+        Bitset(const allocator_type& alloc) :
+            m_words(alloc),
+            m_size(0) {}
+        //! Constructs a bitset with the specified number of bits.
+        //! @param[in] size The number of bits.
+        //! @param[in] value The initial value of all bits.
+        //! @param[in] alloc The allocator to use. The allocator object will be copy-constructed into the bitset.
+        Bitset(usize size, bool value = false, const allocator_type& alloc = allocator_type()) :
+            m_words(num_words_for(size), value ? U64_MAX : 0, alloc),
+            m_size(size)
+        {
+            clear_unused_bits();
+        }
+        //! Gets the number of bits in the bitset.
+        //! @return Returns the number of bits in the bitset.
+        usize size() const
+        {
+            return m_size;
+        }
+        //! Checks whether the bitset is empty, that is, the number of bits in the bitset is `0`.
+        //! @return Returns `true` if the bitset is empty, returns `false` otherwise.
+        bool empty() const
+        {
+            return m_size == 0;
+        }
+        //! Gets the number of words used to store the bits.
+        //! @return Returns the number of words used to store the bits.
+        usize num_words() const
+        {
+            return m_words.size();
+        }
+        //! Gets one pointer to the words used to store the bits.
+        //! @return Returns one pointer to the words used to store the bits. Bit `i` is stored in bit `i % 64` of word `i / 64`.
+        word_type* data()
+        {
+            return m_words.data();
+        }
+        //! Gets one pointer to the words used to store the bits.
+        //! @return Returns one pointer to the words used to store the bits. Bit `i` is stored in bit `i % 64` of word `i / 64`.
+        const word_type* data() const
+        {
+            return m_words.data();
+        }
+        //! Reserves storage so that the bitset can hold at least the specified number of bits without expanding its storage.
+        //! @param[in] new_cap The number of bits to reserve.
+        void reserve(usize new_cap)
+        {
+            m_words.reserve(num_words_for(new_cap));
+        }
+        //! Changes the number of bits in the bitset.
+        //! @param[in] new_size The new number of bits.
+        //! @param[in] value The value of new bits if the bitset grows.
+        void resize(usize new_size, bool value = false)
+        {
+            usize old_size = m_size;
+            m_words.resize(num_words_for(new_size), value ? U64_MAX : 0);
+            m_size = new_size;
+            if (value && new_size > old_size && (old_size % WORD_BITS))
+            {
+                // Sets the unused bits of the old last word.
+                m_words[old_size / WORD_BITS] |= U64_MAX << (old_size % WORD_BITS);
+            }
+            clear_unused_bits();
+        }
+        //! Appends one bit to the end of the bitset.
+        //! @param[in] value The value of the bit.
+        void push_back(bool value)
+        {
+            if (m_size % WORD_BITS == 0) m_words.push_back(0);
+            ++m_size;
+            if (value) set(m_size - 1);
+        }
+        //! Removes all bits from the bitset.
+        void clear()
+        {
+            m_words.clear();
+            m_size = 0;
+        }
+        //! Reduces the capacity of the bitset to the number of bits in the bitset.
+        void shrink_to_fit()
+        {
+            m_words.shrink_to_fit();
+        }
+        //! Tests one bit.
+        //! @param[in] index The index of the bit.
+        //! @return Returns `true` if the bit is `1`, returns `false` otherwise.
+        bool test(usize index) const
+        {
+            lucheck(index < m_size);
+            return (m_words[index / WORD_BITS] >> (index % WORD_BITS)) & 1;
+        }
+        //! Tests one bit.
+        //! @param[in] index The index of the bit.
+        //! @return Returns `true` if the bit is `1`, returns `false` otherwise.
+        bool operator[](usize index) const
+        {
+            return test(index);
+        }
+        //! Sets one bit to `1`.
+        //! @param[in] index The index of the bit.
+        void set(usize index)
+        {
+            lucheck(index < m_size);
+            m_words[index / WORD_BITS] |= (u64)1 << (index % WORD_BITS);
+        }
+        //! Sets one bit to the specified value.
+        //! @param[in] index The index of the bit.
+        //! @param[in] value The value to set.
+        void set(usize index, bool value)
+        {
+            if (value) set(index);
+            else reset(index);
+        }
+        //! Sets one bit to `0`.
+        //! @param[in] index The index of the bit.
+        void reset(usize index)
+        {
+            lucheck(index < m_size);
+            m_words[index / WORD_BITS] &= ~((u64)1 << (index % WORD_BITS));
+        }
+        //! Flips one bit.
+        //! @param[in] index The index of the bit.
+        void flip(usize index)
+        {
+            lucheck(index < m_size);
+            m_words[index / WORD_BITS] ^= (u64)1 << (index % WORD_BITS);
+        }
+        //! Sets all bits to `1`.
+        void set_all()
+        {
+            for (u64& w : m_words) w = U64_MAX;
+            clear_unused_bits();
+        }
+        //! Sets all bits to `0`.
+        void reset_all()
+        {
+            for (u64& w : m_words) w = 0;
+        }
+        //! Flips all bits.
+        void flip_all()
+        {
+            for (u64& w : m_words) w = ~w;
+            clear_unused_bits();
+        }
+        //! Counts the number of bits that are `1`.
+        //! @return Returns the number of bits that are `1`.
+        usize count() const
+        {
+            usize r = 0;
+            for (u64 w : m_words) r += Impl::bitset_popcount(w);
+            return r;
+        }
+        //! Checks whether at least one bit is `1`.
+        //! @return Returns `true` if at least one bit is `1`, returns `false` otherwise.
+        bool any() const
+        {
+            for (u64 w : m_words)
+            {
+                if (w) return true;
+            }
+            return false;
+        }
+        //! Checks whether all bits are `0`.
+        //! @return Returns `true` if all bits are `0` or the bitset is empty, returns `false` otherwise.
+        bool none() const
+        {
+            return !any();
+        }
+        //! Checks whether all bits are `1`.
+        //! @return Returns `true` if all bits are `1` or the bitset is empty, returns `false` otherwise.
+        bool all() const
+        {
+            usize num_full_words = m_size / WORD_BITS;
+            for (usize i = 0; i < num_full_words; ++i)
+            {
+                if (m_words[i] != U64_MAX) return false;
+            }
+            usize tail = m_size % WORD_BITS;
+            return !tail || m_words[num_full_words] == (U64_MAX >> (WORD_BITS - tail));
+        }
+        //! Finds the first bit that is `1`.
+        //! @return Returns the index of the first bit that is `1`, or `USIZE_MAX` if all bits are `0`.
+        usize find_first() const
+        {
+            return find_next(0);
+        }
+        //! Finds the first bit that is `1` starting from the specified index.
+        //! @param[in] index The index of the first bit to check. This can be equal to or greater than @ref size,
+        //! in which case `USIZE_MAX` is returned.
+        //! @return Returns the index of the first bit that is `1` and whose index is not less than `index`,
+        //! or `USIZE_MAX` if no such bit is found.
+        usize find_next(usize index) const
+        {
+            if (index >= m_size) return USIZE_MAX;
+            usize word_index = index / WORD_BITS;
+            u64 w = m_words[word_index] & (U64_MAX << (index % WORD_BITS));
+            while (true)
+            {
+                if (w) return word_index * WORD_BITS + Impl::bitset_count_trailing_zeros(w);
+                ++word_index;
+                if (word_index >= m_words.size()) return USIZE_MAX;
+                w = m_words[word_index];
+            }
+        }
+        //! Calls the specified function for every bit that is `1` in index order.
+        //! @param[in] func The function to call. The function is called with the index of the bit as the only argument.
+        template <typename _Func>
+        void for_each_set_bit(_Func&& func) const
+        {
+            for (usize i = 0; i < m_words.size(); ++i)
+            {
+                u64 w = m_words[i];
+                while (w)
+                {
+                    func(i * WORD_BITS + Impl::bitset_count_trailing_zeros(w));
+                    w &= w - 1;
+                }
+            }
+        }
+        //! Sets every bit to the bitwise AND of the bit and the corresponding bit in `rhs`.
+        //! @param[in] rhs The bitset to read bits from. The size of `rhs` must be equal to the size of this bitset.
+        //! @return Returns `*this`.
+        Bitset& operator&=(const Bitset& rhs)
+        {
+            lucheck(m_size == rhs.m_size);
+            Impl::bitset_apply<Impl::BitsetOp::bit_and>(m_words.data(), rhs.m_words.data(), m_words.size());
+            return *this;
+        }
+        //! Sets every bit to the bitwise OR of the bit and the corresponding bit in `rhs`.
+        //! @param[in] rhs The bitset to read bits from. The size of `rhs` must be equal to the size of this bitset.
+        //! @return Returns `*this`.
+        Bitset& operator|=(const Bitset& rhs)
+        {
+            lucheck(m_size == rhs.m_size);
+            Impl::bitset_apply<Impl::BitsetOp::bit_or>(m_words.data(), rhs.m_words.data(), m_words.size());
+            return *this;
+        }
+        //! Sets every bit to the bitwise XOR of the bit and the corresponding bit in `rhs`.
+        //! @param[in] rhs The bitset to read bits from. The size of `rhs` must be equal to the size of this bitset.
+        //! @return Returns `*this`.
+        Bitset& operator^=(const Bitset& rhs)
+        {
+            lucheck(m_size == rhs.m_size);
+            Impl::bitset_apply<Impl::BitsetOp::bit_xor>(m_words.data(), rhs.m_words.data(), m_words.size());
+            return *this;
+        }
+        //! Clears every bit that is `1` in `rhs`, that is, sets every bit to `bit & ~rhs_bit`.
+        //! @param[in] rhs The bitset to read bits from. The size of `rhs` must be equal to the size of this bitset.
+        //! @return Returns `*this`.
+        Bitset& and_not(const Bitset& rhs)
+        {
+            lucheck(m_size == rhs.m_size);
+            Impl::bitset_apply<Impl::BitsetOp::bit_and_not>(m_words.data(), rhs.m_words.data(), m_words.size());
+            return *this;
+        }
+        //! Checks whether this bitset and `rhs` have at least one bit that is `1` in both bitsets.
+        //! @param[in] rhs The bitset to check. The size of `rhs` must be equal to the size of this bitset.
+        //! @return Returns `true` if at least one bit is `1` in both bitsets, returns `false` otherwise.
+        bool intersects(const Bitset& rhs) const
+        {
+            lucheck(m_size == rhs.m_size);
+            for (usize i = 0; i < m_words.size(); ++i)
+            {
+                if (m_words[i] & rhs.m_words[i]) return true;
+            }
+            return false;
+        }
+        //! Checks whether every bit that is `1` in this bitset is also `1` in `rhs`.
+        //! @param[in] rhs The bitset to check. The size of `rhs` must be equal to the size of this bitset.
+        //! @return Returns `true` if every bit that is `1` in this bitset is also `1` in `rhs`, returns `false` otherwise.
+        bool is_subset_of(const Bitset& rhs) const
+        {
+            lucheck(m_size == rhs.m_size);
+            for (usize i = 0; i < m_words.size(); ++i)
+            {
+                if (m_words[i] & ~rhs.m_words[i]) return false;
+            }
+            return true;
+        }
+        //! Compares two bitsets.
+        //! @param[in] rhs The bitset to compare with.
+        //! @return Returns `true` if two bitsets have the same size and the same bits, returns `false` otherwise.
+        bool operator==(const Bitset& rhs) const
+        {
+            if (m_size != rhs.m_size) return false;
+            return m_words.empty() || memcmp(m_words.data(), rhs.m_words.data(), m_words.size() * sizeof(u64)) == 0;
+        }
+        //! Compares two bitsets.
+        //! @param[in] rhs The bitset to compare with.
+        //! @return Returns `true` if two bitsets have different sizes or different bits, returns `false` otherwise.
+        bool operator!=(const Bitset& rhs) const
+        {
+            return !(*this == rhs);
+        }
+        //! Gets the allocator of the bitset.
+        //! @return Returns one copy of the allocator of the bitset.
+        allocator_type get_allocator() const
+        {
+            return m_words.get_allocator();
+        }
+
+    private:
+        Vector<u64, allocator_type> m_words;
+        usize m_size;
+
+        static usize num_words_for(usize num_bits)
+        {
+            return (num_bits + WORD_BITS - 1) / WORD_BITS;
+        }
+        void clear_unused_bits()
+        {
+            usize tail = m_size % WORD_BITS;
+            if (tail) m_words.back() &= U64_MAX >> (WORD_BITS - tail);
+        }
+    };
+
+    //! @}
+}
@@ -0,0 +1,464 @@
+/*!
+* This file is a portion of LunaSDK.
+* For conditions of distribution and use, see the disclaimer
+* and license in LICENSE.txt
+*
+* @file ConcurrentHashMap.hpp
+* @author JXMaster
+* @date 2026/10/18
+*/
+#pragma once
+#include "Atomic.hpp"
+#include "SpinLock.hpp"
+#include "MemoryUtils.hpp"
+#include "Impl/SwissHashTable.hpp"
+
+namespace Luna
+{
+    namespace ConcurrentHashing
+    {
+        //! The number of shards of one concurrent hash map. Must be one power of two.
+        constexpr usize NUM_SHARDS = 16;
+        constexpr usize SHARD_SHIFT = sizeof(usize) * 8 - 4;
+        constexpr usize MIN_BUCKETS = 8;
+
+        template <typename _Vty>
+        struct Node
+        {
+            // The next node in the same bucket. Readers may read this concurrently, so this is only changed before
+            // the node is published.
+            Node* volatile m_next;
+            // The next node in the retired list.
+            Node* m_next_retired;
+            usize m_hash;
+            _Vty m_value;
+
+            template <typename... _Args>
+            Node(usize hash, _Args&&... args) :
+                m_next(nullptr),
+                m_next_retired(nullptr),
+                m_hash(hash),
+                m_value(forward<_Args>(args)...) {}
+        };
+
+        template <typename _Vty>
+        struct Table
+        {
+            Node<_Vty>* volatile* m_buckets;
+            usize m_bucket_count;
+            // The next table in the retired list.
+            Table* m_next_retired;
+        };
+
+        //! Every shard has its own bucket table and write lock. Readers register themselves to one of two reader
+        //! counters selected by the epoch of the shard. Nodes and tables removed from the shard are retired to the
+        //! list of the current epoch, and are freed when the shard advances to the next-next epoch, at which point
+        //! all readers that may observe them have left.
+        template <typename _Vty>
+        struct alignas(64) Shard
+        {
+            SpinLock m_lock;
+            Table<_Vty>* volatile m_table = nullptr;
+            volatile usize m_size = 0;
+            volatile usize m_epoch = 0;
+            Node<_Vty>* m_retired_nodes[2] = { nullptr, nullptr };
+            Table<_Vty>* m_retired_tables[2] = { nullptr, nullptr };
+            // Placed on a separate cache line so that readers do not contend with the write lock.
+            alignas(64) volatile usize m_readers[2] = { 0, 0 };
+        };
+    }
+
+    //! @addtogroup RuntimeContainer
+    //! @{
+
+    //! A hash map with unique keys that can be accessed by multiple threads concurrently.
+    //! @details Elements are distributed to 16 shards by the hash code of the key. Every shard has one chained hash table and
+    //! one spin lock that serializes writes to the shard, so writes to different shards can be performed in parallel.
+    //! Reads do not take any lock: one reader only increments and decrements one reader counter of the shard, and never
+    //! blocks or is blocked by writers.
+    //!
+    //! Elements are never modified after they are inserted into the map, @ref insert_or_assign replaces the old element
+    //! with a new one. Elements removed from the map and tables replaced when the map grows are not freed immediately, but
+    //! retired and freed by later writes to the same shard when no reader can still observe them, or when the map is
+    //! destroyed.
+    //!
+    //! Since elements may be removed at any time, this map does not provide iterators or references to elements. Use
+    //! @ref find to copy out the value, or @ref visit and @ref for_each to access elements in-place.
+    //! @remark This map is designed for read-mostly registries. Both the key type and the mapped type must be copy-constructible,
+    //! since elements are copied when the table of one shard grows.
+    template <
+        typename _Kty,
+        typename _Ty,
+        typename _Hash = hash<_Kty>,
+        typename _KeyEqual = equal_to<_Kty>,
+        typename _Alloc = Allocator>
+    class ConcurrentHashMap
+    {
+    public:
+        using key_type = _Kty;
+        using mapped_type = _Ty;
+        using value_type = Pair<const _Kty, _Ty>;
+        using allocator_type = _Alloc;
+        using hasher = _Hash;
+        using key_equal = _KeyEqual;
+
+    private:
+        using node_type = ConcurrentHashing::Node<value_type>;
+        using table_type = ConcurrentHashing::Table<value_type>;
+        using shard_type = ConcurrentHashing::Shard<value_type>;
+
+        mutable shard_type m_shards[ConcurrentHashing::NUM_SHARDS];
+        allocator_type m_allocator;
+
+        static usize get_hash(const key_type& key)
+        {
+            return SwissHashing::mix_hash(hasher()(key));
+        }
+        shard_type& get_shard(usize hash) const
+        {
+            return m_shards[(hash >> ConcurrentHashing::SHARD_SHIFT) & (ConcurrentHashing::NUM_SHARDS - 1)];
+        }
+        static usize enter_read(shard_type& shard)
+        {
+            while (true)
+            {
+                usize epoch = shard.m_epoch;
+                atom_inc_usize(&shard.m_readers[epoch & 1]);
+                // The reader must be registered to the counter of the current epoch, otherwise the writer
+                // may have checked the counter before the reader is registered.
+                if (shard.m_epoch == epoch) return epoch & 1;
+                atom_dec_usize(&shard.m_readers[epoch & 1]);
+            }
+        }
+        static void leave_read(shard_type& shard, usize slot)
+        {
+            atom_dec_usize(&shard.m_readers[slot]);
+        }
+        static node_type* find_node(table_type* table, usize hash, const key_type& key)
+        {
+            if (!table) return nullptr;
+            node_type* node = table->m_buckets[hash & (table->m_bucket_count - 1)];
+            while (node)
+            {
+                if (node->m_hash == hash && key_equal()(node->m_value.first, key)) return node;
+                node = node->m_next;
+            }
+            return nullptr;
+        }
+        // Gets the link that points to the node with the specified key, or the link at the end of the bucket.
+        static node_type* volatile* find_link(table_type* table, usize hash, const key_type& key)
+        {
+            node_type* volatile* link = &(table->m_buckets[hash & (table->m_bucket_count - 1)]);
+            while (*link)
+            {
+                node_type* node = *link;
+                if (node->m_hash == hash && key_equal()(node->m_value.first, key)) break;
+                link = &(node->m_next);
+            }
+            return link;
+        }
+        template <typename... _Args>
+        node_type* new_node(usize hash, _Args&&... args)
+        {
+            node_type* node = m_allocator.template allocate<node_type>();
+            new (node) node_type(hash, forward<_Args>(args)...);
+            return node;
+        }
+        void delete_node(node_type* node)
+        {
+            node->~node_type();
+            m_allocator.template deallocate<node_type>(node);
+        }
+        table_type* new_table(usize bucket_count)
+        {
+            table_type* table = m_allocator.template allocate<table_type>();
+            table->m_buckets = m_allocator.template allocate<node_type*>(bucket_count);
+            memzero((void*)table->m_buckets, sizeof(node_type*) * bucket_count);
+            table->m_bucket_count = bucket_count;
+            table->m_next_retired = nullptr;
+            return table;
+        }
+        // Deletes the table and all nodes in the table.
+        void delete_table(table_type* table)
+        {
+            for (usize i = 0; i < table->m_bucket_count; ++i)
+            {
+                node_type* node = table->m_buckets[i];
+                while (node)
+                {
+                    node_type* next = node->m_next;
+                    delete_node(node);
+                    node = next;
+                }
+            }
+            m_allocator.template deallocate<node_type*>((node_type**)table->m_buckets, table->m_bucket_count);
+            m_allocator.template deallocate<table_type>(table);
+        }
+        void free_retired(shard_type& shard, usize slot)
+        {
+            node_type* node = shard.m_retired_nodes[slot];
+            while (node)
+            {
+                node_type* next = node->m_next_retired;
+                delete_node(node);
+                node = next;
+            }
+            shard.m_retired_nodes[slot] = nullptr;
+            table_type* table = shard.m_retired_tables[slot];
+            while (table)
+            {
+                table_type* next = table->m_next_retired;
+                delete_table(table);
+                table = next;
+            }
+            shard.m_retired_tables[slot] = nullptr;
+        }
+        // The following functions must be called with the shard lock held.
+        static void retire_node(shard_type& shard, node_type* node)
+        {
+            usize slot = shard.m_epoch & 1;
+            node->m_next_retired = shard.m_retired_nodes[slot];
+            shard.m_retired_nodes[slot] = node;
+        }
+        static void retire_table(shard_type& shard, table_type* table)
+        {
+            usize slot = shard.m_epoch & 1;
+            table->m_next_retired = shard.m_retired_tables[slot];
+            shard.m_retired_tables[slot] = table;
+        }
+        void try_reclaim(shard_type& shard)
+        {
+            usize epoch = shard.m_epoch;
+            usize prev_slot = (epoch + 1) & 1;
+            if (!shard.m_retired_nodes[0] && !shard.m_retired_nodes[1] &&
+                !shard.m_retired_tables[0] && !shard.m_retired_tables[1]) return;
+            // Readers of the previous epoch may still observe objects retired in the previous epoch.
+            if (shard.m_readers[prev_slot]) return;
+            // Objects retired two epochs ago were removed before any reader of the current epoch is registered.
+            free_retired(shard, prev_slot);
+            atom_exchange_usize(&shard.m_epoch, epoch + 1);
+        }
+        table_type* reserve_for_insert(shard_type& shard)
+        {
+            table_type* table = shard.m_table;
+            if (table && shard.m_size < table->m_bucket_count) return table;
+            usize bucket_count = table ? table->m_bucket_count * 2 : ConcurrentHashing::MIN_BUCKETS;
+            table_type* new_tab = new_table(bucket_count);
+            if (table)
+            {
+                // Nodes are copied rather than moved, since readers may still traverse the old table.
+                for (usize i = 0; i < table->m_bucket_count; ++i)
+                {
+                    for (node_type* node = table->m_buckets[i]; node; node = node->m_next)
+                    {
+                        node_type* new_nd = new_node(node->m_hash, node->m_value);
+                        node_type* volatile* bucket = &(new_tab->m_buckets[node->m_hash & (bucket_count - 1)]);
+                        new_nd->m_next = *bucket;
+                        *bucket = new_nd;
+                    }
+                }
+            }
+            atom_exchange_pointer(&shard.m_table, new_tab);
+            if (table) retire_table(shard, table);
+            return new_tab;
+        }
+        template <typename _Vty>
+        bool internal_insert(const key_type& key, _Vty&& value, bool assign)
+        {
+            usize hash = get_hash(key);
+            shard_type& shard = get_shard(hash);
+            LockGuard guard(shard.m_lock);
+            table_type* table = shard.m_table;
+            if (table)
+            {
+                node_type* volatile* link = find_link(table, hash, key);
+                node_type* old = *link;
+                if (old)
+                {
+                    if (!assign) return false;
+                    node_type* node = new_node(hash, key, forward<_Vty>(value));
+                    node->m_next = old->m_next;
+                    atom_exchange_pointer(link, node);
+                    retire_node(shard, old);
+                    try_reclaim(shard);
+                    return false;
+                }
+            }
+            table = reserve_for_insert(shard);
+            node_type* node = new_node(hash, key, forward<_Vty>(value));
+            node_type* volatile* bucket = &(table->m_buckets[hash & (table->m_bucket_count - 1)]);
+            node->m_next = *bucket;
+            atom_exchange_pointer(bucket, node);
+            shard.m_size = shard.m_size + 1;
+            try_reclaim(shard);
+            return true;
+        }
+    public:
+        //! Constructs an empty map.
+        ConcurrentHashMap() :
+            m_allocator() {}
+        //! Constructs an empty map with an custom allocator.
+        //! @param[in] alloc The allocator to use. The allocator object will be copy-constructed into the map.
+        ConcurrentHashMap(const allocator_type& alloc) :
+            m_allocator(alloc) {}
+        ConcurrentHashMap(const ConcurrentHashMap&) = delete;
+        ConcurrentHashMap(ConcurrentHashMap&&) = delete;
+        ConcurrentHashMap& operator=(const ConcurrentHashMap&) = delete;
+        ConcurrentHashMap& operator=(ConcurrentHashMap&&) = delete;
+        //! Destructs the map and all elements in the map.
+        //! @details The map must not be accessed by other threads when it is being destructed.
+        ~ConcurrentHashMap()
+        {
+            for (shard_type& shard : m_shards)
+            {
+                lucheck_msg(!shard.m_readers[0] && !shard.m_readers[1], "ConcurrentHashMap is destructed while being read.");
+                free_retired(shard, 0);
+                free_retired(shard, 1);
+                if (shard.m_table) delete_table(shard.m_table);
+            }
+        }
+        //! Gets the number of elements in the map.
+        //! @details The returned value is a snapshot and may be outdated if the map is modified concurrently.
+        //! @return Returns the number of elements in the map.
+        usize size() const
+        {
+            usize r = 0;
+            for (shard_type& shard : m_shards) r += shard.m_size;
+            return r;
+        }
+        //! Checks whether the map is empty.
+        //! @return Returns `true` if the map is empty, returns `false` otherwise.
+        bool empty() const
+        {
+            return size() == 0;
+        }
+        //! Checks whether one element with the specified key exists in the map.
+        //! @param[in] key The key of the element to check.
+        //! @return Returns `true` if the element exists, returns `false` otherwise.
+        bool contains(const key_type& key) const
+        {
+            return visit(key, [](const mapped_type&) {});
+        }
+        //! Finds the element with the specified key and copies the value of the element.
+        //! @param[in] key The key of the element to find.
+        //! @param[out] out_value If the element is found, returns the copied value of the element.
+        //! @return Returns `true` if the element is found, returns `false` otherwise.
+        bool find(const key_type& key, mapped_type& out_value) const
+        {
+            return visit(key, [&out_value](const mapped_type& value) { out_value = value; });
+        }
+        //! Finds the element with the specified key and calls the specified function on the value of the element.
+        //! @details The element is valid during the call even if it is removed from the map by other threads concurrently.
+        //! The function should return quickly, since retired elements of the shard cannot be freed until the function returns.
+        //! @param[in] key The key of the element to find.
+        //! @param[in] func The function to call. The function is called with one `const mapped_type&` argument.
+        //! @return Returns `true` if the element is found and the function is called, returns `false` otherwise.
+        template <typename _Func>
+        bool visit(const key_type& key, _Func&& func) const
+        {
+            usize hash = get_hash(key);
+            shard_type& shard = get_shard(hash);
+            usize slot = enter_read(shard);
+            node_type* node = find_node(shard.m_table, hash, key);
+            if (node) func((const mapped_type&)node->m_value.second);
+            leave_read(shard, slot);
+            return node != nullptr;
+        }
+        //! Calls the specified function on every element in the map.
+        //! @details Elements inserted or removed concurrently may or may not be visited.
+        //! @param[in] func The function to call. The function is called with one `const key_type&` argument and
+        //! one `const mapped_type&` argument.
+        template <typename _Func>
+        void for_each(_Func&& func) const
+        {
+            for (shard_type& shard : m_shards)
+            {
+                usize slot = enter_read(shard);
+                table_type* table = shard.m_table;
+                if (table)
+                {
+                    for (usize i = 0; i < table->m_bucket_count; ++i)
+                    {
+                        for (node_type* node = table->m_buckets[i]; node; node = node->m_next)
+                        {
+                            func((const key_type&)node->m_value.first, (const mapped_type&)node->m_value.second);
+                        }
+                    }
+                }
+                leave_read(shard, slot);
+            }
+        }
+        //! Inserts one element into the map if no element with the same key exists.
+        //! @param[in] key The key of the element to insert.
+        //! @param[in] value The value of the element to insert.
+        //! @return Returns `true` if the element is inserted, returns `false` if one element with the same key already exists.
+        bool insert(const key_type& key, const mapped_type& value)
+        {
+            return internal_insert(key, value, false);
+        }
+        //! Inserts one element into the map if no element with the same key exists.
+        //! @param[in] key The key of the element to insert.
+        //! @param[in] value The value of the element to insert.
+        //! @return Returns `true` if the element is inserted, returns `false` if one element with the same key already exists.
+        bool insert(const key_type& key, mapped_type&& value)
+        {
+            return internal_insert(key, move(value), false);
+        }
+        //! Inserts one element into the map, or replaces the element with the same key.
+        //! @param[in] key The key of the element to insert.
+        //! @param[in] value The value of the element to insert.
+        //! @return Returns `true` if the element is inserted, returns `false` if one existing element is replaced.
+        bool insert_or_assign(const key_type& key, const mapped_type& value)
+        {
+            return internal_insert(key, value, true);
+        }
+        //! Inserts one element into the map, or replaces the element with the same key.
+        //! @param[in] key The key of the element to insert.
+        //! @param[in] value The value of the element to insert.
+        //! @return Returns `true` if the element is inserted, returns `false` if one existing element is replaced.
+        bool insert_or_assign(const key_type& key, mapped_type&& value)
+        {
+            return internal_insert(key, move(value), true);
+        }
+        //! Removes the element with the specified key from the map.
+        //! @param[in] key The key of the element to remove.
+        //! @return Returns `true` if the element is removed, returns `false` if the element is not found.
+        bool erase(const key_type& key)
+        {
+            usize hash = get_hash(key);
+            shard_type& shard = get_shard(hash);
+            LockGuard guard(shard.m_lock);
+            table_type* table = shard.m_table;
+            if (!table) return false;
+            node_type* volatile* link = find_link(table, hash, key);
+            node_type* node = *link;
+            if (!node) return false;
+            atom_exchange_pointer(link, node->m_next);
+            retire_node(shard, node);
+            shard.m_size = shard.m_size - 1;
+            try_reclaim(shard);
+            return true;
+        }
+        //! Removes all elements from the map.
+        //! @details If no other thread is reading the map, all memory allocated by the map is freed when this function returns.
+        void clear()
+        {
+            for (shard_type& shard : m_shards)
+            {
+                LockGuard guard(shard.m_lock);
+                table_type* table = shard.m_table;
+                if (table)
+                {
+                    atom_exchange_pointer(&shard.m_table, nullptr);
+                    retire_table(shard, table);
+                    shard.m_size = 0;
+                }
+                // Advances two epochs so that objects retired in both epochs are freed.
+                try_reclaim(shard);
+                try_reclaim(shard);
+            }
+        }
+    };
+
+    //! @}
+}
@@ -0,0 +1,395 @@
+/*!
+* This file is a portion of LunaSDK.
+* For conditions of distribution and use, see the disclaimer
+* and license in LICENSE.txt
+*
+* @file ConcurrentQueue.hpp
+* @author JXMaster
+* @date 2026/10/18
+*/
+#pragma once
+#include "Base.hpp"
+#include "Atomic.hpp"
+#include "Thread.hpp"
+#include "Allocator.hpp"
+#include "MemoryUtils.hpp"
+
+#if defined(LUNA_PLATFORM_X86) || defined(LUNA_PLATFORM_X86_64)
+#include <emmintrin.h>
+#endif
+
+#if defined(LUNA_PLATFORM_ARM64) || defined(LUNA_PLATFORM_ARM32)
+#include <arm_acle.h>
+#endif
+
+namespace Luna
+{
+    namespace Impl
+    {
+        //! The cache line size used to separate indices that are written by different threads.
+        constexpr usize QUEUE_CACHE_LINE_SIZE = 64;
+
+        //! Waits for a short time before retrying one blocking queue operation.
+        //! Spins for the first several retries, then yields the time slice of the current thread.
+        inline void queue_backoff(u32& retries)
+        {
+            if (retries < 16)
+            {
+#if defined(LUNA_PLATFORM_X86) || defined(LUNA_PLATFORM_X86_64)
+                _mm_pause();
+#elif defined(LUNA_PLATFORM_ARM64) || defined(LUNA_PLATFORM_ARM32)
+                __yield();
+#endif
+                ++retries;
+            }
+            else
+            {
+                yield_current_thread();
+            }
+        }
+
+        inline usize queue_capacity(usize capacity)
+        {
+            usize r = 2;
+            while (r < capacity) r <<= 1;
+            return r;
+        }
+    }
+
+    //! @addtogroup RuntimeContainer
+    //! @{
+
+    //! A bounded first-in-first-out queue that can be used by one producer thread and one consumer thread concurrently
+    //! without locks.
+    //! @details Elements are stored in one ring buffer whose capacity is fixed when the queue is created. The write position
+    //! is only written by the producer, and the read position is only written by the consumer. Both positions are stored in
+    //! separated cache lines, and every side caches the last position of the other side it has read, so that the cache line
+    //! of the other side is only accessed when the cached position indicates that the queue is full or empty.
+    //! @remark At any time, at most one thread can push elements to the queue and at most one thread can pop elements from the queue.
+    //! Use @ref MPMCQueue if multiple producers or consumers are required.
+    template <typename _Ty, typename _Alloc = Allocator>
+    class SPSCQueue
+    {
+    public:
+        using value_type = _Ty;
+        using allocator_type = _Alloc;
+
+    private:
+        // Data that is only read after the queue is created.
+        value_type* m_buffer;
+        usize m_mask;
+        allocator_type m_allocator;
+        // Data that is written by the producer.
+        alignas(Impl::QUEUE_CACHE_LINE_SIZE) volatile usize m_write_pos;
+        usize m_cached_read_pos;
+        // Data that is written by the consumer.
+        alignas(Impl::QUEUE_CACHE_LINE_SIZE) volatile usize m_read_pos;
+        usize m_cached_write_pos;
+
+    public:
+        //! Constructs one queue.
+        //! @param[in] capacity The maximum number of elements that can be stored in the queue. The capacity is rounded up to the next
+        //! power of two.
+        //! @param[in] alloc The allocator to use. The allocator object will be copy-constructed into the queue.
+        SPSCQueue(usize capacity, const allocator_type& alloc = allocator_type()) :
+            m_mask(Impl::queue_capacity(capacity) - 1),
+            m_allocator(alloc),
+            m_write_pos(0),
+            m_cached_read_pos(0),
+            m_read_pos(0),
+            m_cached_write_pos(0)
+        {
+            m_buffer = m_allocator.template allocate<value_type>(m_mask + 1);
+        }
+        SPSCQueue(const SPSCQueue&) = delete;
+        SPSCQueue(SPSCQueue&&) = delete;
+        SPSCQueue& operator=(const SPSCQueue&) = delete;
+        SPSCQueue& operator=(SPSCQueue&&) = delete;
+        //! Destructs the queue and all elements in the queue.
+        ~SPSCQueue()
+        {
+            for (usize i = m_read_pos; i != m_write_pos; ++i)
+            {
+                m_buffer[i & m_mask].~value_type();
+            }
+            m_allocator.template deallocate<value_type>(m_buffer, m_mask + 1);
+        }
+        //! Gets the maximum number of elements that can be stored in the queue.
+        usize capacity() const
+        {
+            return m_mask + 1;
+        }
+        //! Gets the number of elements in the queue.
+        //! @details The returned value is a snapshot and may be outdated if the queue is modified concurrently.
+        usize size() const
+        {
+            usize read_pos = m_read_pos;
+            return m_write_pos - read_pos;
+        }
+        //! Checks whether the queue is empty.
+        //! @details The returned value is a snapshot and may be outdated if the queue is modified concurrently.
+        bool empty() const
+        {
+            return size() == 0;
+        }
+        //! Constructs one element at the end of the queue if the queue is not full. Can only be called by the producer thread.
+        //! @param[in] args The arguments to construct the element.
+        //! @return Returns `true` if the element is pushed, returns `false` if the queue is full.
+        template <typename... _Args>
+        bool try_emplace(_Args&&... args)
+        {
+            usize pos = m_write_pos;
+            if (pos - m_cached_read_pos > m_mask)
+            {
+                // Reads the position with one full barrier, so that slots released by the consumer can be reused.
+                m_cached_read_pos = atom_add_usize(&m_read_pos, 0);
+                if (pos - m_cached_read_pos > m_mask) return false;
+            }
+            new (m_buffer + (pos & m_mask)) value_type(forward<_Args>(args)...);
+            // Publishes the element with one full barrier.
+            atom_exchange_usize(&m_write_pos, pos + 1);
+            return true;
+        }
+        //! Pushes one element to the end of the queue if the queue is not full. Can only be called by the producer thread.
+        //! @param[in] value The element to push.
+        //! @return Returns `true` if the element is pushed, returns `false` if the queue is full.
+        bool try_push(const value_type& value)
+        {
+            return try_emplace(value);
+        }
+        //! Pushes one element to the end of the queue if the queue is not full. Can only be called by the producer thread.
+        //! @param[in] value The element to push.
+        //! @return Returns `true` if the element is pushed, returns `false` if the queue is full.
+        bool try_push(value_type&& value)
+        {
+            return try_emplace(move(value));
+        }
+        //! Pushes one element to the end of the queue, waits until the queue is not full if the queue is full.
+        //! Can only be called by the producer thread.
+        //! @param[in] value The element to push.
+        void push(const value_type& value)
+        {
+            u32 retries = 0;
+            while (!try_emplace(value)) Impl::queue_backoff(retries);
+        }
+        //! Pushes one element to the end of the queue, waits until the queue is not full if the queue is full.
+        //! Can only be called by the producer thread.
+        //! @param[in] value The element to push.
+        void push(value_type&& value)
+        {
+            u32 retries = 0;
+            while (!try_emplace(move(value))) Impl::queue_backoff(retries);
+        }
+        //! Pops one element from the front of the queue if the queue is not empty. Can only be called by the consumer thread.
+        //! @param[out] out_value The object to receive the popped element. The element is move-assigned to this object.
+        //! @return Returns `true` if one element is popped, returns `false` if the queue is empty.
+        bool try_pop(value_type& out_value)
+        {
+            usize pos = m_read_pos;
+            if (pos == m_cached_write_pos)
+            {
+                // Reads the position with one full barrier, so that all elements before the position are visible.
+                m_cached_write_pos = atom_add_usize(&m_write_pos, 0);
+                if (pos == m_cached_write_pos) return false;
+            }
+            value_type* elem = m_buffer + (pos & m_mask);
+            out_value = move(*elem);
+            elem->~value_type();
+            // Releases the slot with one full barrier.
+            atom_exchange_usize(&m_read_pos, pos + 1);
+            return true;
+        }
+        //! Pops one element from the front of the queue, waits until the queue is not empty if the queue is empty.
+        //! Can only be called by the consumer thread.
+        //! @param[out] out_value The object to receive the popped element. The element is move-assigned to this object.
+        void pop(value_type& out_value)
+        {
+            u32 retries = 0;
+            while (!try_pop(out_value)) Impl::queue_backoff(retries);
+        }
+    };
+
+    //! A bounded first-in-first-out queue that can be used by multiple producer threads and multiple consumer threads concurrently
+    //! without locks.
+    //! @details Elements are stored in one ring buffer whose capacity is fixed when the queue is created. Every slot of the buffer
+    //! has one sequence number that tells whether the slot is ready to be written by the producer or read by the consumer of one
+    //! specific round, so producers and consumers only contend on the enqueue position and the dequeue position respectively,
+    //! and never block each other. The enqueue position and the dequeue position are stored in separated cache lines.
+    //! @remark Elements pushed by one producer are popped in the same order they are pushed. Elements pushed by different
+    //! producers are popped in the order they acquire slots of the buffer.
+    template <typename _Ty, typename _Alloc = Allocator>
+    class MPMCQueue
+    {
+    public:
+        using value_type = _Ty;
+        using allocator_type = _Alloc;
+
+    private:
+        struct Slot
+        {
+            volatile usize m_sequence;
+            Unconstructed<value_type> m_value;
+        };
+        // Data that is only read after the queue is created.
+        Slot* m_buffer;
+        usize m_mask;
+        allocator_type m_allocator;
+        alignas(Impl::QUEUE_CACHE_LINE_SIZE) volatile usize m_enqueue_pos;
+        alignas(Impl::QUEUE_CACHE_LINE_SIZE) volatile usize m_dequeue_pos;
+
+    public:
+        //! Constructs one queue.
+        //! @param[in] capacity The maximum number of elements that can be stored in the queue. The capacity is rounded up to the next
+        //! power of two.
+        //! @param[in] alloc The allocator to use. The allocator object will be copy-constructed into the queue.
+        MPMCQueue(usize capacity, const allocator_type& alloc = allocator_type()) :
+            m_mask(Impl::queue_capacity(capacity) - 1),
+            m_allocator(alloc),
+            m_enqueue_pos(0),
+            m_dequeue_pos(0)
+        {
+            m_buffer = m_allocator.template allocate<Slot>(m_mask + 1);
+            for (usize i = 0; i <= m_mask; ++i)
+            {
+                m_buffer[i].m_sequence = i;
+            }
+        }
+        MPMCQueue(const MPMCQueue&) = delete;
+        MPMCQueue(MPMCQueue&&) = delete;
+        MPMCQueue& operator=(const MPMCQueue&) = delete;
+        MPMCQueue& operator=(MPMCQueue&&) = delete;
+        //! Destructs the queue and all elements in the queue.
+        ~MPMCQueue()
+        {
+            for (usize i = m_dequeue_pos; i != m_enqueue_pos; ++i)
+            {
+                m_buffer[i & m_mask].m_value.destruct();
+            }
+            m_allocator.template deallocate<Slot>(m_buffer, m_mask + 1);
+        }
+        //! Gets the maximum number of elements that can be stored in the queue.
+        usize capacity() const
+        {
+            return m_mask + 1;
+        }
+        //! Gets the number of elements in the queue.
+        //! @details The returned value is a snapshot and may be outdated if the queue is modified concurrently.
+        usize size() const
+        {
+            usize dequeue_pos = m_dequeue_pos;
+            usize enqueue_pos = m_enqueue_pos;
+            return enqueue_pos > dequeue_pos ? enqueue_pos - dequeue_pos : 0;
+        }
+        //! Checks whether the queue is empty.
+        //! @details The returned value is a snapshot and may be outdated if the queue is modified concurrently.
+        bool empty() const
+        {
+            return size() == 0;
+        }
+        //! Constructs one element at the end of the queue if the queue is not full.
+        //! @param[in] args The arguments to construct the element.
+        //! @return Returns `true` if the element is pushed, returns `false` if the queue is full.
+        template <typename... _Args>
+        bool try_emplace(_Args&&... args)
+        {
+            usize pos = m_enqueue_pos;
+            Slot* slot;
+            while (true)
+            {
+                slot = m_buffer + (pos & m_mask);
+                isize diff = (isize)slot->m_sequence - (isize)pos;
+                if (diff == 0)
+                {
+                    // The slot is free in this round, tries to acquire it.
+                    usize prev = atom_compare_exchange_usize(&m_enqueue_pos, pos + 1, pos);
+                    if (prev == pos) break;
+                    pos = prev;
+                }
+                else if (diff < 0)
+                {
+                    // The slot is still occupied by the element of the last round.
+                    return false;
+                }
+                else
+                {
+                    pos = m_enqueue_pos;
+                }
+            }
+            slot->m_value.construct(forward<_Args>(args)...);
+            // Publishes the element with one full barrier.
+            atom_exchange_usize(&slot->m_sequence, pos + 1);
+            return true;
+        }
+        //! Pushes one element to the end of the queue if the queue is not full.
+        //! @param[in] value The element to push.
+        //! @return Returns `true` if the element is pushed, returns `false` if the queue is full.
+        bool try_push(const value_type& value)
+        {
+            return try_emplace(value);
+        }
+        //! Pushes one element to the end of the queue if the queue is not full.
+        //! @param[in] value The element to push.
+        //! @return Returns `true` if the element is pushed, returns `false` if the queue is full.
+        bool try_push(value_type&& value)
+        {
+            return try_emplace(move(value));
+        }
+        //! Pushes one element to the end of the queue, waits until the queue is not full if the queue is full.
+        //! @param[in] value The element to push.
+        void push(const value_type& value)
+        {
+            u32 retries = 0;
+            while (!try_emplace(value)) Impl::queue_backoff(retries);
+        }
+        //! Pushes one element to the end of the queue, waits until the queue is not full if the queue is full.
+        //! @param[in] value The element to push.
+        void push(value_type&& value)
+        {
+            u32 retries = 0;
+            while (!try_emplace(move(value))) Impl::queue_backoff(retries);
+        }
+        //! Pops one element from the front of the queue if the queue is not empty.
+        //! @param[out] out_value The object to receive the popped element. The element is move-assigned to this object.
+        //! @return Returns `true` if one element is popped, returns `false` if the queue is empty.
+        bool try_pop(value_type& out_value)
+        {
+            usize pos = m_dequeue_pos;
+            Slot* slot;
+            while (true)
+            {
+                slot = m_buffer + (pos & m_mask);
+                isize diff = (isize)slot->m_sequence - (isize)(pos + 1);
+                if (diff == 0)
+                {
+                    // The element of this round is published, tries to acquire it.
+                    usize prev = atom_compare_exchange_usize(&m_dequeue_pos, pos + 1, pos);
+                    if (prev == pos) break;
+                    pos = prev;
+                }
+                else if (diff < 0)
+                {
+                    // The element of this round is not published yet.
+                    return false;
+                }
+                else
+                {
+                    pos = m_dequeue_pos;
+                }
+            }
+            out_value = move(slot->m_value.get());
+            slot->m_value.destruct();
+            // Releases the slot for the next round with one full barrier.
+            atom_exchange_usize(&slot->m_sequence, pos + m_mask + 1);
+            return true;
+        }
+        //! Pops one element from the front of the queue, waits until the queue is not empty if the queue is empty.
+        //! @param[out] out_value The object to receive the popped element. The element is move-assigned to this object.
+        void pop(value_type& out_value)
+        {
+            u32 retries = 0;
+            while (!try_pop(out_value)) Impl::queue_backoff(retries);
+        }
+    };
+
+    //! @}
+}
@@ -0,0 +1,369 @@
+/*!
+* This file is a portion of LunaSDK.
+* For conditions of distribution and use, see the disclaimer
+* and license in LICENSE.txt
+*
+* @file FlatMap.hpp
+* @author JXMaster
+* @date 2026/10/18
+*/
+#pragma once
+#include "Impl/SortedVectorTable.hpp"
+
+namespace Luna
+{
+    //! @addtogroup RuntimeContainer
+    //! @{
+
+    //! An container that contains key-value pairs with unique keys stored in one sorted contiguous array.
+    //! @details Elements are stored in one @ref Vector sorted by keys, and lookups are performed by binary searches
+    //! whose loop bodies compile to conditional moves rather than branches. Compared to hash maps, this map has no
+    //! per-element memory overhead, iterates elements in key order, and accesses only O(log n) elements that are close
+    //! in memory for every lookup, which makes it a good fit for small and read-mostly maps.
+    //!
+    //! Inserting or erasing one element moves all elements after it, so the time complexity of single-element insertions
+    //! and erasures is O(n). Use the range version of @ref insert or the range constructor to insert many elements at once,
+    //! which sorts elements only once.
+    //! @remark Like hash maps, keys are exposed as `const` through iterators, so that the order of elements cannot be broken
+    //! by modifying keys.
+    //!
+    //! Iterators and references to elements are invalidated by every insertion and erasure.
+    template <
+        typename _Kty,
+        typename _Ty,
+        typename _Compare = less<_Kty>,        // Used to order keys.
+        typename _Alloc = Allocator>
+    class FlatMap
+    {
+    public:
+        using key_type = _Kty;
+        using mapped_type = _Ty;
+        using value_type = Pair<const _Kty, _Ty>;
+        using allocator_type = _Alloc;
+        using key_compare = _Compare;
+        using reference = value_type&;
+        using const_reference = const value_type&;
+        using pointer = value_type*;
+        using const_pointer = const value_type*;
+        using iterator = SortedVector::MapIterator<_Kty, _Ty, false>;
+        using const_iterator = SortedVector::MapIterator<_Kty, _Ty, true>;
+
+    private:
+
+        // Elements are stored with non-const keys, so that they can be moved when the array is modified.
+        using storage_type = Pair<_Kty, _Ty>;
+        using table_type = SortedVector::Table<key_type, storage_type, Impl::MapExtractKey<key_type, storage_type>, key_compare, allocator_type>;
+
+        table_type m_base;
+
+        static Pair<iterator, bool> to_result(const Pair<typename table_type::iterator, bool>& r)
+        {
+            return make_pair(iterator(r.first), r.second);
+        }
+
+    public:
+        //! Constructs an empty map.
+        FlatMap() :
+            m_base() {}
+        //! Constructs an empty map with an custom allocator.
+        //! @param[in] alloc The allocator to use. The allocator object will be copy-constructed into the map.
+        FlatMap(const allocator_type& alloc) :
+            m_base(alloc) {}
+        //! Constructs a map with elements in the specified range.
+        //! @details Elements in the range do not need to be sorted. If multiple elements in the range have the same key, only
+        //! the first one is inserted.
+        //! @param[in] first The iterator to the first element to insert.
+        //! @param[in] last The iterator to the one-past-last element to insert.
+        //! @param[in] alloc The allocator to use. The allocator object will be copy-constructed into the map.
+        template <typename _InputIt>
+        FlatMap(_InputIt first, _InputIt last, const allocator_type& alloc = allocator_type()) :
+            m_base(alloc)
+        {
+            m_base.insert(first, last);
+        }
+        //! Constructs a map with elements in the specified initializer list.
+        //! @details Elements in the list do not need to be sorted. If multiple elements in the list have the same key, only
+        //! the first one is inserted.
+        //! @param[in] ilist The initializer list.
+        //! @param[in] alloc The allocator to use. The allocator object will be copy-constructed into the map.
+        FlatMap(InitializerList<value_type> ilist, const allocator_type& alloc = allocator_type()) :
+            m_base(alloc)
+        {
+            m_base.insert(ilist.begin(), ilist.end());
+        }
+        //! Constructs a map by coping elements from another map.
+        //! @param[in] rhs The map to copy elements from.
+        FlatMap(const FlatMap& rhs) :
+            m_base(rhs.m_base) {}
+        //! Constructs a map with an custom allocator and with elements copied from another map.
+        //! @param[in] rhs The map to copy elements from.
+        //! @param[in] alloc The allocator to use. The allocator object will be copy-constructed into the map.
+        FlatMap(const FlatMap& rhs, const allocator_type& alloc) :
+            m_base(rhs.m_base, alloc) {}
+        //! Constructs a map by moving elements from another map.
+        //! @param[in] rhs The map to move elements from.
+        FlatMap(FlatMap&& rhs) :
+            m_base(move(rhs.m_base)) {}
+        //! Constructs a map with an custom allocator and with elements moved from another map.
+        //! @param[in] rhs The map to move elements from.
+        //! @param[in] alloc The allocator to use. The allocator object will be copy-constructed into the map.
+        FlatMap(FlatMap&& rhs, const allocator_type& alloc) :
+            m_base(move(rhs.m_base), alloc) {}
+        //! Replaces elements of the map by coping elements from another map.
+        //! @param[in] rhs The map to copy elements from.
+        //! @return Returns `*this`.
+        FlatMap& operator=(const FlatMap& rhs)
+        {
+            m_base = rhs.m_base;
+            return *this;
+        }
+        //! Replaces elements of the map by moving elements from another map.
+        //! @param[in] rhs The map to move elements from. This map will be empty after this operation.
+        //! @return Returns `*this`.
+        FlatMap& operator=(FlatMap&& rhs)
+        {
+            m_base = move(rhs.m_base);
+            return *this;
+        }
+        //! Gets one iterator to the first element of the map.
+        //! @return Returns one iterator to the first element of the map.
+        iterator begin()
+        {
+            return iterator(m_base.begin());
+        }
+        //! Gets one constant iterator to the first element of the map.
+        //! @return Returns one constant iterator to the first element of the map.
+        const_iterator begin() const
+        {
+            return const_iterator(m_base.begin());
+        }
+        //! Gets one constant iterator to the first element of the map.
+        //! @return Returns one constant iterator to the first element of the map.
+        const_iterator cbegin() const
+        {
+            return const_iterator(m_base.cbegin());
+        }
+        //! Gets one iterator to the one past last element of the map.
+        //! @return Returns one iterator to the one past last element of the map.
+        iterator end()
+        {
+            return iterator(m_base.end());
+        }
+        //! Gets one constant iterator to the one past last element of the map.
+        //! @return Returns one constant iterator to the one past last element of the map.
+        const_iterator end() const
+        {
+            return const_iterator(m_base.end());
+        }
+        //! Gets one constant iterator to the one past last element of the map.
+        //! @return Returns one constant iterator to the one past last element of the map.
+        const_iterator cend() const
+        {
+            return const_iterator(m_base.cend());
+        }
+        //! Checks whether this map is empty, that is, the size of this map is `0`.
+        //! @return Returns `true` if this map is empty, returns `false` otherwise.
+        bool empty() const
+        {
+            return m_base.empty();
+        }
+        //! Gets the size of the map, that is, the number of elements in the map.
+        //! @return Returns the size of the map.
+        usize size() const
+        {
+            return m_base.size();
+        }
+        //! Gets the capacity of the map, that is, the number of elements the map can hold before expanding its storage.
+        //! @return Returns the capacity of the map.
+        usize capacity() const
+        {
+            return m_base.capacity();
+        }
+        //! Removes all elements from the map.
+        void clear()
+        {
+            m_base.clear();
+        }
+        //! Reduces the capacity of the map to the number of elements in the map.
+        void shrink_to_fit()
+        {
+            m_base.shrink_to_fit();
+        }
+        //! Gets the function object used to compare keys.
+        //! @return Returns the function object used to compare keys.
+        key_compare key_comp() const
+        {
+            return m_base.key_comp();
+        }
+        //! Reserves storage so that the map can hold at least the specified number of elements without expanding its storage.
+        //! @param[in] new_cap The number of elements to reserve.
+        void reserve(usize new_cap)
+        {
+            m_base.reserve(new_cap);
+        }
+        //! Gets one pointer to the underlying sorted array of elements.
+        //! @return Returns one pointer to the underlying sorted array of elements.
+        const_pointer data() const
+        {
+            return reinterpret_cast<const_pointer>(m_base.data());
+        }
+        //! Finds the first element whose key is not less than the specified key.
+        //! @param[in] key The key to compare.
+        //! @return Returns one iterator to the found element, or @ref end if no such element is found.
+        iterator lower_bound(const key_type& key)
+        {
+            return iterator(m_base.lower_bound(key));
+        }
+        //! Finds the first element whose key is not less than the specified key.
+        //! @param[in] key The key to compare.
+        //! @return Returns one iterator to the found element, or @ref end if no such element is found.
+        const_iterator lower_bound(const key_type& key) const
+        {
+            return const_iterator(m_base.lower_bound(key));
+        }
+        //! Finds the first element whose key is greater than the specified key.
+        //! @param[in] key The key to compare.
+        //! @return Returns one iterator to the found element, or @ref end if no such element is found.
+        iterator upper_bound(const key_type& key)
+        {
+            return iterator(m_base.upper_bound(key));
+        }
+        //! Finds the first element whose key is greater than the specified key.
+        //! @param[in] key The key to compare.
+        //! @return Returns one iterator to the found element, or @ref end if no such element is found.
+        const_iterator upper_bound(const key_type& key) const
+        {
+            return const_iterator(m_base.upper_bound(key));
+        }
+        //! Finds the element with the specified key.
+        //! @param[in] key The key of the element to find.
+        //! @return Returns one iterator to the element with the specified key, or @ref end if no such element is found.
+        iterator find(const key_type& key)
+        {
+            return iterator(m_base.find(key));
+        }
+        //! Finds the element with the specified key.
+        //! @param[in] key The key of the element to find.
+        //! @return Returns one iterator to the element with the specified key, or @ref end if no such element is found.
+        const_iterator find(const key_type& key) const
+        {
+            return const_iterator(m_base.find(key));
+        }
+        //! Gets the number of elements whose key is equal to the specified key.
+        //! @param[in] key The key of the element to count.
+        //! @return Returns the number of elements whose key is equal to the specified key. Returns `1` or `0`.
+        usize count(const key_type& key) const
+        {
+            return m_base.count(key);
+        }
+        //! Checks whether at least one element with the specified key exists.
+        //! @param[in] key The key of the element to check.
+        //! @return Returns `true` if the element exists, returns `false` otherwise.
+        bool contains(const key_type& key) const
+        {
+            return m_base.contains(key);
+        }
+        //! Inserts the element into the map if the map doesn't contain the element with the same key.
+        //! @param[in] value The element to insert.
+        //! @return Returns one iterator-bool pair indicating the insertion result:
+        //! * If the element is inserted, returns the iterator to the inserted element and `true`.
+        //! * If the element is not inserted, returns the iterator to the existing element with the same key and `false`.
+        Pair<iterator, bool> insert(const value_type& value)
+        {
+            return to_result(m_base.insert(storage_type(value)));
+        }
+        //! Inserts the element into the map if the map doesn't contain the element with the same key.
+        //! @param[in] value The element to insert.
+        //! @return Returns one iterator-bool pair indicating the insertion result:
+        //! * If the element is inserted, returns the iterator to the inserted element and `true`.
+        //! * If the element is not inserted, returns the iterator to the existing element with the same key and `false`.
+        Pair<iterator, bool> insert(value_type&& value)
+        {
+            return to_result(m_base.insert(storage_type(move(value))));
+        }
+        //! Inserts elements in the specified range into the map.
+        //! @details Elements in the range do not need to be sorted. Elements whose keys already exist in the map are not inserted.
+        //! If multiple elements in the range have the same key, only the first one is inserted. Elements are appended to
+        //! the underlying array and sorted once, which is faster than inserting elements one by one if many elements are inserted.
+        //! @param[in] first The iterator to the first element to insert.
+        //! @param[in] last The iterator to the one-past-last element to insert.
+        template <typename _InputIt>
+        void insert(_InputIt first, _InputIt last)
+        {
+            m_base.insert(first, last);
+        }
+        //! Assigns the value to the element with the specified key, or inserts the key-value pair into the
+        //! map if the key does not exist.
+        //! @param[in] key The key of the element.
+        //! @param[in] value The value to assign or insert.
+        //! @return Returns one iterator-bool pair indicating the insertion result:
+        //! * If the element is inserted, returns the iterator to the inserted element and `true`.
+        //! * If the element is assigned, returns the iterator to the assigned element and `false`.
+        template <typename _M>
+        Pair<iterator, bool> insert_or_assign(const key_type& key, _M&& value)
+        {
+            return to_result(m_base.insert_or_assign(key, forward<_M>(value)));
+        }
+        //! Assigns the value to the element with the specified key, or inserts the key-value pair into the
+        //! map if the key does not exist.
+        //! @param[in] key The key of the element.
+        //! @param[in] value The value to assign or insert.
+        //! @return Returns one iterator-bool pair indicating the insertion result:
+        //! * If the element is inserted, returns the iterator to the inserted element and `true`.
+        //! * If the element is assigned, returns the iterator to the assigned element and `false`.
+        template <typename _M>
+        Pair<iterator, bool> insert_or_assign(key_type&& key, _M&& value)
+        {
+            return to_result(m_base.insert_or_assign(move(key), forward<_M>(value)));
+        }
+        //! Constructs one element and inserts it into the map if the map doesn't contain the element with the same key.
+        //! @param[in] args The arguments to construct the element.
+        //! @return Returns one iterator-bool pair indicating the insertion result:
+        //! * If the element is inserted, returns the iterator to the inserted element and `true`.
+        //! * If the element is not inserted, returns the iterator to the existing element with the same key and `false`.
+        template <typename... _Args>
+        Pair<iterator, bool> emplace(_Args&&... args)
+        {
+            return to_result(m_base.emplace(forward<_Args>(args)...));
+        }
+        //! Removes one element from the map.
+        //! @param[in] pos The iterator to the element to remove.
+        //! @return Returns the iterator to the next element after the removed element, or @ref end if the removed element
+        //! is the last element.
+        iterator erase(const_iterator pos)
+        {
+            return iterator(m_base.erase(pos.m_value));
+        }
+        //! Removes elements in the specified range from the map.
+        //! @param[in] first The iterator to the first element to remove.
+        //! @param[in] last The iterator to the one-past-last element to remove.
+        //! @return Returns the iterator to the next element after the removed elements.
+        iterator erase(const_iterator first, const_iterator last)
+        {
+            return iterator(m_base.erase(first.m_value, last.m_value));
+        }
+        //! Removes the element with the specified key from the map.
+        //! @param[in] key The key of the element to remove.
+        //! @return Returns the number of elements removed by this operation. Returns `1` or `0`.
+        usize erase(const key_type& key)
+        {
+            return m_base.erase(key);
+        }
+        //! Swaps elements of this map with the specified map.
+        //! @param[in] rhs The map to swap elements with.
+        void swap(FlatMap& rhs)
+        {
+            FlatMap tmp(move(rhs));
+            rhs = move(*this);
+            *this = move(tmp);
+        }
+        //! Gets the allocator of the map.
+        //! @return Returns one copy of the allocator of the map.
+        allocator_type get_allocator() const
+        {
+            return m_base.get_allocator();
+        }
+    };
+
+    //! @}
+}
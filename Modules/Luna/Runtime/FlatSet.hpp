@@ -0,0 +1,335 @@
+/*!
+* This file is a portion of LunaSDK.
+* For conditions of distribution and use, see the disclaimer
+* and license in LICENSE.txt
+*
+* @file FlatSet.hpp
+* @author JXMaster
+* @date 2026/10/18
+*/
+#pragma once
+#include "Impl/SortedVectorTable.hpp"
+
+namespace Luna
+{
+    //! @addtogroup RuntimeContainer
+    //! @{
+
+    //! An container that contains a set of unique objects stored in one sorted contiguous array.
+    //! @details Elements are stored in one @ref Vector in sorted order, and lookups are performed by binary searches
+    //! whose loop bodies compile to conditional moves rather than branches. Compared to hash sets, this set has no
+    //! per-element memory overhead, iterates elements in order, and accesses only O(log n) elements that are close
+    //! in memory for every lookup, which makes it a good fit for small and read-mostly sets.
+    //!
+    //! Inserting or erasing one element moves all elements after it, so the time complexity of single-element insertions
+    //! and erasures is O(n). Use the range version of @ref insert or the range constructor to insert many elements at once,
+    //! which sorts elements only once.
+    //! @remark Elements of the set cannot be modified through iterators, since that may break the order of elements.
+    //!
+    //! Iterators and references to elements are invalidated by every insertion and erasure.
+    template <
+        typename _Kty,
+        typename _Compare = less<_Kty>,        // Used to order keys.
+        typename _Alloc = Allocator>
+    class FlatSet
+    {
+    public:
+        using key_type = _Kty;
+        using value_type = _Kty;
+        using allocator_type = _Alloc;
+        using key_compare = _Compare;
+        using reference = value_type&;
+        using const_reference = const value_type&;
+        using pointer = value_type*;
+        using const_pointer = const value_type*;
+        using iterator = const value_type*;
+        using const_iterator = const value_type*;
+
+    private:
+
+        using table_type = SortedVector::Table<key_type, value_type, Impl::SetExtractKey<key_type, value_type>, key_compare, allocator_type>;
+
+        table_type m_base;
+
+    public:
+        //! Constructs an empty set.
+        FlatSet() :
+            m_base() {}
+        //! Constructs an empty set with an custom allocator.
+        //! @param[in] alloc The allocator to use. The allocator object will be copy-constructed into the set.
+        FlatSet(const allocator_type& alloc) :
+            m_base(alloc) {}
+        //! Constructs a set with elements in the specified range.
+        //! @details Elements in the range do not need to be sorted. If multiple elements in the range have the same key, only
+        //! the first one is inserted.
+        //! @param[in] first The iterator to the first element to insert.
+        //! @param[in] last The iterator to the one-past-last element to insert.
+        //! @param[in] alloc The allocator to use. The allocator object will be copy-constructed into the set.
+        template <typename _InputIt>
+        FlatSet(_InputIt first, _InputIt last, const allocator_type& alloc = allocator_type()) :
+            m_base(alloc)
+        {
+            m_base.insert(first, last);
+        }
+        //! Constructs a set with elements in the specified initializer list.
+        //! @details Elements in the list do not need to be sorted. If multiple elements in the list have the same key, only
+        //! the first one is inserted.
+        //! @param[in] ilist The initializer list.
+        //! @param[in] alloc The allocator to use. The allocator object will be copy-constructed into the set.
+        FlatSet(InitializerList<value_type> ilist, const allocator_type& alloc = allocator_type()) :
+            m_base(alloc)
+        {
+            m_base.insert(ilist.begin(), ilist.end());
+        }
+        //! Constructs a set by coping elements from another set.
+        //! @param[in] rhs The set to copy elements from.
+        FlatSet(const FlatSet& rhs) :
+            m_base(rhs.m_base) {}
+        //! Constructs a set with an custom allocator and with elements copied from another set.
+        //! @param[in] rhs The set to copy elements from.
+        //! @param[in] alloc The allocator to use. The allocator object will be copy-constructed into the set.
+        FlatSet(const FlatSet& rhs, const allocator_type& alloc) :
+            m_base(rhs.m_base, alloc) {}
+        //! Constructs a set by moving elements from another set.
+        //! @param[in] rhs The set to move elements from.
+        FlatSet(FlatSet&& rhs) :
+            m_base(move(rhs.m_base)) {}
+        //! Constructs a set with an custom allocator and with elements moved from another set.
+        //! @param[in] rhs The set to move elements from.
+        //! @param[in] alloc The allocator to use. The allocator object will be copy-constructed into the set.
+        FlatSet(FlatSet&& rhs, const allocator_type& alloc) :
+            m_base(move(rhs.m_base), alloc) {}
+        //! Replaces elements of the set by coping elements from another set.
+        //! @param[in] rhs The set to copy elements from.
+        //! @return Returns `*this`.
+        FlatSet& operator=(const FlatSet& rhs)
+        {
+            m_base = rhs.m_base;
+            return *this;
+        }
+        //! Replaces elements of the set by moving elements from another set.
+        //! @param[in] rhs The set to move elements from. This set will be empty after this operation.
+        //! @return Returns `*this`.
+        FlatSet& operator=(FlatSet&& rhs)
+        {
+            m_base = move(rhs.m_base);
+            return *this;
+        }
+        //! Gets one iterator to the first element of the set.
+        //! @return Returns one iterator to the first element of the set.
+        iterator begin()
+        {
+            return m_base.begin();
+        }
+        //! Gets one constant iterator to the first element of the set.
+        //! @return Returns one constant iterator to the first element of the set.
+        const_iterator begin() const
+        {
+            return m_base.begin();
+        }
+        //! Gets one constant iterator to the first element of the set.
+        //! @return Returns one constant iterator to the first element of the set.
+        const_iterator cbegin() const
+        {
+            return m_base.cbegin();
+        }
+        //! Gets one iterator to the one past last element of the set.
+        //! @return Returns one iterator to the one past last element of the set.
+        iterator end()
+        {
+            return m_base.end();
+        }
+        //! Gets one constant iterator to the one past last element of the set.
+        //! @return Returns one constant iterator to the one past last element of the set.
+        const_iterator end() const
+        {
+            return m_base.end();
+        }
+        //! Gets one constant iterator to the one past last element of the set.
+        //! @return Returns one constant iterator to the one past last element of the set.
+        const_iterator cend() const
+        {
+            return m_base.cend();
+        }
+        //! Checks whether this set is empty, that is, the size of this set is `0`.
+        //! @return Returns `true` if this set is empty, returns `false` otherwise.
+        bool empty() const
+        {
+            return m_base.empty();
+        }
+        //! Gets the size of the set, that is, the number of elements in the set.
+        //! @return Returns the size of the set.
+        usize size() const
+        {
+            return m_base.size();
+        }
+        //! Gets the capacity of the set, that is, the number of elements the set can hold before expanding its storage.
+        //! @return Returns the capacity of the set.
+        usize capacity() const
+        {
+            return m_base.capacity();
+        }
+        //! Removes all elements from the set.
+        void clear()
+        {
+            m_base.clear();
+        }
+        //! Reduces the capacity of the set to the number of elements in the set.
+        void shrink_to_fit()
+        {
+            m_base.shrink_to_fit();
+        }
+        //! Gets the function object used to compare keys.
+        //! @return Returns the function object used to compare keys.
+        key_compare key_comp() const
+        {
+            return m_base.key_comp();
+        }
+        //! Reserves storage so that the set can hold at least the specified number of elements without expanding its storage.
+        //! @param[in] new_cap The number of elements to reserve.
+        void reserve(usize new_cap)
+        {
+            m_base.reserve(new_cap);
+        }
+        //! Gets one pointer to the underlying sorted array of elements.
+        //! @return Returns one pointer to the underlying sorted array of elements.
+        const_pointer data() const
+        {
+            return m_base.data();
+        }
+        //! Finds the first element whose key is not less than the specified key.
+        //! @param[in] key The key to compare.
+        //! @return Returns one iterator to the found element, or @ref end if no such element is found.
+        iterator lower_bound(const key_type& key)
+        {
+            return m_base.lower_bound(key);
+        }
+        //! Finds the first element whose key is not less than the specified key.
+        //! @param[in] key The key to compare.
+        //! @return Returns one iterator to the found element, or @ref end if no such element is found.
+        const_iterator lower_bound(const key_type& key) const
+        {
+            return m_base.lower_bound(key);
+        }
+        //! Finds the first element whose key is greater than the specified key.
+        //! @param[in] key The key to compare.
+        //! @return Returns one iterator to the found element, or @ref end if no such element is found.
+        iterator upper_bound(const key_type& key)
+        {
+            return m_base.upper_bound(key);
+        }
+        //! Finds the first element whose key is greater than the specified key.
+        //! @param[in] key The key to compare.
+        //! @return Returns one iterator to the found element, or @ref end if no such element is found.
+        const_iterator upper_bound(const key_type& key) const
+        {
+            return m_base.upper_bound(key);
+        }
+        //! Finds the element with the specified key.
+        //! @param[in] key The key of the element to find.
+        //! @return Returns one iterator to the element with the specified key, or @ref end if no such element is found.
+        iterator find(const key_type& key)
+        {
+            return m_base.find(key);
+        }
+        //! Finds the element with the specified key.
+        //! @param[in] key The key of the element to find.
+        //! @return Returns one iterator to the element with the specified key, or @ref end if no such element is found.
+        const_iterator find(const key_type& key) const
+        {
+            return m_base.find(key);
+        }
+        //! Gets the number of elements whose key is equal to the specified key.
+        //! @param[in] key The key of the element to count.
+        //! @return Returns the number of elements whose key is equal to the specified key. Returns `1` or `0`.
+        usize count(const key_type& key) const
+        {
+            return m_base.count(key);
+        }
+        //! Checks whether at least one element with the specified key exists.
+        //! @param[in] key The key of the element to check.
+        //! @return Returns `true` if the element exists, returns `false` otherwise.
+        bool contains(const key_type& key) const
+        {
+            return m_base.contains(key);
+        }
+        //! Inserts the element into the set if the set doesn't contain the element with the same key.
+        //! @param[in] value The element to insert.
+        //! @return Returns one iterator-bool pair indicating the insertion result:
+        //! * If the element is inserted, returns the iterator to the inserted element and `true`.
+        //! * If the element is not inserted, returns the iterator to the existing element with the same key and `false`.
+        Pair<iterator, bool> insert(const value_type& value)
+        {
+            return m_base.insert(value);
+        }
+        //! Inserts the element into the set if the set doesn't contain the element with the same key.
+        //! @param[in] value The element to insert.
+        //! @return Returns one iterator-bool pair indicating the insertion result:
+        //! * If the element is inserted, returns the iterator to the inserted element and `true`.
+        //! * If the element is not inserted, returns the iterator to the existing element with the same key and `false`.
+        Pair<iterator, bool> insert(value_type&& value)
+        {
+            return m_base.insert(move(value));
+        }
+        //! Inserts elements in the specified range into the set.
+        //! @details Elements in the range do not need to be sorted. Elements whose keys already exist in the set are not inserted.
+        //! If multiple elements in the range have the same key, only the first one is inserted. Elements are appended to
+        //! the underlying array and sorted once, which is faster than inserting elements one by one if many elements are inserted.
+        //! @param[in] first The iterator to the first element to insert.
+        //! @param[in] last The iterator to the one-past-last element to insert.
+        template <typename _InputIt>
+        void insert(_InputIt first, _InputIt last)
+        {
+            m_base.insert(first, last);
+        }
+        //! Constructs one element and inserts it into the set if the set doesn't contain the element with the same key.
+        //! @param[in] args The arguments to construct the element.
+        //! @return Returns one iterator-bool pair indicating the insertion result:
+        //! * If the element is inserted, returns the iterator to the inserted element and `true`.
+        //! * If the element is not inserted, returns the iterator to the existing element with the same key and `false`.
+        template <typename... _Args>
+        Pair<iterator, bool> emplace(_Args&&... args)
+        {
+            return m_base.emplace(forward<_Args>(args)...);
+        }
+        //! Removes one element from the set.
+        //! @param[in] pos The iterator to the element to remove.
+        //! @return Returns the iterator to the next element after the removed element, or @ref end if the removed element
+        //! is the last element.
+        iterator erase(const_iterator pos)
+        {
+            return m_base.erase(pos);
+        }
+        //! Removes elements in the specified range from the set.
+        //! @param[in] first The iterator to the first element to remove.
+        //! @param[in] last The iterator to the one-past-last element to remove.
+        //! @return Returns the iterator to the next element after the removed elements.
+        iterator erase(const_iterator first, const_iterator last)
+        {
+            return m_base.erase(first, last);
+        }
+        //! Removes the element with the specified key from the set.
+        //! @param[in] key The key of the element to remove.
+        //! @return Returns the number of elements removed by this operation. Returns `1` or `0`.
+        usize erase(const key_type& key)
+        {
+            return m_base.erase(key);
+        }
+        //! Swaps elements of this set with the specified set.
+        //! @param[in] rhs The set to swap elements with.
+        void swap(FlatSet& rhs)
+        {
+            FlatSet tmp(move(rhs));
+            rhs = move(*this);
+            *this = move(tmp);
+        }
+        //! Gets the allocator of the set.
+        //! @return Returns one copy of the allocator of the set.
+        allocator_type get_allocator() const
+        {
+            return m_base.get_allocator();
+        }
+    };
+
+    //! @}
+}
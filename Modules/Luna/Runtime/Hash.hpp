@@ -9,6 +9,11 @@
 */
 #pragma once
 #include "Base.hpp"
+
+#ifndef LUNA_RUNTIME_API
+#define LUNA_RUNTIME_API
+#endif
+
 namespace Luna
 {
     namespace Impl
@@ -231,6 +236,125 @@ namespace Luna
         {
             return crc64_table[index];
         }
+
+        // Secrets and mixing functions of the wyhash algorithm (https://github.com/wangyi-fudan/wyhash).
+        constexpr const u64 wyhash_secret[4] =
+        {
+            0x2d358dccaa6c78a5ULL, 0x8bb84b93962eacc9ULL, 0x4b33a62ed433d4a3ULL, 0x4d5a2da51de1aa47ULL
+        };
+
+        //! Computes the 128-bit product of `a` and `b`, and stores the low 64 bits in `a` and high 64 bits in `b`.
+        inline constexpr void wymum(u64& a, u64& b)
+        {
+#if defined(__SIZEOF_INT128__)
+            __uint128_t r = (__uint128_t)a * b;
+            a = (u64)r;
+            b = (u64)(r >> 64);
+#else
+            u64 ha = a >> 32, hb = b >> 32, la = (u32)a, lb = (u32)b;
+            u64 rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb;
+            u64 t = rl + (rm0 << 32);
+            u64 c = t < rl ? 1 : 0;
+            u64 lo = t + (rm1 << 32);
+            c += lo < t ? 1 : 0;
+            u64 hi = rh + (rm0 >> 32) + (rm1 >> 32) + c;
+            a = lo;
+            b = hi;
+#endif
+        }
+
+        inline constexpr u64 wymix(u64 a, u64 b)
+        {
+            wymum(a, b);
+            return a ^ b;
+        }
+
+        //! Reads little-endian integers from character arrays, which can be evaluated at compile time.
+        struct WyhashCharReader
+        {
+            static constexpr u64 r8(const c8* p)
+            {
+                return (u64)(u8)p[0] | ((u64)(u8)p[1] << 8) | ((u64)(u8)p[2] << 16) | ((u64)(u8)p[3] << 24) |
+                    ((u64)(u8)p[4] << 32) | ((u64)(u8)p[5] << 40) | ((u64)(u8)p[6] << 48) | ((u64)(u8)p[7] << 56);
+            }
+            static constexpr u64 r4(const c8* p)
+            {
+                return (u64)(u8)p[0] | ((u64)(u8)p[1] << 8) | ((u64)(u8)p[2] << 16) | ((u64)(u8)p[3] << 24);
+            }
+        };
+
+        //! Reads integers from memory using unaligned loads.
+        struct WyhashMemoryReader
+        {
+            static u64 r8(const u8* p)
+            {
+                u64 v;
+                std::memcpy(&v, p, sizeof(u64));
+#ifndef LUNA_PLATFORM_LITTLE_ENDIAN
+                v = __builtin_bswap64(v);
+#endif
+                return v;
+            }
+            static u64 r4(const u8* p)
+            {
+                u32 v;
+                std::memcpy(&v, p, sizeof(u32));
+#ifndef LUNA_PLATFORM_LITTLE_ENDIAN
+                v = __builtin_bswap32(v);
+#endif
+                return v;
+            }
+        };
+
+        template <typename _Reader, typename _Ty>
+        constexpr u64 wyhash(const _Ty* p, usize len, u64 seed)
+        {
+            const u64* secret = wyhash_secret;
+            seed ^= wymix(seed ^ secret[0], secret[1]);
+            u64 a = 0, b = 0;
+            if (len <= 16)
+            {
+                if (len >= 4)
+                {
+                    a = (_Reader::r4(p) << 32) | _Reader::r4(p + ((len >> 3) << 2));
+                    b = (_Reader::r4(p + len - 4) << 32) | _Reader::r4(p + len - 4 - ((len >> 3) << 2));
+                }
+                else if (len > 0)
+                {
+                    a = ((u64)(u8)p[0] << 16) | ((u64)(u8)p[len >> 1] << 8) | (u64)(u8)p[len - 1];
+                }
+            }
+            else
+            {
+                usize i = len;
+                if (i > 48)
+                {
+                    // Three independent lanes, so that multiplications of one round can be executed in parallel.
+                    u64 see1 = seed, see2 = seed;
+                    do
+                    {
+                        seed = wymix(_Reader::r8(p) ^ secret[1], _Reader::r8(p + 8) ^ seed);
+                        see1 = wymix(_Reader::r8(p + 16) ^ secret[2], _Reader::r8(p + 24) ^ see1);
+                        see2 = wymix(_Reader::r8(p + 32) ^ secret[3], _Reader::r8(p + 40) ^ see2);
+                        p += 48;
+                        i -= 48;
+                    } while (i > 48);
+                    seed ^= see1 ^ see2;
+                }
+                while (i > 16)
+                {
+                    seed = wymix(_Reader::r8(p) ^ secret[1], _Reader::r8(p + 8) ^ seed);
+                    i -= 16;
+                    p += 16;
+                }
+                a = _Reader::r8(p + i - 16);
+                b = _Reader::r8(p + i - 8);
+            }
+            a ^= secret[1];
+            b ^= seed;
+            wymum(a, b);
+            return wymix(a ^ secret[0] ^ (u64)len, b ^ secret[1]);
+        }
     }
 
     //! @addtogroup Runtime
@@ -377,5 +501,57 @@ namespace Luna
         return strhash<u64>(s, h);
     }
 
+    //! Computes a 64-bit hash code for the specified binary data using the wyhash algorithm.
+    //! @details Unlike @ref memhash, which processes one byte per step, this function processes 8 bytes per load and 
+    //! 48 bytes per round, so it is much faster for long keys. This function is suitable for hash tables, but is not suitable 
+    //! for cryptographic usages.
+    //! @param[in] data A pointer to the data to be hashed.
+    //! @param[in] size The length of the data in bytes.
+    //! @param[in] seed The seed of the hash. Different seeds produce different hash codes from the same data.
+    //! @return Returns the hash code of the data.
+    inline u64 wyhash64(const void* data, usize size, u64 seed = 0)
+    {
+        return Impl::wyhash<Impl::WyhashMemoryReader>(reinterpret_cast<const u8*>(data), size, seed);
+    }
+
+    //! Computes a 64-bit hash code for the specified null-terminated string using the wyhash algorithm.
+    //! @details This function can be evaluated at compile time, and returns the same value as calling @ref wyhash64 on 
+    //! the string data (excluding the null terminator).
+    //! @param[in] s A pointer to one null-terminated string to compute.
+    //! @param[in] seed The seed of the hash. See @ref wyhash64 for details.
+    //! @return Returns the hash code of the string.
+    inline constexpr u64 strwyhash64(const c8* s, u64 seed = 0)
+    {
+        usize size = 0;
+        while (s[size]) ++size;
+        return Impl::wyhash<Impl::WyhashCharReader>(s, size, seed);
+    }
+
+    //! Computes a hash code that can be used in hash tables for the specified binary data.
+    //! @details This is the hash function used by @ref hash specializations for strings and other byte ranges.
+    //! @param[in] data A pointer to the data to be hashed.
+    //! @param[in] size The length of the data in bytes.
+    //! @return Returns the hash code of the data.
+    inline usize hash_bytes(const void* data, usize size)
+    {
+        return (usize)wyhash64(data, size);
+    }
+
+    //! Computes the CRC-32C (Castagnoli) checksum of the specified binary data.
+    //! @details This function uses the SSE 4.2 `crc32` instruction on x86 and the ARMv8 CRC32 instructions on ARM if 
+    //! they are supported by the CPU, which is checked at run time. Otherwise, one table-based software implementation 
+    //! is used. All implementations produce the same result.
+    //! @param[in] data A pointer to the data to be checked.
+    //! @param[in] size The length of the data in bytes.
+    //! @param[in] crc The checksum of the previous data. Specify `0` for new checksums. Computing the checksum of one 
+    //! data stream in multiple calls by passing the result of the last call to `crc` produces the same result as computing 
+    //! the checksum of the whole stream in one call.
+    //! @return Returns the checksum of the data.
+    LUNA_RUNTIME_API u32 crc32c(const void* data, usize size, u32 crc = 0);
+
+    //! Checks whether @ref crc32c is accelerated by CPU instructions on the current platform.
+    //! @return Returns `true` if @ref crc32c uses CPU instructions, returns `false` if @ref crc32c uses the software implementation.
+    LUNA_RUNTIME_API bool is_crc32c_hardware_accelerated();
+
     //! @}
 }
@@ -84,6 +84,16 @@ namespace Luna
     {
         return (_Ty*)__sync_lock_test_and_set((void**)target, value);
     }
+    template <typename _Ty>
+    inline _Ty* atom_load_acquire_pointer(_Ty* const volatile* src)
+    {
+        return (_Ty*)__atomic_load_n((void* const volatile*)src, __ATOMIC_ACQUIRE);
+    }
+    template <typename _Ty>
+    inline void atom_store_release_pointer(_Ty* volatile* dst, void* value)
+    {
+        __atomic_store_n((void* volatile*)dst, value, __ATOMIC_RELEASE);
+    }
 
     inline i32 atom_compare_exchange_i32(i32 volatile* dest, i32 exchange, i32 comperand)
     {
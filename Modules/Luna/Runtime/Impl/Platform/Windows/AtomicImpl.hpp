@@ -88,6 +88,19 @@ namespace Luna
     {
         return (_Ty*)InterlockedExchangePointer((PVOID volatile *)target, (PVOID)value);
     }
+    template <typename _Ty>
+    inline _Ty* atom_load_acquire_pointer(_Ty* const volatile* src)
+    {
+        _Ty* r = *src;
+        std::atomic_thread_fence(std::memory_order_acquire);
+        return r;
+    }
+    template <typename _Ty>
+    inline void atom_store_release_pointer(_Ty* volatile* dst, void* value)
+    {
+        std::atomic_thread_fence(std::memory_order_release);
+        *dst = (_Ty*)value;
+    }
 
     inline i32 atom_compare_exchange_i32(i32 volatile* dst, i32 exchange, i32 comperand)
     {
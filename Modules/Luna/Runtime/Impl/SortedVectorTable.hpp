@@ -0,0 +1,322 @@
+/*!
+* This file is a portion of LunaSDK.
+* For conditions of distribution and use, see the disclaimer
+* and license in LICENSE.txt
+*
+* @file SortedVectorTable.hpp
+* @author JXMaster
+* @date 2026/10/18
+* @brief Defines the sorted contiguous table used by both flat map and flat set.
+*/
+#pragma once
+#include "../Vector.hpp"
+#include "../Functional.hpp"
+#include "../Algorithm.hpp"
+#include "HashTableBase.hpp"
+
+namespace Luna
+{
+    namespace SortedVector
+    {
+        //! The iterator of sorted maps. Elements are stored as `Pair<_Kty, _Ty>` so that they can be moved
+        //! when the array is modified, but are exposed as `Pair<const _Kty, _Ty>` so that the user cannot
+        //! modify keys and break the order of elements.
+        template <typename _Kty, typename _Ty, bool _Const>
+        struct MapIterator
+        {
+            using value_type = Pair<const _Kty, _Ty>;
+            using storage_type = Pair<_Kty, _Ty>;
+            using difference_type = isize;
+            using pointer = conditional_t<_Const, const value_type*, value_type*>;
+            using reference = conditional_t<_Const, const value_type&, value_type&>;
+            using storage_pointer = conditional_t<_Const, const storage_type*, storage_type*>;
+            using iterator_category = random_access_iterator_tag;
+
+            storage_pointer m_value;
+
+            MapIterator() :
+                m_value(nullptr) {}
+            explicit MapIterator(storage_pointer value) :
+                m_value(value) {}
+            MapIterator(const MapIterator<_Kty, _Ty, false>& rhs) :
+                m_value(rhs.m_value) {}
+            reference operator*() const
+            {
+                return *reinterpret_cast<pointer>(m_value);
+            }
+            pointer operator->() const
+            {
+                return reinterpret_cast<pointer>(m_value);
+            }
+            reference operator[](isize n) const
+            {
+                return *reinterpret_cast<pointer>(m_value + n);
+            }
+            MapIterator& operator++()
+            {
+                ++m_value;
+                return *this;
+            }
+            MapIterator operator++(int)
+            {
+                MapIterator temp(*this);
+                ++m_value;
+                return temp;
+            }
+            MapIterator& operator--()
+            {
+                --m_value;
+                return *this;
+            }
+            MapIterator operator--(int)
+            {
+                MapIterator temp(*this);
+                --m_value;
+                return temp;
+            }
+            MapIterator& operator+=(isize n)
+            {
+                m_value += n;
+                return *this;
+            }
+            MapIterator& operator-=(isize n)
+            {
+                m_value -= n;
+                return *this;
+            }
+            MapIterator operator+(isize n) const
+            {
+                return MapIterator(m_value + n);
+            }
+            MapIterator operator-(isize n) const
+            {
+                return MapIterator(m_value - n);
+            }
+            isize operator-(const MapIterator& rhs) const
+            {
+                return m_value - rhs.m_value;
+            }
+            bool operator==(const MapIterator& rhs) const { return m_value == rhs.m_value; }
+            bool operator!=(const MapIterator& rhs) const { return m_value != rhs.m_value; }
+            bool operator<(const MapIterator& rhs) const { return m_value < rhs.m_value; }
+            bool operator>(const MapIterator& rhs) const { return m_value > rhs.m_value; }
+            bool operator<=(const MapIterator& rhs) const { return m_value <= rhs.m_value; }
+            bool operator>=(const MapIterator& rhs) const { return m_value >= rhs.m_value; }
+        };
+
+        template <typename _Kty,
+            typename _Vty,
+            typename _ExtractKey,                // MapExtractKey for FlatMap, SetExtractKey for FlatSet.
+            typename _Compare,
+            typename _Alloc>
+        class Table
+        {
+        public:
+            using key_type = _Kty;
+            using value_type = _Vty;
+            using allocator_type = _Alloc;
+            using key_compare = _Compare;
+            using iterator = value_type*;
+            using const_iterator = const value_type*;
+
+        private:
+            Vector<value_type, allocator_type> m_data;
+
+            static const key_type& extract_key(const value_type& value)
+            {
+                return _ExtractKey()(value);
+            }
+            // Finds the first element whose key is not less than the specified key.
+            // The loop body compiles to one conditional move, so the loop has no branch mispredictions.
+            const value_type* internal_lower_bound(const key_type& key) const
+            {
+                const value_type* base = m_data.data();
+                usize n = m_data.size();
+                if (!n) return base;
+                while (n > 1)
+                {
+                    usize half = n >> 1;
+                    base = key_compare()(extract_key(base[half]), key) ? base + half : base;
+                    n -= half;
+                }
+                return base + (key_compare()(extract_key(*base), key) ? 1 : 0);
+            }
+            // Finds the first element whose key is greater than the specified key.
+            const value_type* internal_upper_bound(const key_type& key) const
+            {
+                const value_type* base = m_data.data();
+                usize n = m_data.size();
+                if (!n) return base;
+                while (n > 1)
+                {
+                    usize half = n >> 1;
+                    base = key_compare()(key, extract_key(base[half])) ? base : base + half;
+                    n -= half;
+                }
+                return base + (key_compare()(key, extract_key(*base)) ? 0 : 1);
+            }
+            bool is_equal(const value_type* iter, const key_type& key) const
+            {
+                return iter != m_data.data() + m_data.size() && !key_compare()(key, extract_key(*iter));
+            }
+            iterator to_iterator(const value_type* iter)
+            {
+                return m_data.begin() + (iter - m_data.data());
+            }
+
+        public:
+            Table() {}
+            Table(const allocator_type& alloc) :
+                m_data(alloc) {}
+            Table(const Table& rhs) :
+                m_data(rhs.m_data) {}
+            Table(const Table& rhs, const allocator_type& alloc) :
+                m_data(rhs.m_data, alloc) {}
+            Table(Table&& rhs) :
+                m_data(move(rhs.m_data)) {}
+            Table(Table&& rhs, const allocator_type& alloc) :
+                m_data(move(rhs.m_data), alloc) {}
+            Table& operator=(const Table& rhs)
+            {
+                m_data = rhs.m_data;
+                return *this;
+            }
+            Table& operator=(Table&& rhs)
+            {
+                m_data = move(rhs.m_data);
+                return *this;
+            }
+            iterator begin() { return m_data.begin(); }
+            const_iterator begin() const { return m_data.begin(); }
+            const_iterator cbegin() const { return m_data.cbegin(); }
+            iterator end() { return m_data.end(); }
+            const_iterator end() const { return m_data.end(); }
+            const_iterator cend() const { return m_data.cend(); }
+            bool empty() const { return m_data.empty(); }
+            usize size() const { return m_data.size(); }
+            usize capacity() const { return m_data.capacity(); }
+            void reserve(usize new_cap) { m_data.reserve(new_cap); }
+            void shrink_to_fit() { m_data.shrink_to_fit(); }
+            void clear() { m_data.clear(); }
+            const value_type* data() const { return m_data.data(); }
+            key_compare key_comp() const { return key_compare(); }
+            allocator_type get_allocator() const { return m_data.get_allocator(); }
+
+            iterator lower_bound(const key_type& key)
+            {
+                return to_iterator(internal_lower_bound(key));
+            }
+            const_iterator lower_bound(const key_type& key) const
+            {
+                return internal_lower_bound(key);
+            }
+            iterator upper_bound(const key_type& key)
+            {
+                return to_iterator(internal_upper_bound(key));
+            }
+            const_iterator upper_bound(const key_type& key) const
+            {
+                return internal_upper_bound(key);
+            }
+            iterator find(const key_type& key)
+            {
+                const value_type* iter = internal_lower_bound(key);
+                return is_equal(iter, key) ? to_iterator(iter) : end();
+            }
+            const_iterator find(const key_type& key) const
+            {
+                const value_type* iter = internal_lower_bound(key);
+                return is_equal(iter, key) ? iter : end();
+            }
+            usize count(const key_type& key) const
+            {
+                return is_equal(internal_lower_bound(key), key) ? 1 : 0;
+            }
+            bool contains(const key_type& key) const
+            {
+                return is_equal(internal_lower_bound(key), key);
+            }
+            Pair<iterator, bool> insert(const value_type& value)
+            {
+                const value_type* iter = internal_lower_bound(extract_key(value));
+                if (is_equal(iter, extract_key(value))) return make_pair(to_iterator(iter), false);
+                return make_pair(m_data.insert(iter, value), true);
+            }
+            Pair<iterator, bool> insert(value_type&& value)
+            {
+                const value_type* iter = internal_lower_bound(extract_key(value));
+                if (is_equal(iter, extract_key(value))) return make_pair(to_iterator(iter), false);
+                return make_pair(m_data.insert(iter, move(value)), true);
+            }
+            template <typename _InputIt>
+            void insert(_InputIt first, _InputIt last)
+            {
+                usize old_size = m_data.size();
+                m_data.insert(m_data.end(), first, last);
+                if (m_data.size() == old_size) return;
+                // Sorts the whole range with a stable sort, so that existing elements are ordered before new elements
+                // with the same key, and new elements with the same key keep their input order.
+                stable_sort(m_data.begin(), m_data.end(), [](const value_type& lhs, const value_type& rhs)
+                {
+                    return key_compare()(extract_key(lhs), extract_key(rhs));
+                });
+                // Keeps only the first element of every key.
+                iterator dst = m_data.begin();
+                for (iterator iter = m_data.begin() + 1; iter != m_data.end(); ++iter)
+                {
+                    if (key_compare()(extract_key(*dst), extract_key(*iter)))
+                    {
+                        ++dst;
+                        if (dst != iter) *dst = move(*iter);
+                    }
+                }
+                m_data.erase(dst + 1, m_data.end());
+            }
+            template <typename _M>
+            Pair<iterator, bool> insert_or_assign(const key_type& key, _M&& value)
+            {
+                const value_type* iter = internal_lower_bound(key);
+                if (is_equal(iter, key))
+                {
+                    iterator r = to_iterator(iter);
+                    r->second = forward<_M>(value);
+                    return make_pair(r, false);
+                }
+                return make_pair(m_data.emplace(iter, key, forward<_M>(value)), true);
+            }
+            template <typename _M>
+            Pair<iterator, bool> insert_or_assign(key_type&& key, _M&& value)
+            {
+                const value_type* iter = internal_lower_bound(key);
+                if (is_equal(iter, key))
+                {
+                    iterator r = to_iterator(iter);
+                    r->second = forward<_M>(value);
+                    return make_pair(r, false);
+                }
+                return make_pair(m_data.emplace(iter, move(key), forward<_M>(value)), true);
+            }
+            template <typename... _Args>
+            Pair<iterator, bool> emplace(_Args&&... args)
+            {
+                value_type value(forward<_Args>(args)...);
+                return insert(move(value));
+            }
+            iterator erase(const_iterator pos)
+            {
+                return m_data.erase(pos);
+            }
+            iterator erase(const_iterator first, const_iterator last)
+            {
+                return m_data.erase(first, last);
+            }
+            usize erase(const key_type& key)
+            {
+                const value_type* iter = internal_lower_bound(key);
+                if (!is_equal(iter, key)) return 0;
+                m_data.erase(iter);
+                return 1;
+            }
+        };
+    }
+}
@@ -0,0 +1,869 @@
+/*!
+* This file is a portion of LunaSDK.
+* For conditions of distribution and use, see the disclaimer
+* and license in LICENSE.txt
+*
+* @file SwissHashTable.hpp
+* @author JXMaster
+* @date 2026/10/18
+* @brief A hash table implementation that stores one control byte per slot and probes slots in groups.
+*/
+#pragma once
+#include "../Base.hpp"
+#include "../Functional.hpp"
+#include "../Algorithm.hpp"
+#include "../Allocator.hpp"
+#include "HashTableBase.hpp"
+#include <cmath> // for floorf
+
+#if defined(LUNA_PLATFORM_X86_64) || (defined(LUNA_PLATFORM_X86) && (defined(__SSE2__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)))
+#define LUNA_SWISS_HASHING_SSE2
+#include <emmintrin.h>
+#elif defined(LUNA_PLATFORM_ARM64)
+#define LUNA_SWISS_HASHING_NEON
+#include <arm_neon.h>
+#endif
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+namespace Luna
+{
+    namespace SwissHashing
+    {
+        //! The control byte of one slot. Full slots store the low 7 bits of the hash (`0` to `127`),
+        //! empty and deleted slots store negative values, so that they can be checked by the sign bit.
+        using ctrl_t = i8;
+
+        constexpr ctrl_t CTRL_EMPTY = -128;    // 0b10000000
+        constexpr ctrl_t CTRL_DELETED = -2;    // 0b11111110
+
+        inline bool is_full(ctrl_t c)
+        {
+            return c >= 0;
+        }
+
+        inline u32 count_trailing_zeros(u64 v)
+        {
+#ifdef _MSC_VER
+#ifdef LUNA_PLATFORM_64BIT
+            unsigned long r;
+            _BitScanForward64(&r, v);
+            return (u32)r;
+#else
+            unsigned long r;
+            if (_BitScanForward(&r, (u32)v)) return (u32)r;
+            _BitScanForward(&r, (u32)(v >> 32));
+            return (u32)r + 32;
+#endif
+#else
+            return (u32)__builtin_ctzll(v);
+#endif
+        }
+
+        inline u32 count_leading_zeros(u64 v)
+        {
+#ifdef _MSC_VER
+#ifdef LUNA_PLATFORM_64BIT
+            unsigned long r;
+            _BitScanReverse64(&r, v);
+            return 63 - (u32)r;
+#else
+            unsigned long r;
+            if (_BitScanReverse(&r, (u32)(v >> 32))) return 31 - (u32)r;
+            _BitScanReverse(&r, (u32)v);
+            return 63 - (u32)r;
+#endif
+#else
+            return (u32)__builtin_clzll(v);
+#endif
+        }
+
+        //! A mask of slots in one group. Every slot is represented by `1 << _Shift` bits in the mask, and only
+        //! the highest bit of them may be set.
+        template <u32 _Width, u32 _Shift>
+        struct BitMask
+        {
+            u64 m_mask;
+
+            explicit BitMask(u64 mask) :
+                m_mask(mask) {}
+            explicit operator bool() const
+            {
+                return m_mask != 0;
+            }
+            //! Gets the index of the first slot in the mask. The mask must not be empty.
+            u32 lowest() const
+            {
+                return count_trailing_zeros(m_mask) >> _Shift;
+            }
+            void remove_lowest()
+            {
+                m_mask &= m_mask - 1;
+            }
+            //! Gets the number of slots before the first slot in the mask.
+            u32 trailing_zeros() const
+            {
+                return m_mask ? count_trailing_zeros(m_mask) >> _Shift : _Width;
+            }
+            //! Gets the number of slots after the last slot in the mask.
+            u32 leading_zeros() const
+            {
+                constexpr u32 extra_bits = 64 - (_Width << _Shift);
+                return m_mask ? (count_leading_zeros(m_mask) - extra_bits) >> _Shift : _Width;
+            }
+        };
+
+#if defined(LUNA_SWISS_HASHING_SSE2)
+        //! Tests 16 control bytes at once using SSE2 instructions.
+        struct Group
+        {
+            static constexpr usize WIDTH = 16;
+            using mask_type = BitMask<16, 0>;
+
+            __m128i m_ctrl;
+
+            explicit Group(const ctrl_t* ctrl) :
+                m_ctrl(_mm_loadu_si128(reinterpret_cast<const __m128i*>(ctrl))) {}
+            //! Matches slots whose control bytes are equal to `h2`.
+            mask_type match(u8 h2) const
+            {
+                return mask_type((u32)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8((char)h2), m_ctrl)));
+            }
+            mask_type match_empty() const
+            {
+                return mask_type((u32)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(CTRL_EMPTY), m_ctrl)));
+            }
+            mask_type match_empty_or_deleted() const
+            {
+                return mask_type((u32)_mm_movemask_epi8(m_ctrl));
+            }
+        };
+#elif defined(LUNA_SWISS_HASHING_NEON)
+        //! Tests 16 control bytes at once using NEON instructions.
+        struct Group
+        {
+            static constexpr usize WIDTH = 16;
+            using mask_type = BitMask<16, 2>;
+
+            int8x16_t m_ctrl;
+
+            explicit Group(const ctrl_t* ctrl) :
+                m_ctrl(vld1q_s8(ctrl)) {}
+            // NEON does not have `movemask`, so we narrow every 8-bit lane to 4 bits, and keep the highest bit of
+            // every 4 bits.
+            static u64 to_mask(uint8x16_t cmp)
+            {
+                u64 r = vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(cmp), 4)), 0);
+                return r & 0x8888888888888888ULL;
+            }
+            mask_type match(u8 h2) const
+            {
+                return mask_type(to_mask(vceqq_s8(vdupq_n_s8((i8)h2), m_ctrl)));
+            }
+            mask_type match_empty() const
+            {
+                return mask_type(to_mask(vceqq_s8(vdupq_n_s8(CTRL_EMPTY), m_ctrl)));
+            }
+            mask_type match_empty_or_deleted() const
+            {
+                return mask_type(to_mask(vcltzq_s8(m_ctrl)));
+            }
+        };
+#else
+        //! Tests 8 control bytes at once using 64-bit integer operations.
+        struct Group
+        {
+            static constexpr usize WIDTH = 8;
+            using mask_type = BitMask<8, 3>;
+
+            static constexpr u64 LSBS = 0x0101010101010101ULL;
+            static constexpr u64 MSBS = 0x8080808080808080ULL;
+
+            u64 m_ctrl;
+
+            explicit Group(const ctrl_t* ctrl)
+            {
+                memcpy(&m_ctrl, ctrl, sizeof(u64));
+#ifndef LUNA_PLATFORM_LITTLE_ENDIAN
+                m_ctrl = __builtin_bswap64(m_ctrl);
+#endif
+            }
+            //! This may report false positives for bytes after one matched byte, which is fine because
+            //! keys of matched slots are always compared.
+            mask_type match(u8 h2) const
+            {
+                u64 x = m_ctrl ^ (LSBS * h2);
+                return mask_type((x - LSBS) & ~x & MSBS);
+            }
+            mask_type match_empty() const
+            {
+                // Only `CTRL_EMPTY` has the highest bit set and the second lowest bit cleared.
+                return mask_type(m_ctrl & ~(m_ctrl << 6) & MSBS);
+            }
+            mask_type match_empty_or_deleted() const
+            {
+                return mask_type(m_ctrl & MSBS);
+            }
+        };
+#endif
+
+        template <typename _Ty, bool _Const>
+        struct Iterator
+        {
+            using value_type = _Ty;
+            using pointer = conditional_t<_Const, const value_type*, value_type*>;
+            using reference = conditional_t<_Const, const value_type&, value_type&>;
+            using iterator_category = forward_iterator_tag;
+
+            pointer m_value;
+            ctrl_t* m_ctrl;
+            ctrl_t* m_end;
+
+            Iterator(pointer value, ctrl_t* ctrl, ctrl_t* end) :
+                m_value(value),
+                m_ctrl(ctrl),
+                m_end(end) {}
+            Iterator(const Iterator<_Ty, false>& rhs)
+            {
+                m_value = rhs.m_value;
+                m_ctrl = rhs.m_ctrl;
+                m_end = rhs.m_end;
+            }
+            reference operator*() const
+            {
+                return *m_value;
+            }
+            pointer operator->() const
+            {
+                return m_value;
+            }
+            Iterator& operator++()
+            {
+                do
+                {
+                    ++m_value;
+                    ++m_ctrl;
+                } while ((m_ctrl != m_end) && !is_full(*m_ctrl));
+                return *this;
+            }
+            Iterator operator++(int)
+            {
+                Iterator temp(*this);
+                ++*this;
+                return temp;
+            }
+            bool operator==(const Iterator& rhs) const
+            {
+                return m_ctrl == rhs.m_ctrl;
+            }
+            bool operator!=(const Iterator& rhs) const
+            {
+                return m_ctrl != rhs.m_ctrl;
+            }
+        };
+
+        //! Mixes bits of the hash code, so that hash functions that do not spread bits well (like identity
+        //! hashes for integers and pointers) still produce well-distributed slot indices and control bytes.
+        inline usize mix_hash(usize h)
+        {
+            constexpr u64 k = 0x9E3779B97F4A7C15ULL;
+#if defined(__SIZEOF_INT128__)
+            __uint128_t r = (__uint128_t)(u64)h * k;
+            return (usize)((u64)r ^ (u64)(r >> 64));
+#else
+            u64 r = (u64)h * k;
+            return (usize)(r ^ (r >> 32));
+#endif
+        }
+
+        constexpr usize MIN_CAPACITY = 16;
+        constexpr f32 INITIAL_LOAD_FACTOR = 0.875f;
+
+        template <typename _Kty,
+            typename _Vty,
+            typename _ExtractKey,                // MapExtractKey for FlatHashMap, SetExtractKey for FlatHashSet.
+            typename _Hash = hash<_Kty>,        // Used to hash the key value.
+            typename _KeyEqual = equal_to<_Kty>,
+            typename _Alloc = Allocator>    // Used to compare the element.
+        class HashTable
+        {
+        public:
+            using key_type = _Kty;
+            using value_type = _Vty;
+            using allocator_type = _Alloc;
+            using hasher = _Hash;
+            using key_equal = _KeyEqual;
+            using reference = value_type&;
+            using const_reference = const value_type&;
+            using pointer = value_type*;
+            using const_pointer = const value_type*;
+            using iterator = Iterator<value_type, false>;
+            using const_iterator = Iterator<value_type, true>;
+            using extract_key = _ExtractKey;
+
+            // -------------------- Begin of ABI compatible part --------------------
+
+            //! A pointer to the slot array.
+            OptionalPair<allocator_type, value_type*> m_allocator_and_slots;
+            //! A pointer to the control byte array. The array has `m_capacity + Group::WIDTH` bytes, the
+            //! last `Group::WIDTH` bytes are copies of the first `Group::WIDTH` bytes, so that groups can
+            //! be loaded from any slot without wrapping.
+            ctrl_t* m_ctrl;
+            //! The number of slots, which is always zero or one power of two not smaller than `MIN_CAPACITY`.
+            usize m_capacity;
+            //! The number of elements in the hash table.
+            usize m_size;
+            //! The number of empty slots that can be filled before the table must be rehashed. Deleted slots
+            //! are not counted.
+            usize m_growth_left;
+            //! The maximum load factor of the table.
+            f32 m_max_load_factor;
+
+            // --------------------  End of ABI compatible part  --------------------
+
+        private:
+            template <typename _Ty>
+            _Ty* allocate(usize n)
+            {
+                return m_allocator_and_slots.first().template allocate<_Ty>(n);
+            }
+            template <typename _Ty>
+            void deallocate(_Ty* ptr, usize n)
+            {
+                m_allocator_and_slots.first().template deallocate<_Ty>(ptr, n);
+            }
+            value_type* slots() const
+            {
+                return m_allocator_and_slots.second();
+            }
+            //! Gets the maximum number of elements that can be stored in a table with `cap` slots.
+            //! At least one slot is always left empty so that probing always terminates.
+            usize growth_limit(usize cap) const
+            {
+                return min((usize)floorf(m_max_load_factor * (f32)cap), cap - 1);
+            }
+            usize capacity_for(usize n) const
+            {
+                usize cap = MIN_CAPACITY;
+                while (growth_limit(cap) < n) cap <<= 1;
+                return cap;
+            }
+            void set_ctrl(usize i, ctrl_t c)
+            {
+                m_ctrl[i] = c;
+                // Updates the cloned byte.
+                if (i < Group::WIDTH) m_ctrl[m_capacity + i] = c;
+            }
+            void reset_ctrl()
+            {
+                memset(m_ctrl, (u8)CTRL_EMPTY, m_capacity + Group::WIDTH);
+                m_growth_left = growth_limit(m_capacity) - m_size;
+            }
+            void internal_alloc_table(usize cap)
+            {
+                m_allocator_and_slots.second() = allocate<value_type>(cap);
+                m_ctrl = allocate<ctrl_t>(cap + Group::WIDTH);
+                m_capacity = cap;
+            }
+            void internal_free_table()
+            {
+                if (m_allocator_and_slots.second())
+                {
+                    deallocate<value_type>(m_allocator_and_slots.second(), m_capacity);
+                    deallocate<ctrl_t>(m_ctrl, m_capacity + Group::WIDTH);
+                    m_allocator_and_slots.second() = nullptr;
+                    m_ctrl = nullptr;
+                }
+            }
+            void internal_destruct_elements()
+            {
+                for (usize i = 0; i < m_capacity; ++i)
+                {
+                    if (is_full(m_ctrl[i])) (slots() + i)->~value_type();
+                }
+            }
+            void internal_clear_and_free_table()
+            {
+                internal_destruct_elements();
+                internal_free_table();
+                m_capacity = 0;
+                m_size = 0;
+                m_growth_left = 0;
+            }
+            //! Copies all elements and control bytes from `rhs`, which must have the same capacity as this table.
+            template <typename _Table, typename _ConstructFunc>
+            void internal_copy_table(_Table& rhs, _ConstructFunc construct_func)
+            {
+                internal_alloc_table(rhs.m_capacity);
+                memcpy(m_ctrl, rhs.m_ctrl, rhs.m_capacity + Group::WIDTH);
+                for (usize i = 0; i < rhs.m_capacity; ++i)
+                {
+                    if (is_full(rhs.m_ctrl[i])) construct_func(slots() + i, rhs.slots() + i);
+                }
+                m_size = rhs.m_size;
+                m_growth_left = rhs.m_growth_left;
+            }
+            usize hash_key(const key_type& key) const
+            {
+                return mix_hash(hasher()(key));
+            }
+            static u8 h2(usize h)
+            {
+                return (u8)(h & 0x7F);
+            }
+            usize probe_start(usize h) const
+            {
+                return (h >> 7) & (m_capacity - 1);
+            }
+            //! Finds the first empty or deleted slot for the specified hash.
+            usize find_first_non_full(usize h) const
+            {
+                usize mask = m_capacity - 1;
+                usize pos = probe_start(h);
+                usize step = 0;
+                while (true)
+                {
+                    Group g(m_ctrl + pos);
+                    auto m = g.match_empty_or_deleted();
+                    if (m) return (pos + m.lowest()) & mask;
+                    step += Group::WIDTH;
+                    pos = (pos + step) & mask;
+                }
+            }
+            void internal_rehash(usize new_cap)
+            {
+                value_type* old_slots = slots();
+                ctrl_t* old_ctrl = m_ctrl;
+                usize old_cap = m_capacity;
+                internal_alloc_table(new_cap);
+                reset_ctrl();
+                for (usize i = 0; i < old_cap; ++i)
+                {
+                    if (!is_full(old_ctrl[i])) continue;
+                    usize h = hash_key(extract_key()(old_slots[i]));
+                    usize pos = find_first_non_full(h);
+                    set_ctrl(pos, h2(h));
+                    copy_relocate(slots() + pos, old_slots + i);
+                }
+                if (old_slots)
+                {
+                    deallocate<value_type>(old_slots, old_cap);
+                    deallocate<ctrl_t>(old_ctrl, old_cap + Group::WIDTH);
+                }
+            }
+            //! Finds one slot to insert a new element with the specified hash, and rehashes the table if needed.
+            usize prepare_insert(usize h)
+            {
+                if (!m_capacity) internal_rehash(MIN_CAPACITY);
+                usize pos = find_first_non_full(h);
+                if (!m_growth_left && m_ctrl[pos] != CTRL_DELETED)
+                {
+                    // If enough slots are occupied by deleted slots, cleaning them is enough. Otherwise, grow the table.
+                    usize new_cap = (m_size * 8 <= growth_limit(m_capacity) * 7) ? m_capacity : m_capacity * 2;
+                    internal_rehash(new_cap);
+                    pos = find_first_non_full(h);
+                }
+                if (m_ctrl[pos] == CTRL_EMPTY) --m_growth_left;
+                set_ctrl(pos, h2(h));
+                ++m_size;
+                return pos;
+            }
+            usize internal_find(const key_type& key, usize h) const
+            {
+                if (!m_capacity) return USIZE_MAX;
+                usize mask = m_capacity - 1;
+                usize pos = probe_start(h);
+                usize step = 0;
+                u8 tag = h2(h);
+                while (true)
+                {
+                    Group g(m_ctrl + pos);
+                    for (auto m = g.match(tag); m; m.remove_lowest())
+                    {
+                        usize i = (pos + m.lowest()) & mask;
+                        if (key_equal()(key, extract_key()(slots()[i]))) return i;
+                    }
+                    if (g.match_empty()) return USIZE_MAX;
+                    step += Group::WIDTH;
+                    pos = (pos + step) & mask;
+                }
+            }
+            iterator make_iterator(usize i)
+            {
+                return iterator(slots() + i, m_ctrl + i, m_ctrl + m_capacity);
+            }
+            const_iterator make_iterator(usize i) const
+            {
+                return const_iterator(slots() + i, m_ctrl + i, m_ctrl + m_capacity);
+            }
+            template <typename... _Args>
+            iterator internal_insert(usize h, _Args&&... args)
+            {
+                // Constructs the value before rehashing, since arguments may refer to elements in the table.
+                Unconstructed<value_type> value;
+                value.construct(forward<_Args>(args)...);
+                usize pos = prepare_insert(h);
+                copy_relocate(slots() + pos, &(value.get()));
+                return make_iterator(pos);
+            }
+        public:
+            bool empty() const
+            {
+                return m_size == 0;
+            }
+            usize size() const
+            {
+                return m_size;
+            }
+            usize hash_table_size() const
+            {
+                return m_capacity;
+            }
+            f32 load_factor() const
+            {
+                if (!m_capacity)
+                {
+                    return 0.0f;
+                }
+                return (f32)m_size / (f32)m_capacity;
+            }
+            f32 max_load_factor() const
+            {
+                return m_max_load_factor;
+            }
+            void clear()
+            {
+                if (!m_capacity) return;
+                internal_destruct_elements();
+                m_size = 0;
+                reset_ctrl();
+            }
+            void shrink_to_fit()
+            {
+                if (!m_size)
+                {
+                    internal_clear_and_free_table();
+                    return;
+                }
+                rehash(0);
+            }
+            hasher hash_function() const
+            {
+                return hasher();
+            }
+            key_equal key_eq() const
+            {
+                return key_equal();
+            }
+            //! The number of elements this hash table can hold before next rehash.
+            usize capacity() const
+            {
+                return m_capacity ? growth_limit(m_capacity) : 0;
+            }
+            void rehash(usize new_buffer_size)
+            {
+                usize new_cap = capacity_for(m_size);
+                while (new_cap < new_buffer_size) new_cap <<= 1;
+                if (new_cap == m_capacity) return;
+                internal_rehash(new_cap);
+            }
+            void reserve(usize new_cap)
+            {
+                if (new_cap > capacity())
+                {
+                    internal_rehash(capacity_for(new_cap));
+                }
+            }
+            void max_load_factor(f32 ml)
+            {
+                lucheck(ml > 0.0f && ml <= 1.0f);
+                m_max_load_factor = ml;
+                if (m_capacity)
+                {
+                    if (m_size > growth_limit(m_capacity))
+                    {
+                        rehash(0);
+                    }
+                    else
+                    {
+                        // Rebuilds the table so that `m_growth_left` matches the new load factor.
+                        internal_rehash(m_capacity);
+                    }
+                }
+            }
+            HashTable() :
+                m_allocator_and_slots(allocator_type(), nullptr),
+                m_ctrl(nullptr),
+                m_capacity(0),
+                m_size(0),
+                m_growth_left(0),
+                m_max_load_factor(INITIAL_LOAD_FACTOR) {}
+            HashTable(const allocator_type& alloc) :
+                m_allocator_and_slots(alloc, nullptr),
+                m_ctrl(nullptr),
+                m_capacity(0),
+                m_size(0),
+                m_growth_left(0),
+                m_max_load_factor(INITIAL_LOAD_FACTOR) {}
+            HashTable(const HashTable& rhs) :
+                HashTable()
+            {
+                m_max_load_factor = rhs.m_max_load_factor;
+                if (!rhs.empty())
+                {
+                    internal_copy_table(rhs, [](value_type* dst, const value_type* src) { copy_construct(dst, src); });
+                }
+            }
+            HashTable(const HashTable& rhs, const allocator_type& alloc) :
+                HashTable(alloc)
+            {
+                m_max_load_factor = rhs.m_max_load_factor;
+                if (!rhs.empty())
+                {
+                    internal_copy_table(rhs, [](value_type* dst, const value_type* src) { copy_construct(dst, src); });
+                }
+            }
+            HashTable(HashTable&& rhs) :
+                m_allocator_and_slots(move(rhs.m_allocator_and_slots.first()), rhs.m_allocator_and_slots.second()),
+                m_ctrl(rhs.m_ctrl),
+                m_capacity(rhs.m_capacity),
+                m_size(rhs.m_size),
+                m_growth_left(rhs.m_growth_left),
+                m_max_load_factor(rhs.m_max_load_factor)
+            {
+                rhs.m_allocator_and_slots.second() = nullptr;
+                rhs.m_ctrl = nullptr;
+                rhs.m_capacity = 0;
+                rhs.m_size = 0;
+                rhs.m_growth_left = 0;
+            }
+            HashTable(HashTable&& rhs, const allocator_type& alloc) :
+                HashTable(alloc)
+            {
+                *this = move(rhs);
+            }
+            HashTable& operator=(const HashTable& rhs)
+            {
+                internal_clear_and_free_table();
+                m_max_load_factor = rhs.m_max_load_factor;
+                if (!rhs.empty())
+                {
+                    internal_copy_table(rhs, [](value_type* dst, const value_type* src) { copy_construct(dst, src); });
+                }
+                return *this;
+            }
+            HashTable& operator=(HashTable&& rhs)
+            {
+                internal_clear_and_free_table();
+                m_max_load_factor = rhs.m_max_load_factor;
+                if (m_allocator_and_slots.first() == rhs.m_allocator_and_slots.first())
+                {
+                    m_allocator_and_slots.second() = rhs.m_allocator_and_slots.second();
+                    m_ctrl = rhs.m_ctrl;
+                    m_capacity = rhs.m_capacity;
+                    m_size = rhs.m_size;
+                    m_growth_left = rhs.m_growth_left;
+                    rhs.m_allocator_and_slots.second() = nullptr;
+                    rhs.m_ctrl = nullptr;
+                    rhs.m_capacity = 0;
+                    rhs.m_size = 0;
+                    rhs.m_growth_left = 0;
+                }
+                else if (!rhs.empty())
+                {
+                    internal_copy_table(rhs, [](value_type* dst, value_type* src) { move_construct(dst, src); });
+                    rhs.clear();
+                }
+                return *this;
+            }
+            ~HashTable()
+            {
+                internal_clear_and_free_table();
+            }
+            iterator begin()
+            {
+                if (!m_capacity)
+                {
+                    return iterator(nullptr, nullptr, nullptr);
+                }
+                iterator i = make_iterator(0);
+                if (!is_full(m_ctrl[0])) ++i;
+                return i;
+            }
+            const_iterator begin() const
+            {
+                if (!m_capacity)
+                {
+                    return const_iterator(nullptr, nullptr, nullptr);
+                }
+                const_iterator i = make_iterator(0);
+                if (!is_full(m_ctrl[0])) ++i;
+                return i;
+            }
+            const_iterator cbegin() const
+            {
+                return begin();
+            }
+            iterator end()
+            {
+                if (!m_capacity)
+                {
+                    return iterator(nullptr, nullptr, nullptr);
+                }
+                return make_iterator(m_capacity);
+            }
+            const_iterator end() const
+            {
+                if (!m_capacity)
+                {
+                    return const_iterator(nullptr, nullptr, nullptr);
+                }
+                return make_iterator(m_capacity);
+            }
+            const_iterator cend() const
+            {
+                return end();
+            }
+            iterator find(const key_type& key)
+            {
+                usize i = internal_find(key, hash_key(key));
+                return i == USIZE_MAX ? end() : make_iterator(i);
+            }
+            const_iterator find(const key_type& key) const
+            {
+                usize i = internal_find(key, hash_key(key));
+                return i == USIZE_MAX ? end() : make_iterator(i);
+            }
+            usize count(const key_type& key) const
+            {
+                return contains(key) ? 1 : 0;
+            }
+            bool contains(const key_type& key) const
+            {
+                return internal_find(key, hash_key(key)) != USIZE_MAX;
+            }
+            Pair<iterator, bool> insert(const value_type& value)
+            {
+                usize h = hash_key(extract_key()(value));
+                usize i = internal_find(extract_key()(value), h);
+                if (i != USIZE_MAX)
+                {
+                    return make_pair(make_iterator(i), false);
+                }
+                return make_pair(internal_insert(h, value), true);
+            }
+            Pair<iterator, bool> insert(value_type&& value)
+            {
+                usize h = hash_key(extract_key()(value));
+                usize i = internal_find(extract_key()(value), h);
+                if (i != USIZE_MAX)
+                {
+                    return make_pair(make_iterator(i), false);
+                }
+                return make_pair(internal_insert(h, move(value)), true);
+            }
+            Pair<iterator, bool> insert_or_assign(const value_type& value)
+            {
+                usize h = hash_key(extract_key()(value));
+                usize i = internal_find(extract_key()(value), h);
+                if (i != USIZE_MAX)
+                {
+                    slots()[i] = value;
+                    return make_pair(make_iterator(i), false);
+                }
+                return make_pair(internal_insert(h, value), true);
+            }
+            Pair<iterator, bool> insert_or_assign(value_type&& value)
+            {
+                usize h = hash_key(extract_key()(value));
+                usize i = internal_find(extract_key()(value), h);
+                if (i != USIZE_MAX)
+                {
+                    slots()[i] = move(value);
+                    return make_pair(make_iterator(i), false);
+                }
+                return make_pair(internal_insert(h, move(value)), true);
+            }
+            template <typename _M>
+            Pair<iterator, bool> insert_or_assign(const key_type& key, _M&& value)
+            {
+                usize h = hash_key(key);
+                usize i = internal_find(key, h);
+                if (i != USIZE_MAX)
+                {
+                    slots()[i].second = forward<_M>(value);
+                    return make_pair(make_iterator(i), false);
+                }
+                return make_pair(internal_insert(h, key, forward<_M>(value)), true);
+            }
+            template <typename _M>
+            Pair<iterator, bool> insert_or_assign(key_type&& key, _M&& value)
+            {
+                usize h = hash_key(key);
+                usize i = internal_find(key, h);
+                if (i != USIZE_MAX)
+                {
+                    slots()[i].second = forward<_M>(value);
+                    return make_pair(make_iterator(i), false);
+                }
+                return make_pair(internal_insert(h, move(key), forward<_M>(value)), true);
+            }
+            template <typename... _Args>
+            Pair<iterator, bool> emplace(_Args&&... args)
+            {
+                Unconstructed<value_type> value;
+                value.construct(forward<_Args>(args)...);
+                usize h = hash_key(extract_key()(value.get()));
+                usize i = internal_find(extract_key()(value.get()), h);
+                if (i != USIZE_MAX)
+                {
+                    value.destruct();
+                    return make_pair(make_iterator(i), false);
+                }
+                usize pos = prepare_insert(h);
+                copy_relocate(slots() + pos, &(value.get()));
+                return make_pair(make_iterator(pos), true);
+            }
+            iterator erase(const_iterator pos)
+            {
+                usize i = pos.m_ctrl - m_ctrl;
+                destruct(slots() + i);
+                --m_size;
+                // If the slot is not inside one full group in any probe sequence, no search could have
+                // passed it, so it can be marked as empty instead of deleted.
+                usize index_before = (i - Group::WIDTH) & (m_capacity - 1);
+                auto empty_after = Group(m_ctrl + i).match_empty();
+                auto empty_before = Group(m_ctrl + index_before).match_empty();
+                bool was_never_full = empty_before && empty_after &&
+                    (empty_after.trailing_zeros() + empty_before.leading_zeros()) < Group::WIDTH;
+                if (was_never_full)
+                {
+                    set_ctrl(i, CTRL_EMPTY);
+                    ++m_growth_left;
+                }
+                else
+                {
+                    set_ctrl(i, CTRL_DELETED);
+                }
+                iterator r = make_iterator(i);
+                ++r;
+                return r;
+            }
+            usize erase(const key_type& key)
+            {
+                usize i = internal_find(key, hash_key(key));
+                if (i != USIZE_MAX)
+                {
+                    erase(make_iterator(i));
+                    return 1;
+                }
+                return 0;
+            }
+            allocator_type get_allocator() const
+            {
+                return m_allocator_and_slots.first();
+            }
+        };
+    }
+}
@@ -0,0 +1,50 @@
+/*!
+* This file is a portion of LunaSDK.
+* For conditions of distribution and use, see the disclaimer
+* and license in LICENSE.txt
+*
+* @file LockProfiler.hpp
+* @author JXMaster
+* @date 2026/10/18
+* @brief Hooks used by locks to record contention when the lock profiler is enabled.
+*/
+#pragma once
+#include "Base.hpp"
+
+#ifndef LUNA_RUNTIME_API
+#define LUNA_RUNTIME_API
+#endif
+
+#if defined(LUNA_ENABLE_LOCK_PROFILER)
+#define LUNA_LOCK_PROFILER_ENABLED
+#endif
+
+namespace Luna
+{
+    //! @addtogroup RuntimeProfiler
+    //! @{
+
+    //! The handle of one lock profiler site, which collects contention statistics of all locks with the same name.
+    using lock_profiler_site_t = opaque_t;
+
+    //! Gets the lock profiler site with the specified name, and creates the site if it does not exist.
+    //! @details Sites are never destroyed, and can be fetched before LunaSDK is initialized, so that global locks can be profiled.
+    //! Locks fetch their sites when they are acquired for the first time, so users usually do not need to call this directly.
+    //! @param[in] name The name of the lock. The string must be valid until LunaSDK is closed, so string literals are
+    //! usually used.
+    //! @return Returns the handle of the site. Returns `nullptr` if `name` is `nullptr`, or if the number of sites reaches the limit.
+    LUNA_RUNTIME_API lock_profiler_site_t get_lock_profiler_site(const c8* name);
+
+    //! Records one lock acquisition.
+    //! @param[in] site The site of the lock. If this is `nullptr`, this function does nothing.
+    //! @param[in] wait_ticks The time, in ticks, that the thread waited for the lock.
+    //! @param[in] contended Whether the lock was owned by another thread when the thread tried to acquire it.
+    LUNA_RUNTIME_API void lock_profiler_record_acquire(lock_profiler_site_t site, u64 wait_ticks, bool contended);
+
+    //! Records one lock release.
+    //! @param[in] site The site of the lock. If this is `nullptr`, this function does nothing.
+    //! @param[in] hold_ticks The time, in ticks, that the thread held the lock.
+    LUNA_RUNTIME_API void lock_profiler_record_release(lock_profiler_site_t site, u64 hold_ticks);
+
+    //! @}
+}
@@ -26,6 +26,21 @@ namespace Luna
     //! @addtogroup RuntimeMemory
     //! @{
 
+    //! Specifies the heap allocator that serves @ref memalloc, @ref memfree, @ref memrealloc and @ref memsize.
+    //! @details The heap allocator is selected by @ref InitDesc::heap_allocator when LunaSDK is initialized.
+    //! Memory blocks allocated by one allocator can always be freed after the allocator is changed.
+    enum class HeapAllocatorType : u8
+    {
+        //! Forwards all allocations to the system heap. This is the default heap allocator.
+        system = 0,
+        //! Serves small allocations from size class spans through per-thread caches, 
+        //! and forwards large allocations to the system heap.
+        size_class = 1,
+    };
+
+    //! Gets the heap allocator currently used by @ref memalloc.
+    LUNA_RUNTIME_API HeapAllocatorType get_heap_allocator_type();
+
     //! Allocates heap memory.
     //! @param[in] size The size, in bytes, of the memory block to allocate. If this is `0`, no memory will be allocated.
     //! @param[in] alignment Optional. The alignment requirement, in bytes, of the memory block to allocate. Default is `0`.
@@ -76,6 +91,83 @@ namespace Luna
     //! * If `ptr` is not `nullptr`, `alignment` **must** be equal to `alignment` passed to @ref memalloc or @ref memrealloc which allocates `ptr`.
     LUNA_RUNTIME_API usize memsize(void* ptr, usize alignment = 0);
 
+    //! Allocates heap memory that is backed by huge pages if possible.
+    //! @details Huge pages reduce TLB misses when large buffers are accessed sequentially. This function maps the memory
+    //! directly from the system, and tries to use huge pages reserved explicitly from the system (like `MAP_HUGETLB` on Linux and
+    //! `MEM_LARGE_PAGES` on Windows) first. If explicit huge pages are not available, the memory is mapped from normal pages and
+    //! advised to be backed by transparent huge pages if the platform supports them. The returned memory is freed by @ref memfree
+    //! and can be resized by @ref memrealloc.
+    //!
+    //! Use this function for large long-lived buffers. For small allocations, most of the huge page will be wasted.
+    //! @param[in] size The size, in bytes, of the memory block to allocate. If this is `0`, no memory will be allocated.
+    //! @param[in] alignment Optional. The alignment requirement, in bytes, of the memory block to allocate. Default is `0`.
+    //! @return Returns one pointer to the allocated memory block.
+    //! Returns `nullptr` if memory allocation failed or if `size` is `0`.
+    //! @par Valid Usage
+    //! * If `alignment` is not `0`, `alignment` **must** be powers of 2 (like 32, 64, 128, 256, etc).
+    LUNA_RUNTIME_API void* memalloc_huge_pages(usize size, usize alignment = 0);
+
+    //! Sets the size threshold for @ref memalloc to map memory blocks directly from the system and advise them to be backed
+    //! by transparent huge pages.
+    //! @details The initial threshold is specified by @ref InitDesc::huge_page_threshold.
+    //! @param[in] threshold The size threshold in bytes. Allocations whose sizes are not smaller than this are mapped directly.
+    //! Specify `0` to disable this behavior. This has no effect if the platform does not support huge pages.
+    LUNA_RUNTIME_API void set_huge_page_threshold(usize threshold);
+
+    //! Gets the size threshold for @ref memalloc to map memory blocks directly from the system.
+    //! @return Returns the size threshold in bytes, or `0` if this behavior is disabled or the platform does not support huge pages.
+    LUNA_RUNTIME_API usize get_huge_page_threshold();
+
+    //! Describes memory blocks that are mapped directly from the system by @ref memalloc_huge_pages and by @ref memalloc
+    //! for allocations larger than the huge page threshold.
+    struct HugePageStats
+    {
+        //! The size, in bytes, of one huge page of the platform, or `0` if the platform does not support huge pages.
+        usize huge_page_size;
+        //! The number of live mapped blocks.
+        usize num_blocks;
+        //! The total size, in bytes, of all live mapped blocks.
+        usize mapped_bytes;
+        //! The total size, in bytes, of live mapped blocks that are advised to be backed by transparent huge pages.
+        //! The system may still back some parts of these blocks with normal pages.
+        usize transparent_huge_page_bytes;
+        //! The total size, in bytes, of live mapped blocks that are backed by huge pages reserved explicitly from the system.
+        usize explicit_huge_page_bytes;
+    };
+
+    //! Gets statistics of memory blocks that are mapped directly from the system for huge pages.
+    LUNA_RUNTIME_API HugePageStats get_huge_page_stats();
+
+    //! The number of size buckets in @ref MemoryStats::size_histogram.
+    constexpr u32 NUM_MEMORY_STATS_SIZE_BUCKETS = 24;
+
+    //! Describes heap memory allocated by @ref memalloc, @ref memrealloc and @ref memalloc_huge_pages.
+    //! @details Sizes are measured by sizes returned by @ref memsize, which may be larger than sizes requested by the user.
+    struct MemoryStats
+    {
+        //! The number of bytes currently allocated.
+        usize allocated_bytes;
+        //! The maximum number of bytes allocated at the same time since the program starts.
+        //! @details This is tracked with one granularity of 64KB per thread, and may be slightly smaller than the actual peak.
+        usize peak_allocated_bytes;
+        //! The total number of memory blocks allocated since the program starts. Blocks moved by @ref memrealloc are counted as new blocks.
+        u64 num_allocations;
+        //! The total number of memory blocks freed since the program starts. Blocks moved by @ref memrealloc are counted as freed blocks.
+        u64 num_frees;
+        //! The number of blocks allocated since the program starts, grouped by block size. Bucket 0 counts blocks not
+        //! larger than 16 bytes, bucket `i` counts blocks larger than `2^(i + 3)` bytes and not larger than `2^(i + 4)` bytes,
+        //! and the last bucket also counts all larger blocks.
+        u64 size_histogram[NUM_MEMORY_STATS_SIZE_BUCKETS];
+    };
+
+    //! Gets statistics of heap memory.
+    //! @details Statistics are always collected regardless of whether `LUNA_MEMORY_PROFILER_ENABLED` is defined. Every thread counts its allocations
+    //! in thread-local counters, which are merged when this function is called, so collecting statistics adds little overhead
+    //! to allocations, and this function can be called periodically to export telemetry data.
+    //!
+    //! Since counters are read while other threads may be allocating, the returned values are not one exact snapshot of one time point.
+    LUNA_RUNTIME_API MemoryStats get_memory_stats();
+
     //! Allocates heap memory for one object and constructs the object.
     //! @return Returns one pointer to the allocated object.
     //! Returns `nullptr` if memory allocation failed.
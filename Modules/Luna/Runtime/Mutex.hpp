@@ -43,8 +43,11 @@ namespace Luna
     };
 
     //! Creates a new mutex object.
+    //! @param[in] name Optional. The name used by the lock profiler to collect contention statistics of this mutex. 
+    //! The string must be valid until LunaSDK is closed. Mutexes with the same name share one set of statistics.
+    //! The name is ignored if `LUNA_LOCK_PROFILER_ENABLED` is not defined.
     //! @return Returns the new created mutex object.
-    LUNA_RUNTIME_API Ref<IMutex> new_mutex();
+    LUNA_RUNTIME_API Ref<IMutex> new_mutex(const c8* name = nullptr);
 
     //! A RAII wrapper for one mutex object that releases the mutex automatically when the wrapper is 
     //! destructed.
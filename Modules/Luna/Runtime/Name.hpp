@@ -11,6 +11,8 @@
 #pragma once
 #include "String.hpp"
 #include "Functional.hpp"
+#include "Hash.hpp"
+#include "Atomic.hpp"
 
 #ifndef LUNA_RUNTIME_API
 #define LUNA_RUNTIME_API
@@ -57,9 +59,42 @@ namespace Luna
     //! 
     //! For each call to @ref intern_name, one call to @ref release_name is needed to finally release the internal name string block.
     //! 
+    //! Name strings are stored in multiple shards selected by name IDs, and every shard is protected by its own lock, so
+    //! threads that intern different names seldom block each other.
+    //! 
     //! For end user, prefer using @ref Name objects instead of calling these APIs directly.
     LUNA_RUNTIME_API const c8* intern_name(const c8* name, usize count);
 
+    //! Describes one name string literal whose size and ID are computed at compile time.
+    //! @details Name literals are usually created by @ref luname, which also caches the interned name for every call site.
+    struct NameLiteral
+    {
+        //! The name string.
+        const c8* str;
+        //! The number of characters in the name string, excluding the null terminator.
+        usize size;
+        //! The ID of the name string, which is equal to the ID returned by @ref get_name_id for the interned name.
+        name_id_t id;
+
+        //! Constructs one name literal from one null-terminated string.
+        //! @param[in] s The name string.
+        explicit constexpr NameLiteral(const c8* s) :
+            str(s),
+            size(0),
+            id((name_id_t)strwyhash64(s))
+        {
+            while (s[size]) ++size;
+        }
+    };
+
+    //! Interns one name literal to the runtime and fetches the interned address for it.
+    //! @details This behaves the same as @ref intern_name, but uses the ID computed at compile time instead of
+    //! hashing the string again.
+    //! @param[in] literal The name literal to intern.
+    //! @return Returns the interned address for the name string. If `literal.size` is `0`, the returned address is `nullptr`
+    //! and the memory block is not interned.
+    LUNA_RUNTIME_API const c8* intern_name(const NameLiteral& literal);
+
     //! Increases the reference count of the name string by 1.
     //! @param[in] name The pointer of the string. If this is `nullptr`, this call does nothing.
     //! @par Valid Usage
@@ -92,6 +127,8 @@ namespace Luna
     //! * If `name` is not `nullptr`, it must be a string pointer returned by @ref intern_name.
     LUNA_RUNTIME_API usize get_name_size(const c8* name);
 
+    class NameLiteralCache;
+
     //! Represents one name string.
     //! @details The name string is one constant string that is mainly used to identify entities in LunaSDK. Name strings 
     //! are reference counted and managed by system, all @ref Name objects containing the same name string will refer the same name
@@ -100,6 +137,7 @@ namespace Luna
     class Name
     {
     private:
+        friend class NameLiteralCache;
         const c8* m_str;
     public:
         //! Constructs one empty name.
@@ -116,6 +154,10 @@ namespace Luna
         //! @param[in] count The number of characters in the string used to create the name.
         Name(const c8* name, usize count) :
             m_str(intern_name(name, count)) {}
+        //! Constructs one name with the provided name literal.
+        //! @param[in] literal The name literal.
+        Name(const NameLiteral& literal) :
+            m_str(intern_name(literal)) {}
         //! Constructs one name from one string.
         //! @param[in] str The name string.
         Name(const String& str) :
@@ -224,6 +266,66 @@ namespace Luna
         }
     };
 
+    //! Interns the name literal and stores the interned name to the name literal cache if the cache is empty.
+    //! @details This is called by @ref NameLiteralCache::get, and should not be called directly.
+    //! @param[in] cache The cache to refresh.
+    //! @param[in] literal The name literal to intern.
+    LUNA_RUNTIME_API void refresh_name_literal_cache(NameLiteralCache* cache, const NameLiteral& literal);
+
+    //! Caches the interned name of one name literal for one @ref luname call site.
+    //! @details All caches are reset when LunaSDK is closed, and the name is interned again when the cache is used after
+    //! LunaSDK is initialized again, so that the cached name never refers to name strings freed by the previous name table.
+    //! The cached name is not released when the cache is destroyed, since all name strings are freed when LunaSDK is closed.
+    //! @par Valid Usage
+    //! * Name literal caches must have static storage duration.
+    class NameLiteralCache
+    {
+    public:
+        union
+        {
+            Name m_name;
+        };
+        NameLiteralCache* m_next;
+        bool m_registered;
+
+        NameLiteralCache() :
+            m_name(),
+            m_next(nullptr),
+            m_registered(false) {}
+        ~NameLiteralCache() {}
+        //! Gets the cached name, and interns the name literal if the cache is empty.
+        //! @param[in] literal The name literal to intern.
+        //! @return Returns one constant reference to the cached name.
+        const Name& get(const NameLiteral& literal)
+        {
+            // Pairs with the release store in `publish`, so that the name string is visible if the pointer is not `nullptr`.
+            if (!atom_load_acquire_pointer(&m_name.m_str))
+            {
+                refresh_name_literal_cache(this, literal);
+            }
+            return m_name;
+        }
+        //! Stores one interned name to the cache, the cache takes over the reference of the name.
+        //! @details This is called by @ref refresh_name_literal_cache, and should not be called directly.
+        //! @param[in] str The interned name string.
+        void publish(const c8* str)
+        {
+            atom_store_release_pointer(&m_name.m_str, (void*)str);
+        }
+    };
+
+    //! Gets one @ref Name for one string literal.
+    //! @details The ID of the string is computed at compile time, and the string is interned only once when the call site is
+    //! executed for the first time. The interned name is stored in one @ref NameLiteralCache of the call site, so later executions
+    //! only check whether the cache is empty and return the cached name. Use this for names that are looked up frequently, 
+    //! like names of resources and properties. The returned reference is valid until LunaSDK is closed.
+    //! @param[in] _str The name string. This must be one string literal.
+    //! @return Returns one constant reference to the @ref Name object.
+    #define luname(_str) ([]() -> const ::Luna::Name& { \
+        static constexpr ::Luna::NameLiteral luna_name_literal_(_str); \
+        static ::Luna::NameLiteralCache luna_name_cache_; \
+        return luna_name_cache_.get(luna_name_literal_); }())
+
     template <> struct hash<Name>
     {
         usize operator()(const Name& val) const { return static_cast<usize>(val.id()); }
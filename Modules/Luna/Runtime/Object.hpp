@@ -53,6 +53,54 @@ namespace Luna
         return register_struct_type(desc);
     }
 
+    //! Enables pooled allocation for boxed objects of the specified type.
+    //! @details Memory blocks of pooled objects are not freed when the objects are destroyed (both strong and weak reference
+    //! counts reach zero). Instead, they are cached in one per-type, per-thread free list, and reused by the next 
+    //! @ref object_alloc call for the same type on the same thread. This avoids heap allocations for short-lived objects
+    //! that are created and destroyed frequently.
+    //! 
+    //! When one thread caches more than `max_cached_objects_per_thread` blocks for one type, half of them are moved to 
+    //! one central list shared by all threads, and blocks that exceed the central list capacity are freed. 
+    //! 
+    //! Pooling cannot be disabled once enabled.
+    //! @param[in] type The type to enable pooling for.
+    //! @param[in] max_cached_objects_per_thread The maximum number of blocks cached by one thread for this type.
+    //! @return Returns `true` if pooling is enabled for the type. Returns `false` if the maximum number of pools is reached,
+    //! in which case objects of the type are still allocated from the heap.
+    //! @par Valid Usage
+    //! * No object of `type` should be alive when this function is called.
+    LUNA_RUNTIME_API bool enable_object_pool(typeinfo_t type, u32 max_cached_objects_per_thread = 64);
+
+    //! Registers one type so that it can be used for creating boxed objects, and enables pooled allocation for the type.
+    //! See @ref register_boxed_type and @ref enable_object_pool for details.
+    //! @param[in] max_cached_objects_per_thread The maximum number of blocks cached by one thread for this type.
+    template <typename _Ty>
+    typeinfo_t register_pooled_boxed_type(u32 max_cached_objects_per_thread = 64)
+    {
+        typeinfo_t type = register_boxed_type<_Ty>();
+        enable_object_pool(type, max_cached_objects_per_thread);
+        return type;
+    }
+
+    //! Describes the occupancy of one object pool.
+    struct ObjectPoolStats
+    {
+        //! The number of alive objects allocated from the pool.
+        usize live_objects;
+        //! The number of blocks cached by the pool that can be reused for new objects.
+        usize cached_objects;
+        //! The number of allocations that allocate new blocks from the heap.
+        u64 heap_allocations;
+        //! The number of allocations that reuse cached blocks.
+        u64 reused_allocations;
+    };
+
+    //! Gets statistics of the object pool of the specified type.
+    //! @param[in] type The type to query.
+    //! @param[out] out_stats The statistics of the object pool.
+    //! @return Returns `true` if the type is pooled and `out_stats` is written. Returns `false` otherwise.
+    LUNA_RUNTIME_API bool get_object_pool_stats(typeinfo_t type, ObjectPoolStats& out_stats);
+
     //! Allocates one boxed object.
     //! @param[in] type The type of the object to allocate.
     //! @return Returns one pointer to the allocated object.
@@ -10,6 +10,7 @@
 #pragma once
 #include "Name.hpp"
 #include "Vector.hpp"
+#include "InlineVector.hpp"
 #include "Memory.hpp"
 #include <Luna/Runtime/StackAllocator.hpp>
 
@@ -143,7 +144,7 @@ namespace Luna
     //! responsibility to check it before using it.
     class Path
     {
-        Vector<Name> m_nodes;
+        InlineVector<Name, 8> m_nodes;
         Name m_root;
         PathFlag m_flags;
 
@@ -448,12 +449,11 @@ namespace Luna
             }
             m_flags = PathFlag::none;
             m_root = base.root();
-            auto dd = Name("..");
+            const Name& dd = luname("..");
             for (usize i = diff_begin; i < base.size(); ++i)
             {
                 m_nodes.push_back(dd);
             }
-            dd = nullptr;
             for (usize i = diff_begin; i < target.size(); ++i)
             {
                 m_nodes.push_back(target[i]);
@@ -877,13 +877,13 @@ namespace Luna
             if (m_root)
             {
                 id = m_root.id();
-                h = memhash<usize>(&id, sizeof(u64), h);
-                h = strhash<usize>("://", h);// To deferent "A://B" from "/A/B"
+                h = (usize)wyhash64(&id, sizeof(u64), h);
+                h = (usize)wyhash64("://", 3, h);// To deferent "A://B" from "/A/B"
             }
             for (auto& i : m_nodes)
             {
                 id = i.id();
-                h = memhash<usize>(&id, sizeof(u64), h);
+                h = (usize)wyhash64(&id, sizeof(u64), h);
             }
             return h;
         }
@@ -10,6 +10,9 @@
 #pragma once
 #include "Functional.hpp"
 #include "Name.hpp"
+#include "String.hpp"
+#include "Result.hpp"
+#include "Vector.hpp"
 
 #ifndef LUNA_RUNTIME_API
 #define LUNA_RUNTIME_API
@@ -19,6 +22,14 @@
 #define LUNA_MEMORY_PROFILER_ENABLED
 #endif
 
+#if (defined(LUNA_ENABLE_CPU_PROFILER) || (LUNA_DEBUG_LEVEL >= LUNA_DEBUG_LEVEL_PROFILE))
+#define LUNA_CPU_PROFILER_ENABLED
+#endif
+
+#if defined(LUNA_ENABLE_PROFILER_COUNTERS)
+#define LUNA_PROFILER_COUNTERS_ENABLED
+#endif
+
 namespace Luna
 {
     struct IThread;
@@ -45,6 +56,9 @@ namespace Luna
     };
 
     //! Allocates one temporary buffer that can be used to store event data for the next profiler event.
+    //! @details The buffer is allocated inline in the profiler event ring buffer of the current thread, so the 
+    //! data is copied to the collector thread without additional memory allocations. If the ring buffer is full, the 
+    //! buffer is allocated from scratch memory, and the next event will be dropped.
     //! @param[in] size The size to allocate in bytes.
     //! @param[in] alignment The alignment requirement of the allocated memory in bytes. This can be `0`, indicating
     //! that no alignment requirement is specified.
@@ -74,20 +88,59 @@ namespace Luna
     }
 
     //! Submits one profiler event.
+    //! @details Events are recorded to one lock-free ring buffer owned by the submitting thread together with the timestamp 
+    //! and the data allocated by @ref allocate_profiler_event_data, and are dispatched to profiler callbacks asynchronously
+    //! by one background collector thread. Events are dispatched in timestamp order of events visible to the collector
+    //! at the same time, and events submitted by the same thread are always dispatched in submission order.
+    //!
+    //! Events are not recorded if no profiler callback is registered. If the ring buffer of the current thread is full,
+    //! the event is dropped and counted in @ref ProfilerEventStats::num_dropped_events. The size of the ring buffer is 
+    //! specified by @ref InitDesc::profiler_event_buffer_size.
     //! @param[in] event_id The ID of the event to set.
     LUNA_RUNTIME_API void submit_profiler_event(u64 event_id);
 
     using on_profiler_event_t = void(const ProfilerEvent& event);
 
     //! Registers one profiler callback function.
+    //! @details Profiler callbacks are called by the collector thread, or by threads that call @ref flush_profiler_events.
+    //! Callbacks are never called concurrently. Events submitted before the callback is registered are not delivered to the
+    //! callback. Data of events are only valid in the callback, since memory blocks or objects referred by events may already
+    //! be freed when the event is dispatched, callbacks should not access them.
+    //! 
+    //! If this is called in one profiler callback, the new callback is registered after all events of the current dispatch
+    //! are delivered to existing callbacks.
     //! @param[in] handler The callback function object to register.
     //! @return Returns one handle that can be used to unregister the callback function.
     LUNA_RUNTIME_API usize register_profiler_callback(const Function<on_profiler_event_t>& handler);
     //! Unregisters one profiler callback function.
+    //! @details The callback function will not be called after this function returns. If this is called in one profiler callback,
+    //! the callback is unregistered after all events of the current dispatch are delivered, so the callback may still be called
+    //! for remaining events of the current dispatch.
+    //! Events that are submitted but not dispatched yet are not delivered to the callback, call @ref flush_profiler_events
+    //! before this if such events are required.
     //! @param[in] handler_id The handler that returned by @ref register_profiler_callback for the callback function 
     //! to unregister. 
     LUNA_RUNTIME_API void unregister_profiler_callback(usize handler_id);
 
+    //! Dispatches all profiler events submitted before this call to profiler callbacks on the current thread, and waits
+    //! until they are dispatched.
+    //! @details This does nothing if called in one profiler callback.
+    LUNA_RUNTIME_API void flush_profiler_events();
+
+    //! Describes the number of profiler events processed by the profiler.
+    struct ProfilerEventStats
+    {
+        //! The number of events recorded to ring buffers.
+        u64 num_submitted_events;
+        //! The number of events dropped because ring buffers are full.
+        u64 num_dropped_events;
+        //! The number of events dispatched to profiler callbacks.
+        u64 num_dispatched_events;
+    };
+
+    //! Gets the number of profiler events processed by the profiler since LunaSDK is initialized.
+    LUNA_RUNTIME_API ProfilerEventStats get_profiler_event_stats();
+
     namespace ProfilerEventId
     {
         //! The memory allocation event ID.
@@ -100,7 +153,42 @@ namespace Luna
         constexpr u64 SET_MEMORY_TYPE = strhash64("SET_MEMORY_TYPE");
         //! The set memory domain event ID.
         constexpr u64 SET_MEMORY_DOMAIN = strhash64("SET_MEMORY_DOMAIN");
+        //! The CPU scope begin event ID.
+        constexpr u64 CPU_SCOPE_BEGIN = strhash64("CPU_SCOPE_BEGIN");
+        //! The CPU scope end event ID.
+        constexpr u64 CPU_SCOPE_END = strhash64("CPU_SCOPE_END");
+        //! The set thread name event ID.
+        constexpr u64 SET_THREAD_NAME = strhash64("SET_THREAD_NAME");
+        //! The counter value event ID.
+        constexpr u64 COUNTER_VALUE = strhash64("COUNTER_VALUE");
     }
+
+    //! Specifies how values of one profiler counter channel are interpreted.
+    enum class ProfilerCounterType : u8
+    {
+        //! The value accumulates the total amount of one quantity, like the number of executed jobs or loaded bytes.
+        //! Counters are usually updated by @ref profiler_counter_add, and are summarized by their changes between snapshots.
+        counter = 0,
+        //! The value measures the current level of one quantity, like the queue depth or the number of live entities.
+        //! Gauges are summarized by their current, minimum and maximum values between snapshots.
+        gauge = 1,
+    };
+
+    //! Describes one static source location that is profiled.
+    //! @details Source locations are usually declared as static variables by @ref luprofile_scope, so profiler events
+    //! only need to store pointers to them.
+    struct ProfilerSourceLocation
+    {
+        //! The name of the profiled scope.
+        const c8* name;
+        //! The name of the function that contains the profiled scope.
+        const c8* function;
+        //! The name of the source file that contains the profiled scope.
+        const c8* file;
+        //! The line number of the profiled scope in the source file.
+        u32 line;
+    };
+
     namespace ProfilerEventData
     {
         //! The memory allocation event data.
@@ -116,6 +204,8 @@ namespace Luna
         {
             //! The memory pointer.
             void* ptr;
+            //! The size of the memory, or `0` if the size is not specified.
+            usize size;
         };
         //! The set memory name event data.
         struct SetMemoryName
@@ -152,6 +242,37 @@ namespace Luna
             //! so long as this structure is valid.
             const c8 domain[1];
         };
+        //! The CPU scope begin event data.
+        struct CpuScopeBegin
+        {
+            //! The source location of the scope.
+            const ProfilerSourceLocation* location;
+        };
+        //! The CPU scope end event data.
+        struct CpuScopeEnd
+        {
+            //! The source location of the scope.
+            const ProfilerSourceLocation* location;
+        };
+        //! The set thread name event data.
+        struct SetThreadName
+        {
+            //! The name of the thread that submits this event.
+            //! The string buffer is allocated along with this structure, and can be
+            //! referred directly by referring this property. The string buffer is valid 
+            //! so long as this structure is valid.
+            const c8 name[1];
+        };
+        //! The counter value event data.
+        struct CounterValue
+        {
+            //! The interned name of the counter channel, which is valid until LunaSDK is closed.
+            const c8* name;
+            //! The value of the channel after the update.
+            f64 value;
+            //! The type of the channel.
+            ProfilerCounterType type;
+        };
     }
 
 #ifdef LUNA_MEMORY_PROFILER_ENABLED
@@ -165,9 +286,11 @@ namespace Luna
 
     //! Emits one @ref PROFILER_EVENT_ID_MEMORY_DEALLOCATE profiler event.
     //! @param[in] ptr The registered memory pointer.
+    //! @param[in] size The size of the memory block, in bytes. Since events are dispatched asynchronously, callbacks cannot query the size of the 
+    //! memory block when the event is dispatched, so the size should be provided if known.
     //! @remark Memory deallocations through `memfree` call this internally when memory profiling is enabled, thus the user does not
     //! need to call this again.
-    LUNA_RUNTIME_API void memory_profiler_deallocate(void* ptr);
+    LUNA_RUNTIME_API void memory_profiler_deallocate(void* ptr, usize size = 0);
 
     //! Sets a debug name for the memory block, for example, the name of the resource file this memory block is allocated for. 
     //! This function emits one @ref PROFILER_EVENT_ID_SET_MEMORY_NAME profiler event.
@@ -194,5 +317,217 @@ namespace Luna
     LUNA_RUNTIME_API void memory_profiler_set_memory_domain(void* ptr, const c8* domain, usize str_size = USIZE_MAX);
 #endif
 
+    //! Emits one @ref ProfilerEventId::CPU_SCOPE_BEGIN profiler event on the current thread.
+    //! @param[in] location The source location of the scope. The location must be valid until the program exits.
+    //! @remark Use @ref luprofile_scope or @ref luprofile_function instead of calling this directly, so that
+    //! the scope is always ended and the event can be removed when CPU profiling is disabled.
+    LUNA_RUNTIME_API void cpu_profiler_begin_scope(const ProfilerSourceLocation* location);
+
+    //! Emits one @ref ProfilerEventId::CPU_SCOPE_END profiler event on the current thread.
+    //! @param[in] location The source location passed to the matching @ref cpu_profiler_begin_scope call.
+    LUNA_RUNTIME_API void cpu_profiler_end_scope(const ProfilerSourceLocation* location);
+
+    //! Sets the name of the current thread shown in profiling tools.
+    //! @details This function emits one @ref ProfilerEventId::SET_THREAD_NAME profiler event, and records the name so that
+    //! traces captured later can also show the name.
+    //! @param[in] name The name of the current thread.
+    //! @param[in] str_size The size of the name, not including the null terminator. If this is `USIZE_MAX`, the size is determined by the system
+    //! using @ref strlen.
+    LUNA_RUNTIME_API void set_profiler_thread_name(const c8* name, usize str_size = USIZE_MAX);
+
+    //! Begins one CPU scope on construction and ends the scope on destruction.
+    struct CpuProfilerScope
+    {
+        const ProfilerSourceLocation* m_location;
+
+        CpuProfilerScope(const ProfilerSourceLocation* location) :
+            m_location(location)
+        {
+            cpu_profiler_begin_scope(location);
+        }
+        ~CpuProfilerScope()
+        {
+            cpu_profiler_end_scope(m_location);
+        }
+    };
+
+    //! The handle of one profiler counter channel.
+    using profiler_counter_t = opaque_t;
+
+    //! Gets the profiler counter channel with the specified name, and creates the channel if it does not exist.
+    //! @details Channels are interned by names and are never destroyed until LunaSDK is closed, so subsystems usually fetch the
+    //! channel handle once when they are initialized and store it for later use. The initial value of one new channel is `0`.
+    //! @param[in] name The name of the channel. Use `/` to group channels by subsystems, like `JobSystem/Queued Jobs`.
+    //! @param[in] type The type of the channel. If the channel already exists, this is ignored and the type specified
+    //! when the channel is created is used.
+    //! @return Returns the handle of the channel. Returns `nullptr` if `name` is empty.
+    LUNA_RUNTIME_API profiler_counter_t get_profiler_counter(const Name& name, ProfilerCounterType type);
+
+    //! Adds one value to the profiler counter channel.
+    //! @details The value is updated atomically, so this can be called from multiple threads concurrently.
+    //! One @ref ProfilerEventId::COUNTER_VALUE event with the new value is emitted if the profiler is recording.
+    //!
+    //! Every call updates the shared channel atomically, so hot paths should use @ref luprofile_counter_add instead, which
+    //! is compiled out unless `LUNA_PROFILER_COUNTERS_ENABLED` is defined.
+    //! @param[in] counter The channel to update. If this is `nullptr`, this function does nothing.
+    //! @param[in] delta The value to add. This can be negative.
+    LUNA_RUNTIME_API void profiler_counter_add(profiler_counter_t counter, f64 delta);
+
+    //! Sets the value of the profiler counter channel.
+    //! @details One @ref ProfilerEventId::COUNTER_VALUE event with the new value is emitted if the profiler is recording.
+    //! @param[in] counter The channel to update. If this is `nullptr`, this function does nothing.
+    //! @param[in] value The value to set.
+    LUNA_RUNTIME_API void profiler_counter_set(profiler_counter_t counter, f64 value);
+
+    //! Gets the current value of the profiler counter channel.
+    //! @param[in] counter The channel to query.
+    //! @return Returns the current value of the channel. Returns `0` if `counter` is `nullptr`.
+    LUNA_RUNTIME_API f64 get_profiler_counter_value(profiler_counter_t counter);
+
+    //! Describes one profiler counter channel in one @ref ProfilerMetricsSnapshot.
+    struct ProfilerCounterMetrics
+    {
+        //! The name of the channel.
+        Name name;
+        //! The type of the channel.
+        ProfilerCounterType type;
+        //! The value of the channel when the snapshot is taken.
+        f64 value;
+        //! The minimum value of the channel since the last snapshot, including the value when the last snapshot is taken.
+        //! @details If the channel has never been updated, this is the current value of the channel.
+        f64 min_value;
+        //! The maximum value of the channel since the last snapshot, including the value when the last snapshot is taken.
+        //! @details If the channel has never been updated, this is the current value of the channel.
+        f64 max_value;
+        //! The value changed since the last snapshot.
+        f64 delta;
+        //! The number of updates since the last snapshot.
+        u64 num_updates;
+    };
+
+    //! Summarizes all profiler counter channels in one time interval.
+    struct ProfilerMetricsSnapshot
+    {
+        //! The length, in seconds, of the time interval since the last snapshot, or since the first channel is created if
+        //! this is the first snapshot.
+        f64 interval;
+        //! Metrics of all channels, in the order that channels are created.
+        Vector<ProfilerCounterMetrics> counters;
+    };
+
+    //! Takes one metrics snapshot of all profiler counter channels, and starts a new time interval.
+    //! @details This function is intended to be called periodically, for example, once per second, to export telemetry data
+    //! or to display load of subsystems. Channels are updated while the snapshot is taken, so the returned values are not one
+    //! exact snapshot of one time point.
+    //!
+    //! The `Memory/Allocated Bytes` gauge is updated by the runtime with @ref MemoryStats::allocated_bytes before the snapshot
+    //! is taken, and periodically when the profiler is recording.
+    LUNA_RUNTIME_API ProfilerMetricsSnapshot take_profiler_metrics_snapshot();
+
+    //! The number of wait time buckets in @ref LockContentionStats::wait_time_histogram.
+    constexpr u32 NUM_LOCK_WAIT_TIME_BUCKETS = 16;
+
+    //! Describes contention of all locks with the same name.
+    //! @details Statistics are collected only for named locks, and only if `LUNA_LOCK_PROFILER_ENABLED` is defined, which is
+    //! enabled by the `lock_profiler` build option. Locks are named by @ref SpinLock::SpinLock(const c8*),
+    //! @ref RecursiveSpinLock::RecursiveSpinLock(const c8*), @ref new_mutex and @ref new_read_write_lock.
+    struct LockContentionStats
+    {
+        //! The name of the lock.
+        const c8* name;
+        //! The number of times the lock is acquired. Recursive acquisitions of the same lock from the owning thread are counted once.
+        u64 num_acquires;
+        //! The number of acquisitions that waited for the lock because the lock was owned by other threads.
+        u64 num_contended_acquires;
+        //! The total time, in seconds, that threads waited for the lock.
+        f64 total_wait_time;
+        //! The maximum time, in seconds, that one thread waited for the lock.
+        f64 max_wait_time;
+        //! The total time, in seconds, that threads held the lock. Read ownerships of read write locks are not counted.
+        f64 total_hold_time;
+        //! The maximum time, in seconds, that one thread held the lock.
+        f64 max_hold_time;
+        //! The number of contended acquisitions grouped by wait time. Bucket 0 counts waits shorter than 1 microsecond,
+        //! bucket `i` counts waits not shorter than `2^(i - 1)` microseconds and shorter than `2^i` microseconds,
+        //! and the last bucket also counts all longer waits.
+        u64 wait_time_histogram[NUM_LOCK_WAIT_TIME_BUCKETS];
+    };
+
+    //! Gets contention statistics of named locks, sorted by the total wait time in descending order.
+    //! @details Statistics are accumulated since the program starts or since @ref reset_lock_contention_stats is called.
+    //! Locks that have not been acquired are not reported.
+    //! @param[in] max_count Optional. The maximum number of locks to report. Specify this to get only the most contended locks.
+    //! @return Returns statistics of locks.
+    LUNA_RUNTIME_API Vector<LockContentionStats> get_lock_contention_stats(usize max_count = USIZE_MAX);
+
+    //! Resets contention statistics of all named locks to zero.
+    LUNA_RUNTIME_API void reset_lock_contention_stats();
+
+    //! Starts capturing CPU scope events and counter values of all threads for one trace.
+    //! @details Captured events can be encoded to one Chrome trace JSON file by @ref end_trace_capture, which
+    //! can be opened by `chrome://tracing` and [Perfetto UI](https://ui.perfetto.dev). Current values of all profiler counter
+    //! channels are recorded when the capture begins, so that every counter track starts with one value.
+    //! Calling this function when capturing is already started discards all captured events.
+    LUNA_RUNTIME_API void begin_trace_capture();
+
+    //! Checks whether one trace is being captured.
+    LUNA_RUNTIME_API bool is_trace_capturing();
+
+    //! Stops capturing the trace, and encodes captured events to Chrome trace JSON format.
+    //! @details The output object has the following layout:
+    //! ```json
+    //! {
+    //!     "displayTimeUnit" : "ms",
+    //!     "traceEvents" : [
+    //!         { "name" : "thread_name", "ph" : "M", "pid" : 1, "tid" : 1, "args" : { "name" : "..." } },
+    //!         { "name" : "...", "cat" : "cpu", "ph" : "B", "ts" : 0.000, "pid" : 1, "tid" : 1, 
+    //!           "args" : { "function" : "...", "file" : "...", "line" : 1 } },
+    //!         { "ph" : "E", "ts" : 1.000, "pid" : 1, "tid" : 1 },
+    //!         { "name" : "...", "ph" : "C", "ts" : 1.000, "pid" : 1, "args" : { "value" : 1 } }
+    //!     ],
+    //!     "otherData" : {
+    //!         "lockContention" : [
+    //!             { "name" : "...", "acquires" : 1, "contendedAcquires" : 1, "totalWaitUs" : 1.000, "maxWaitUs" : 1.000,
+    //!               "totalHoldUs" : 1.000, "maxHoldUs" : 1.000, "waitHistogram" : [ 0, 1, ... ] }
+    //!         ]
+    //!     }
+    //! }
+    //! ```
+    //! Timestamps are in microseconds since @ref begin_trace_capture is called. `otherData` is written only if named locks
+    //! have been acquired, and lists at most 16 most contended locks returned by @ref get_lock_contention_stats. Note that lock 
+    //! statistics are accumulated since the program starts or since @ref reset_lock_contention_stats is called, not only during the capture.
+    //! @return Returns the encoded JSON string. Returns one trace with no event if capturing is not started.
+    LUNA_RUNTIME_API String end_trace_capture();
+
+    //! Stops capturing the trace, and writes captured events to one Chrome trace JSON file.
+    //! @param[in] path The path of the file to write. The file will be created if it does not exist, or overwritten if it exists.
+    LUNA_RUNTIME_API RV end_trace_capture(const c8* path);
+
     //! @}
-}
\ No newline at end of file
+}
+
+#ifdef LUNA_CPU_PROFILER_ENABLED
+#define luna_profile_concat_(_a, _b) _a##_b
+#define luna_profile_concat(_a, _b) luna_profile_concat_(_a, _b)
+//! Profiles the rest of the current scope as one CPU scope with the specified name.
+//! @details This macro expands to nothing if `LUNA_CPU_PROFILER_ENABLED` is not defined.
+//! @param[in] _name The name of the scope. This must be one string literal.
+#define luprofile_scope(_name) static const Luna::ProfilerSourceLocation luna_profile_concat(_luna_profile_location_, __LINE__) = \
+    { _name, __FUNCTION__, __FILE__, (Luna::u32)__LINE__ }; \
+    Luna::CpuProfilerScope luna_profile_concat(_luna_profile_scope_, __LINE__)(&luna_profile_concat(_luna_profile_location_, __LINE__));
+//! Profiles the rest of the current scope as one CPU scope named by the current function.
+//! @details This macro expands to nothing if `LUNA_CPU_PROFILER_ENABLED` is not defined.
+#define luprofile_function() luprofile_scope(__FUNCTION__)
+#else
+#define luprofile_scope(_name)
+#define luprofile_function()
+#endif
+
+#ifdef LUNA_PROFILER_COUNTERS_ENABLED
+//! Adds one value to the profiler counter channel by calling @ref Luna::profiler_counter_add.
+//! @details This macro expands to nothing if `LUNA_PROFILER_COUNTERS_ENABLED` is not defined, and the arguments are not
+//! evaluated in such case.
+#define luprofile_counter_add(_counter, _delta) Luna::profiler_counter_add(_counter, _delta)
+#else
+#define luprofile_counter_add(_counter, _delta) ((void)0)
+#endif
@@ -52,8 +52,13 @@ namespace Luna
     };
 
     //! Creates one new read write lock.
+    //! @param[in] name Optional. The name used by the lock profiler to collect contention statistics of this lock. 
+    //! The string must be valid until LunaSDK is closed. Locks with the same name share one set of statistics.
+    //! The name is ignored if `LUNA_LOCK_PROFILER_ENABLED` is not defined.
+    //! @details Only write ownerships are recorded with hold times, since read ownerships can be held by multiple threads
+    //! at the same time.
     //! @return Returns the created read write lock.
-    LUNA_RUNTIME_API Ref<IReadWriteLock> new_read_write_lock();
+    LUNA_RUNTIME_API Ref<IReadWriteLock> new_read_write_lock(const c8* name = nullptr);
 
     //! @}
 }
\ No newline at end of file
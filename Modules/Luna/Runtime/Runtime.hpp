@@ -10,6 +10,7 @@
 */
 #pragma once
 #include "Result.hpp"
+#include "Memory.hpp"
 
 #ifndef LUNA_RUNTIME_API
 #define LUNA_RUNTIME_API
@@ -28,13 +29,30 @@ namespace Luna
     //! @addtogroup RuntimeInit
     //! @{
 
+    //! Describes how LunaSDK should be initialized.
+    struct InitDesc
+    {
+        //! The heap allocator used by @ref memalloc, @ref memfree, @ref memrealloc and @ref memsize.
+        //! @details Defaults to @ref HeapAllocatorType::system. Specify @ref HeapAllocatorType::size_class to serve small 
+        //! allocations from per-thread caches, which is faster for allocation-heavy workloads but keeps freed small blocks 
+        //! cached by LunaSDK instead of returning them to the system heap.
+        HeapAllocatorType heap_allocator = HeapAllocatorType::system;
+        //! The size threshold, in bytes, for @ref memalloc to map memory blocks directly from the system and advise them to be
+        //! backed by transparent huge pages. Specify `0` to disable this behavior. See @ref set_huge_page_threshold for details.
+        usize huge_page_threshold = 4_mb;
+        //! The size, in bytes, of the ring buffer that stores profiler events submitted by one thread. The size is rounded up to
+        //! powers of 2. Events submitted when the buffer is full are dropped. See @ref submit_profiler_event for details.
+        usize profiler_event_buffer_size = 256_kb;
+    };
+
     //! Initializes LunaSDK.
+    //! @param[in] desc The initialization options.
     //! @details Call this function to initialize LunaSDK. Most features provided by LunaSDK are only available after LunaSDK is initialized, 
     //! so always initialize LunaSDK firstly on program startup. Calling this function when LunaSDK is already initialized does nothing and returns `true` directly.
     //! 
     //! Note that modules registered to LunaSDK will not be initialized by this function, they should be initialized manually using functions like @ref init_modules.
     //! @return Returns `true` if LunaSDK is succssfully initialized, returns `false` otherwise.
-    LUNA_RUNTIME_API bool init();
+    LUNA_RUNTIME_API bool init(const InitDesc& desc = InitDesc());
 
     //! Checks whether LunaSDK is initialized.
     //! @return Returns `true` if LunaSDK is initialized. Returns `false` otherwise.
@@ -0,0 +1,324 @@
+/*!
+* This file is a portion of LunaSDK.
+* For conditions of distribution and use, see the disclaimer
+* and license in LICENSE.txt
+*
+* @file AllocationProfiler.cpp
+* @author JXMaster
+* @date 2026/10/18
+*/
+#include "../PlatformDefines.hpp"
+#define LUNA_RUNTIME_API LUNA_EXPORT
+#include "AllocationProfiler.hpp"
+#include "OS.hpp"
+#include "../Atomic.hpp"
+#include "../SpinLock.hpp"
+#include "../HashMap.hpp"
+#include "../Algorithm.hpp"
+#include "JSONWriter.hpp"
+#include <cmath>
+
+namespace Luna
+{
+    usize g_allocation_sampling_interval = 0;
+    usize g_num_allocation_samples = 0;
+    u32 g_allocation_sample_filter[ALLOCATION_SAMPLE_FILTER_SIZE];
+    thread_local isize tls_allocation_bytes_until_sample = 0;
+
+    static thread_local u64 tls_allocation_sampler_seed = 0;
+    // Set when the current thread is recording samples or capturing profiles, so that allocations made by
+    // the profiler itself are not sampled.
+    static thread_local bool tls_allocation_sampler_busy = false;
+
+    // Sampled blocks are stored in tables sharded by address, so that threads that free sampled blocks
+    // allocated by other threads do not contend on one lock.
+    constexpr usize NUM_ALLOCATION_SAMPLE_SHARDS = 16;
+    struct AllocationSampleShard
+    {
+        SpinLock m_lock;
+        HashMap<usize, AllocationSampleRecord, hash<usize>, equal_to<usize>, OSAllocator> m_records;
+    };
+    AllocationSampleShard g_allocation_sample_shards[NUM_ALLOCATION_SAMPLE_SHARDS];
+
+    inline AllocationSampleShard& get_allocation_sample_shard(const void* ptr)
+    {
+        return g_allocation_sample_shards[((usize)ptr >> 4) % NUM_ALLOCATION_SAMPLE_SHARDS];
+    }
+
+    // Draws the number of bytes to the next sample from one exponential distribution, so every byte has the
+    // same probability of being sampled regardless of the allocation pattern.
+    static isize next_sample_distance(usize interval)
+    {
+        u64& s = tls_allocation_sampler_seed;
+        if(!s) s = ((u64)(usize)&s ^ OS::get_ticks()) | 1;
+        s ^= s >> 12;
+        s ^= s << 25;
+        s ^= s >> 27;
+        u64 r = s * 2685821657736338717ULL;
+        f64 u = (f64)((r >> 11) + 1) / 9007199254740992.0;
+        f64 d = -std::log(u) * (f64)interval;
+        return (isize)min<f64>(d, (f64)interval * 64.0) + 1;
+    }
+
+    void allocation_profiler_sample(void* ptr, usize size)
+    {
+        usize interval = g_allocation_sampling_interval;
+        if(!interval) return;
+        if(!tls_allocation_sampler_seed)
+        {
+            // This is the first allocation on this thread, draw the first distance.
+            tls_allocation_bytes_until_sample += next_sample_distance(interval);
+            if(tls_allocation_bytes_until_sample >= 0) return;
+        }
+        tls_allocation_bytes_until_sample = next_sample_distance(interval);
+        if(tls_allocation_sampler_busy) return;
+        tls_allocation_sampler_busy = true;
+        AllocationSampleRecord record;
+        record.size = size;
+        record.interval = interval;
+        record.num_frames = OS::stack_backtrace(Span<opaque_t>(record.frames, MAX_ALLOCATION_SAMPLE_FRAMES));
+        AllocationSampleRecord old_record;
+        auto& shard = get_allocation_sample_shard(ptr);
+        {
+            LockGuard guard(shard.m_lock);
+            auto iter = shard.m_records.find((usize)ptr);
+            if(iter != shard.m_records.end())
+            {
+                // The old record is destroyed out of the lock, since releasing names may free memory.
+                old_record = move(iter->second);
+                iter->second = move(record);
+            }
+            else
+            {
+                shard.m_records.insert(make_pair((usize)ptr, move(record)));
+                atom_inc_u32(&g_allocation_sample_filter[allocation_sample_filter_index(ptr)]);
+                atom_inc_usize(&g_num_allocation_samples);
+            }
+        }
+        tls_allocation_sampler_busy = false;
+    }
+    bool allocation_profiler_remove_sample(void* ptr, AllocationSampleRecord* out_record)
+    {
+        // Declared before the lock guard, so the record is destroyed out of the lock.
+        AllocationSampleRecord record;
+        {
+            auto& shard = get_allocation_sample_shard(ptr);
+            LockGuard guard(shard.m_lock);
+            auto iter = shard.m_records.find((usize)ptr);
+            if(iter == shard.m_records.end()) return false;
+            record = move(iter->second);
+            shard.m_records.erase(iter);
+            atom_dec_u32(&g_allocation_sample_filter[allocation_sample_filter_index(ptr)]);
+            atom_dec_usize(&g_num_allocation_samples);
+        }
+        if(out_record) *out_record = move(record);
+        return true;
+    }
+    void allocation_profiler_restore_sample(void* ptr, AllocationSampleRecord&& record)
+    {
+        AllocationSampleRecord old_record;
+        auto& shard = get_allocation_sample_shard(ptr);
+        LockGuard guard(shard.m_lock);
+        auto iter = shard.m_records.find((usize)ptr);
+        if(iter != shard.m_records.end())
+        {
+            old_record = move(iter->second);
+            iter->second = move(record);
+        }
+        else
+        {
+            shard.m_records.insert(make_pair((usize)ptr, move(record)));
+            atom_inc_u32(&g_allocation_sample_filter[allocation_sample_filter_index(ptr)]);
+            atom_inc_usize(&g_num_allocation_samples);
+        }
+    }
+#ifdef LUNA_MEMORY_PROFILER_ENABLED
+    static void set_sample_name(void* ptr, const c8* str, usize str_size, bool domain)
+    {
+        if(!g_num_allocation_samples || !g_allocation_sample_filter[allocation_sample_filter_index(ptr)]) return;
+        // Declared before the lock guard, so the old name is released out of the lock.
+        Name name(str, str_size);
+        auto& shard = get_allocation_sample_shard(ptr);
+        LockGuard guard(shard.m_lock);
+        auto iter = shard.m_records.find((usize)ptr);
+        if(iter == shard.m_records.end()) return;
+        Name& dst = domain ? iter->second.domain : iter->second.type;
+        Name old_name = move(dst);
+        dst = move(name);
+        name = move(old_name);
+    }
+    void allocation_profiler_set_memory_type(void* ptr, const c8* type, usize str_size)
+    {
+        set_sample_name(ptr, type, str_size, false);
+    }
+    void allocation_profiler_set_memory_domain(void* ptr, const c8* domain, usize str_size)
+    {
+        set_sample_name(ptr, domain, str_size, true);
+    }
+#endif
+    void allocation_profiler_init()
+    {
+        memzero(g_allocation_sample_filter, sizeof(g_allocation_sample_filter));
+    }
+    void allocation_profiler_close()
+    {
+        g_allocation_sampling_interval = 0;
+        // Stops tracking first, since releasing names in records may free memory.
+        g_num_allocation_samples = 0;
+        memzero(g_allocation_sample_filter, sizeof(g_allocation_sample_filter));
+        // Names stored in records must be released before the name table is closed.
+        for(auto& shard : g_allocation_sample_shards)
+        {
+            shard.m_records.clear();
+            shard.m_records.shrink_to_fit();
+        }
+    }
+    LUNA_RUNTIME_API void set_allocation_sampling_interval(usize interval)
+    {
+        atom_exchange_usize(&g_allocation_sampling_interval, interval);
+    }
+    LUNA_RUNTIME_API usize get_allocation_sampling_interval()
+    {
+        return g_allocation_sampling_interval;
+    }
+    static void sort_allocation_sites(Vector<AllocationSite>& sites)
+    {
+        sort(sites.begin(), sites.end(), [](const AllocationSite& lhs, const AllocationSite& rhs) { return lhs.bytes > rhs.bytes; });
+    }
+    LUNA_RUNTIME_API AllocationProfile capture_allocation_profile()
+    {
+        bool busy = tls_allocation_sampler_busy;
+        tls_allocation_sampler_busy = true;
+        AllocationProfile profile;
+        profile.sampling_interval = g_allocation_sampling_interval;
+        profile.timestamp = OS::get_ticks();
+        {
+            Vector<AllocationSampleRecord, OSAllocator> records;
+            for(auto& shard : g_allocation_sample_shards)
+            {
+                LockGuard guard(shard.m_lock);
+                for(auto& i : shard.m_records) records.push_back(i.second);
+            }
+            HashMap<u64, usize> site_indices;
+            Vector<f64> site_bytes;
+            Vector<f64> site_counts;
+            for(auto& record : records)
+            {
+                u64 id = memhash64(record.frames, sizeof(opaque_t) * record.num_frames);
+                name_id_t type_id = record.type.id();
+                name_id_t domain_id = record.domain.id();
+                id = memhash64(&type_id, sizeof(name_id_t), id);
+                id = memhash64(&domain_id, sizeof(name_id_t), id);
+                auto iter = site_indices.find(id);
+                usize index;
+                if(iter == site_indices.end())
+                {
+                    index = profile.sites.size();
+                    site_indices.insert(make_pair(id, index));
+                    AllocationSite site;
+                    site.id = id;
+                    site.frames.assign(Span<opaque_t>(record.frames, record.num_frames));
+                    site.type = record.type;
+                    site.domain = record.domain;
+                    profile.sites.push_back(move(site));
+                    site_bytes.push_back(0.0);
+                    site_counts.push_back(0.0);
+                }
+                else
+                {
+                    index = iter->second;
+                }
+                // One block of `size` bytes is sampled with probability `1 - exp(-size / interval)`.
+                f64 probability = 1.0 - std::exp(-(f64)record.size / (f64)record.interval);
+                f64 weight = probability > 0.0 ? 1.0 / probability : 1.0;
+                site_bytes[index] += (f64)record.size * weight;
+                site_counts[index] += weight;
+                ++profile.sites[index].samples;
+            }
+            for(usize i = 0; i < profile.sites.size(); ++i)
+            {
+                profile.sites[i].bytes = (i64)(site_bytes[i] + 0.5);
+                profile.sites[i].count = (i64)(site_counts[i] + 0.5);
+            }
+        }
+        sort_allocation_sites(profile.sites);
+        tls_allocation_sampler_busy = busy;
+        return profile;
+    }
+    LUNA_RUNTIME_API AllocationProfile diff_allocation_profiles(const AllocationProfile& base, const AllocationProfile& current)
+    {
+        AllocationProfile profile;
+        profile.sampling_interval = current.sampling_interval;
+        profile.timestamp = current.timestamp;
+        HashMap<u64, usize> base_indices;
+        for(usize i = 0; i < base.sites.size(); ++i)
+        {
+            base_indices.insert(make_pair(base.sites[i].id, i));
+        }
+        Vector<bool> base_matched(base.sites.size(), false);
+        for(auto& site : current.sites)
+        {
+            AllocationSite d = site;
+            auto iter = base_indices.find(site.id);
+            if(iter != base_indices.end())
+            {
+                auto& base_site = base.sites[iter->second];
+                d.bytes -= base_site.bytes;
+                d.count -= base_site.count;
+                d.samples -= base_site.samples;
+                base_matched[iter->second] = true;
+            }
+            if(d.bytes || d.count || d.samples) profile.sites.push_back(move(d));
+        }
+        for(usize i = 0; i < base.sites.size(); ++i)
+        {
+            if(base_matched[i]) continue;
+            AllocationSite d = base.sites[i];
+            d.bytes = -d.bytes;
+            d.count = -d.count;
+            d.samples = -d.samples;
+            profile.sites.push_back(move(d));
+        }
+        sort_allocation_sites(profile.sites);
+        return profile;
+    }
+    LUNA_RUNTIME_API String allocation_profile_to_json(const AllocationProfile& profile, bool resolve_symbols)
+    {
+        String r;
+        append_json_format(r, "{\"sampling_interval\":%llu,", (unsigned long long)profile.sampling_interval);
+        append_json_format(r, "\"timestamp\":%llu,\"sites\":[", (unsigned long long)profile.timestamp);
+        for(usize i = 0; i < profile.sites.size(); ++i)
+        {
+            auto& site = profile.sites[i];
+            if(i) r.push_back(',');
+            append_json_format(r, "{\"id\":\"0x%016llx\",\"type\":", (unsigned long long)site.id);
+            append_json_string(r, site.type.c_str());
+            r.append(",\"domain\":");
+            append_json_string(r, site.domain.c_str());
+            append_json_format(r, ",\"bytes\":%lld", (long long)site.bytes);
+            append_json_format(r, ",\"count\":%lld", (long long)site.count);
+            append_json_format(r, ",\"samples\":%lld,\"frames\":[", (long long)site.samples);
+            for(usize j = 0; j < site.frames.size(); ++j)
+            {
+                if(j) r.push_back(',');
+                append_json_format(r, "\"0x%016llx\"", (unsigned long long)(usize)site.frames[j]);
+            }
+            r.push_back(']');
+            if(resolve_symbols && !site.frames.empty())
+            {
+                r.append(",\"symbols\":[");
+                const c8** symbols = OS::stack_backtrace_symbols(Span<const opaque_t>(site.frames.data(), site.frames.size()));
+                for(usize j = 0; j < site.frames.size(); ++j)
+                {
+                    if(j) r.push_back(',');
+                    append_json_string(r, symbols ? symbols[j] : nullptr);
+                }
+                if(symbols) OS::free_backtrace_symbols(symbols);
+                r.push_back(']');
+            }
+            r.push_back('}');
+        }
+        r.append("]}");
+        return r;
+    }
+}
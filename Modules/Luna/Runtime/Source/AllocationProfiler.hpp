@@ -0,0 +1,78 @@
+/*!
+* This file is a portion of LunaSDK.
+* For conditions of distribution and use, see the disclaimer
+* and license in LICENSE.txt
+*
+* @file AllocationProfiler.hpp
+* @author JXMaster
+* @date 2026/10/18
+*/
+#pragma once
+#include "../AllocationProfiler.hpp"
+#include "../Profiler.hpp"
+
+namespace Luna
+{
+    void allocation_profiler_init();
+    void allocation_profiler_close();
+
+    // The number of slots in the sampled block filter.
+    constexpr usize ALLOCATION_SAMPLE_FILTER_SIZE = 4096;
+
+    // The sampling interval, `0` if sampling is disabled.
+    extern usize g_allocation_sampling_interval;
+    // The number of live sampled blocks.
+    extern usize g_num_allocation_samples;
+    // Counting filter of sampled blocks indexed by `allocation_sample_filter_index`. One slot is not zero if
+    // one sampled block may be mapped to the slot, so `memfree` can skip the sample table for most blocks.
+    extern u32 g_allocation_sample_filter[ALLOCATION_SAMPLE_FILTER_SIZE];
+    // The number of bytes to allocate before the next sample is taken on the current thread.
+    extern thread_local isize tls_allocation_bytes_until_sample;
+
+    struct AllocationSampleRecord
+    {
+        usize size;
+        usize interval;
+        u32 num_frames;
+        opaque_t frames[MAX_ALLOCATION_SAMPLE_FRAMES];
+        Name type;
+        Name domain;
+    };
+
+    void allocation_profiler_sample(void* ptr, usize size);
+    // Removes the sample of one block. If `out_record` is not `nullptr`, the removed record is moved to `out_record`.
+    // Returns `true` if the block is sampled.
+    bool allocation_profiler_remove_sample(void* ptr, AllocationSampleRecord* out_record = nullptr);
+    // Inserts one record removed by `allocation_profiler_remove_sample` back to the sample table.
+    void allocation_profiler_restore_sample(void* ptr, AllocationSampleRecord&& record);
+
+    inline usize allocation_sample_filter_index(const void* ptr)
+    {
+        return (usize)(((u64)(usize)ptr * 0x9E3779B97F4A7C15ULL) >> 52) & (ALLOCATION_SAMPLE_FILTER_SIZE - 1);
+    }
+    // Called by `memalloc` for every allocated block.
+    inline void allocation_profiler_allocate(void* ptr, usize size)
+    {
+        if(!g_allocation_sampling_interval) return;
+        tls_allocation_bytes_until_sample -= (isize)size;
+        if(tls_allocation_bytes_until_sample < 0) allocation_profiler_sample(ptr, size);
+    }
+    // Called by `memfree` for every freed block.
+    inline void allocation_profiler_deallocate(void* ptr)
+    {
+        if(!g_num_allocation_samples) return;
+        if(g_allocation_sample_filter[allocation_sample_filter_index(ptr)]) allocation_profiler_remove_sample(ptr);
+    }
+    // Called by `memrealloc` before the block is reallocated. The sample of the block is moved to `out_record`, so that
+    // it can be restored by `allocation_profiler_restore_sample` if reallocation fails. Returns `true` if the block is sampled.
+    inline bool allocation_profiler_detach(void* ptr, AllocationSampleRecord& out_record)
+    {
+        if(!g_num_allocation_samples) return false;
+        if(!g_allocation_sample_filter[allocation_sample_filter_index(ptr)]) return false;
+        return allocation_profiler_remove_sample(ptr, &out_record);
+    }
+#ifdef LUNA_MEMORY_PROFILER_ENABLED
+    void allocation_profiler_set_memory_type(void* ptr, const c8* type, usize str_size);
+    void allocation_profiler_set_memory_domain(void* ptr, const c8* domain, usize str_size);
+#endif
+}
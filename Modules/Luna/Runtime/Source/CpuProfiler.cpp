@@ -0,0 +1,259 @@
+/*!
+* This file is a portion of LunaSDK.
+* For conditions of distribution and use, see the disclaimer
+* and license in LICENSE.txt
+*
+* @file CpuProfiler.cpp
+* @author JXMaster
+* @date 2026/10/18
+*/
+#include "../PlatformDefines.hpp"
+#define LUNA_RUNTIME_API LUNA_EXPORT
+#include "Profiler.hpp"
+#include "OS.hpp"
+#include "../SpinLock.hpp"
+#include "../HashMap.hpp"
+#include "../Thread.hpp"
+#include "../Time.hpp"
+#include "../File.hpp"
+#include "JSONWriter.hpp"
+#include <stdio.h>
+
+namespace Luna
+{
+    // Names set by `set_profiler_thread_name`, so that traces captured after the names are set can still show them.
+    SpinLock g_profiler_thread_names_lock;
+    HashMap<IThread*, String, hash<IThread*>, equal_to<IThread*>, OSAllocator> g_profiler_thread_names;
+
+    enum class TraceEventType : u8
+    {
+        scope_begin,
+        scope_end,
+        counter,
+    };
+    struct TraceEventRecord
+    {
+        u64 timestamp;
+        IThread* thread;
+        // Valid for scope events.
+        const ProfilerSourceLocation* location;
+        // Valid for counter events.
+        const c8* counter_name;
+        f64 counter_value;
+        TraceEventType type;
+    };
+    SpinLock g_trace_capture_lock;
+    Vector<TraceEventRecord, OSAllocator> g_trace_events;
+    usize g_trace_capture_callback = USIZE_MAX;
+    u64 g_trace_capture_begin_ticks = 0;
+
+    void cpu_profiler_close()
+    {
+        if(g_trace_capture_callback != USIZE_MAX)
+        {
+            // Delivers events that are still buffered before stopping the capture.
+            flush_profiler_events();
+            unregister_profiler_callback(g_trace_capture_callback);
+            g_trace_capture_callback = USIZE_MAX;
+        }
+        g_trace_events.clear();
+        g_trace_events.shrink_to_fit();
+        g_profiler_thread_names.clear();
+        g_profiler_thread_names.shrink_to_fit();
+    }
+    LUNA_RUNTIME_API void cpu_profiler_begin_scope(const ProfilerSourceLocation* location)
+    {
+        ProfilerEventData::CpuScopeBegin* data = (ProfilerEventData::CpuScopeBegin*)allocate_profiler_event_data(
+            sizeof(ProfilerEventData::CpuScopeBegin), 
+            alignof(ProfilerEventData::CpuScopeBegin));
+        data->location = location;
+        submit_profiler_event(ProfilerEventId::CPU_SCOPE_BEGIN);
+    }
+    LUNA_RUNTIME_API void cpu_profiler_end_scope(const ProfilerSourceLocation* location)
+    {
+        ProfilerEventData::CpuScopeEnd* data = (ProfilerEventData::CpuScopeEnd*)allocate_profiler_event_data(
+            sizeof(ProfilerEventData::CpuScopeEnd), 
+            alignof(ProfilerEventData::CpuScopeEnd));
+        data->location = location;
+        submit_profiler_event(ProfilerEventId::CPU_SCOPE_END);
+    }
+    LUNA_RUNTIME_API void set_profiler_thread_name(const c8* name, usize str_size)
+    {
+        if(str_size == USIZE_MAX) str_size = strlen(name);
+        {
+            String thread_name(name, str_size);
+            LockGuard guard(g_profiler_thread_names_lock);
+            g_profiler_thread_names.insert_or_assign(get_current_thread(), move(thread_name));
+        }
+        usize sz = sizeof(ProfilerEventData::SetThreadName) + str_size; // One extra character is allocated in structure.
+        ProfilerEventData::SetThreadName* data = (ProfilerEventData::SetThreadName*)allocate_profiler_event_data(sz, alignof(ProfilerEventData::SetThreadName));
+        c8* dst = const_cast<c8*>(data->name);
+        memcpy(dst, name, str_size);
+        dst[str_size] = 0;
+        submit_profiler_event(ProfilerEventId::SET_THREAD_NAME);
+    }
+    static void trace_capture_callback(const ProfilerEvent& event)
+    {
+        TraceEventRecord record;
+        record.timestamp = event.timestamp;
+        record.thread = event.thread;
+        record.location = nullptr;
+        record.counter_name = nullptr;
+        record.counter_value = 0.0;
+        if(event.id == ProfilerEventId::CPU_SCOPE_BEGIN)
+        {
+            record.type = TraceEventType::scope_begin;
+            record.location = ((const ProfilerEventData::CpuScopeBegin*)event.data)->location;
+        }
+        else if(event.id == ProfilerEventId::CPU_SCOPE_END)
+        {
+            record.type = TraceEventType::scope_end;
+            record.location = ((const ProfilerEventData::CpuScopeEnd*)event.data)->location;
+        }
+        else if(event.id == ProfilerEventId::COUNTER_VALUE)
+        {
+            const ProfilerEventData::CounterValue* data = (const ProfilerEventData::CounterValue*)event.data;
+            record.type = TraceEventType::counter;
+            record.counter_name = data->name;
+            record.counter_value = data->value;
+        }
+        else return;
+        LockGuard guard(g_trace_capture_lock);
+        g_trace_events.push_back(record);
+    }
+    LUNA_RUNTIME_API void begin_trace_capture()
+    {
+        {
+            LockGuard guard(g_trace_capture_lock);
+            g_trace_events.clear();
+            g_trace_capture_begin_ticks = get_ticks();
+        }
+        if(g_trace_capture_callback == USIZE_MAX)
+        {
+            g_trace_capture_callback = register_profiler_callback(trace_capture_callback);
+        }
+        // Starts every counter track with the current value.
+        emit_profiler_counter_values();
+    }
+    LUNA_RUNTIME_API bool is_trace_capturing()
+    {
+        return g_trace_capture_callback != USIZE_MAX;
+    }
+    LUNA_RUNTIME_API String end_trace_capture()
+    {
+        if(g_trace_capture_callback != USIZE_MAX)
+        {
+            // Delivers events that are still buffered before stopping the capture.
+            flush_profiler_events();
+            unregister_profiler_callback(g_trace_capture_callback);
+            g_trace_capture_callback = USIZE_MAX;
+        }
+        Vector<TraceEventRecord, OSAllocator> events;
+        {
+            LockGuard guard(g_trace_capture_lock);
+            events = move(g_trace_events);
+        }
+        f64 us_per_tick = 1000000.0 / get_ticks_per_second();
+        // Threads are numbered in the order they appear in the trace.
+        HashMap<IThread*, u32> thread_ids;
+        String r;
+        r.append("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[");
+        bool first = true;
+        for(auto& e : events)
+        {
+            f64 ts = e.timestamp >= g_trace_capture_begin_ticks ? (f64)(e.timestamp - g_trace_capture_begin_ticks) * us_per_tick : 0.0;
+            if(e.type == TraceEventType::counter)
+            {
+                // Counter tracks belong to the process rather than threads.
+                if(!first) r.push_back(',');
+                first = false;
+                r.append("{\"name\":");
+                append_json_string(r, e.counter_name);
+                append_json_format(r, ",\"ph\":\"C\",\"ts\":%.3f,\"pid\":1,\"args\":{\"value\":%.17g}}", ts, e.counter_value);
+                continue;
+            }
+            u32 tid;
+            auto iter = thread_ids.find(e.thread);
+            if(iter == thread_ids.end())
+            {
+                tid = (u32)thread_ids.size() + 1;
+                thread_ids.insert(make_pair(e.thread, tid));
+                String name;
+                {
+                    LockGuard guard(g_profiler_thread_names_lock);
+                    auto name_iter = g_profiler_thread_names.find(e.thread);
+                    if(name_iter != g_profiler_thread_names.end()) name = name_iter->second;
+                }
+                if(name.empty())
+                {
+                    c8 buf[32];
+                    snprintf(buf, sizeof(buf), "Thread %u", tid);
+                    name = buf;
+                }
+                if(!first) r.push_back(',');
+                first = false;
+                append_json_format(r, "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":", tid);
+                append_json_string(r, name.c_str());
+                r.append("}}");
+            }
+            else
+            {
+                tid = iter->second;
+            }
+            if(!first) r.push_back(',');
+            first = false;
+            if(e.type == TraceEventType::scope_begin)
+            {
+                r.append("{\"name\":");
+                append_json_string(r, e.location->name);
+                append_json_format(r, ",\"cat\":\"cpu\",\"ph\":\"B\",\"ts\":%.3f,\"pid\":1,\"tid\":%u,\"args\":{\"function\":", ts, tid);
+                append_json_string(r, e.location->function);
+                r.append(",\"file\":");
+                append_json_string(r, e.location->file);
+                append_json_format(r, ",\"line\":%u}}", e.location->line);
+            }
+            else
+            {
+                append_json_format(r, "{\"ph\":\"E\",\"ts\":%.3f,\"pid\":1,\"tid\":%u}", ts, tid);
+            }
+        }
+        r.append("]");
+        // Reports the most contended locks, so that lock waits shown in the trace can be attributed to locks.
+        Vector<LockContentionStats> lock_stats = get_lock_contention_stats(16);
+        if(!lock_stats.empty())
+        {
+            r.append(",\"otherData\":{\"lockContention\":[");
+            for(usize i = 0; i < lock_stats.size(); ++i)
+            {
+                const LockContentionStats& s = lock_stats[i];
+                if(i) r.push_back(',');
+                r.append("{\"name\":");
+                append_json_string(r, s.name);
+                append_json_format(r, ",\"acquires\":%llu,\"contendedAcquires\":%llu", 
+                    (unsigned long long)s.num_acquires, (unsigned long long)s.num_contended_acquires);
+                append_json_format(r, ",\"totalWaitUs\":%.3f,\"maxWaitUs\":%.3f", s.total_wait_time * 1000000.0, s.max_wait_time * 1000000.0);
+                append_json_format(r, ",\"totalHoldUs\":%.3f,\"maxHoldUs\":%.3f", s.total_hold_time * 1000000.0, s.max_hold_time * 1000000.0);
+                r.append(",\"waitHistogram\":[");
+                for(u32 j = 0; j < NUM_LOCK_WAIT_TIME_BUCKETS; ++j)
+                {
+                    append_json_format(r, j ? ",%llu" : "%llu", (unsigned long long)s.wait_time_histogram[j]);
+                }
+                r.append("]}");
+            }
+            r.append("]}");
+        }
+        r.push_back('}');
+        return r;
+    }
+    LUNA_RUNTIME_API RV end_trace_capture(const c8* path)
+    {
+        String trace = end_trace_capture();
+        lutry
+        {
+            lulet(f, open_file(path, FileOpenFlag::write, FileCreationMode::create_always));
+            luexp(f->write(trace.data(), trace.size()));
+        }
+        lucatchret;
+        return ok;
+    }
+}
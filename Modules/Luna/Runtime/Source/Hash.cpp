@@ -0,0 +1,224 @@
+/*!
+* This file is a portion of LunaSDK.
+* For conditions of distribution and use, see the disclaimer
+* and license in LICENSE.txt
+*
+* @file Hash.cpp
+* @author JXMaster
+* @date 2026/10/18
+*/
+#include "../PlatformDefines.hpp"
+#define LUNA_RUNTIME_API LUNA_EXPORT
+#include "../Hash.hpp"
+
+#if defined(LUNA_PLATFORM_X86_64) || defined(LUNA_PLATFORM_X86)
+#define LUNA_CRC32C_SSE42
+#include <nmmintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#if defined(__GNUC__) || defined(__clang__)
+#define LUNA_CRC32C_TARGET __attribute__((target("sse4.2")))
+#endif
+#elif defined(LUNA_PLATFORM_ARM64)
+#define LUNA_CRC32C_ARMV8
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#else
+#include <arm_acle.h>
+#if defined(__clang__)
+#define LUNA_CRC32C_TARGET __attribute__((target("crc")))
+#else
+#define LUNA_CRC32C_TARGET __attribute__((target("+crc")))
+#endif
+#endif
+#if (defined(LUNA_PLATFORM_LINUX) || defined(LUNA_PLATFORM_ANDROID)) && !defined(__ARM_FEATURE_CRC32)
+#include <sys/auxv.h>
+#include <asm/hwcap.h>
+#endif
+#endif
+
+#ifndef LUNA_CRC32C_TARGET
+#define LUNA_CRC32C_TARGET
+#endif
+
+namespace Luna
+{
+    // The reflected polynomial of CRC-32C.
+    constexpr u32 CRC32C_POLY = 0x82F63B78;
+
+    // Tables for the slicing-by-8 software implementation. `v[k][i]` is the CRC of byte `i` followed by `k` zero bytes.
+    struct Crc32cTable
+    {
+        u32 v[8][256];
+
+        constexpr Crc32cTable() : v()
+        {
+            for (u32 i = 0; i < 256; ++i)
+            {
+                u32 crc = i;
+                for (u32 j = 0; j < 8; ++j)
+                {
+                    crc = (crc >> 1) ^ (CRC32C_POLY & (0 - (crc & 1)));
+                }
+                v[0][i] = crc;
+            }
+            for (u32 i = 0; i < 256; ++i)
+            {
+                for (u32 k = 1; k < 8; ++k)
+                {
+                    v[k][i] = (v[k - 1][i] >> 8) ^ v[0][v[k - 1][i] & 0xFF];
+                }
+            }
+        }
+    };
+
+    constexpr Crc32cTable g_crc32c_table;
+
+    static u32 crc32c_software(u32 crc, const u8* p, usize size)
+    {
+        auto& t = g_crc32c_table.v;
+#ifdef LUNA_PLATFORM_LITTLE_ENDIAN
+        while (size && ((usize)p & 7))
+        {
+            crc = t[0][(crc ^ *p) & 0xFF] ^ (crc >> 8);
+            ++p;
+            --size;
+        }
+        while (size >= 8)
+        {
+            u64 v;
+            memcpy(&v, p, sizeof(u64));
+            v ^= crc;
+            crc = t[7][v & 0xFF] ^ t[6][(v >> 8) & 0xFF] ^ t[5][(v >> 16) & 0xFF] ^ t[4][(v >> 24) & 0xFF] ^
+                t[3][(v >> 32) & 0xFF] ^ t[2][(v >> 40) & 0xFF] ^ t[1][(v >> 48) & 0xFF] ^ t[0][v >> 56];
+            p += 8;
+            size -= 8;
+        }
+#endif
+        while (size)
+        {
+            crc = t[0][(crc ^ *p) & 0xFF] ^ (crc >> 8);
+            ++p;
+            --size;
+        }
+        return crc;
+    }
+
+#if defined(LUNA_CRC32C_SSE42)
+    LUNA_CRC32C_TARGET static u32 crc32c_hardware(u32 crc, const u8* p, usize size)
+    {
+        while (size && ((usize)p & 7))
+        {
+            crc = _mm_crc32_u8(crc, *p);
+            ++p;
+            --size;
+        }
+#if defined(LUNA_PLATFORM_X86_64)
+        u64 crc64 = crc;
+        while (size >= 8)
+        {
+            u64 v;
+            memcpy(&v, p, sizeof(u64));
+            crc64 = _mm_crc32_u64(crc64, v);
+            p += 8;
+            size -= 8;
+        }
+        crc = (u32)crc64;
+#else
+        while (size >= 4)
+        {
+            u32 v;
+            memcpy(&v, p, sizeof(u32));
+            crc = _mm_crc32_u32(crc, v);
+            p += 4;
+            size -= 4;
+        }
+#endif
+        while (size)
+        {
+            crc = _mm_crc32_u8(crc, *p);
+            ++p;
+            --size;
+        }
+        return crc;
+    }
+    static bool is_crc32c_hardware_supported()
+    {
+#ifdef _MSC_VER
+        int info[4];
+        __cpuid(info, 1);
+        return (info[2] & (1 << 20)) != 0;
+#else
+        unsigned int eax, ebx, ecx, edx;
+        if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx)) return false;
+        return (ecx & bit_SSE4_2) != 0;
+#endif
+    }
+#elif defined(LUNA_CRC32C_ARMV8)
+    LUNA_CRC32C_TARGET static u32 crc32c_hardware(u32 crc, const u8* p, usize size)
+    {
+        while (size && ((usize)p & 7))
+        {
+            crc = __crc32cb(crc, *p);
+            ++p;
+            --size;
+        }
+        while (size >= 8)
+        {
+            u64 v;
+            memcpy(&v, p, sizeof(u64));
+            crc = __crc32cd(crc, v);
+            p += 8;
+            size -= 8;
+        }
+        while (size)
+        {
+            crc = __crc32cb(crc, *p);
+            ++p;
+            --size;
+        }
+        return crc;
+    }
+    static bool is_crc32c_hardware_supported()
+    {
+#if defined(__ARM_FEATURE_CRC32) || defined(LUNA_PLATFORM_MACOS) || defined(LUNA_PLATFORM_IOS) || defined(LUNA_PLATFORM_WINDOWS)
+        // CRC32 instructions are always available on these platforms.
+        return true;
+#elif defined(LUNA_PLATFORM_LINUX) || defined(LUNA_PLATFORM_ANDROID)
+        return (getauxval(AT_HWCAP) & HWCAP_CRC32) != 0;
+#else
+        return false;
+#endif
+    }
+#else
+    static bool is_crc32c_hardware_supported()
+    {
+        return false;
+    }
+#endif
+
+    using crc32c_func_t = u32(u32 crc, const u8* p, usize size);
+
+    static crc32c_func_t* select_crc32c_func()
+    {
+#if defined(LUNA_CRC32C_SSE42) || defined(LUNA_CRC32C_ARMV8)
+        if (is_crc32c_hardware_supported()) return crc32c_hardware;
+#endif
+        return crc32c_software;
+    }
+
+    // Selected when the module is loaded, so that `crc32c` can be called before LunaSDK is initialized.
+    crc32c_func_t* const g_crc32c_func = select_crc32c_func();
+
+    LUNA_RUNTIME_API u32 crc32c(const void* data, usize size, u32 crc)
+    {
+        return ~g_crc32c_func(~crc, (const u8*)data, size);
+    }
+    LUNA_RUNTIME_API bool is_crc32c_hardware_accelerated()
+    {
+        return g_crc32c_func != crc32c_software;
+    }
+}
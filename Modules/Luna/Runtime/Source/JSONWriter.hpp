@@ -0,0 +1,52 @@
+/*!
+* This file is a portion of LunaSDK.
+* For conditions of distribution and use, see the disclaimer
+* and license in LICENSE.txt
+* 
+* @file JSONWriter.hpp
+* @author JXMaster
+* @date 2026/10/18
+* @brief Helpers used by profilers to write JSON text without depending on VariantUtils.
+*/
+#pragma once
+#include "../String.hpp"
+#include <stdio.h>
+
+namespace Luna
+{
+    //! Appends formatted text to the JSON string. The formatted text must be shorter than 128 characters.
+    inline void append_json_format(String& dst, const c8* format, ...)
+    {
+        c8 buf[128];
+        VarList args;
+        va_start(args, format);
+        vsnprintf(buf, sizeof(buf), format, args);
+        va_end(args);
+        dst.append(buf);
+    }
+    //! Appends one quoted and escaped JSON string. `nullptr` is written as an empty string.
+    inline void append_json_string(String& dst, const c8* str)
+    {
+        dst.push_back('"');
+        if(str)
+        {
+            for(const c8* c = str; *c; ++c)
+            {
+                if(*c == '"' || *c == '\\')
+                {
+                    dst.push_back('\\');
+                    dst.push_back(*c);
+                }
+                else if((u8)*c < 0x20)
+                {
+                    append_json_format(dst, "\\u%04x", (u32)(u8)*c);
+                }
+                else
+                {
+                    dst.push_back(*c);
+                }
+            }
+        }
+        dst.push_back('"');
+    }
+}
@@ -0,0 +1,153 @@
+/*!
+* This file is a portion of LunaSDK.
+* For conditions of distribution and use, see the disclaimer
+* and license in LICENSE.txt
+*
+* @file LockProfiler.cpp
+* @author JXMaster
+* @date 2026/10/18
+*/
+#include "../PlatformDefines.hpp"
+#define LUNA_RUNTIME_API LUNA_EXPORT
+#include "../LockProfiler.hpp"
+#include "Profiler.hpp"
+#include "../SpinLock.hpp"
+#include "../Atomic.hpp"
+#include "../Time.hpp"
+#include "../Algorithm.hpp"
+
+namespace Luna
+{
+    struct LockProfilerSite
+    {
+        const c8* name;
+        u64 num_acquires;
+        u64 num_contended_acquires;
+        u64 total_wait_ticks;
+        u64 max_wait_ticks;
+        u64 total_hold_ticks;
+        u64 max_hold_ticks;
+        u64 wait_time_histogram[NUM_LOCK_WAIT_TIME_BUCKETS];
+    };
+
+    // Sites are stored in one static array rather than allocated, so that global locks can be profiled before
+    // and after the runtime is initialized.
+    constexpr usize MAX_LOCK_PROFILER_SITES = 256;
+    LockProfilerSite g_lock_profiler_sites[MAX_LOCK_PROFILER_SITES];
+    usize g_num_lock_profiler_sites = 0;
+    // This lock must not be named, or acquiring it records to itself.
+    SpinLock g_lock_profiler_sites_lock;
+    f64 g_lock_profiler_us_per_tick = 0.0;
+
+    static void update_max_ticks(u64* dst, u64 ticks)
+    {
+        u64 current = *((volatile u64*)dst);
+        while(ticks > current)
+        {
+            u64 prev = atom_compare_exchange_u64(dst, ticks, current);
+            if(prev == current) break;
+            current = prev;
+        }
+    }
+    static u32 get_wait_time_bucket(u64 wait_ticks)
+    {
+        if(g_lock_profiler_us_per_tick == 0.0)
+        {
+            // The tick frequency may not be queried yet if the lock is acquired before the runtime is initialized.
+            f64 ticks_per_second = get_ticks_per_second();
+            if(ticks_per_second <= 0.0) return 0;
+            g_lock_profiler_us_per_tick = 1000000.0 / ticks_per_second;
+        }
+        u64 us = (u64)((f64)wait_ticks * g_lock_profiler_us_per_tick);
+        u32 bucket = 0;
+        while(us && bucket < NUM_LOCK_WAIT_TIME_BUCKETS - 1)
+        {
+            us >>= 1;
+            ++bucket;
+        }
+        return bucket;
+    }
+    LUNA_RUNTIME_API lock_profiler_site_t get_lock_profiler_site(const c8* name)
+    {
+        if(!name) return nullptr;
+        LockGuard guard(g_lock_profiler_sites_lock);
+        for(usize i = 0; i < g_num_lock_profiler_sites; ++i)
+        {
+            if(!strcmp(g_lock_profiler_sites[i].name, name)) return &g_lock_profiler_sites[i];
+        }
+        if(g_num_lock_profiler_sites == MAX_LOCK_PROFILER_SITES) return nullptr;
+        LockProfilerSite* site = &g_lock_profiler_sites[g_num_lock_profiler_sites];
+        site->name = name;
+        ++g_num_lock_profiler_sites;
+        return site;
+    }
+    LUNA_RUNTIME_API void lock_profiler_record_acquire(lock_profiler_site_t site, u64 wait_ticks, bool contended)
+    {
+        if(!site) return;
+        LockProfilerSite* s = (LockProfilerSite*)site;
+        atom_inc_u64(&s->num_acquires);
+        if(!contended) return;
+        atom_inc_u64(&s->num_contended_acquires);
+        atom_add_u64(&s->total_wait_ticks, (i64)wait_ticks);
+        update_max_ticks(&s->max_wait_ticks, wait_ticks);
+        atom_inc_u64(&s->wait_time_histogram[get_wait_time_bucket(wait_ticks)]);
+    }
+    LUNA_RUNTIME_API void lock_profiler_record_release(lock_profiler_site_t site, u64 hold_ticks)
+    {
+        if(!site) return;
+        LockProfilerSite* s = (LockProfilerSite*)site;
+        atom_add_u64(&s->total_hold_ticks, (i64)hold_ticks);
+        update_max_ticks(&s->max_hold_ticks, hold_ticks);
+    }
+    LUNA_RUNTIME_API Vector<LockContentionStats> get_lock_contention_stats(usize max_count)
+    {
+        Vector<LockContentionStats> r;
+        f64 seconds_per_tick = 1.0 / get_ticks_per_second();
+        {
+            LockGuard guard(g_lock_profiler_sites_lock);
+            for(usize i = 0; i < g_num_lock_profiler_sites; ++i)
+            {
+                LockProfilerSite& s = g_lock_profiler_sites[i];
+                u64 num_acquires = *((volatile u64*)&s.num_acquires);
+                if(!num_acquires) continue;
+                LockContentionStats stats;
+                stats.name = s.name;
+                stats.num_acquires = num_acquires;
+                stats.num_contended_acquires = *((volatile u64*)&s.num_contended_acquires);
+                stats.total_wait_time = (f64)*((volatile u64*)&s.total_wait_ticks) * seconds_per_tick;
+                stats.max_wait_time = (f64)*((volatile u64*)&s.max_wait_ticks) * seconds_per_tick;
+                stats.total_hold_time = (f64)*((volatile u64*)&s.total_hold_ticks) * seconds_per_tick;
+                stats.max_hold_time = (f64)*((volatile u64*)&s.max_hold_ticks) * seconds_per_tick;
+                for(u32 j = 0; j < NUM_LOCK_WAIT_TIME_BUCKETS; ++j)
+                {
+                    stats.wait_time_histogram[j] = *((volatile u64*)&s.wait_time_histogram[j]);
+                }
+                r.push_back(stats);
+            }
+        }
+        sort(r.begin(), r.end(), [](const LockContentionStats& lhs, const LockContentionStats& rhs)
+        {
+            return lhs.total_wait_time > rhs.total_wait_time;
+        });
+        if(r.size() > max_count) r.resize(max_count);
+        return r;
+    }
+    LUNA_RUNTIME_API void reset_lock_contention_stats()
+    {
+        LockGuard guard(g_lock_profiler_sites_lock);
+        for(usize i = 0; i < g_num_lock_profiler_sites; ++i)
+        {
+            LockProfilerSite& s = g_lock_profiler_sites[i];
+            atom_exchange_u64(&s.num_acquires, 0);
+            atom_exchange_u64(&s.num_contended_acquires, 0);
+            atom_exchange_u64(&s.total_wait_ticks, 0);
+            atom_exchange_u64(&s.max_wait_ticks, 0);
+            atom_exchange_u64(&s.total_hold_ticks, 0);
+            atom_exchange_u64(&s.max_hold_ticks, 0);
+            for(u32 j = 0; j < NUM_LOCK_WAIT_TIME_BUCKETS; ++j)
+            {
+                atom_exchange_u64(&s.wait_time_histogram[j], 0);
+            }
+        }
+    }
+}
@@ -16,15 +16,259 @@
 #include "../Atomic.hpp"
 #include "Memory.hpp"
 #include "../Profiler.hpp"
+#include "SizeClassAllocator.hpp"
+#include "AllocationProfiler.hpp"
+#include "../SpinLock.hpp"
+#include "../HashMap.hpp"
 
 namespace Luna
 {
+    HeapAllocatorType g_heap_allocator_type = HeapAllocatorType::system;
+
+    // Huge page blocks are mapped directly from the system and tracked by their addresses, so that `memfree`,
+    // `memsize` and `memrealloc` can tell them from system heap blocks.
+    struct HugePageBlock
+    {
+        usize size;
+        OS::PageBacking backing;
+    };
+    usize g_huge_page_size = 0;
+    usize g_huge_page_threshold = 0;
+    usize g_num_huge_page_blocks = 0;
+    usize g_huge_page_mapped_bytes = 0;
+    usize g_transparent_huge_page_bytes = 0;
+    usize g_explicit_huge_page_bytes = 0;
+    SpinLock g_huge_page_blocks_lock;
+    HashMap<usize, HugePageBlock, hash<usize>, equal_to<usize>, OSAllocator> g_huge_page_blocks;
+
+    static void huge_page_stats_add(const HugePageBlock& block, isize sign)
+    {
+        isize delta = (isize)block.size * sign;
+        atom_add_usize(&g_huge_page_mapped_bytes, delta);
+        if(block.backing == OS::PageBacking::transparent_huge_pages) atom_add_usize(&g_transparent_huge_page_bytes, delta);
+        else if(block.backing == OS::PageBacking::explicit_huge_pages) atom_add_usize(&g_explicit_huge_page_bytes, delta);
+    }
+    static void huge_page_block_insert(void* ptr, const HugePageBlock& block)
+    {
+        {
+            LockGuard guard(g_huge_page_blocks_lock);
+            g_huge_page_blocks.insert(make_pair((usize)ptr, block));
+        }
+        atom_inc_usize(&g_num_huge_page_blocks);
+        huge_page_stats_add(block, 1);
+    }
+    static bool huge_page_block_remove(void* ptr, HugePageBlock& out_block)
+    {
+        // Huge page blocks are always aligned to the page size, while system heap blocks are almost never page-aligned,
+        // so most blocks are rejected without taking the lock.
+        if(!*((volatile usize*)&g_num_huge_page_blocks) || ((usize)ptr & (OS::get_page_size() - 1))) return false;
+        {
+            LockGuard guard(g_huge_page_blocks_lock);
+            auto iter = g_huge_page_blocks.find((usize)ptr);
+            if(iter == g_huge_page_blocks.end()) return false;
+            out_block = iter->second;
+            g_huge_page_blocks.erase(iter);
+        }
+        atom_dec_usize(&g_num_huge_page_blocks);
+        huge_page_stats_add(out_block, -1);
+        return true;
+    }
+    static bool huge_page_block_find(void* ptr, HugePageBlock& out_block)
+    {
+        if(!*((volatile usize*)&g_num_huge_page_blocks) || ((usize)ptr & (OS::get_page_size() - 1))) return false;
+        LockGuard guard(g_huge_page_blocks_lock);
+        auto iter = g_huge_page_blocks.find((usize)ptr);
+        if(iter == g_huge_page_blocks.end()) return false;
+        out_block = iter->second;
+        return true;
+    }
+    static void* huge_page_block_alloc(usize size, usize alignment, bool explicit_huge_pages, usize* out_size)
+    {
+        // Blocks are aligned to the huge page size, or to the page size if huge pages are not supported.
+        if(alignment > max(g_huge_page_size, OS::get_page_size())) return nullptr;
+        HugePageBlock block;
+        void* mem = OS::huge_page_alloc(size, explicit_huge_pages, block.backing);
+        if(!mem) return nullptr;
+        block.size = align_upper(size, block.backing == OS::PageBacking::explicit_huge_pages ? g_huge_page_size : OS::get_page_size());
+        huge_page_block_insert(mem, block);
+        *out_size = block.size;
+        return mem;
+    }
+
+    // Memory statistics are counted by per-thread counters that are only written by the owning thread, and are merged
+    // when being read. The number of allocated bytes is flushed to the global counter when the thread-local delta
+    // exceeds `MEMORY_STATS_FLUSH_BYTES`, so that the peak can be tracked without one atomic operation per allocation.
+    constexpr isize MEMORY_STATS_FLUSH_BYTES = 64_kb;
+    struct MemoryStatsThreadCounters
+    {
+        MemoryStatsThreadCounters* next;
+        MemoryStatsThreadCounters* prev;
+        isize unflushed_bytes;
+        u64 num_allocations;
+        u64 num_frees;
+        u64 size_histogram[NUM_MEMORY_STATS_SIZE_BUCKETS];
+    };
+    // Protects the counter list and retired counters.
+    SpinLock g_memory_stats_lock;
+    MemoryStatsThreadCounters* g_memory_stats_counters = nullptr;
+    // Counters of exited threads, and of allocations made when thread-local counters are not available.
+    // `size_histogram`, `num_allocations` and `num_frees` are modified atomically.
+    MemoryStatsThreadCounters g_memory_stats_retired_counters;
+    usize g_memory_stats_flushed_bytes = 0;
+    usize g_memory_stats_peak_bytes = 0;
+    static thread_local MemoryStatsThreadCounters* tls_memory_stats_counters = nullptr;
+    // Set when the thread-local counters are destroyed, so that blocks freed later by other thread exit 
+    // callbacks do not create the counters again.
+    static thread_local bool tls_memory_stats_thread_exited = false;
+    // The OS TLS slot is used only to merge and free the counters when the thread exits.
+    opaque_t g_memory_stats_tls = nullptr;
+
+    inline u32 get_memory_stats_size_bucket(usize size)
+    {
+        u32 bucket = 0;
+        usize s = (size - 1) >> 4;
+        while(s && bucket < NUM_MEMORY_STATS_SIZE_BUCKETS - 1)
+        {
+            s >>= 1;
+            ++bucket;
+        }
+        return bucket;
+    }
+    static void memory_stats_flush_bytes(isize delta)
+    {
+        usize current = atom_add_usize(&g_memory_stats_flushed_bytes, delta) + (usize)delta;
+        usize peak = *((volatile usize*)&g_memory_stats_peak_bytes);
+        while((isize)current > (isize)peak)
+        {
+            usize prev = atom_compare_exchange_usize(&g_memory_stats_peak_bytes, current, peak);
+            if(prev == peak) break;
+            peak = prev;
+        }
+    }
+    static void memory_stats_thread_counters_dtor(void* data)
+    {
+        MemoryStatsThreadCounters* counters = (MemoryStatsThreadCounters*)data;
+        tls_memory_stats_counters = nullptr;
+        tls_memory_stats_thread_exited = true;
+        {
+            LockGuard guard(g_memory_stats_lock);
+            if(counters->prev) counters->prev->next = counters->next;
+            else g_memory_stats_counters = counters->next;
+            if(counters->next) counters->next->prev = counters->prev;
+            atom_add_u64(&g_memory_stats_retired_counters.num_allocations, counters->num_allocations);
+            atom_add_u64(&g_memory_stats_retired_counters.num_frees, counters->num_frees);
+            for(u32 i = 0; i < NUM_MEMORY_STATS_SIZE_BUCKETS; ++i)
+            {
+                atom_add_u64(&g_memory_stats_retired_counters.size_histogram[i], counters->size_histogram[i]);
+            }
+            memory_stats_flush_bytes(counters->unflushed_bytes);
+        }
+        OS::memdelete(counters);
+    }
+    inline MemoryStatsThreadCounters* get_memory_stats_thread_counters()
+    {
+        MemoryStatsThreadCounters* counters = tls_memory_stats_counters;
+        if(!counters && g_memory_stats_tls && !tls_memory_stats_thread_exited)
+        {
+            counters = OS::memnew<MemoryStatsThreadCounters>();
+            memzero(counters);
+            {
+                LockGuard guard(g_memory_stats_lock);
+                counters->next = g_memory_stats_counters;
+                if(counters->next) counters->next->prev = counters;
+                g_memory_stats_counters = counters;
+            }
+            tls_memory_stats_counters = counters;
+            OS::tls_set(g_memory_stats_tls, counters);
+        }
+        return counters;
+    }
+    inline void memory_stats_allocate(usize size)
+    {
+        MemoryStatsThreadCounters* counters = get_memory_stats_thread_counters();
+        u32 bucket = get_memory_stats_size_bucket(size);
+        if(!counters)
+        {
+            atom_inc_u64(&g_memory_stats_retired_counters.num_allocations);
+            atom_inc_u64(&g_memory_stats_retired_counters.size_histogram[bucket]);
+            memory_stats_flush_bytes((isize)size);
+            return;
+        }
+        // Counters are only written by the owning thread, volatile stores make the values visible to readers.
+        *((volatile u64*)&counters->num_allocations) = counters->num_allocations + 1;
+        *((volatile u64*)&counters->size_histogram[bucket]) = counters->size_histogram[bucket] + 1;
+        isize unflushed = counters->unflushed_bytes + (isize)size;
+        if(unflushed >= MEMORY_STATS_FLUSH_BYTES)
+        {
+            memory_stats_flush_bytes(unflushed);
+            unflushed = 0;
+        }
+        *((volatile isize*)&counters->unflushed_bytes) = unflushed;
+    }
+    inline void memory_stats_deallocate(usize size)
+    {
+        MemoryStatsThreadCounters* counters = get_memory_stats_thread_counters();
+        if(!counters)
+        {
+            atom_inc_u64(&g_memory_stats_retired_counters.num_frees);
+            memory_stats_flush_bytes(-(isize)size);
+            return;
+        }
+        *((volatile u64*)&counters->num_frees) = counters->num_frees + 1;
+        isize unflushed = counters->unflushed_bytes - (isize)size;
+        if(unflushed <= -MEMORY_STATS_FLUSH_BYTES)
+        {
+            memory_stats_flush_bytes(unflushed);
+            unflushed = 0;
+        }
+        *((volatile isize*)&counters->unflushed_bytes) = unflushed;
+    }
+
+    void memory_init(HeapAllocatorType heap_allocator, usize huge_page_threshold)
+    {
+        // The TLS slot is kept until the process exits, since blocks may be freed after LunaSDK is closed.
+        if(!g_memory_stats_tls) g_memory_stats_tls = OS::tls_alloc(memory_stats_thread_counters_dtor);
+        if(heap_allocator == HeapAllocatorType::size_class)
+        {
+            size_class_allocator_init();
+        }
+        g_heap_allocator_type = heap_allocator;
+        g_huge_page_size = OS::get_huge_page_size();
+        g_huge_page_threshold = g_huge_page_size ? huge_page_threshold : 0;
+    }
+    void memory_close()
+    {
+        g_heap_allocator_type = HeapAllocatorType::system;
+        g_huge_page_threshold = 0;
+        size_class_allocator_flush_thread_cache();
+    }
+    LUNA_RUNTIME_API HeapAllocatorType get_heap_allocator_type()
+    {
+        return g_heap_allocator_type;
+    }
     LUNA_RUNTIME_API void* memalloc(usize size, usize alignment)
     {
         if(!size) return nullptr;
-        void* mem = OS::memalloc(size, alignment);
+        void* mem = nullptr;
+        usize allocated = 0;
+        if(g_heap_allocator_type == HeapAllocatorType::size_class)
+        {
+            mem = size_class_alloc(size, alignment);
+            if(mem) allocated = size_class_memsize(mem);
+        }
+        if(!mem && g_huge_page_threshold && size >= g_huge_page_threshold)
+        {
+            mem = huge_page_block_alloc(size, alignment, false, &allocated);
+        }
+        if(!mem)
+        {
+            mem = OS::memalloc(size, alignment);
+            if(!mem) return nullptr;
+            allocated = OS::memsize(mem, alignment);
+        }
+        memory_stats_allocate(allocated);
+        allocation_profiler_allocate(mem, size);
 #ifdef LUNA_MEMORY_PROFILER_ENABLED
-        usize allocated = OS::memsize(mem, alignment);
         memory_profiler_allocate(mem, allocated);
 #endif
         return mem;
@@ -38,25 +282,174 @@ namespace Luna
             memfree(ptr, alignment);
             return nullptr;
         }
-        // expanding or contracting the existing area pointed to by `ptr`, if possible.
-        usize old_size = memsize(ptr, alignment);
+        if(size_class_owns(ptr))
+        {
+            // Size class blocks can only be resized within their size class.
+            usize old_size = size_class_memsize(ptr);
+            if(size <= old_size) return ptr;
+            void* new_ptr = memalloc(size, alignment);
+            if(!new_ptr) return nullptr;
+            memcpy(new_ptr, ptr, old_size);
+            memfree(ptr, alignment);
+            return new_ptr;
+        }
+        HugePageBlock block;
+        if(huge_page_block_find(ptr, block))
+        {
+            if(size <= block.size) return ptr;
+            // Explicit huge pages cannot be remapped in page granularity, and remapped pages may lose
+            // the alignment requirement, so we copy the data in such cases.
+            if(block.backing == OS::PageBacking::explicit_huge_pages || alignment > OS::get_page_size())
+            {
+                void* new_ptr = memalloc(size, alignment);
+                if(!new_ptr) return nullptr;
+                memcpy(new_ptr, ptr, block.size);
+                memfree(ptr, alignment);
+                return new_ptr;
+            }
+            // The old block is unregistered before it is reallocated, since its address may be reused by 
+            // other threads once it is freed. The old block is registered again if reallocation fails.
+#ifdef LUNA_MEMORY_PROFILER_ENABLED
+            memory_profiler_deallocate(ptr, block.size);
+#endif
+            AllocationSampleRecord sample;
+            bool sampled = allocation_profiler_detach(ptr, sample);
+            huge_page_block_remove(ptr, block);
+            void* new_ptr = OS::virtual_realloc(ptr, block.size, size);
+            // Keeps tracking the old block if failed.
+            HugePageBlock new_block = block;
+            if(new_ptr) new_block.size = align_upper(size, OS::get_page_size());
+            huge_page_block_insert(new_ptr ? new_ptr : ptr, new_block);
+            if(new_ptr)
+            {
+                memory_stats_deallocate(block.size);
+                memory_stats_allocate(new_block.size);
+                allocation_profiler_allocate(new_ptr, size);
+            }
+            else if(sampled) allocation_profiler_restore_sample(ptr, move(sample));
+#ifdef LUNA_MEMORY_PROFILER_ENABLED
+            memory_profiler_allocate(new_ptr ? new_ptr : ptr, new_block.size);
+#endif
+            return new_ptr;
+        }
+        usize old_size = OS::memsize(ptr, alignment);
         if(size <= old_size) return ptr;
-        // reallocating.
-        void* new_ptr = memalloc(size, alignment);
-        memcpy(new_ptr, ptr, min(old_size, size));
-        memfree(ptr, alignment);
+        // Let the system heap expand the block in place or remap the block if possible.
+#ifdef LUNA_MEMORY_PROFILER_ENABLED
+        memory_profiler_deallocate(ptr, old_size);
+#endif
+        AllocationSampleRecord sample;
+        bool sampled = allocation_profiler_detach(ptr, sample);
+        void* new_ptr = OS::memrealloc(ptr, size, alignment);
+        usize new_size = new_ptr ? OS::memsize(new_ptr, alignment) : old_size;
+        if(new_ptr)
+        {
+            memory_stats_deallocate(old_size);
+            memory_stats_allocate(new_size);
+            allocation_profiler_allocate(new_ptr, size);
+        }
+        else if(sampled) allocation_profiler_restore_sample(ptr, move(sample));
+#ifdef LUNA_MEMORY_PROFILER_ENABLED
+        memory_profiler_allocate(new_ptr ? new_ptr : ptr, new_size);
+#endif
         return new_ptr;
     }
-    LUNA_RUNTIME_API void memfree(void* ptr, usize alignment)
+    // Emits statistics and profiler events for one block that is going to be freed.
+    inline void on_memory_free(void* ptr, usize size)
     {
-        if(!ptr) return;
+        memory_stats_deallocate(size);
 #ifdef LUNA_MEMORY_PROFILER_ENABLED
-        memory_profiler_deallocate(ptr);
+        memory_profiler_deallocate(ptr, size);
 #endif
+        allocation_profiler_deallocate(ptr);
+    }
+    LUNA_RUNTIME_API void memfree(void* ptr, usize alignment)
+    {
+        if(!ptr) return;
+        // Blocks are freed by the allocator that allocates them, even if the heap allocator is changed.
+        if(size_class_owns(ptr))
+        {
+            on_memory_free(ptr, size_class_memsize(ptr));
+            size_class_free(ptr);
+            return;
+        }
+        HugePageBlock block;
+        if(huge_page_block_remove(ptr, block))
+        {
+            on_memory_free(ptr, block.size);
+            OS::virtual_free(ptr, block.size);
+            return;
+        }
+        on_memory_free(ptr, OS::memsize(ptr, alignment));
         OS::memfree(ptr, alignment);
     }
     LUNA_RUNTIME_API usize memsize(void* ptr, usize alignment)
     {
+        if(!ptr) return 0;
+        if(size_class_owns(ptr)) return size_class_memsize(ptr);
+        HugePageBlock block;
+        if(huge_page_block_find(ptr, block)) return block.size;
         return OS::memsize(ptr, alignment);
     }
-}
\ No newline at end of file
+    LUNA_RUNTIME_API void* memalloc_huge_pages(usize size, usize alignment)
+    {
+        if(!size) return nullptr;
+        usize allocated;
+        void* mem = huge_page_block_alloc(size, alignment, true, &allocated);
+        // Falls back to the normal heap if the alignment requirement cannot be satisfied.
+        if(!mem) return memalloc(size, alignment);
+        memory_stats_allocate(allocated);
+        allocation_profiler_allocate(mem, size);
+#ifdef LUNA_MEMORY_PROFILER_ENABLED
+        memory_profiler_allocate(mem, allocated);
+#endif
+        return mem;
+    }
+    LUNA_RUNTIME_API void set_huge_page_threshold(usize threshold)
+    {
+        g_huge_page_threshold = g_huge_page_size ? threshold : 0;
+    }
+    LUNA_RUNTIME_API usize get_huge_page_threshold()
+    {
+        return g_huge_page_threshold;
+    }
+    LUNA_RUNTIME_API HugePageStats get_huge_page_stats()
+    {
+        HugePageStats r;
+        r.huge_page_size = g_huge_page_size;
+        r.num_blocks = *((volatile usize*)&g_num_huge_page_blocks);
+        r.mapped_bytes = *((volatile usize*)&g_huge_page_mapped_bytes);
+        r.transparent_huge_page_bytes = *((volatile usize*)&g_transparent_huge_page_bytes);
+        r.explicit_huge_page_bytes = *((volatile usize*)&g_explicit_huge_page_bytes);
+        return r;
+    }
+    LUNA_RUNTIME_API MemoryStats get_memory_stats()
+    {
+        MemoryStats r;
+        isize bytes = (isize)*((volatile usize*)&g_memory_stats_flushed_bytes);
+        r.num_allocations = *((volatile u64*)&g_memory_stats_retired_counters.num_allocations);
+        r.num_frees = *((volatile u64*)&g_memory_stats_retired_counters.num_frees);
+        for(u32 i = 0; i < NUM_MEMORY_STATS_SIZE_BUCKETS; ++i)
+        {
+            r.size_histogram[i] = *((volatile u64*)&g_memory_stats_retired_counters.size_histogram[i]);
+        }
+        {
+            LockGuard guard(g_memory_stats_lock);
+            for(MemoryStatsThreadCounters* counters = g_memory_stats_counters; counters; counters = counters->next)
+            {
+                bytes += *((volatile isize*)&counters->unflushed_bytes);
+                r.num_allocations += *((volatile u64*)&counters->num_allocations);
+                r.num_frees += *((volatile u64*)&counters->num_frees);
+                for(u32 i = 0; i < NUM_MEMORY_STATS_SIZE_BUCKETS; ++i)
+                {
+                    r.size_histogram[i] += *((volatile u64*)&counters->size_histogram[i]);
+                }
+            }
+        }
+        // Counters are read while other threads are allocating, so the sum may be slightly off.
+        r.allocated_bytes = bytes > 0 ? (usize)bytes : 0;
+        usize peak = *((volatile usize*)&g_memory_stats_peak_bytes);
+        r.peak_allocated_bytes = max(r.allocated_bytes, peak);
+        return r;
+    }
+}
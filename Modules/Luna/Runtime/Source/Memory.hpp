@@ -12,5 +12,6 @@
 
 namespace Luna
 {
-    
+    void memory_init(HeapAllocatorType heap_allocator, usize huge_page_threshold);
+    void memory_close();
 }
\ No newline at end of file
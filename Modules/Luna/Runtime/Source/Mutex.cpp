@@ -13,8 +13,12 @@
 #include "Mutex.hpp"
 namespace Luna
 {
-    LUNA_RUNTIME_API Ref<IMutex> new_mutex()
+    LUNA_RUNTIME_API Ref<IMutex> new_mutex(const c8* name)
     {
-        return new_object<Mutex>();
+        Ref<Mutex> r = new_object<Mutex>();
+#ifdef LUNA_LOCK_PROFILER_ENABLED
+        r->m_site = get_lock_profiler_site(name);
+#endif
+        return r;
     }
 }
\ No newline at end of file
@@ -19,6 +19,12 @@ namespace Luna
         luiimpl();
 
         opaque_t m_handle;
+#ifdef LUNA_LOCK_PROFILER_ENABLED
+        lock_profiler_site_t m_site = nullptr;
+        u64 m_acquire_ticks = 0;
+        // The number of times the mutex is acquired by the owning thread, only accessed by the owning thread.
+        u32 m_lock_depth = 0;
+#endif
 
         Mutex()
         {
@@ -30,14 +36,53 @@ namespace Luna
         }
         virtual void wait() override
         {
+#ifdef LUNA_LOCK_PROFILER_ENABLED
+            if (m_site)
+            {
+                // Only the outermost acquisition is recorded.
+                if (!OS::try_lock_mutex(m_handle))
+                {
+                    m_acquire_ticks = lock_os_mutex_profiled(m_handle, m_site);
+                }
+                else if (!m_lock_depth)
+                {
+                    lock_profiler_record_acquire(m_site, 0, false);
+                    m_acquire_ticks = get_ticks();
+                }
+                ++m_lock_depth;
+                return;
+            }
+#endif
             OS::lock_mutex(m_handle);
         }
         virtual bool try_wait() override
         {
-            return OS::try_lock_mutex(m_handle);
+            bool r = OS::try_lock_mutex(m_handle);
+#ifdef LUNA_LOCK_PROFILER_ENABLED
+            if (r && m_site)
+            {
+                if (!m_lock_depth)
+                {
+                    lock_profiler_record_acquire(m_site, 0, false);
+                    m_acquire_ticks = get_ticks();
+                }
+                ++m_lock_depth;
+            }
+#endif
+            return r;
         }
         virtual void unlock() override
         {
+#ifdef LUNA_LOCK_PROFILER_ENABLED
+            if (m_site)
+            {
+                --m_lock_depth;
+                if (!m_lock_depth)
+                {
+                    lock_profiler_record_release(m_site, get_ticks() - m_acquire_ticks);
+                }
+            }
+#endif
             OS::unlock_mutex(m_handle);
         }
     };
@@ -14,7 +14,7 @@
 #include "../SelfIndexedUnorderedMultiMap.hpp"
 #include "../SpinLock.hpp"
 #include "../Memory.hpp"
-#include "../Profiler.hpp"
+#include "OS.hpp"
 namespace Luna
 {
     struct NameEntry
@@ -43,36 +43,125 @@ namespace Luna
             return v->m_id;
         }
     };
-    Unconstructed<SelfIndexedUnorderedMultiMap<name_id_t, NameEntry*, NameEntryExtractKey>> g_name_map;
-    RecursiveSpinLock g_name_mtx;
-    bool g_name_inited = false;
-    static void erase_entry(NameEntry* entry)
+
+    // Names are sharded by the high bits of their IDs, so that threads interning different names rarely contend on the same lock.
+    constexpr u32 NUM_NAME_SHARDS_LOG2 = 6;
+    constexpr u32 NUM_NAME_SHARDS = 1 << NUM_NAME_SHARDS_LOG2;
+    // Name entries are allocated from chunks in size classes of `NAME_BLOCK_GRANULARITY` bytes, larger entries are allocated
+    // individually.
+    constexpr usize NAME_BLOCK_GRANULARITY = 16;
+    constexpr usize NUM_NAME_BLOCK_SIZE_CLASSES = 32;
+    constexpr usize MAX_NAME_BLOCK_SIZE = NAME_BLOCK_GRANULARITY * NUM_NAME_BLOCK_SIZE_CLASSES;
+    constexpr usize NAME_CHUNK_SIZE = 16_kb;
+
+    inline usize get_name_block_size(usize str_size)
     {
-        auto range = g_name_map.get().equal_range(entry->m_id);
-        luassert(range.first != g_name_map.get().end());
-        for (auto iter = range.first; iter != range.second; ++iter)
+        return align_upper(sizeof(NameEntry) + sizeof(c8) * (str_size + 1), NAME_BLOCK_GRANULARITY);
+    }
+
+    // Aligned to cache lines so that locks of different shards do not share cache lines.
+    struct alignas(64) NameShard
+    {
+        SpinLock m_lock { "Runtime/Name Table" };
+        SelfIndexedUnorderedMultiMap<name_id_t, NameEntry*, NameEntryExtractKey> m_map;
+        // The chunk that new blocks are allocated from.
+        byte_t* m_chunk_cur = nullptr;
+        byte_t* m_chunk_end = nullptr;
+        // All allocated chunks, linked by the first pointer of every chunk.
+        void* m_chunks = nullptr;
+        // Freed blocks of every size class, linked by the first pointer of every block.
+        void* m_free_blocks[NUM_NAME_BLOCK_SIZE_CLASSES] = { nullptr };
+
+        void* allocate_block(usize block_size)
         {
-            if (entry == *iter)
+            if (block_size > MAX_NAME_BLOCK_SIZE)
+            {
+                return OS::memalloc(block_size, alignof(NameEntry));
+            }
+            usize size_class = block_size / NAME_BLOCK_GRANULARITY - 1;
+            void* block = m_free_blocks[size_class];
+            if (block)
             {
-                g_name_map.get().erase(iter);
-                break;
+                m_free_blocks[size_class] = *((void**)block);
+                return block;
             }
+            if ((usize)(m_chunk_end - m_chunk_cur) < block_size)
+            {
+                // The rest of the current chunk is wasted, which is smaller than `MAX_NAME_BLOCK_SIZE`.
+                byte_t* chunk = (byte_t*)OS::memalloc(NAME_CHUNK_SIZE, NAME_BLOCK_GRANULARITY);
+                if (!chunk) return nullptr;
+                *((void**)chunk) = m_chunks;
+                m_chunks = chunk;
+                m_chunk_cur = chunk + NAME_BLOCK_GRANULARITY;
+                m_chunk_end = chunk + NAME_CHUNK_SIZE;
+            }
+            block = m_chunk_cur;
+            m_chunk_cur += block_size;
+            return block;
         }
-        memfree(entry);
+        void free_block(void* block, usize block_size)
+        {
+            if (block_size > MAX_NAME_BLOCK_SIZE)
+            {
+                OS::memfree(block, alignof(NameEntry));
+                return;
+            }
+            usize size_class = block_size / NAME_BLOCK_GRANULARITY - 1;
+            *((void**)block) = m_free_blocks[size_class];
+            m_free_blocks[size_class] = block;
+        }
+        ~NameShard()
+        {
+            for (NameEntry* entry : m_map)
+            {
+                usize block_size = get_name_block_size(entry->m_str_size);
+                if (block_size > MAX_NAME_BLOCK_SIZE) OS::memfree(entry, alignof(NameEntry));
+            }
+            while (m_chunks)
+            {
+                void* next = *((void**)m_chunks);
+                OS::memfree(m_chunks, NAME_BLOCK_GRANULARITY);
+                m_chunks = next;
+            }
+        }
+    };
+
+    NameShard* g_name_shards = nullptr;
+    bool g_name_inited = false;
+
+    // All name literal caches that have been refreshed since LunaSDK is initialized.
+    NameLiteralCache* g_name_literal_caches = nullptr;
+    SpinLock g_name_literal_caches_lock { "Runtime/Name Literal Caches" };
+
+    inline NameShard& get_name_shard(name_id_t id)
+    {
+        return g_name_shards[id >> (sizeof(name_id_t) * 8 - NUM_NAME_SHARDS_LOG2)];
     }
     void name_init()
     {
-        g_name_map.construct();
+        g_name_shards = (NameShard*)OS::memalloc(sizeof(NameShard) * NUM_NAME_SHARDS, alignof(NameShard));
+        for (u32 i = 0; i < NUM_NAME_SHARDS; ++i)
+        {
+            new (&g_name_shards[i]) NameShard();
+        }
         g_name_inited = true;
     }
     void name_close()
     {
+        // Reset all name literal caches, so that names are interned again if LunaSDK is initialized again.
+        for (NameLiteralCache* cache = g_name_literal_caches; cache; cache = cache->m_next)
+        {
+            new (&cache->m_name) Name();
+            cache->m_registered = false;
+        }
+        g_name_literal_caches = nullptr;
         // Release all name strings.
-        for (auto& i : g_name_map.get())
+        for (u32 i = 0; i < NUM_NAME_SHARDS; ++i)
         {
-            memfree(i);
+            g_name_shards[i].~NameShard();
         }
-        g_name_map.destruct();
+        OS::memfree(g_name_shards, alignof(NameShard));
+        g_name_shards = nullptr;
         g_name_inited = false;
     }
     LUNA_RUNTIME_API const c8* intern_name(const c8* name)
@@ -81,49 +170,65 @@ namespace Luna
         if (!name || (*name == '\0')) return nullptr;
         return intern_name(name, strlen(name));
     }
-    LUNA_RUNTIME_API const c8* intern_name(const c8* name, usize count)
+    static const c8* intern_name_with_id(const c8* name, usize count, name_id_t h)
     {
-        lucheck_msg(g_name_inited, "intern_name must be called after Luna::init()!");
-        if (!name || (*name == '\0')) return nullptr;
-        name_id_t h = memhash<name_id_t>(name, count);
-        LockGuard guard(g_name_mtx);
-        auto range = g_name_map.get().equal_range(h);
-        if (range.first != g_name_map.get().end())
+        NameShard& shard = get_name_shard(h);
+        LockGuard guard(shard.m_lock);
+        auto range = shard.m_map.equal_range(h);
+        for (auto iter = range.first; iter != range.second; ++iter)
         {
-            auto iter = range.first;
-            // Skip comparison for single-string case.
-            ++iter;
-            if(iter == range.second)
-            {
-                iter = range.first;
-                NameEntry* entry = *iter;
-                atom_inc_u32(&(entry->m_ref_count));
-                return get_name_string(entry);
-            }
-            // Compare each string to find the right one.
-            for (iter = range.first; iter != range.second; ++iter)
+            NameEntry* entry = *iter;
+            const c8* entry_string = get_name_string(entry);
+            if (entry->m_str_size == count && !memcmp(name, entry_string, count * sizeof(c8)))
             {
-                NameEntry* entry = *iter;
-                const c8* entry_string = get_name_string(entry);
-                if (!memcmp(name, entry_string, count * sizeof(c8)))
+                // Entries whose reference counts drop to 0 are being erased by `release_name`, and must not be revived.
+                u32 ref_count = entry->m_ref_count;
+                while (ref_count)
                 {
-                    atom_inc_u32(&(entry->m_ref_count));
-                    return entry_string;
+                    u32 prev = atom_compare_exchange_u32(&(entry->m_ref_count), ref_count + 1, ref_count);
+                    if (prev == ref_count) return entry_string;
+                    ref_count = prev;
                 }
             }
         }
         // Create new entry.
-        NameEntry* new_entry = (NameEntry*)memalloc(sizeof(c8) * (count + 1) + sizeof(NameEntry), alignof(NameEntry));
-#ifdef LUNA_MEMORY_PROFILER_ENABLED
-        memory_profiler_set_memory_type(new_entry, "Name", 4);
-#endif
+        NameEntry* new_entry = (NameEntry*)shard.allocate_block(get_name_block_size(count));
+        if (!new_entry) return nullptr;
         new (new_entry) NameEntry(h, count, 1);
         c8* buf = (c8*)(new_entry + 1);
         memcpy(buf, name, sizeof(c8) * count);
         buf[count] = 0;
-        g_name_map.get().insert(new_entry);
+        shard.m_map.insert(new_entry);
         return buf;
     }
+    LUNA_RUNTIME_API const c8* intern_name(const c8* name, usize count)
+    {
+        lucheck_msg(g_name_inited, "intern_name must be called after Luna::init()!");
+        if (!name || (*name == '\0')) return nullptr;
+        return intern_name_with_id(name, count, (name_id_t)wyhash64(name, count));
+    }
+    LUNA_RUNTIME_API const c8* intern_name(const NameLiteral& literal)
+    {
+        lucheck_msg(g_name_inited, "intern_name must be called after Luna::init()!");
+        if (!literal.size) return nullptr;
+        luassert(literal.id == (name_id_t)wyhash64(literal.str, literal.size));
+        return intern_name_with_id(literal.str, literal.size, literal.id);
+    }
+    LUNA_RUNTIME_API void refresh_name_literal_cache(NameLiteralCache* cache, const NameLiteral& literal)
+    {
+        lucheck_msg(g_name_inited, "luname must be called after Luna::init()!");
+        LockGuard guard(g_name_literal_caches_lock);
+        // The cache may be refreshed by another thread.
+        if (!cache->m_name.empty()) return;
+        if (!cache->m_registered)
+        {
+            cache->m_next = g_name_literal_caches;
+            g_name_literal_caches = cache;
+            cache->m_registered = true;
+        }
+        // The old name is not released, since it is either empty or freed by the previous name table.
+        cache->publish(intern_name(literal));
+    }
     LUNA_RUNTIME_API void retain_name(const c8* name)
     {
         if (!name) return;
@@ -137,8 +242,19 @@ namespace Luna
         u32 r = atom_dec_u32(&(entry->m_ref_count));
         if (!r)
         {
-            LockGuard guard(g_name_mtx);
-            erase_entry(entry);
+            NameShard& shard = get_name_shard(entry->m_id);
+            LockGuard guard(shard.m_lock);
+            auto range = shard.m_map.equal_range(entry->m_id);
+            luassert(range.first != shard.m_map.end());
+            for (auto iter = range.first; iter != range.second; ++iter)
+            {
+                if (entry == *iter)
+                {
+                    shard.m_map.erase(iter);
+                    break;
+                }
+            }
+            shard.free_block(entry, get_name_block_size(entry->m_str_size));
         }
     }
     LUNA_RUNTIME_API name_id_t get_name_id(const c8* name)
@@ -18,6 +18,7 @@
 #include "../Thread.hpp"
 #include "../File.hpp"
 #include "../Log.hpp"
+#include "../LockProfiler.hpp"
 namespace Luna
 {
     namespace OS
@@ -76,6 +77,16 @@ namespace Luna
         //! @param[in] alignment Optional. The alignment requirement specified when allocating the memory block. Default is 0.
         void memfree(void* ptr, usize alignment = 0);
 
+        //! Reallocates memory blocks allocated by `OS::memalloc` or `OS::memrealloc`.
+        //! The implementation should expand or contract the existing memory block in place if possible, and moves the memory block
+        //! only if the existing memory block cannot be resized.
+        //! @param[in] ptr The pointer to reallocate. If this is `nullptr`, this function behaves the same as `OS::memalloc`.
+        //! @param[in] size The new size of the memory block. If this is 0, the memory block is freed and the return value will be `nullptr`.
+        //! @param[in] alignment Optional. The alignment requirement specified when allocating the memory block. Default is 0.
+        //! @return Returns a pointer to the reallocated memory block, or `nullptr` if failed. If failed, the original
+        //! memory block is not changed.
+        void* memrealloc(void* ptr, usize size, usize alignment = 0);
+
         //! Gets the allocated size of the memory block allocated by `OS::memalloc` or `OS::memrealloc`. 
         //! The returned size is the size that is available for the user to use. 
         //! Note that the allocated size may be bigger than the size required to specify alignment and padding requirements.
@@ -84,6 +95,61 @@ namespace Luna
         //! @return The size of bytes of the memory block. If `ptr` is `nullptr`, the returned value is 0.
         usize memsize(void* ptr, usize alignment = 0);
 
+        //! Gets the size, in bytes, of one virtual memory page of the platform.
+        usize get_page_size();
+
+        //! Allocates memory pages directly from the virtual memory system of the platform, bypassing the system heap.
+        //! @param[in] size The number of bytes to allocate. This will be rounded up to times of the page size.
+        //! @param[in] alignment Optional. The required alignment of the returned address. If this is smaller than the page size, 
+        //! the returned address is aligned to the page size. The alignment value must be powers of 2.
+        //! @return Returns the address of the first allocated page, or `nullptr` if failed. The allocated pages are readable, writable 
+        //! and zero-initialized.
+        void* virtual_alloc(usize size, usize alignment = 0);
+
+        //! Frees memory pages allocated by `OS::virtual_alloc`.
+        //! @param[in] ptr The pointer returned by `OS::virtual_alloc`. If this is `nullptr`, this function does nothing.
+        //! @param[in] size The size passed to `OS::virtual_alloc` when allocating the pages.
+        void virtual_free(void* ptr, usize size);
+
+        //! Resizes memory pages allocated by `OS::virtual_alloc`, remapping the pages to a new address if they cannot be
+        //! resized in place. The data of the pages is preserved without being copied if the platform supports page remapping.
+        //! @param[in] ptr The pointer returned by `OS::virtual_alloc` or `OS::virtual_realloc`.
+        //! @param[in] old_size The current size of the pages.
+        //! @param[in] new_size The new size of the pages. This will be rounded up to times of the page size.
+        //! @return Returns the address of the resized pages, or `nullptr` if failed. If failed, the original pages are not changed.
+        //! The returned address is only guaranteed to be aligned to the page size.
+        void* virtual_realloc(void* ptr, usize old_size, usize new_size);
+
+        //! Gets the size, in bytes, of one huge page of the platform.
+        //! @return Returns the huge page size, or `0` if the platform does not support huge pages.
+        usize get_huge_page_size();
+
+        //! Describes the pages that back memory allocated by `OS::huge_page_alloc`.
+        enum class PageBacking : u8
+        {
+            //! The memory is backed by normal pages.
+            normal = 0,
+            //! The memory is advised to be backed by transparent huge pages. The system may still use normal pages
+            //! for some parts of the memory.
+            transparent_huge_pages = 1,
+            //! The memory is backed by huge pages reserved explicitly from the system.
+            explicit_huge_pages = 2,
+        };
+
+        //! Allocates memory pages that are backed by huge pages if possible, falling back to normal pages if huge pages
+        //! are not available.
+        //! @param[in] size The number of bytes to allocate. This will be rounded up to times of the page size, or times of the
+        //! huge page size if explicit huge pages are used.
+        //! @param[in] explicit_huge_pages Whether to allocate huge pages reserved explicitly from the system first. If this is `false` or
+        //! if explicit huge pages are not available, the memory is allocated from normal pages and advised to be backed by transparent
+        //! huge pages.
+        //! @param[out] out_backing Receives the pages that back the allocated memory.
+        //! @return Returns the address of the first allocated page, or `nullptr` if failed. If the platform supports huge pages, the
+        //! returned address is aligned to the huge page size, otherwise the returned address is aligned to the page size.
+        //! The allocated pages should be freed by `OS::virtual_free` with the size rounded up to times of the huge page size
+        //! if `out_backing` is `PageBacking::explicit_huge_pages`.
+        void* huge_page_alloc(usize size, bool explicit_huge_pages, PageBacking& out_backing);
+
         //! Global object creation function.
         template <typename _Ty, typename... _Args>
         _Ty* memnew(_Args&&... args)
@@ -557,17 +623,78 @@ namespace Luna
         }
     };
 
+#ifdef LUNA_LOCK_PROFILER_ENABLED
+    //! Locks one OS mutex and records the acquisition to the lock profiler.
+    //! @return Returns the ticks when the mutex is acquired, which is used to compute the hold time.
+    inline u64 lock_os_mutex_profiled(opaque_t mutex, lock_profiler_site_t site)
+    {
+        u64 wait_ticks = 0;
+        bool contended = !OS::try_lock_mutex(mutex);
+        if (contended)
+        {
+            u64 begin_ticks = get_ticks();
+            OS::lock_mutex(mutex);
+            wait_ticks = get_ticks() - begin_ticks;
+        }
+        lock_profiler_record_acquire(site, wait_ticks, contended);
+        return get_ticks();
+    }
+#endif
+
+    //! The lock profiler state of one OS mutex that is acquired by @ref OSMutexGuard.
+    struct OSMutexProfilerState
+    {
+        //! The lock profiler site of the mutex. If this is `nullptr`, acquisitions are not recorded.
+        lock_profiler_site_t site = nullptr;
+#ifdef LUNA_LOCK_PROFILER_ENABLED
+        u64 acquire_ticks = 0;
+        // The number of times the mutex is acquired by the owning thread, only accessed by the owning thread.
+        u32 lock_depth = 0;
+#endif
+    };
+
     struct OSMutexGuard
     {
         opaque_t m_handle;
+#ifdef LUNA_LOCK_PROFILER_ENABLED
+        OSMutexProfilerState* m_state;
+#endif
 
-        OSMutexGuard(opaque_t h) :
+        OSMutexGuard(opaque_t h, OSMutexProfilerState* state = nullptr) :
             m_handle(h)
         {
+#ifdef LUNA_LOCK_PROFILER_ENABLED
+            m_state = (state && state->site) ? state : nullptr;
+            if (m_state)
+            {
+                // Only the outermost acquisition is recorded.
+                if (!OS::try_lock_mutex(m_handle))
+                {
+                    m_state->acquire_ticks = lock_os_mutex_profiled(m_handle, m_state->site);
+                }
+                else if (!m_state->lock_depth)
+                {
+                    lock_profiler_record_acquire(m_state->site, 0, false);
+                    m_state->acquire_ticks = get_ticks();
+                }
+                ++m_state->lock_depth;
+                return;
+            }
+#endif
             OS::lock_mutex(m_handle);
         }
         ~OSMutexGuard()
         {
+#ifdef LUNA_LOCK_PROFILER_ENABLED
+            if (m_state)
+            {
+                --m_state->lock_depth;
+                if (!m_state->lock_depth)
+                {
+                    lock_profiler_record_release(m_state->site, get_ticks() - m_state->acquire_ticks);
+                }
+            }
+#endif
             OS::unlock_mutex(m_handle);
         }
     };
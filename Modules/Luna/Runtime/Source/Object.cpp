@@ -18,9 +18,201 @@
 #include "../Profiler.hpp"
 
 #include "OS.hpp"
+#include "TypeInfo.hpp"
 
 namespace Luna
 {
+    // The maximum number of object pools. Types that are marked as pooled after this limit is reached 
+    // are allocated from the heap.
+    constexpr u32 MAX_OBJECT_POOLS = 256;
+
+    struct ObjectPool
+    {
+        u32 index;
+        usize block_size;
+        usize alignment;
+        u32 max_cached_objects_per_thread;
+        // Blocks returned by threads whose caches are full or threads that are exited.
+        SpinLock lock;
+        void* central_head = nullptr;
+        usize central_count = 0;
+        // Statistics of exited threads, protected by `g_object_pools_lock`.
+        i64 retired_live_objects = 0;
+        u64 retired_heap_allocations = 0;
+        u64 retired_reused_allocations = 0;
+    };
+
+    struct ObjectPoolThreadList
+    {
+        void* head;
+        u32 count;
+        // Statistics, only modified by the owning thread.
+        i64 live_objects;
+        u64 heap_allocations;
+        u64 reused_allocations;
+    };
+
+    struct ObjectPoolThreadCache
+    {
+        // Lists indexed by pool indices. Lists are allocated when the thread uses pools that do not have lists yet,
+        // so threads that use no pooled type do not allocate lists.
+        ObjectPoolThreadList* lists;
+        u32 num_lists;
+        ObjectPoolThreadCache* prev;
+        ObjectPoolThreadCache* next;
+    };
+
+    ObjectPool* g_object_pools[MAX_OBJECT_POOLS];
+    u32 g_num_object_pools = 0;
+    // Protects `g_object_pools` and the thread cache list.
+    SpinLock g_object_pools_lock;
+    ObjectPoolThreadCache* g_object_pool_thread_caches = nullptr;
+    // Increased every time the runtime is initialized, so that caches cached by threads that outlive one
+    // `object_close` are not used after they are freed.
+    u32 g_object_pool_generation = 0;
+    static thread_local ObjectPoolThreadCache* tls_object_pool_thread_cache = nullptr;
+    static thread_local u32 tls_object_pool_thread_cache_generation = 0;
+    // The OS TLS slot is used only to flush and free the thread cache when the thread exits.
+    opaque_t g_object_pool_thread_cache_tls = nullptr;
+
+    // Returns `count` blocks linked from `head` to the central list of the pool, blocks that exceed the 
+    // central list capacity are freed.
+    static void object_pool_release_blocks(ObjectPool* pool, void* head, usize count)
+    {
+        usize max_central_count = (usize)pool->max_cached_objects_per_thread * 8;
+        void* free_head = nullptr;
+        {
+            LockGuard guard(pool->lock);
+            while (head && pool->central_count < max_central_count)
+            {
+                void* next = *(void**)head;
+                *(void**)head = pool->central_head;
+                pool->central_head = head;
+                ++pool->central_count;
+                head = next;
+            }
+            free_head = head;
+        }
+        while (free_head)
+        {
+            void* next = *(void**)free_head;
+            memfree(free_head, pool->alignment);
+            free_head = next;
+        }
+    }
+    static void object_pool_thread_cache_dtor(void* data)
+    {
+        ObjectPoolThreadCache* cache = (ObjectPoolThreadCache*)data;
+        tls_object_pool_thread_cache = nullptr;
+        LockGuard guard(g_object_pools_lock);
+        for (u32 i = 0; i < cache->num_lists; ++i)
+        {
+            ObjectPool* pool = g_object_pools[i];
+            ObjectPoolThreadList& list = cache->lists[i];
+            object_pool_release_blocks(pool, list.head, list.count);
+            pool->retired_live_objects += list.live_objects;
+            pool->retired_heap_allocations += list.heap_allocations;
+            pool->retired_reused_allocations += list.reused_allocations;
+        }
+        if (cache->prev) cache->prev->next = cache->next;
+        else g_object_pool_thread_caches = cache->next;
+        if (cache->next) cache->next->prev = cache->prev;
+        if (cache->lists) OS::memfree(cache->lists, alignof(ObjectPoolThreadList));
+        OS::memdelete(cache);
+    }
+    static ObjectPoolThreadCache* get_object_pool_thread_cache()
+    {
+        ObjectPoolThreadCache* cache = tls_object_pool_thread_cache;
+        if (cache && tls_object_pool_thread_cache_generation != g_object_pool_generation)
+        {
+            // The cache was freed by the previous `object_close`.
+            cache = nullptr;
+        }
+        if (!cache)
+        {
+            cache = OS::memnew<ObjectPoolThreadCache>();
+            memzero(cache);
+            {
+                LockGuard guard(g_object_pools_lock);
+                cache->next = g_object_pool_thread_caches;
+                if (cache->next) cache->next->prev = cache;
+                g_object_pool_thread_caches = cache;
+            }
+            tls_object_pool_thread_cache = cache;
+            tls_object_pool_thread_cache_generation = g_object_pool_generation;
+            OS::tls_set(g_object_pool_thread_cache_tls, cache);
+        }
+        return cache;
+    }
+    static ObjectPoolThreadList& get_object_pool_thread_list(ObjectPool* pool)
+    {
+        ObjectPoolThreadCache* cache = get_object_pool_thread_cache();
+        if (pool->index >= cache->num_lists)
+        {
+            // Allocates lists for all pools created by now.
+            LockGuard guard(g_object_pools_lock);
+            u32 num_lists = g_num_object_pools;
+            ObjectPoolThreadList* lists = (ObjectPoolThreadList*)OS::memalloc(sizeof(ObjectPoolThreadList) * num_lists, alignof(ObjectPoolThreadList));
+            if (cache->num_lists) memcpy(lists, cache->lists, sizeof(ObjectPoolThreadList) * cache->num_lists);
+            memzero(lists + cache->num_lists, sizeof(ObjectPoolThreadList) * (num_lists - cache->num_lists));
+            if (cache->lists) OS::memfree(cache->lists, alignof(ObjectPoolThreadList));
+            cache->lists = lists;
+            cache->num_lists = num_lists;
+        }
+        return cache->lists[pool->index];
+    }
+    static void* object_pool_allocate(ObjectPool* pool, bool& new_block)
+    {
+        ObjectPoolThreadList& list = get_object_pool_thread_list(pool);
+        ++list.live_objects;
+        if (!list.head && pool->central_count)
+        {
+            // Fetches half of the thread cache capacity from the central list.
+            usize fetch_count = max<usize>(pool->max_cached_objects_per_thread / 2, 1);
+            LockGuard guard(pool->lock);
+            while (pool->central_head && list.count < fetch_count)
+            {
+                void* block = pool->central_head;
+                pool->central_head = *(void**)block;
+                --pool->central_count;
+                *(void**)block = list.head;
+                list.head = block;
+                ++list.count;
+            }
+        }
+        if (list.head)
+        {
+            void* block = list.head;
+            list.head = *(void**)block;
+            --list.count;
+            ++list.reused_allocations;
+            new_block = false;
+            return block;
+        }
+        ++list.heap_allocations;
+        new_block = true;
+        return memalloc(pool->block_size, pool->alignment);
+    }
+    static void object_pool_free(ObjectPool* pool, void* block)
+    {
+        ObjectPoolThreadList& list = get_object_pool_thread_list(pool);
+        --list.live_objects;
+        *(void**)block = list.head;
+        list.head = block;
+        ++list.count;
+        if (list.count > pool->max_cached_objects_per_thread)
+        {
+            // Releases half of the cached blocks to the central list.
+            u32 release_count = list.count / 2;
+            void* head = list.head;
+            void* tail = head;
+            for (u32 i = 1; i < release_count; ++i) tail = *(void**)tail;
+            list.head = *(void**)tail;
+            list.count -= release_count;
+            *(void**)tail = nullptr;
+            object_pool_release_blocks(pool, head, release_count);
+        }
+    }
     struct ObjectHeader
     {
         typeinfo_t type;
@@ -67,8 +259,10 @@ namespace Luna
                 usize alignment = get_type_alignment(type);
                 usize padded_size = get_padding_size(alignment);
                 void* raw_ptr = (void*)((usize)obj - padded_size);
+                ObjectPool* pool = ((TypeInfo*)type.handle)->object_pool;
                 this->~ObjectHeader();
-                memfree(raw_ptr, alignment);
+                if (pool) object_pool_free(pool, raw_ptr);
+                else memfree(raw_ptr, alignment);
             }
         }
     };
@@ -81,14 +275,20 @@ namespace Luna
         usize size = get_type_size(type);
         usize alignment = get_type_alignment(type);
         usize padding_size = ObjectHeader::get_padding_size(alignment);
-        void* mem = memalloc(size + padding_size, alignment);
+        ObjectPool* pool = ((TypeInfo*)type.handle)->object_pool;
+        bool new_block = true;
+        void* mem = pool ? object_pool_allocate(pool, new_block) : memalloc(size + padding_size, alignment);
         object_t object = (object_t)((usize)mem + padding_size);
         ObjectHeader* header = get_header(object);
         new (header) ObjectHeader();
         header->type = type;
 #ifdef LUNA_MEMORY_PROFILER_ENABLED
-        Name type_name = get_type_name(type);
-        memory_profiler_set_memory_type(mem, type_name.c_str(), type_name.size());
+        // Blocks reused from the pool already have their memory types set.
+        if (new_block)
+        {
+            Name type_name = get_type_name(type);
+            memory_profiler_set_memory_type(mem, type_name.c_str(), type_name.size());
+        }
 #endif
         return object;
     }
@@ -165,7 +365,91 @@ namespace Luna
         }
         return false;
     }
+    LUNA_RUNTIME_API bool enable_object_pool(typeinfo_t type, u32 max_cached_objects_per_thread)
+    {
+        lucheck(type);
+        TypeInfo* t = (TypeInfo*)type.handle;
+        LockGuard guard(g_object_pools_lock);
+        if (t->object_pool) return true;
+        if (g_num_object_pools >= MAX_OBJECT_POOLS) return false;
+        ObjectPool* pool = OS::memnew<ObjectPool>();
+        pool->index = g_num_object_pools;
+        pool->alignment = get_type_alignment(type);
+        pool->block_size = get_type_size(type) + ObjectHeader::get_padding_size(pool->alignment);
+        pool->max_cached_objects_per_thread = max<u32>(max_cached_objects_per_thread, 1);
+        g_object_pools[g_num_object_pools] = pool;
+        ++g_num_object_pools;
+        t->object_pool = pool;
+        return true;
+    }
+    LUNA_RUNTIME_API bool get_object_pool_stats(typeinfo_t type, ObjectPoolStats& out_stats)
+    {
+        lucheck(type);
+        ObjectPool* pool = ((TypeInfo*)type.handle)->object_pool;
+        if (!pool) return false;
+        LockGuard guard(g_object_pools_lock);
+        i64 live_objects = pool->retired_live_objects;
+        usize cached_objects = pool->central_count;
+        out_stats.heap_allocations = pool->retired_heap_allocations;
+        out_stats.reused_allocations = pool->retired_reused_allocations;
+        // Statistics of running threads are read without synchronization, so they may be slightly out of date.
+        for (ObjectPoolThreadCache* cache = g_object_pool_thread_caches; cache; cache = cache->next)
+        {
+            if (pool->index >= cache->num_lists) continue;
+            const ObjectPoolThreadList& list = cache->lists[pool->index];
+            live_objects += list.live_objects;
+            cached_objects += list.count;
+            out_stats.heap_allocations += list.heap_allocations;
+            out_stats.reused_allocations += list.reused_allocations;
+        }
+        out_stats.live_objects = (usize)max<i64>(live_objects, 0);
+        out_stats.cached_objects = cached_objects;
+        return true;
+    }
+    void object_init()
+    {
+        ++g_object_pool_generation;
+        g_object_pool_thread_cache_tls = OS::tls_alloc(object_pool_thread_cache_dtor);
+    }
     void object_close()
     {
+        // Frees all cached blocks. Objects should be released before the runtime is closed, so 
+        // all blocks are cached by now.
+        LockGuard guard(g_object_pools_lock);
+        for (ObjectPoolThreadCache* cache = g_object_pool_thread_caches; cache;)
+        {
+            ObjectPoolThreadCache* next = cache->next;
+            for (u32 i = 0; i < cache->num_lists; ++i)
+            {
+                void* block = cache->lists[i].head;
+                while (block)
+                {
+                    void* next_block = *(void**)block;
+                    memfree(block, g_object_pools[i]->alignment);
+                    block = next_block;
+                }
+            }
+            if (cache->lists) OS::memfree(cache->lists, alignof(ObjectPoolThreadList));
+            OS::memdelete(cache);
+            cache = next;
+        }
+        g_object_pool_thread_caches = nullptr;
+        tls_object_pool_thread_cache = nullptr;
+        for (u32 i = 0; i < g_num_object_pools; ++i)
+        {
+            ObjectPool* pool = g_object_pools[i];
+            void* block = pool->central_head;
+            while (block)
+            {
+                void* next_block = *(void**)block;
+                memfree(block, pool->alignment);
+                block = next_block;
+            }
+            OS::memdelete(pool);
+            g_object_pools[i] = nullptr;
+        }
+        g_num_object_pools = 0;
+        OS::tls_free(g_object_pool_thread_cache_tls);
+        g_object_pool_thread_cache_tls = nullptr;
     }
 }
\ No newline at end of file
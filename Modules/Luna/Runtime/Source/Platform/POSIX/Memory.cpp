@@ -13,6 +13,7 @@
 #include "../../../Error.hpp"
 #include <pthread.h>
 #include <stdlib.h>
+#include <unistd.h>
 #include "../../../Algorithm.hpp"
 
 #if defined(LUNA_PLATFORM_APPLE)
@@ -21,6 +22,8 @@
 #include <malloc.h>
 #endif
 
+#include <stdio.h>
+
 namespace Luna
 {
     namespace OS
@@ -49,6 +52,32 @@ namespace Luna
                 free(origin_ptr);
             }
         }
+        void* memrealloc(void* ptr, usize size, usize alignment /* = 0 */)
+        {
+            if (!ptr) return memalloc(size, alignment);
+            if (!size)
+            {
+                memfree(ptr, alignment);
+                return nullptr;
+            }
+            // `realloc` expands the block in place if possible. For large blocks allocated by `mmap`, 
+            // glibc resizes the block using `mremap`, so the data is not copied.
+            if (alignment <= MAX_ALIGN) return realloc(ptr, size);
+            isize offset = *(((isize*)ptr) - 1);
+            void* origin_ptr = (void*)(((usize)ptr) - offset);
+            usize copy_size = min(memsize(ptr, alignment), size);
+            usize new_origin_ptr = (usize)realloc(origin_ptr, size + alignment);
+            if (!new_origin_ptr) return nullptr;
+            usize aligned_ptr = align_upper(new_origin_ptr + 1, alignment);
+            isize new_offset = aligned_ptr - new_origin_ptr;
+            // The block may be moved to an address with different alignment, in which case we need to move the data.
+            if (new_offset != offset)
+            {
+                memmove((void*)aligned_ptr, (void*)(new_origin_ptr + offset), copy_size);
+            }
+            *((isize*)(aligned_ptr)-1) = new_offset;
+            return (void*)aligned_ptr;
+        }
         usize memsize(void* ptr, usize alignment /* = 0 */)
         {
             if (!ptr) return 0;
@@ -66,6 +95,123 @@ namespace Luna
             return malloc_size(origin_ptr) - offset;
 #else
             return malloc_usable_size(origin_ptr) - offset;
+#endif
+        }
+        usize get_page_size()
+        {
+            static usize page_size = (usize)sysconf(_SC_PAGESIZE);
+            return page_size;
+        }
+        void* virtual_alloc(usize size, usize alignment)
+        {
+            if (!size) return nullptr;
+            usize page_size = get_page_size();
+            size = align_upper(size, page_size);
+            if (alignment <= page_size)
+            {
+                void* r = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+                return r == MAP_FAILED ? nullptr : r;
+            }
+            // Over-reserve and trim the unaligned head and tail pages.
+            usize reserve_size = size + alignment - page_size;
+            void* r = mmap(nullptr, reserve_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if (r == MAP_FAILED) return nullptr;
+            usize begin = (usize)r;
+            usize aligned_begin = align_upper(begin, alignment);
+            usize head_size = aligned_begin - begin;
+            usize tail_size = reserve_size - head_size - size;
+            if (head_size) munmap(r, head_size);
+            if (tail_size) munmap((void*)(aligned_begin + size), tail_size);
+            return (void*)aligned_begin;
+        }
+        void virtual_free(void* ptr, usize size)
+        {
+            if (!ptr) return;
+            munmap(ptr, align_upper(size, get_page_size()));
+        }
+        void* virtual_realloc(void* ptr, usize old_size, usize new_size)
+        {
+            usize page_size = get_page_size();
+            old_size = align_upper(old_size, page_size);
+            new_size = align_upper(new_size, page_size);
+            if (old_size == new_size) return ptr;
+#ifdef LUNA_PLATFORM_LINUX
+            void* r = mremap(ptr, old_size, new_size, MREMAP_MAYMOVE);
+            return r == MAP_FAILED ? nullptr : r;
+#else
+            if (new_size < old_size)
+            {
+                munmap((void*)((usize)ptr + new_size), old_size - new_size);
+                return ptr;
+            }
+            // Try to map the pages right after the existing pages first.
+            void* tail = (void*)((usize)ptr + old_size);
+            void* r = mmap(tail, new_size - old_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if (r == tail) return ptr;
+            if (r != MAP_FAILED) munmap(r, new_size - old_size);
+            r = virtual_alloc(new_size);
+            if (!r) return nullptr;
+            memcpy(r, ptr, old_size);
+            munmap(ptr, old_size);
+            return r;
+#endif
+        }
+        usize get_huge_page_size()
+        {
+#ifdef LUNA_PLATFORM_LINUX
+            static usize huge_page_size = []()
+            {
+                // Reads the default huge page size from /proc/meminfo, 2MB is used if the size cannot be read.
+                usize r = 2_mb;
+                FILE* f = fopen("/proc/meminfo", "r");
+                if (f)
+                {
+                    char line[256];
+                    unsigned long size_kb;
+                    while (fgets(line, sizeof(line), f))
+                    {
+                        if (sscanf(line, "Hugepagesize: %lu kB", &size_kb) == 1)
+                        {
+                            if (size_kb) r = (usize)size_kb * 1024;
+                            break;
+                        }
+                    }
+                    fclose(f);
+                }
+                return r;
+            }();
+            return huge_page_size;
+#else
+            return 0;
+#endif
+        }
+        void* huge_page_alloc(usize size, bool explicit_huge_pages, PageBacking& out_backing)
+        {
+            out_backing = PageBacking::normal;
+            if (!size) return nullptr;
+#ifdef LUNA_PLATFORM_LINUX
+            usize huge_page_size = get_huge_page_size();
+            if (explicit_huge_pages)
+            {
+                // Fails if no huge page is reserved in the huge page pool of the system.
+                void* r = mmap(nullptr, align_upper(size, huge_page_size), PROT_READ | PROT_WRITE, 
+                    MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+                if (r != MAP_FAILED)
+                {
+                    out_backing = PageBacking::explicit_huge_pages;
+                    return r;
+                }
+            }
+            // Aligns the range to the huge page size so that it can be fully backed by transparent huge pages.
+            void* r = virtual_alloc(size, huge_page_size);
+            if (!r) return nullptr;
+            if (madvise(r, align_upper(size, get_page_size()), MADV_HUGEPAGE) == 0)
+            {
+                out_backing = PageBacking::transparent_huge_pages;
+            }
+            return r;
+#else
+            return virtual_alloc(size);
 #endif
         }
     }
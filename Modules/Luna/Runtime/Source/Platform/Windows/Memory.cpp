@@ -11,6 +11,7 @@
 #include "../../../Platform/Windows/MiniWin.hpp"
 #include "../../OS.hpp"
 #include <Luna/Runtime/Result.hpp>
+#include <Luna/Runtime/MemoryUtils.hpp>
 
 namespace Luna
 {
@@ -36,10 +37,104 @@ namespace Luna
                 free(ptr);
             }
         }
+        void* memrealloc(void* ptr, usize size, usize alignment /* = 0 */)
+        {
+            if (!ptr) return memalloc(size, alignment);
+            if (!size)
+            {
+                memfree(ptr, alignment);
+                return nullptr;
+            }
+            return (alignment > MAX_ALIGN) ? _aligned_realloc(ptr, size, alignment) : realloc(ptr, size);
+        }
         usize memsize(void* ptr, usize alignment /* = 0 */)
         {
             if (!ptr) return 0;
             return (alignment > MAX_ALIGN) ? _aligned_msize(ptr, alignment, 0) : _msize(ptr);
         }
+        usize get_page_size()
+        {
+            static usize page_size = 0;
+            if (!page_size)
+            {
+                SYSTEM_INFO info;
+                GetSystemInfo(&info);
+                page_size = (usize)info.dwPageSize;
+            }
+            return page_size;
+        }
+        void* virtual_alloc(usize size, usize alignment)
+        {
+            if (!size) return nullptr;
+            size = align_upper(size, get_page_size());
+            SYSTEM_INFO info;
+            GetSystemInfo(&info);
+            // Addresses returned by VirtualAlloc are always aligned to the allocation granularity (usually 64KB).
+            if (alignment <= (usize)info.dwAllocationGranularity)
+            {
+                return VirtualAlloc(nullptr, size, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+            }
+            // Reserve a larger range to find one aligned address, then allocate at that address. 
+            // This may fail if another thread takes the range in between, so we retry several times.
+            for (u32 i = 0; i < 8; ++i)
+            {
+                void* r = VirtualAlloc(nullptr, size + alignment, MEM_RESERVE, PAGE_NOACCESS);
+                if (!r) return nullptr;
+                usize aligned_begin = align_upper((usize)r, alignment);
+                VirtualFree(r, 0, MEM_RELEASE);
+                r = VirtualAlloc((void*)aligned_begin, size, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+                if (r) return r;
+            }
+            return nullptr;
+        }
+        void virtual_free(void* ptr, usize size)
+        {
+            if (!ptr) return;
+            VirtualFree(ptr, 0, MEM_RELEASE);
+        }
+        void* virtual_realloc(void* ptr, usize old_size, usize new_size)
+        {
+            usize page_size = get_page_size();
+            old_size = align_upper(old_size, page_size);
+            new_size = align_upper(new_size, page_size);
+            if (new_size <= old_size)
+            {
+                // Pages of one reservation cannot be released partially, so we only decommit them.
+                if (new_size < old_size)
+                {
+                    VirtualFree((void*)((usize)ptr + new_size), old_size - new_size, MEM_DECOMMIT);
+                }
+                return ptr;
+            }
+            // Windows does not support remapping pages, so we need to copy the data.
+            void* r = virtual_alloc(new_size);
+            if (!r) return nullptr;
+            memcpy(r, ptr, old_size);
+            VirtualFree(ptr, 0, MEM_RELEASE);
+            return r;
+        }
+        usize get_huge_page_size()
+        {
+            static usize huge_page_size = (usize)GetLargePageMinimum();
+            return huge_page_size;
+        }
+        void* huge_page_alloc(usize size, bool explicit_huge_pages, PageBacking& out_backing)
+        {
+            out_backing = PageBacking::normal;
+            if (!size) return nullptr;
+            usize huge_page_size = get_huge_page_size();
+            if (explicit_huge_pages && huge_page_size)
+            {
+                // Fails if the process does not have the SeLockMemoryPrivilege privilege.
+                void* r = VirtualAlloc(nullptr, align_upper(size, huge_page_size), MEM_RESERVE | MEM_COMMIT | MEM_LARGE_PAGES, PAGE_READWRITE);
+                if (r)
+                {
+                    out_backing = PageBacking::explicit_huge_pages;
+                    return r;
+                }
+            }
+            // Windows does not support transparent huge pages.
+            return virtual_alloc(size, huge_page_size);
+        }
     }
 }
\ No newline at end of file
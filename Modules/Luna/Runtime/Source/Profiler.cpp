@@ -16,189 +16,550 @@
 #include "../Thread.hpp"
 #include "OS.hpp"
 #include "../Vector.hpp"
+#include "../SpinLock.hpp"
+#include "../Atomic.hpp"
+#include "AllocationProfiler.hpp"
 
 namespace Luna
 {
     Event<on_profiler_event_t, OSAllocator> g_profiler_callbacks;
     opaque_t g_profiler_callbacks_lock;
-    opaque_t g_profiler_thread_context_tls;
+    // The number of registered callbacks. Events are not recorded if no callback is registered.
+    usize g_num_profiler_callbacks = 0;
+    opaque_t g_profiler_ring_tls;
     bool g_profiler_ready = false;
+    // The handle of the next registered callback, which is the same as the handle returned by `g_profiler_callbacks.add_handler`.
+    usize g_profiler_next_callback_handle = 0;
+    // Callbacks registered and unregistered by profiler callbacks, which are applied after events are dispatched.
+    // These are only accessed by the thread that holds `g_profiler_dispatch_mutex`.
+    Vector<Pair<usize, Function<on_profiler_event_t>>, OSAllocator> g_profiler_pending_callbacks;
+    Vector<usize, OSAllocator> g_profiler_pending_removed_callbacks;
 
-    struct ProfilerEventEntry
+    // Every thread submits events to its own ring buffer, which is written only by the submitting thread
+    // and read only by the thread that holds `g_profiler_dispatch_mutex`, so submitting one event needs no lock. 
+    // Every event is stored as one record with the event data placed inline after the record header.
+    // Records never wrap around the buffer end, one padding record is inserted instead.
+    struct ProfilerEventRecord
     {
+        // `0` for padding records.
         u64 id;
         u64 timestamp;
+        void(*dtor)(void*);
+        // The size of the record including the header and the data.
+        u32 size;
+        // The offset of the data from the record header, or `0` if the event has no data.
+        u32 data_offset;
+    };
+    // Records are aligned to at least the header size, so that one padding record always has room for its header.
+    constexpr usize PROFILER_RECORD_ALIGNMENT = 32;
+    static_assert(sizeof(ProfilerEventRecord) <= PROFILER_RECORD_ALIGNMENT, "Padding records must be able to hold one record header.");
+
+    struct ProfilerEventRing
+    {
+        ProfilerEventRing* next = nullptr;
+        IThread* thread = nullptr;
+        byte_t* buffer = nullptr;
+        usize capacity = 0;
+        // Position of the next record to write, published by the producer when one event is submitted.
+        u64 write_pos = 0;
+        // Position of the next record to read, published by the consumer when records are dispatched.
+        u64 read_pos = 0;
+        u64 num_submitted = 0;
+        u64 num_dropped = 0;
+        // The reserved record that is not submitted yet.
+        u64 pending_pos = 0;
+        usize pending_padding = 0;
+        usize pending_size = 0;
+        usize pending_data_offset = 0;
+        void* pending_data = nullptr;
+        void(*pending_dtor)(void*) = nullptr;
+        bool pending_reserved = false;
+        // Set when the owning thread exits, the ring is freed after all records are dispatched.
+        u32 retired = 0;
+        // Used to store data of events that cannot be recorded.
+        void* scratch = nullptr;
+        usize scratch_size = 0;
+    };
+
+    usize g_profiler_ring_capacity = 0;
+    SpinLock g_profiler_rings_lock;
+    ProfilerEventRing* g_profiler_rings = nullptr;
+    // Statistics of retired rings.
+    u64 g_profiler_retired_submitted = 0;
+    u64 g_profiler_retired_dropped = 0;
+    u64 g_profiler_num_dispatched = 0;
+    opaque_t g_profiler_dispatch_mutex = nullptr;
+    opaque_t g_profiler_collector = nullptr;
+    u32 g_profiler_collector_exiting = 0;
+    // Wakes up the collector thread when it waits for profiler callbacks to be registered.
+    opaque_t g_profiler_collector_signal = nullptr;
+    // Increased every time the profiler is initialized, so that rings cached by threads that outlive one
+    // `profiler_close` are not used after they are freed.
+    u32 g_profiler_generation = 0;
+    static thread_local ProfilerEventRing* tls_profiler_ring = nullptr;
+    static thread_local u32 tls_profiler_ring_generation = 0;
+    static thread_local bool tls_profiler_thread_exited = false;
+    // Set when the current thread is dispatching events, so that callbacks that flush events do not dead lock.
+    static thread_local bool tls_profiler_dispatching = false;
+
+    // Scratch memory for events that are discarded because the profiler is not recording or the thread has no ring.
+    struct ProfilerScratchBuffer
+    {
         void* data = nullptr;
-        usize data_size = 0;
+        usize size = 0;
+        void* pending_data = nullptr;
         void(*dtor)(void*) = nullptr;
+        bool discarded = false;
     };
-    struct ProfilerDataBuffer
+    // The scratch buffer is trivially destructible, so that it can still be used by TLS destructors that run after
+    // C++ thread-local destructors (like deallocating thread-local objects).
+    static thread_local ProfilerScratchBuffer tls_profiler_scratch;
+    // Frees the scratch memory when the thread exits. Events submitted after this use temporary scratch memory, which
+    // is freed when the event is submitted.
+    struct ProfilerScratchBufferGuard
     {
-        void* data;
-        usize size;
-        usize capacity;
-        ProfilerDataBuffer(usize capacity) :
-            capacity(capacity),
-            size(0)
+        ~ProfilerScratchBufferGuard()
         {
-            data = OS::memalloc(capacity);
+            if(tls_profiler_scratch.data) OS::memfree(tls_profiler_scratch.data, 64);
+            tls_profiler_scratch.data = nullptr;
+            tls_profiler_scratch.size = 0;
+            tls_profiler_thread_exited = true;
         }
-        ~ProfilerDataBuffer()
+    };
+    static thread_local ProfilerScratchBufferGuard tls_profiler_scratch_guard;
+
+    static void* get_profiler_scratch(void*& data, usize& data_size, usize size)
+    {
+        if(size > data_size)
         {
-            OS::memfree(data);
+            if(data) OS::memfree(data, 64);
+            data_size = max<usize>(align_upper(size, 64), 256);
+            data = OS::memalloc(data_size, 64);
         }
-    };
-    struct ProfilerThreadContext
+        return data;
+    }
+    static void free_profiler_ring(ProfilerEventRing* ring)
     {
-        Vector<ProfilerEventEntry, OSAllocator> m_events;
-        Vector<ProfilerDataBuffer, OSAllocator> m_event_data_buffers;
-        ProfilerEventEntry m_next_entry;
-
-        bool m_thread_locked_callbacks = false;
-
-        void* allocate_data_buffer(usize size, usize alignment, void(*dtor)(void*));
-        void merge_data_buffers();
-        void dispatch_events();
-    };
-    void profiler_thread_context_dtor(void* data)
+        OS::memfree(ring->buffer, 64);
+        if(ring->scratch) OS::memfree(ring->scratch, 64);
+        OS::memdelete(ring);
+    }
+    static void profiler_ring_dtor(void* data)
     {
-        if(data) OS::memdelete((ProfilerThreadContext*)data);
+        ProfilerEventRing* ring = (ProfilerEventRing*)data;
+        tls_profiler_ring = nullptr;
+        tls_profiler_thread_exited = true;
+        atom_exchange_u32(&ring->retired, 1);
+        // Wakes up the collector so that the ring is freed even if no callback is registered.
+        opaque_t signal = g_profiler_collector_signal;
+        if(signal) OS::trigger_signal(signal);
     }
-    void* ProfilerThreadContext::allocate_data_buffer(usize size, usize alignment, void(*dtor)(void*))
+    static ProfilerEventRing* get_profiler_ring()
     {
-        m_next_entry.data_size = size;
-        m_next_entry.dtor = dtor;
-        m_next_entry.data = nullptr;
-        if(!m_event_data_buffers.empty())
+        ProfilerEventRing* ring = tls_profiler_ring;
+        if(ring && tls_profiler_ring_generation != g_profiler_generation)
         {
-            // try allocate from existing buffer.
-            auto& buffer = m_event_data_buffers.back();
-            usize addr = align_upper((usize)buffer.data + buffer.size, alignment);
-            if(addr + size <= (usize)buffer.data + buffer.capacity)
+            // The ring was freed by the previous `profiler_close`.
+            ring = nullptr;
+            tls_profiler_ring = nullptr;
+        }
+        if(!ring && !tls_profiler_thread_exited)
+        {
+            ring = OS::memnew<ProfilerEventRing>();
+            ring->thread = get_current_thread();
+            ring->capacity = g_profiler_ring_capacity;
+            ring->buffer = (byte_t*)OS::memalloc(ring->capacity, 64);
             {
-                m_next_entry.data = (void*)addr;
-                buffer.size = addr + size - (usize)buffer.data;
+                LockGuard guard(g_profiler_rings_lock);
+                ring->next = g_profiler_rings;
+                g_profiler_rings = ring;
             }
+            tls_profiler_ring = ring;
+            tls_profiler_ring_generation = g_profiler_generation;
+            OS::tls_set(g_profiler_ring_tls, ring);
+        }
+        return ring;
+    }
+    // Reserves space for one record with the specified data size in the ring.
+    static bool reserve_profiler_record(ProfilerEventRing* ring, usize size, usize alignment)
+    {
+        alignment = max<usize>(alignment, PROFILER_RECORD_ALIGNMENT);
+        u64 write_pos = ring->write_pos;
+        u64 read_pos = *((volatile u64*)&ring->read_pos);
+        usize pos = (usize)(write_pos & (ring->capacity - 1));
+        usize padding = 0;
+        usize data_offset = 0;
+        usize record_size;
+        auto compute = [&]()
+        {
+            usize record_addr = (usize)ring->buffer + pos;
+            data_offset = size ? align_upper(record_addr + sizeof(ProfilerEventRecord), alignment) - record_addr : 0;
+            record_size = align_upper((size ? data_offset + size : sizeof(ProfilerEventRecord)), PROFILER_RECORD_ALIGNMENT);
+        };
+        compute();
+        if(pos + record_size > ring->capacity)
+        {
+            padding = ring->capacity - pos;
+            pos = 0;
+            compute();
+        }
+        if(record_size > ring->capacity / 2 || write_pos + padding + record_size - read_pos > ring->capacity)
+        {
+            return false;
         }
-        if(!m_next_entry.data)
+        if(padding)
         {
-            // allocate a new block.
-            usize capacity = alignment > MAX_ALIGN ? size + alignment : size;
-            m_event_data_buffers.emplace_back(capacity);
-            auto& buffer = m_event_data_buffers.back();
-            usize addr = align_upper((usize)buffer.data, alignment);
-            buffer.size = addr + size - (usize)buffer.data;
-            luassert(buffer.size <= buffer.capacity);
-            m_next_entry.data = (void*)addr;
+            ProfilerEventRecord* pad = (ProfilerEventRecord*)(ring->buffer + (usize)(write_pos & (ring->capacity - 1)));
+            pad->id = 0;
+            pad->size = (u32)padding;
         }
-        return m_next_entry.data;
+        ring->pending_pos = write_pos;
+        ring->pending_padding = padding;
+        ring->pending_size = record_size;
+        ring->pending_data_offset = data_offset;
+        ring->pending_data = size ? ring->buffer + pos + data_offset : nullptr;
+        ring->pending_reserved = true;
+        return true;
     }
-    void ProfilerThreadContext::merge_data_buffers()
+    // Applies callbacks registered and unregistered by profiler callbacks.
+    static void apply_pending_profiler_callbacks()
     {
-        if(m_event_data_buffers.size() > 1)
+        if(g_profiler_pending_callbacks.empty() && g_profiler_pending_removed_callbacks.empty()) return;
+        OS::acquire_write_lock(g_profiler_callbacks_lock);
+        for(auto& callback : g_profiler_pending_callbacks)
         {
-            usize sz = 0;
-            for(auto& buffer : m_event_data_buffers)
-            {
-                sz += buffer.capacity;
-            }
-            sz = align_upper(sz, 16);
-            m_event_data_buffers.clear();
-            m_event_data_buffers.emplace_back(sz);
+            usize handle = g_profiler_callbacks.add_handler(move(callback.second));
+            luassert(handle == callback.first);
+            atom_inc_usize(&g_num_profiler_callbacks);
         }
+        for(usize handle : g_profiler_pending_removed_callbacks)
+        {
+            g_profiler_callbacks.remove_handler(handle);
+            atom_dec_usize(&g_num_profiler_callbacks);
+        }
+        OS::release_write_lock(g_profiler_callbacks_lock);
+        g_profiler_pending_callbacks.clear();
+        g_profiler_pending_removed_callbacks.clear();
     }
-    void ProfilerThreadContext::dispatch_events()
+    // Dispatches all events submitted to rings, returns the number of dispatched events.
+    // This must be called with `g_profiler_dispatch_mutex` acquired.
+    static usize dispatch_profiler_events()
     {
-        for(usize i = 0; i < m_events.size(); ++i)
+        struct RingCursor
+        {
+            ProfilerEventRing* ring;
+            u64 pos;
+            u64 end;
+        };
+        static Vector<RingCursor, OSAllocator> cursors;
+        cursors.clear();
+        {
+            LockGuard guard(g_profiler_rings_lock);
+            for(ProfilerEventRing* ring = g_profiler_rings; ring; ring = ring->next)
+            {
+                RingCursor cursor;
+                cursor.ring = ring;
+                cursor.pos = ring->read_pos;
+                // Reads the position with one full barrier, so that all records before the position are visible.
+                cursor.end = atom_add_u64(&ring->write_pos, 0);
+                cursors.push_back(cursor);
+            }
+        }
+        tls_profiler_dispatching = true;
+        usize num_dispatched = 0;
+        auto skip_padding = [](RingCursor& cursor)
+        {
+            while(cursor.pos < cursor.end)
+            {
+                ProfilerEventRecord* record = (ProfilerEventRecord*)(cursor.ring->buffer + (usize)(cursor.pos & (cursor.ring->capacity - 1)));
+                if(record->id) break;
+                cursor.pos += record->size;
+            }
+        };
+        for(auto& cursor : cursors) skip_padding(cursor);
+        OS::acquire_read_lock(g_profiler_callbacks_lock);
+        while(true)
         {
-            ProfilerEvent dst;
-            ProfilerEventEntry& src = m_events[i];
-            dst.data = src.data;
-            dst.id = src.id;
-            dst.timestamp = src.timestamp;
-            dst.thread = get_current_thread();
-            OS::acquire_read_lock(g_profiler_callbacks_lock);
-            g_profiler_callbacks(dst);
-            OS::release_read_lock(g_profiler_callbacks_lock);
+            // Merges events from all rings in timestamp order.
+            RingCursor* next = nullptr;
+            u64 next_timestamp = U64_MAX;
+            for(auto& cursor : cursors)
+            {
+                if(cursor.pos >= cursor.end) continue;
+                ProfilerEventRecord* record = (ProfilerEventRecord*)(cursor.ring->buffer + (usize)(cursor.pos & (cursor.ring->capacity - 1)));
+                if(!next || record->timestamp < next_timestamp)
+                {
+                    next = &cursor;
+                    next_timestamp = record->timestamp;
+                }
+            }
+            if(!next) break;
+            ProfilerEventRecord* record = (ProfilerEventRecord*)(next->ring->buffer + (usize)(next->pos & (next->ring->capacity - 1)));
+            ProfilerEvent e;
+            e.id = record->id;
+            e.timestamp = record->timestamp;
+            e.thread = next->ring->thread;
+            e.data = record->data_offset ? (byte_t*)record + record->data_offset : nullptr;
+            g_profiler_callbacks(e);
+            if(record->dtor) record->dtor((void*)e.data);
+            next->pos += record->size;
+            skip_padding(*next);
+            ++num_dispatched;
         }
-        for(auto& e : m_events)
+        OS::release_read_lock(g_profiler_callbacks_lock);
+        tls_profiler_dispatching = false;
+        apply_pending_profiler_callbacks();
+        atom_add_u64(&g_profiler_num_dispatched, num_dispatched);
+        // Releases the space of dispatched records, and frees rings of exited threads.
+        ProfilerEventRing* retired_rings = nullptr;
         {
-            if(e.dtor) e.dtor(e.data);
+            LockGuard guard(g_profiler_rings_lock);
+            for(auto& cursor : cursors)
+            {
+                ProfilerEventRing* ring = cursor.ring;
+                atom_exchange_u64(&ring->read_pos, cursor.pos);
+                if(*((volatile u32*)&ring->retired) && cursor.pos == *((volatile u64*)&ring->write_pos))
+                {
+                    ProfilerEventRing** link = &g_profiler_rings;
+                    while(*link != ring) link = &((*link)->next);
+                    *link = ring->next;
+                    g_profiler_retired_submitted += ring->num_submitted;
+                    g_profiler_retired_dropped += ring->num_dropped;
+                    ring->next = retired_rings;
+                    retired_rings = ring;
+                }
+            }
         }
-        m_events.clear();
-        merge_data_buffers();
+        while(retired_rings)
+        {
+            ProfilerEventRing* next = retired_rings->next;
+            free_profiler_ring(retired_rings);
+            retired_rings = next;
+        }
+        return num_dispatched;
     }
-    ProfilerThreadContext* get_profiler_thread_context()
+    static void profiler_collector_main(void*)
     {
-        ProfilerThreadContext* ctx = (ProfilerThreadContext*)OS::tls_get(g_profiler_thread_context_tls);
-        if(!ctx)
+        u64 counter_update_interval = get_ticks_per_second() / 100;
+        u64 last_counter_update = 0;
+        while(!*((volatile u32*)&g_profiler_collector_exiting))
         {
-            ctx = OS::memnew<ProfilerThreadContext>();
-            OS::tls_set(g_profiler_thread_context_tls, ctx);
+            if(is_profiler_recording() && get_ticks() - last_counter_update >= counter_update_interval)
+            {
+                update_runtime_profiler_counters();
+                last_counter_update = get_ticks();
+            }
+            OS::lock_mutex(g_profiler_dispatch_mutex);
+            usize num_dispatched = dispatch_profiler_events();
+            OS::unlock_mutex(g_profiler_dispatch_mutex);
+            if(num_dispatched) continue;
+            if(!*((volatile usize*)&g_num_profiler_callbacks))
+            {
+                // Events are not recorded if no callback is registered, so the collector waits until one callback
+                // is registered, one thread with a ring exits, or the profiler is closed.
+                OS::wait_signal(g_profiler_collector_signal);
+            }
+            else
+            {
+                OS::sleep(1);
+            }
         }
-        return ctx;
+        // `profiler_close` frees the ring of this thread after this function returns, so the ring is detached
+        // from the thread to prevent the TLS destructor from accessing the ring when the thread exits.
+        tls_profiler_ring = nullptr;
+        OS::tls_set(g_profiler_ring_tls, nullptr);
     }
-    void profiler_init()
+    void profiler_init(usize event_buffer_size)
     {
-        g_profiler_thread_context_tls = OS::tls_alloc(profiler_thread_context_dtor);
+        usize capacity = 4_kb;
+        while(capacity < event_buffer_size) capacity *= 2;
+        g_profiler_ring_capacity = capacity;
+        ++g_profiler_generation;
+        g_profiler_ring_tls = OS::tls_alloc(profiler_ring_dtor);
         g_profiler_callbacks_lock = OS::new_read_write_lock();
+        g_profiler_dispatch_mutex = OS::new_mutex();
+        g_profiler_collector_exiting = 0;
+        g_profiler_collector_signal = OS::new_signal(false);
+        g_profiler_collector = OS::new_thread(profiler_collector_main, nullptr, "Profiler Collector", 0);
     }
     void profiler_close()
     {
+        atom_exchange_u32(&g_profiler_collector_exiting, 1);
+        OS::trigger_signal(g_profiler_collector_signal);
+        OS::wait_thread(g_profiler_collector);
+        OS::detach_thread(g_profiler_collector);
+        g_profiler_collector = nullptr;
+        // Dispatches remaining events so that event data are destructed.
+        OS::lock_mutex(g_profiler_dispatch_mutex);
+        dispatch_profiler_events();
+        OS::unlock_mutex(g_profiler_dispatch_mutex);
         g_profiler_callbacks.clear();
+        g_num_profiler_callbacks = 0;
+        g_profiler_pending_callbacks.clear();
+        g_profiler_pending_callbacks.shrink_to_fit();
+        g_profiler_pending_removed_callbacks.clear();
+        g_profiler_pending_removed_callbacks.shrink_to_fit();
+        while(g_profiler_rings)
+        {
+            ProfilerEventRing* next = g_profiler_rings->next;
+            free_profiler_ring(g_profiler_rings);
+            g_profiler_rings = next;
+        }
+        tls_profiler_ring = nullptr;
+        g_profiler_retired_submitted = 0;
+        g_profiler_retired_dropped = 0;
+        g_profiler_num_dispatched = 0;
+        OS::delete_mutex(g_profiler_dispatch_mutex);
+        g_profiler_dispatch_mutex = nullptr;
+        OS::delete_signal(g_profiler_collector_signal);
+        g_profiler_collector_signal = nullptr;
         OS::delete_read_write_lock(g_profiler_callbacks_lock);
-        OS::tls_free(g_profiler_thread_context_tls);
+        OS::tls_free(g_profiler_ring_tls);
     }
     LUNA_RUNTIME_API void* allocate_profiler_event_data(usize size, usize alignment, void(*dtor)(void*))
     {
-        auto ctx = get_profiler_thread_context();
-        return ctx->allocate_data_buffer(size, alignment, dtor);
+        ProfilerEventRing* ring = is_profiler_recording() ? get_profiler_ring() : nullptr;
+        if(!ring)
+        {
+            // The event will be discarded, the data is written to scratch memory.
+            tls_profiler_scratch.discarded = true;
+            tls_profiler_scratch.dtor = dtor;
+            usize scratch_alignment = max<usize>(alignment, 64);
+            if(!tls_profiler_scratch.data && !tls_profiler_thread_exited)
+            {
+                // Registers the guard to free the scratch memory when the thread exits.
+                (void)&tls_profiler_scratch_guard;
+            }
+            void* scratch = get_profiler_scratch(tls_profiler_scratch.data, tls_profiler_scratch.size, size + scratch_alignment);
+            tls_profiler_scratch.pending_data = (void*)align_upper((usize)scratch, scratch_alignment);
+            return tls_profiler_scratch.pending_data;
+        }
+        ring->pending_dtor = dtor;
+        if(reserve_profiler_record(ring, size, alignment))
+        {
+            return ring->pending_data;
+        }
+        // The ring is full, the data is written to scratch memory and the event will be dropped.
+        usize scratch_alignment = max<usize>(alignment, 64);
+        void* scratch = get_profiler_scratch(ring->scratch, ring->scratch_size, size + scratch_alignment);
+        ring->pending_data = (void*)align_upper((usize)scratch, scratch_alignment);
+        return ring->pending_data;
     }
     LUNA_RUNTIME_API void submit_profiler_event(u64 event_id)
     {
-        if(!g_profiler_ready) return;
-        auto ctx = get_profiler_thread_context();
-        ctx->m_next_entry.timestamp = OS::get_ticks();
-        ctx->m_next_entry.id = event_id;
-        ctx->m_events.push_back(ctx->m_next_entry);
-        ctx->m_next_entry = ProfilerEventEntry();
-        // This profiler event is issued in another profiler event or register/unregister profiler callback.
-        if(ctx->m_events.size() == 1 && !ctx->m_thread_locked_callbacks)
+        if(tls_profiler_scratch.discarded)
         {
-            ctx->dispatch_events();
+            if(tls_profiler_scratch.dtor) tls_profiler_scratch.dtor(tls_profiler_scratch.pending_data);
+            tls_profiler_scratch.discarded = false;
+            tls_profiler_scratch.dtor = nullptr;
+            if(tls_profiler_thread_exited && tls_profiler_scratch.data)
+            {
+                // The scratch memory guard of this thread may already be destructed, so the memory must not be kept.
+                OS::memfree(tls_profiler_scratch.data, 64);
+                tls_profiler_scratch.data = nullptr;
+                tls_profiler_scratch.size = 0;
+            }
+            return;
         }
+        if(!is_profiler_recording()) return;
+        ProfilerEventRing* ring = get_profiler_ring();
+        if(!ring) return;
+        if(!ring->pending_reserved && !ring->pending_data)
+        {
+            // The event has no data.
+            ring->pending_dtor = nullptr;
+            reserve_profiler_record(ring, 0, 0);
+        }
+        if(ring->pending_reserved)
+        {
+            ProfilerEventRecord* record = (ProfilerEventRecord*)(ring->buffer + 
+                (usize)((ring->pending_pos + ring->pending_padding) & (ring->capacity - 1)));
+            record->id = event_id;
+            record->timestamp = get_ticks();
+            record->dtor = ring->pending_dtor;
+            record->size = (u32)ring->pending_size;
+            record->data_offset = (u32)ring->pending_data_offset;
+            // Publishes the record with one full barrier.
+            atom_exchange_u64(&ring->write_pos, ring->pending_pos + ring->pending_padding + ring->pending_size);
+            *((volatile u64*)&ring->num_submitted) = ring->num_submitted + 1;
+        }
+        else
+        {
+            if(ring->pending_dtor && ring->pending_data) ring->pending_dtor(ring->pending_data);
+            *((volatile u64*)&ring->num_dropped) = ring->num_dropped + 1;
+        }
+        ring->pending_reserved = false;
+        ring->pending_data = nullptr;
+        ring->pending_dtor = nullptr;
+    }
+    LUNA_RUNTIME_API void flush_profiler_events()
+    {
+        if(!g_profiler_dispatch_mutex || tls_profiler_dispatching) return;
+        OS::lock_mutex(g_profiler_dispatch_mutex);
+        dispatch_profiler_events();
+        OS::unlock_mutex(g_profiler_dispatch_mutex);
+    }
+    LUNA_RUNTIME_API ProfilerEventStats get_profiler_event_stats()
+    {
+        ProfilerEventStats r;
+        LockGuard guard(g_profiler_rings_lock);
+        r.num_submitted_events = g_profiler_retired_submitted;
+        r.num_dropped_events = g_profiler_retired_dropped;
+        for(ProfilerEventRing* ring = g_profiler_rings; ring; ring = ring->next)
+        {
+            r.num_submitted_events += *((volatile u64*)&ring->num_submitted);
+            r.num_dropped_events += *((volatile u64*)&ring->num_dropped);
+        }
+        r.num_dispatched_events = *((volatile u64*)&g_profiler_num_dispatched);
+        return r;
     }
     LUNA_RUNTIME_API usize register_profiler_callback(const Function<on_profiler_event_t>& handler)
     {
-        auto ctx = get_profiler_thread_context();
         auto move_handler = handler;
-        // Any events that occur in write scope will trigger dead lock, so we use m_thread_locked_callbacks to prevent dispatching events in write scope.
+        if(tls_profiler_dispatching)
+        {
+            // Called by one profiler callback, which holds the read lock of callbacks.
+            usize r = g_profiler_next_callback_handle++;
+            g_profiler_pending_callbacks.push_back(make_pair(r, move(move_handler)));
+            return r;
+        }
+        // Dispatches events submitted before this call to existing callbacks, so that the new callback
+        // only receives events submitted after it is registered.
+        opaque_t dispatch_mutex = g_profiler_dispatch_mutex;
+        if(dispatch_mutex)
+        {
+            OS::lock_mutex(dispatch_mutex);
+            dispatch_profiler_events();
+        }
         OS::acquire_write_lock(g_profiler_callbacks_lock);
-        ctx->m_thread_locked_callbacks = true;
         usize r = g_profiler_callbacks.add_handler(move(move_handler));
-        ctx->m_thread_locked_callbacks = false;
+        g_profiler_next_callback_handle = r + 1;
+        atom_inc_usize(&g_num_profiler_callbacks);
         OS::release_write_lock(g_profiler_callbacks_lock);
-        // Dispatch any events that occur during registration.
-        if(!ctx->m_events.empty())
-        {
-            ctx->dispatch_events();
-        }
+        if(dispatch_mutex) OS::unlock_mutex(dispatch_mutex);
+        if(g_profiler_collector_signal) OS::trigger_signal(g_profiler_collector_signal);
         return r;
     }
     LUNA_RUNTIME_API void unregister_profiler_callback(usize handler_id)
     {
-        auto ctx = get_profiler_thread_context();
-        // Any events that occur in write scope will trigger dead lock, so we use m_thread_locked_callbacks to prevent dispatching events in write scope.
+        if(tls_profiler_dispatching)
+        {
+            // Called by one profiler callback, which holds the read lock of callbacks.
+            for(auto iter = g_profiler_pending_callbacks.begin(); iter != g_profiler_pending_callbacks.end(); ++iter)
+            {
+                if(iter->first == handler_id)
+                {
+                    g_profiler_pending_callbacks.erase(iter);
+                    return;
+                }
+            }
+            g_profiler_pending_removed_callbacks.push_back(handler_id);
+            return;
+        }
         OS::acquire_write_lock(g_profiler_callbacks_lock);
-        ctx->m_thread_locked_callbacks = true;
         g_profiler_callbacks.remove_handler(handler_id);
-        ctx->m_thread_locked_callbacks = false;
+        atom_dec_usize(&g_num_profiler_callbacks);
         OS::release_write_lock(g_profiler_callbacks_lock);
-        // Dispatch any events that occur during unregistration.
-        if(!ctx->m_events.empty())
-        {
-            ctx->dispatch_events();
-        }
     }
 #ifdef LUNA_MEMORY_PROFILER_ENABLED
     LUNA_RUNTIME_API void memory_profiler_allocate(void* ptr, usize size)
@@ -210,13 +571,14 @@ namespace Luna
         data->size = size;
         submit_profiler_event(ProfilerEventId::MEMORY_ALLOCATE);
     }
-    LUNA_RUNTIME_API void memory_profiler_deallocate(void* ptr)
+    LUNA_RUNTIME_API void memory_profiler_deallocate(void* ptr, usize size)
     {
         ProfilerEventData::MemoryDeallocate* data = (ProfilerEventData::MemoryDeallocate*)allocate_profiler_event_data(
             sizeof(ProfilerEventData::MemoryDeallocate),
             alignof(ProfilerEventData::MemoryDeallocate)
         );
         data->ptr = ptr;
+        data->size = size;
         submit_profiler_event(ProfilerEventId::MEMORY_DEALLOCATE);
     }
     LUNA_RUNTIME_API void memory_profiler_set_memory_name(void* ptr, const c8* name, usize str_size)
@@ -233,6 +595,7 @@ namespace Luna
     LUNA_RUNTIME_API void memory_profiler_set_memory_type(void* ptr, const c8* type, usize str_size)
     {
         if(str_size == USIZE_MAX) str_size = strlen(type);
+        allocation_profiler_set_memory_type(ptr, type, str_size);
         usize sz = sizeof(ProfilerEventData::SetMemoryType) + str_size; // One extra character is allocated in structure.
         ProfilerEventData::SetMemoryType* data = (ProfilerEventData::SetMemoryType*)allocate_profiler_event_data(sz, alignof(ProfilerEventData::SetMemoryType));
         data->ptr = ptr;
@@ -244,6 +607,7 @@ namespace Luna
     LUNA_RUNTIME_API void memory_profiler_set_memory_domain(void* ptr, const c8* domain, usize str_size)
     {
         if(str_size == USIZE_MAX) str_size = strlen(domain);
+        allocation_profiler_set_memory_domain(ptr, domain, str_size);
         usize sz = sizeof(ProfilerEventData::SetMemoryDomain) + str_size; // One extra character is allocated in structure.
         ProfilerEventData::SetMemoryDomain* data = (ProfilerEventData::SetMemoryDomain*)allocate_profiler_event_data(sz, alignof(ProfilerEventData::SetMemoryDomain));
         data->ptr = ptr;
@@ -12,8 +12,22 @@
 
 namespace Luna
 {
-    void profiler_init();
+    void profiler_init(usize event_buffer_size);
     void profiler_close();
+    void cpu_profiler_close();
+    void profiler_counter_init();
+    void profiler_counter_close();
+    // Emits current values of all counter channels, used when one trace capture begins.
+    void emit_profiler_counter_values();
+    // Updates counters maintained by the runtime. Called periodically by the profiler collector thread.
+    void update_runtime_profiler_counters();
     // Used to disable profiler when LunaSDK Runtime is initializing or closing.
     extern bool g_profiler_ready;
+    // The number of registered profiler callbacks.
+    extern usize g_num_profiler_callbacks;
+    // Checks whether submitted profiler events are recorded.
+    inline bool is_profiler_recording()
+    {
+        return g_profiler_ready && *((volatile usize*)&g_num_profiler_callbacks);
+    }
 }
\ No newline at end of file
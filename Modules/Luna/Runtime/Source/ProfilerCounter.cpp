@@ -0,0 +1,205 @@
+/*!
+* This file is a portion of LunaSDK.
+* For conditions of distribution and use, see the disclaimer
+* and license in LICENSE.txt
+*
+* @file ProfilerCounter.cpp
+* @author JXMaster
+* @date 2026/10/18
+*/
+#include "../PlatformDefines.hpp"
+#define LUNA_RUNTIME_API LUNA_EXPORT
+#include "Profiler.hpp"
+#include "OS.hpp"
+#include "../SpinLock.hpp"
+#include "../HashMap.hpp"
+#include "../Atomic.hpp"
+#include "../Time.hpp"
+#include "../Memory.hpp"
+
+namespace Luna
+{
+    constexpr u64 F64_POSITIVE_INFINITY_BITS = 0x7FF0000000000000ULL;
+    constexpr u64 F64_NEGATIVE_INFINITY_BITS = 0xFFF0000000000000ULL;
+
+    struct ProfilerCounterChannel
+    {
+        Name name;
+        ProfilerCounterType type;
+        // Values are stored as bits of `f64`, so that they can be updated by atomic operations.
+        u64 value = 0;
+        // The range of values since the last snapshot. The range is empty (`+inf` to `-inf`) until the channel is
+        // updated for the first time, so that the initial value is not counted if it is never set.
+        u64 min_value = F64_POSITIVE_INFINITY_BITS;
+        u64 max_value = F64_NEGATIVE_INFINITY_BITS;
+        u64 num_updates = 0;
+        // The value when the last snapshot is taken, only accessed with `g_profiler_counters_lock` acquired.
+        f64 snapshot_value = 0.0;
+    };
+
+    SpinLock g_profiler_counters_lock;
+    Vector<ProfilerCounterChannel*, OSAllocator> g_profiler_counters;
+    HashMap<Name, ProfilerCounterChannel*, hash<Name>, equal_to<Name>, OSAllocator> g_profiler_counter_map;
+    u64 g_profiler_metrics_begin_ticks = 0;
+    // Counters maintained by the runtime, protected by `g_profiler_counters_lock`.
+    profiler_counter_t g_memory_allocated_bytes_counter = nullptr;
+
+    inline u64 f64_to_bits(f64 v)
+    {
+        u64 r;
+        memcpy(&r, &v, sizeof(u64));
+        return r;
+    }
+    inline f64 bits_to_f64(u64 v)
+    {
+        f64 r;
+        memcpy(&r, &v, sizeof(f64));
+        return r;
+    }
+    // Starts the range of the next interval from `value`, and returns the old bound. The range is kept empty if
+    // the channel has never been updated.
+    static f64 reset_profiler_counter_bound(u64* bound, u64 empty_bits, f64 value)
+    {
+        u64 old_bits = *((volatile u64*)bound);
+        while(old_bits != empty_bits)
+        {
+            u64 prev = atom_compare_exchange_u64(bound, f64_to_bits(value), old_bits);
+            if(prev == old_bits) break;
+            old_bits = prev;
+        }
+        return bits_to_f64(old_bits);
+    }
+    static void emit_profiler_counter_value(ProfilerCounterChannel* channel, f64 value)
+    {
+        ProfilerEventData::CounterValue* data = (ProfilerEventData::CounterValue*)allocate_profiler_event_data(
+            sizeof(ProfilerEventData::CounterValue),
+            alignof(ProfilerEventData::CounterValue));
+        data->name = channel->name.c_str();
+        data->value = value;
+        data->type = channel->type;
+        submit_profiler_event(ProfilerEventId::COUNTER_VALUE);
+    }
+    static void on_profiler_counter_updated(ProfilerCounterChannel* channel, f64 value)
+    {
+        u64 bound = *((volatile u64*)&channel->min_value);
+        while(value < bits_to_f64(bound))
+        {
+            u64 prev = atom_compare_exchange_u64(&channel->min_value, f64_to_bits(value), bound);
+            if(prev == bound) break;
+            bound = prev;
+        }
+        bound = *((volatile u64*)&channel->max_value);
+        while(value > bits_to_f64(bound))
+        {
+            u64 prev = atom_compare_exchange_u64(&channel->max_value, f64_to_bits(value), bound);
+            if(prev == bound) break;
+            bound = prev;
+        }
+        atom_inc_u64(&channel->num_updates);
+        if(is_profiler_recording()) emit_profiler_counter_value(channel, value);
+    }
+    void profiler_counter_init()
+    {
+        g_memory_allocated_bytes_counter = get_profiler_counter("Memory/Allocated Bytes", ProfilerCounterType::gauge);
+    }
+    void profiler_counter_close()
+    {
+        // Dispatches events that refer names of channels before channels are destroyed.
+        flush_profiler_events();
+        LockGuard guard(g_profiler_counters_lock);
+        g_memory_allocated_bytes_counter = nullptr;
+        for(ProfilerCounterChannel* channel : g_profiler_counters)
+        {
+            OS::memdelete(channel);
+        }
+        g_profiler_counters.clear();
+        g_profiler_counters.shrink_to_fit();
+        g_profiler_counter_map.clear();
+        g_profiler_counter_map.shrink_to_fit();
+        g_profiler_metrics_begin_ticks = 0;
+    }
+    void update_runtime_profiler_counters()
+    {
+        LockGuard guard(g_profiler_counters_lock);
+        if(!g_memory_allocated_bytes_counter) return;
+        profiler_counter_set(g_memory_allocated_bytes_counter, (f64)get_memory_stats().allocated_bytes);
+    }
+    void emit_profiler_counter_values()
+    {
+        LockGuard guard(g_profiler_counters_lock);
+        for(ProfilerCounterChannel* channel : g_profiler_counters)
+        {
+            emit_profiler_counter_value(channel, bits_to_f64(*((volatile u64*)&channel->value)));
+        }
+    }
+    LUNA_RUNTIME_API profiler_counter_t get_profiler_counter(const Name& name, ProfilerCounterType type)
+    {
+        if(!name) return nullptr;
+        LockGuard guard(g_profiler_counters_lock);
+        auto iter = g_profiler_counter_map.find(name);
+        if(iter != g_profiler_counter_map.end()) return iter->second;
+        ProfilerCounterChannel* channel = OS::memnew<ProfilerCounterChannel>();
+        channel->name = name;
+        channel->type = type;
+        if(g_profiler_counters.empty()) g_profiler_metrics_begin_ticks = get_ticks();
+        g_profiler_counters.push_back(channel);
+        g_profiler_counter_map.insert(make_pair(name, channel));
+        return channel;
+    }
+    LUNA_RUNTIME_API void profiler_counter_add(profiler_counter_t counter, f64 delta)
+    {
+        if(!counter) return;
+        ProfilerCounterChannel* channel = (ProfilerCounterChannel*)counter;
+        u64 old_bits = *((volatile u64*)&channel->value);
+        while(true)
+        {
+            f64 value = bits_to_f64(old_bits) + delta;
+            u64 prev = atom_compare_exchange_u64(&channel->value, f64_to_bits(value), old_bits);
+            if(prev == old_bits)
+            {
+                on_profiler_counter_updated(channel, value);
+                return;
+            }
+            old_bits = prev;
+        }
+    }
+    LUNA_RUNTIME_API void profiler_counter_set(profiler_counter_t counter, f64 value)
+    {
+        if(!counter) return;
+        ProfilerCounterChannel* channel = (ProfilerCounterChannel*)counter;
+        atom_exchange_u64(&channel->value, f64_to_bits(value));
+        on_profiler_counter_updated(channel, value);
+    }
+    LUNA_RUNTIME_API f64 get_profiler_counter_value(profiler_counter_t counter)
+    {
+        if(!counter) return 0.0;
+        ProfilerCounterChannel* channel = (ProfilerCounterChannel*)counter;
+        return bits_to_f64(*((volatile u64*)&channel->value));
+    }
+    LUNA_RUNTIME_API ProfilerMetricsSnapshot take_profiler_metrics_snapshot()
+    {
+        update_runtime_profiler_counters();
+        ProfilerMetricsSnapshot r;
+        LockGuard guard(g_profiler_counters_lock);
+        u64 ticks = get_ticks();
+        r.interval = g_profiler_metrics_begin_ticks ? (f64)(ticks - g_profiler_metrics_begin_ticks) / (f64)get_ticks_per_second() : 0.0;
+        g_profiler_metrics_begin_ticks = ticks;
+        r.counters.reserve(g_profiler_counters.size());
+        for(ProfilerCounterChannel* channel : g_profiler_counters)
+        {
+            ProfilerCounterMetrics metrics;
+            metrics.name = channel->name;
+            metrics.type = channel->type;
+            f64 value = bits_to_f64(*((volatile u64*)&channel->value));
+            metrics.value = value;
+            // The range of the next interval starts from the current value.
+            metrics.min_value = min(reset_profiler_counter_bound(&channel->min_value, F64_POSITIVE_INFINITY_BITS, value), value);
+            metrics.max_value = max(reset_profiler_counter_bound(&channel->max_value, F64_NEGATIVE_INFINITY_BITS, value), value);
+            metrics.delta = value - channel->snapshot_value;
+            channel->snapshot_value = value;
+            metrics.num_updates = atom_exchange_u64(&channel->num_updates, 0);
+            r.counters.push_back(move(metrics));
+        }
+        return r;
+    }
+}
@@ -21,7 +21,7 @@ namespace Luna
         register_boxed_type<Random>();
         impl_interface_for_type<Random, IRandom>();
         g_random_engine.seed((unsigned int)get_ticks());
-        g_random_mutex = new_mutex();
+        g_random_mutex = new_mutex("Runtime/Random");
     }
     void random_close()
     {
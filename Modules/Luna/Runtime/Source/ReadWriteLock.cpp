@@ -13,8 +13,12 @@
 #include "ReadWriteLock.hpp"
 namespace Luna
 {
-    LUNA_RUNTIME_API Ref<IReadWriteLock> new_read_write_lock()
+    LUNA_RUNTIME_API Ref<IReadWriteLock> new_read_write_lock(const c8* name)
     {
-        return new_object<ReadWriteLock>();
+        Ref<ReadWriteLock> r = new_object<ReadWriteLock>();
+#ifdef LUNA_LOCK_PROFILER_ENABLED
+        r->m_site = get_lock_profiler_site(name);
+#endif
+        return r;
     }
 }
\ No newline at end of file
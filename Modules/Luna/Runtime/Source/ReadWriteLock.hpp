@@ -19,6 +19,11 @@ namespace Luna
         luiimpl();
 
         opaque_t m_handle;
+#ifdef LUNA_LOCK_PROFILER_ENABLED
+        lock_profiler_site_t m_site = nullptr;
+        // The ticks when the write ownership is acquired.
+        u64 m_acquire_ticks = 0;
+#endif
 
         ReadWriteLock()
         {
@@ -30,19 +35,62 @@ namespace Luna
         }
         virtual void acquire_read() override
         {
+#ifdef LUNA_LOCK_PROFILER_ENABLED
+            if (m_site)
+            {
+                u64 wait_ticks = 0;
+                bool contended = !OS::try_acquire_read_lock(m_handle);
+                if (contended)
+                {
+                    u64 begin_ticks = get_ticks();
+                    OS::acquire_read_lock(m_handle);
+                    wait_ticks = get_ticks() - begin_ticks;
+                }
+                lock_profiler_record_acquire(m_site, wait_ticks, contended);
+                return;
+            }
+#endif
             OS::acquire_read_lock(m_handle);
         }
         virtual void acquire_write() override
         {
+#ifdef LUNA_LOCK_PROFILER_ENABLED
+            if (m_site)
+            {
+                u64 wait_ticks = 0;
+                bool contended = !OS::try_acquire_write_lock(m_handle);
+                if (contended)
+                {
+                    u64 begin_ticks = get_ticks();
+                    OS::acquire_write_lock(m_handle);
+                    wait_ticks = get_ticks() - begin_ticks;
+                }
+                lock_profiler_record_acquire(m_site, wait_ticks, contended);
+                m_acquire_ticks = get_ticks();
+                return;
+            }
+#endif
             OS::acquire_write_lock(m_handle);
         }
         virtual bool try_acquire_read() override
         {
-            return OS::try_acquire_read_lock(m_handle);
+            bool r = OS::try_acquire_read_lock(m_handle);
+#ifdef LUNA_LOCK_PROFILER_ENABLED
+            if (r && m_site) lock_profiler_record_acquire(m_site, 0, false);
+#endif
+            return r;
         }
         virtual bool try_acquire_write() override
         {
-            return OS::try_acquire_write_lock(m_handle);
+            bool r = OS::try_acquire_write_lock(m_handle);
+#ifdef LUNA_LOCK_PROFILER_ENABLED
+            if (r && m_site)
+            {
+                lock_profiler_record_acquire(m_site, 0, false);
+                m_acquire_ticks = get_ticks();
+            }
+#endif
+            return r;
         }
         virtual void release_read() override
         {
@@ -50,6 +98,9 @@ namespace Luna
         }
         virtual void release_write() override
         {
+#ifdef LUNA_LOCK_PROFILER_ENABLED
+            if (m_site) lock_profiler_record_release(m_site, get_ticks() - m_acquire_ticks);
+#endif
             OS::release_write_lock(m_handle);
         }
     };
@@ -26,10 +26,12 @@
 #include "ReadWriteLock.hpp"
 #include "StdIO.hpp"
 #include "Profiler.hpp"
+#include "AllocationProfiler.hpp"
 namespace Luna
 {
     void error_init();
     void error_close();
+    void object_init();
     void object_close();
     void add_builtin_typeinfo();
 
@@ -63,15 +65,19 @@ namespace Luna
 
     static bool g_initialized = false;
 
-    LUNA_RUNTIME_API bool init()
+    LUNA_RUNTIME_API bool init(const InitDesc& desc)
     {
         if (g_initialized) return true;
         OS::init();
-        profiler_init();
+        memory_init(desc.heap_allocator, desc.huge_page_threshold);
+        allocation_profiler_init();
+        profiler_init(desc.profiler_event_buffer_size);
         stack_allocator_init();
         error_init();
         name_init();
+        profiler_counter_init();
         type_registry_init();
+        object_init();
         add_builtin_typeinfo();
         register_types_and_interfaces();
         thread_init();
@@ -91,7 +97,10 @@ namespace Luna
     {
         if (!g_initialized) return;
         module_close();
+        allocation_profiler_close();
         g_profiler_ready = false;
+        cpu_profiler_close();
+        profiler_counter_close();
         std_io_close();
         log_close();
         random_close();
@@ -102,6 +111,7 @@ namespace Luna
         error_close();
         stack_allocator_close();
         profiler_close();
+        memory_close();
         OS::close();
         g_initialized = false;
     }
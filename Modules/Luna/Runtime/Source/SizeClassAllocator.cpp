@@ -0,0 +1,398 @@
+/*!
+* This file is a portion of LunaSDK.
+* For conditions of distribution and use, see the disclaimer
+* and license in LICENSE.txt
+*
+* @file SizeClassAllocator.cpp
+* @author JXMaster
+* @date 2026/10/18
+*/
+#include "../PlatformDefines.hpp"
+#include "SizeClassAllocator.hpp"
+#include "OS.hpp"
+#include "../SpinLock.hpp"
+#include "../MemoryUtils.hpp"
+#include "../Algorithm.hpp"
+#include "../Assert.hpp"
+
+namespace Luna
+{
+    // Small memory blocks are carved from spans. Every span is one SPAN_SIZE-aligned memory region that
+    // stores blocks of one size class, so the span header of one block can be found by masking the block address.
+    constexpr usize SPAN_SHIFT = 16;
+    constexpr usize SPAN_SIZE = (usize)1 << SPAN_SHIFT;
+    // Spans are fetched from the OS in regions to reduce system calls.
+    constexpr usize SPANS_PER_REGION = 16;
+    // The span header is stored at the beginning of the span, blocks are stored after this offset.
+    constexpr usize SPAN_DATA_OFFSET = 256;
+    // Alignments larger than this, or blocks larger than MAX_SMALL_SIZE, are allocated from the system heap.
+    constexpr usize MAX_SMALL_ALIGNMENT = SPAN_DATA_OFFSET;
+    constexpr usize MAX_SMALL_SIZE = 8_kb;
+    // 8 classes in 16 bytes steps up to 128 bytes, then 4 classes for every power of 2 up to MAX_SMALL_SIZE.
+    constexpr u32 NUM_SIZE_CLASSES = 32;
+
+    struct SpanHeader
+    {
+        // Links spans in the central list of their size class.
+        SpanHeader* next;
+        SpanHeader* prev;
+        // Blocks that are returned to this span.
+        void* free_list;
+        // The part of the span that is not carved into blocks yet.
+        byte_t* bump;
+        byte_t* end;
+        u32 size_class;
+        // The number of blocks that are held by thread caches or users.
+        u32 num_allocated;
+    };
+    static_assert(sizeof(SpanHeader) <= SPAN_DATA_OFFSET, "SpanHeader header too large.");
+
+    u32 g_class_sizes[NUM_SIZE_CLASSES];
+    u32 g_class_batch_sizes[NUM_SIZE_CLASSES];
+    // Size to class lookup tables, indexed by `(size + 15) / 16` for size <= 1024 and `(size + 127) / 128` for size <= 8192.
+    u8 g_small_size_classes[1024 / 16 + 1];
+    u8 g_large_size_classes[MAX_SMALL_SIZE / 128 + 1];
+
+    inline u32 get_size_class(usize size)
+    {
+        return size <= 1024 ? g_small_size_classes[(size + 15) >> 4] : g_large_size_classes[(size + 127) >> 7];
+    }
+
+    inline SpanHeader* get_span(const void* ptr)
+    {
+        return (SpanHeader*)((usize)ptr & ~(SPAN_SIZE - 1));
+    }
+
+    // The page map records which SPAN_SIZE regions of the 48-bit address space belong to spans.
+    // The map is one two-level bit table, leaves are allocated on demand and are never freed, so
+    // lookups need no lock.
+    constexpr usize PAGE_MAP_ADDRESS_BITS = 48;
+    constexpr usize PAGE_MAP_LEAF_BITS = 16;
+    constexpr usize PAGE_MAP_LEAF_SIZE = (usize)1 << PAGE_MAP_LEAF_BITS;
+    constexpr usize PAGE_MAP_ROOT_SIZE = (usize)1 << (PAGE_MAP_ADDRESS_BITS - SPAN_SHIFT - PAGE_MAP_LEAF_BITS);
+    u64* volatile g_page_map[PAGE_MAP_ROOT_SIZE];
+
+    inline bool page_map_test(u64 addr)
+    {
+        if (addr >> PAGE_MAP_ADDRESS_BITS) return false;
+        u64 region = addr >> SPAN_SHIFT;
+        const u64* leaf = g_page_map[region >> PAGE_MAP_LEAF_BITS];
+        if (!leaf) return false;
+        usize bit = (usize)(region & (PAGE_MAP_LEAF_SIZE - 1));
+        return (leaf[bit >> 6] >> (bit & 63)) & 1;
+    }
+    // Called with g_span_pool_lock held.
+    bool page_map_set(u64 addr)
+    {
+        u64 region = addr >> SPAN_SHIFT;
+        usize root_index = (usize)(region >> PAGE_MAP_LEAF_BITS);
+        u64* leaf = g_page_map[root_index];
+        if (!leaf)
+        {
+            leaf = (u64*)OS::virtual_alloc(PAGE_MAP_LEAF_SIZE / 8);
+            if (!leaf) return false;
+            g_page_map[root_index] = leaf;
+        }
+        usize bit = (usize)(region & (PAGE_MAP_LEAF_SIZE - 1));
+        leaf[bit >> 6] |= ((u64)1 << (bit & 63));
+        return true;
+    }
+
+    // The global pool of unused spans.
+    SpinLock g_span_pool_lock;
+    SpanHeader* g_free_spans = nullptr;
+
+    SpanHeader* allocate_span()
+    {
+        LockGuard guard(g_span_pool_lock);
+        if (!g_free_spans)
+        {
+            usize region_size = SPAN_SIZE * SPANS_PER_REGION;
+            byte_t* region = (byte_t*)OS::virtual_alloc(region_size, SPAN_SIZE);
+            if (!region) return nullptr;
+            if (((u64)(usize)region + region_size) >> PAGE_MAP_ADDRESS_BITS)
+            {
+                // Out of the range that can be recorded by the page map.
+                OS::virtual_free(region, region_size);
+                return nullptr;
+            }
+            for (usize i = 0; i < SPANS_PER_REGION; ++i)
+            {
+                if (!page_map_set((u64)(usize)(region + SPAN_SIZE * i)))
+                {
+                    // Spans that are already recorded are kept in the pool.
+                    if (i == 0) OS::virtual_free(region, region_size);
+                    break;
+                }
+                SpanHeader* span = (SpanHeader*)(region + SPAN_SIZE * i);
+                span->next = g_free_spans;
+                g_free_spans = span;
+            }
+            if (!g_free_spans) return nullptr;
+        }
+        SpanHeader* span = g_free_spans;
+        g_free_spans = span->next;
+        return span;
+    }
+
+    void free_span(SpanHeader* span)
+    {
+        LockGuard guard(g_span_pool_lock);
+        span->next = g_free_spans;
+        g_free_spans = span;
+    }
+
+    // The central list stores spans that have free blocks for one size class.
+    struct CentralList
+    {
+        SpinLock m_lock;
+        SpanHeader* m_spans = nullptr;
+
+        void link(SpanHeader* span)
+        {
+            span->prev = nullptr;
+            span->next = m_spans;
+            if (m_spans) m_spans->prev = span;
+            m_spans = span;
+        }
+        void unlink(SpanHeader* span)
+        {
+            if (span->prev) span->prev->next = span->next;
+            else m_spans = span->next;
+            if (span->next) span->next->prev = span->prev;
+            span->next = nullptr;
+            span->prev = nullptr;
+        }
+    };
+    CentralList g_central_lists[NUM_SIZE_CLASSES];
+
+    inline bool is_span_full(SpanHeader* span)
+    {
+        return !span->free_list && span->bump == span->end;
+    }
+
+    // Fetches at most `count` blocks from the central list. Returns the number of blocks fetched.
+    u32 central_fetch(u32 size_class, u32 count, void** out_head)
+    {
+        CentralList& central = g_central_lists[size_class];
+        usize block_size = g_class_sizes[size_class];
+        void* head = nullptr;
+        u32 fetched = 0;
+        LockGuard guard(central.m_lock);
+        while (fetched < count)
+        {
+            SpanHeader* span = central.m_spans;
+            if (!span)
+            {
+                span = allocate_span();
+                if (!span) break;
+                span->free_list = nullptr;
+                span->bump = (byte_t*)span + SPAN_DATA_OFFSET;
+                span->end = span->bump + (SPAN_SIZE - SPAN_DATA_OFFSET) / block_size * block_size;
+                span->size_class = size_class;
+                span->num_allocated = 0;
+                central.link(span);
+            }
+            while (fetched < count)
+            {
+                void* block;
+                if (span->free_list)
+                {
+                    block = span->free_list;
+                    span->free_list = *(void**)block;
+                }
+                else if (span->bump != span->end)
+                {
+                    block = span->bump;
+                    span->bump += block_size;
+                }
+                else break;
+                *(void**)block = head;
+                head = block;
+                ++span->num_allocated;
+                ++fetched;
+            }
+            if (is_span_full(span))
+            {
+                central.unlink(span);
+            }
+        }
+        *out_head = head;
+        return fetched;
+    }
+
+    // Returns one linked list of blocks to the central list.
+    void central_release(u32 size_class, void* head)
+    {
+        CentralList& central = g_central_lists[size_class];
+        LockGuard guard(central.m_lock);
+        while (head)
+        {
+            void* block = head;
+            head = *(void**)block;
+            SpanHeader* span = get_span(block);
+            bool was_full = is_span_full(span);
+            *(void**)block = span->free_list;
+            span->free_list = block;
+            --span->num_allocated;
+            if (was_full)
+            {
+                central.link(span);
+            }
+            // Keeps at least one span for every size class to prevent creating and destroying spans repeatedly.
+            if (!span->num_allocated && (span->next || span->prev))
+            {
+                central.unlink(span);
+                free_span(span);
+            }
+        }
+    }
+
+    struct ThreadCacheFreeList
+    {
+        void* m_head = nullptr;
+        u32 m_length = 0;
+    };
+
+    struct ThreadCache
+    {
+        ThreadCacheFreeList m_lists[NUM_SIZE_CLASSES];
+
+        void release(u32 size_class, u32 count)
+        {
+            ThreadCacheFreeList& list = m_lists[size_class];
+            void* head = list.m_head;
+            void* tail = head;
+            for (u32 i = 1; i < count; ++i)
+            {
+                tail = *(void**)tail;
+            }
+            list.m_head = *(void**)tail;
+            list.m_length -= count;
+            *(void**)tail = nullptr;
+            central_release(size_class, head);
+        }
+        void flush()
+        {
+            for (u32 i = 0; i < NUM_SIZE_CLASSES; ++i)
+            {
+                if (m_lists[i].m_length)
+                {
+                    release(i, m_lists[i].m_length);
+                }
+            }
+        }
+    };
+    // The pointer is trivially constructible so that accessing it needs no initialization guard.
+    static thread_local ThreadCache* tls_thread_cache = nullptr;
+    // The OS TLS slot is used only to flush and free the thread cache when the thread exits.
+    opaque_t g_thread_cache_tls = nullptr;
+
+    void thread_cache_dtor(void* data)
+    {
+        ThreadCache* cache = (ThreadCache*)data;
+        tls_thread_cache = nullptr;
+        cache->flush();
+        OS::memdelete(cache);
+    }
+
+    ThreadCache* get_thread_cache()
+    {
+        ThreadCache* cache = tls_thread_cache;
+        if (!cache)
+        {
+            cache = OS::memnew<ThreadCache>();
+            tls_thread_cache = cache;
+            OS::tls_set(g_thread_cache_tls, cache);
+        }
+        return cache;
+    }
+
+    void size_class_allocator_init()
+    {
+        if (g_class_sizes[0]) return;
+        g_thread_cache_tls = OS::tls_alloc(thread_cache_dtor);
+        u32 num_classes = 0;
+        for (u32 size = 16; size <= 128; size += 16)
+        {
+            g_class_sizes[num_classes++] = size;
+        }
+        for (u32 base = 128; base < MAX_SMALL_SIZE; base *= 2)
+        {
+            for (u32 i = 1; i <= 4; ++i)
+            {
+                g_class_sizes[num_classes++] = base + base / 4 * i;
+            }
+        }
+        luassert(num_classes == NUM_SIZE_CLASSES);
+        for (u32 i = 0; i < NUM_SIZE_CLASSES; ++i)
+        {
+            // Moves about 16KB between thread caches and central lists in one batch.
+            g_class_batch_sizes[i] = min<u32>(max<u32>((u32)(16_kb / g_class_sizes[i]), 2), 64);
+        }
+        u32 size_class = 0;
+        for (usize i = 0; i < sizeof(g_small_size_classes); ++i)
+        {
+            while (g_class_sizes[size_class] < i * 16) ++size_class;
+            g_small_size_classes[i] = (u8)size_class;
+        }
+        size_class = 0;
+        for (usize i = 0; i < sizeof(g_large_size_classes); ++i)
+        {
+            while (g_class_sizes[size_class] < i * 128) ++size_class;
+            g_large_size_classes[i] = (u8)size_class;
+        }
+    }
+    void size_class_allocator_flush_thread_cache()
+    {
+        ThreadCache* cache = tls_thread_cache;
+        if (cache) cache->flush();
+    }
+    void* size_class_alloc(usize size, usize alignment)
+    {
+        if (alignment > MAX_ALIGN)
+        {
+            if (alignment > MAX_SMALL_ALIGNMENT) return nullptr;
+            size = align_upper(size, alignment);
+        }
+        if (size > MAX_SMALL_SIZE) return nullptr;
+        u32 size_class = get_size_class(size);
+        // Blocks start at SPAN_DATA_OFFSET, so they are aligned to `alignment` if the block size is.
+        if (alignment > MAX_ALIGN && (g_class_sizes[size_class] & (alignment - 1))) return nullptr;
+        ThreadCacheFreeList& list = get_thread_cache()->m_lists[size_class];
+        if (!list.m_head)
+        {
+            void* head;
+            u32 fetched = central_fetch(size_class, g_class_batch_sizes[size_class], &head);
+            if (!fetched) return nullptr;
+            list.m_head = head;
+            list.m_length = fetched;
+        }
+        void* block = list.m_head;
+        list.m_head = *(void**)block;
+        --list.m_length;
+        return block;
+    }
+    bool size_class_owns(const void* ptr)
+    {
+        return page_map_test((u64)(usize)ptr);
+    }
+    void size_class_free(void* ptr)
+    {
+        u32 size_class = get_span(ptr)->size_class;
+        ThreadCache* cache = get_thread_cache();
+        ThreadCacheFreeList& list = cache->m_lists[size_class];
+        *(void**)ptr = list.m_head;
+        list.m_head = ptr;
+        ++list.m_length;
+        u32 batch_size = g_class_batch_sizes[size_class];
+        if (list.m_length > batch_size * 2)
+        {
+            cache->release(size_class, batch_size);
+        }
+    }
+    usize size_class_memsize(const void* ptr)
+    {
+        return g_class_sizes[get_span(ptr)->size_class];
+    }
+}
@@ -0,0 +1,37 @@
+/*!
+* This file is a portion of LunaSDK.
+* For conditions of distribution and use, see the disclaimer
+* and license in LICENSE.txt
+*
+* @file SizeClassAllocator.hpp
+* @author JXMaster
+* @date 2026/10/18
+* @brief The built-in thread-caching size class allocator used by `memalloc` when `HeapAllocatorType::size_class` is selected.
+*/
+#pragma once
+#include "../Base.hpp"
+
+namespace Luna
+{
+    //! Initializes size class tables. This must be called before `size_class_alloc` is called.
+    void size_class_allocator_init();
+
+    //! Returns all memory blocks cached by the current thread to the central lists.
+    void size_class_allocator_flush_thread_cache();
+
+    //! Allocates one memory block from the size class allocator.
+    //! @return Returns the allocated memory block. Returns `nullptr` if the request cannot be served by
+    //! the size class allocator (too large or the alignment is not supported), in which case the caller
+    //! should allocate the memory block from the system heap.
+    void* size_class_alloc(usize size, usize alignment);
+
+    //! Checks whether the specified memory block is allocated by the size class allocator.
+    //! @details This check is valid even if the size class allocator is not initialized.
+    bool size_class_owns(const void* ptr);
+
+    //! Frees one memory block allocated by `size_class_alloc`.
+    void size_class_free(void* ptr);
+
+    //! Gets the size of one memory block allocated by `size_class_alloc`.
+    usize size_class_memsize(const void* ptr);
+}
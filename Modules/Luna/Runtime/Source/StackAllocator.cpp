@@ -13,50 +13,110 @@
 #include "../Thread.hpp"
 #include "../UniquePtr.hpp"
 #include "../SpinLock.hpp"
+#include "../Atomic.hpp"
+#include "../Algorithm.hpp"
 
 namespace Luna
 {
     opaque_t g_stack_allocator_tls;
 
+    usize g_stack_alloc_high_water_mark = 0;
+
     // Allocators for all threads.
+    // Memory is allocated from one chain of blocks. The first block is allocated when the thread allocates 
+    // memory for the first time, and extra blocks are allocated when the current block is exhausted. Extra blocks 
+    // are freed when the scope that allocates them is closed.
     struct StackAllocatorTLSContext
     {
-        byte_t* data;
-        byte_t* cursor;
+        struct alignas(MAX_ALIGN) Block
+        {
+            Block* prev;
+            usize size;
 
-        static constexpr usize STACK_ALLOC_SIZE = 4_mb;
+            usize begin() const { return (usize)(this + 1); }
+            usize end() const { return (usize)this + size; }
+        };
+        Block* current = nullptr;
+        usize cursor = 0;
+        // The total size of blocks before the current block, excluding block headers.
+        usize prev_blocks_used = 0;
+        usize high_water_mark = 0;
+
+        static constexpr usize FIRST_BLOCK_SIZE = 64_kb;
+        static constexpr usize MAX_GROW_BLOCK_SIZE = 4_mb;
 
-        StackAllocatorTLSContext()
-        {
-            data = (byte_t*)memalloc(STACK_ALLOC_SIZE);
-            cursor = data;
-        }
         ~StackAllocatorTLSContext()
         {
-            memfree(data);
+            while(current)
+            {
+                Block* prev = current->prev;
+                memfree(current);
+                current = prev;
+            }
         }
 
         opaque_t begin_scope()
         {
-            return cursor;
+            return (opaque_t)cursor;
+        }
+        bool allocate_block(usize size, usize alignment)
+        {
+            usize block_size = current ? min(current->size * 2, MAX_GROW_BLOCK_SIZE) : FIRST_BLOCK_SIZE;
+            block_size = max(block_size, sizeof(Block) + size + (alignment > MAX_ALIGN ? alignment : 0));
+            Block* block = (Block*)memalloc(block_size);
+            if(!block) return false;
+            block->size = block_size;
+            block->prev = current;
+            if(current) prev_blocks_used += current->end() - current->begin();
+            current = block;
+            cursor = block->begin();
+            return true;
         }
         void* allocate(usize size, usize alignment)
         {
             alignment = alignment < MAX_ALIGN ? MAX_ALIGN : alignment;
             size = align_upper(size, alignment);
-            usize addr = align_upper((usize)cursor, alignment);
-            if((addr + size) > ((usize)data + STACK_ALLOC_SIZE))
+            usize addr = align_upper(cursor, alignment);
+            if(!current || (addr + size) > current->end())
             {
-                // stack overflow
-                return nullptr;
+                if(!allocate_block(size, alignment)) return nullptr;
+                addr = align_upper(cursor, alignment);
+            }
+            cursor = addr + size;
+            usize used = prev_blocks_used + (cursor - current->begin());
+            if(used > high_water_mark)
+            {
+                high_water_mark = used;
+                // Updates the global high-water mark.
+                usize global = g_stack_alloc_high_water_mark;
+                while(used > global)
+                {
+                    usize r = atom_compare_exchange_usize(&g_stack_alloc_high_water_mark, used, global);
+                    if(r == global) break;
+                    global = r;
+                }
             }
-            cursor = (byte_t*)(addr + size);
             return (byte_t*)addr;
         }
         void end_scope(opaque_t handle)
         {
-            lucheck_msg((usize)handle <= (usize)cursor, "Try to close one scope that is already closed.");
-            cursor = (byte_t*)handle;
+            // Frees extra blocks allocated in this scope. The first block is kept for reuse.
+            while(current && current->prev && ((usize)handle < current->begin() || (usize)handle > current->end()))
+            {
+                Block* prev = current->prev;
+                memfree(current);
+                current = prev;
+                prev_blocks_used -= current->end() - current->begin();
+                cursor = current->end();
+            }
+            if(!handle)
+            {
+                // The scope is opened before any block is allocated.
+                cursor = current ? current->begin() : 0;
+                return;
+            }
+            lucheck_msg(current && (usize)handle >= current->begin() && (usize)handle <= cursor, "Try to close one scope that is already closed.");
+            cursor = (usize)handle;
         }
     };
     
@@ -113,4 +173,13 @@ namespace Luna
     {
         get_stack_allocator_ctx()->end_scope(handle);
     }
+    LUNA_RUNTIME_API usize get_stack_alloc_high_water_mark(bool current_thread)
+    {
+        if(current_thread)
+        {
+            StackAllocatorTLSContext* ctx = (StackAllocatorTLSContext*)tls_get(g_stack_allocator_tls);
+            return ctx ? ctx->high_water_mark : 0;
+        }
+        return g_stack_alloc_high_water_mark;
+    }
 }
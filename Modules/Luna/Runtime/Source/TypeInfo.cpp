@@ -11,16 +11,17 @@
 #define LUNA_RUNTIME_API LUNA_EXPORT
 #include "TypeInfo.hpp"
 #include "../UnorderedMultiMap.hpp"
-#include "../HashMap.hpp"
+#include "../ConcurrentHashMap.hpp"
 #include "OS.hpp"
 
 namespace Luna
 {
     Vector<UniquePtr<TypeInfo>> g_type_registry;
     opaque_t g_type_registry_lock;
+    OSMutexProfilerState g_type_registry_lock_state;
 
     UnorderedMultiMap<Name, NamedTypeInfo*> g_type_name_map;
-    HashMap<Guid, NamedTypeInfo*> g_type_guid_map;
+    ConcurrentHashMap<Guid, NamedTypeInfo*> g_type_guid_map;
 
     static typeinfo_t g_void_type;
     static typeinfo_t g_u8_type;
@@ -64,8 +65,8 @@ namespace Luna
     {
         for (auto& i : private_data)
         {
-            if (i.dtor) i.dtor(i.data);
-            memfree(i.data, i.alignment);
+            if (i.second.dtor) i.second.dtor(i.second.data);
+            memfree(i.second.data, i.second.alignment);
         }
     }
 
@@ -80,13 +81,16 @@ namespace Luna
         t->alignment = alignment;
         g_type_registry.push_back(move(ti));
         g_type_name_map.insert(make_pair(name, t));
-        g_type_guid_map.insert(make_pair(guid, t));
+        g_type_guid_map.insert(guid, t);
         return (typeinfo_t)t;
     }
 
     void type_registry_init()
     {
         g_type_registry_lock = OS::new_mutex();
+#ifdef LUNA_LOCK_PROFILER_ENABLED
+        g_type_registry_lock_state.site = get_lock_profiler_site("Runtime/Type Registry");
+#endif
         g_void_type = add_primitive_typeinfo("void", Guid("{3A153D8F-8C16-4D68-9743-C8FC675BF5E4}"), 0, 0);
         g_u8_type = add_primitive_typeinfo("u8", Guid("{23A6E98D-BB1A-469D-99D2-D2915CBAACBA}"), sizeof(u8), alignof(u8));
         g_i8_type = add_primitive_typeinfo("i8", Guid("{2624AF5D-B874-4E8F-898D-2A17D875EB9A}"), sizeof(i8), alignof(i8));
@@ -129,7 +133,6 @@ namespace Luna
         g_type_registry.shrink_to_fit();
         g_type_name_map.clear();
         g_type_guid_map.clear();
-        g_type_guid_map.shrink_to_fit();
         OS::delete_mutex(g_type_registry_lock);
     }
     static void structure_default_construct(typeinfo_t type, void* data)
@@ -221,7 +224,7 @@ namespace Luna
     }
     LUNA_RUNTIME_API typeinfo_t register_struct_type(const StructureTypeDesc& desc)
     {
-        OSMutexGuard guard(g_type_registry_lock);
+        OSMutexGuard guard(g_type_registry_lock, &g_type_registry_lock_state);
         typeinfo_t type = get_type_by_guid(desc.guid);
         if (type) return type;
         type = get_type_by_name(desc.name, desc.alias);
@@ -270,12 +273,12 @@ namespace Luna
         if (!st->move_assign && use_default_move_assign) st->move_assign = structure_default_move_assign;
         g_type_registry.push_back(move(t));
         g_type_name_map.insert(make_pair(st->name, (NamedTypeInfo*)st));
-        g_type_guid_map.insert(make_pair(st->guid, (NamedTypeInfo*)st));
+        g_type_guid_map.insert(st->guid, (NamedTypeInfo*)st);
         return (typeinfo_t)st;
     }
     LUNA_RUNTIME_API typeinfo_t register_generic_struct_type(const GenericStructureTypeDesc& desc)
     {
-        OSMutexGuard guard(g_type_registry_lock);
+        OSMutexGuard guard(g_type_registry_lock, &g_type_registry_lock_state);
         typeinfo_t type = get_type_by_guid(desc.guid);
         if (type) return type;
         type = get_type_by_name(desc.name, desc.alias);
@@ -291,12 +294,12 @@ namespace Luna
         st->instantiate = desc.instantiate;
         g_type_registry.push_back(move(t));
         g_type_name_map.insert(make_pair(st->name, (NamedTypeInfo*)st));
-        g_type_guid_map.insert(make_pair(st->guid, (NamedTypeInfo*)st));
+        g_type_guid_map.insert(st->guid, (NamedTypeInfo*)st);
         return (typeinfo_t)st;
     }
     LUNA_RUNTIME_API typeinfo_t register_enum_type(const EnumerationTypeDesc& desc)
     {
-        OSMutexGuard guard(g_type_registry_lock);
+        OSMutexGuard guard(g_type_registry_lock, &g_type_registry_lock_state);
         typeinfo_t type = get_type_by_guid(desc.guid);
         if (type) return type;
         type = get_type_by_name(desc.name, desc.alias);
@@ -314,7 +317,7 @@ namespace Luna
         et->options.assign_n(desc.options.data(), desc.options.size());
         g_type_registry.push_back(move(t));
         g_type_name_map.insert(make_pair(et->name, (NamedTypeInfo*)et));
-        g_type_guid_map.insert(make_pair(et->guid, (NamedTypeInfo*)et));
+        g_type_guid_map.insert(et->guid, (NamedTypeInfo*)et);
         return (typeinfo_t)et;
     }
 
@@ -441,7 +444,7 @@ namespace Luna
     }
     LUNA_RUNTIME_API typeinfo_t get_type_by_name(const Name& name, const Name& alias)
     {
-        OSMutexGuard guard(g_type_registry_lock);
+        OSMutexGuard guard(g_type_registry_lock, &g_type_registry_lock_state);
         auto range = g_type_name_map.equal_range(name);
         if (range.first == range.second) return nullptr;
         for (auto iter = range.first; iter != range.second; ++iter)
@@ -454,14 +457,14 @@ namespace Luna
     }
     LUNA_RUNTIME_API typeinfo_t get_type_by_guid(const Guid& guid)
     {
-        OSMutexGuard guard(g_type_registry_lock);
-        auto iter = g_type_guid_map.find(guid);
-        if (iter == g_type_guid_map.end()) return nullptr;
-        return (typeinfo_t)(iter->second);
+        // Lookups by GUID do not lock the type registry, so they can be performed by multiple threads in parallel.
+        NamedTypeInfo* type = nullptr;
+        g_type_guid_map.find(guid, type);
+        return (typeinfo_t)type;
     }
     LUNA_RUNTIME_API typeinfo_t get_generic_instanced_type(typeinfo_t generic_type, Span<const GenericArgument> generic_arguments)
     {
-        OSMutexGuard guard(g_type_registry_lock);
+        OSMutexGuard guard(g_type_registry_lock, &g_type_registry_lock_state);
         if (((TypeInfo*)generic_type.handle)->kind != TypeKind::generic_structure) return nullptr;
         GenericStructureTypeInfo* st = (GenericStructureTypeInfo*)generic_type.handle;
         for (GenericStructureInstancedTypeInfo* gt : st->generic_instanced_types)
@@ -690,12 +693,10 @@ namespace Luna
     LUNA_RUNTIME_API void* get_type_private_data(typeinfo_t type, const Guid& data_guid)
     {
         TypeInfo* t = (TypeInfo*)type.handle;
-        for (auto& i : t->private_data)
+        auto iter = t->private_data.find(data_guid);
+        if (iter != t->private_data.end())
         {
-            if (i.guid == data_guid)
-            {
-                return i.data;
-            }
+            return iter->second.data;
         }
         if (t->kind == TypeKind::generic_structure_instanced)
         {
@@ -706,34 +707,32 @@ namespace Luna
     LUNA_RUNTIME_API void* set_type_private_data(typeinfo_t type, const Guid& data_guid, usize data_size, usize data_alignment, void(*data_dtor)(void*))
     {
         TypeInfo* t = (TypeInfo*)type.handle;
-        for (auto iter = t->private_data.begin(); iter != t->private_data.end(); ++iter)
+        auto iter = t->private_data.find(data_guid);
+        if (iter != t->private_data.end())
         {
-            if (iter->guid == data_guid)
+            TypeInfoPrivateData& data = iter->second;
+            if (data.dtor) data.dtor(data.data);
+            memfree(data.data, data.alignment);
+            if (data_size)
             {
-                if (iter->dtor) iter->dtor(iter->data);
-                memfree(iter->data, iter->alignment);
-                if (data_size)
-                {
-                    iter->data = memalloc(data_size, data_alignment);
-                    iter->dtor = data_dtor;
-                    iter->alignment = data_alignment;
-                    return iter->data;
-                }
-                else
-                {
-                    t->private_data.erase(iter);
-                    return nullptr;
-                }
+                data.data = memalloc(data_size, data_alignment);
+                data.dtor = data_dtor;
+                data.alignment = data_alignment;
+                return data.data;
+            }
+            else
+            {
+                t->private_data.erase(iter);
+                return nullptr;
             }
         }
         if (data_size)
         {
-            t->private_data.emplace_back();
-            auto& data = t->private_data.back();
-            data.guid = data_guid;
+            TypeInfoPrivateData data;
             data.data = memalloc(data_size, data_alignment);
             data.dtor = data_dtor;
             data.alignment = data_alignment;
+            t->private_data.insert(make_pair(data_guid, data));
             return data.data;
         }
         return nullptr;
@@ -11,6 +11,7 @@
 #include "../TypeInfo.hpp"
 #include "../UniquePtr.hpp"
 #include "../SpinLock.hpp"
+#include "../FlatMap.hpp"
 
 namespace Luna
 {
@@ -24,16 +25,19 @@ namespace Luna
     };
     struct TypeInfoPrivateData
     {
-        Guid guid;
         void(*dtor)(void*);
         void* data;
         usize alignment;
     };
+    struct ObjectPool;
     struct TypeInfo
     {
         TypeKind kind;
-        Vector<TypeInfoPrivateData> private_data;
+        // Private data sorted by GUID, so that one lookup only performs one binary search.
+        FlatMap<Guid, TypeInfoPrivateData> private_data;
         Vector<Pair<Name, Variant>> attributes;
+        // The pool used to allocate boxed objects of this type, `nullptr` if the type is not pooled.
+        ObjectPool* object_pool = nullptr;
         virtual ~TypeInfo();
     };
     struct NamedTypeInfo : TypeInfo
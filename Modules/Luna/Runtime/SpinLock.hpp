@@ -11,6 +11,8 @@
 #include "Base.hpp"
 #include "Atomic.hpp"
 #include "Thread.hpp"
+#include "Time.hpp"
+#include "LockProfiler.hpp"
 
 #if defined(LUNA_PLATFORM_X86) || defined(LUNA_PLATFORM_X86_64)
 #include <emmintrin.h>
@@ -41,10 +43,50 @@ namespace Luna
     class SpinLock
     {
         volatile u32 counter;
+#ifdef LUNA_LOCK_PROFILER_ENABLED
+        const c8* m_name;
+        lock_profiler_site_t volatile m_site;
+        u64 m_acquire_ticks;
+        lock_profiler_site_t get_site()
+        {
+            lock_profiler_site_t site = m_site;
+            if (!site)
+            {
+                site = get_lock_profiler_site(m_name);
+                m_site = site;
+            }
+            return site;
+        }
+#endif
+        void spin()
+        {
+            while (atom_compare_exchange_u32(&counter, 1, 0) != 0)
+            {
+#if defined(LUNA_PLATFORM_X86) || defined(LUNA_PLATFORM_X86_64)
+                _mm_pause(); // not_ready-waiting.
+#elif defined(LUNA_PLATFORM_ARM64) || defined(LUNA_PLATFORM_ARM32)
+                __yield();
+#endif
+            }
+        }
     public:
         //! Constructs one spin lock. The spin lock is unlocked after creation.
         SpinLock() :
-            counter(0) {}
+            counter(0)
+#ifdef LUNA_LOCK_PROFILER_ENABLED
+            , m_name(nullptr), m_site(nullptr), m_acquire_ticks(0)
+#endif
+        {}
+        //! Constructs one named spin lock. The spin lock is unlocked after creation.
+        //! @param[in] name The name used by the lock profiler to collect contention statistics of this lock. The string must be valid
+        //! until LunaSDK is closed. Locks with the same name share one set of statistics. The name is ignored if 
+        //! `LUNA_LOCK_PROFILER_ENABLED` is not defined.
+        explicit SpinLock(const c8* name) :
+            counter(0)
+#ifdef LUNA_LOCK_PROFILER_ENABLED
+            , m_name(name), m_site(nullptr), m_acquire_ticks(0)
+#endif
+        {}
         SpinLock(const SpinLock&) = delete;
         SpinLock(SpinLock&& rhs) = delete;
         SpinLock& operator=(const SpinLock&) = delete;
@@ -55,14 +97,23 @@ namespace Luna
         //! if you need to lock the same spin lock multiple times from the same thread.
         void lock()
         {
-            while (atom_compare_exchange_u32(&counter, 1, 0) != 0)
+#ifdef LUNA_LOCK_PROFILER_ENABLED
+            if (m_name)
             {
-#if defined(LUNA_PLATFORM_X86) || defined(LUNA_PLATFORM_X86_64)
-                _mm_pause(); // not_ready-waiting.
-#elif defined(LUNA_PLATFORM_ARM64) || defined(LUNA_PLATFORM_ARM32)
-                __yield();
-#endif
+                u64 wait_ticks = 0;
+                bool contended = atom_compare_exchange_u32(&counter, 1, 0) != 0;
+                if (contended)
+                {
+                    u64 begin_ticks = get_ticks();
+                    spin();
+                    wait_ticks = get_ticks() - begin_ticks;
+                }
+                m_acquire_ticks = get_ticks();
+                lock_profiler_record_acquire(get_site(), wait_ticks, contended);
+                return;
             }
+#endif
+            spin();
         }
         //! Tries to lock the spin lock.
         //! @return Returns `true` if the spin lock is successfully locked when the function returns. Returns 
@@ -70,11 +121,24 @@ namespace Luna
         bool try_lock()
         {
             u32 comp = atom_compare_exchange_u32(&counter, 1, 0);
+#ifdef LUNA_LOCK_PROFILER_ENABLED
+            if (comp == 0 && m_name)
+            {
+                m_acquire_ticks = get_ticks();
+                lock_profiler_record_acquire(get_site(), 0, false);
+            }
+#endif
             return comp == 0;
         }
         //! Unlocks the spin lock.
         void unlock()
         {
+#ifdef LUNA_LOCK_PROFILER_ENABLED
+            if (m_name)
+            {
+                lock_profiler_record_release(get_site(), get_ticks() - m_acquire_ticks);
+            }
+#endif
             atom_exchange_u32(&counter, 0);
         }
     };
@@ -84,11 +148,51 @@ namespace Luna
     {
         volatile usize tid;
         volatile u32 counter;
+#ifdef LUNA_LOCK_PROFILER_ENABLED
+        const c8* m_name;
+        lock_profiler_site_t volatile m_site;
+        u64 m_acquire_ticks;
+        lock_profiler_site_t get_site()
+        {
+            lock_profiler_site_t site = m_site;
+            if (!site)
+            {
+                site = get_lock_profiler_site(m_name);
+                m_site = site;
+            }
+            return site;
+        }
+#endif
+        void spin(usize current_tid)
+        {
+            while (atom_compare_exchange_usize(&tid, current_tid, 0) != 0)
+            {
+#if defined(LUNA_PLATFORM_X86) || defined(LUNA_PLATFORM_X86_64)
+                _mm_pause(); // not_ready-waiting.
+#elif defined(LUNA_PLATFORM_ARM64) || defined(LUNA_PLATFORM_ARM32)
+                __yield();
+#endif
+            }
+        }
     public:
         //! Constructs one spin lock. The spin lock is unlocked after creation.
         RecursiveSpinLock() :
             tid(0),
-            counter(0) {}
+            counter(0)
+#ifdef LUNA_LOCK_PROFILER_ENABLED
+            , m_name(nullptr), m_site(nullptr), m_acquire_ticks(0)
+#endif
+        {}
+        //! Constructs one named spin lock. The spin lock is unlocked after creation.
+        //! @param[in] name The name used by the lock profiler to collect contention statistics of this lock. See @ref SpinLock::SpinLock(const c8*)
+        //! for details.
+        explicit RecursiveSpinLock(const c8* name) :
+            tid(0),
+            counter(0)
+#ifdef LUNA_LOCK_PROFILER_ENABLED
+            , m_name(name), m_site(nullptr), m_acquire_ticks(0)
+#endif
+        {}
         RecursiveSpinLock(const RecursiveSpinLock&) = delete;
         RecursiveSpinLock(RecursiveSpinLock&& rhs) = delete;
         RecursiveSpinLock& operator=(const RecursiveSpinLock&) = delete;
@@ -102,14 +206,24 @@ namespace Luna
                 ++counter;
                 return;
             }
-            while (atom_compare_exchange_usize(&tid, current_tid, 0) != 0)
+#ifdef LUNA_LOCK_PROFILER_ENABLED
+            // Only the outermost acquisition is recorded.
+            if (m_name)
             {
-#if defined(LUNA_PLATFORM_X86) || defined(LUNA_PLATFORM_X86_64)
-                _mm_pause(); // not_ready-waiting.
-#elif defined(LUNA_PLATFORM_ARM64) || defined(LUNA_PLATFORM_ARM32)
-                __yield();
-#endif
+                u64 wait_ticks = 0;
+                bool contended = atom_compare_exchange_usize(&tid, current_tid, 0) != 0;
+                if (contended)
+                {
+                    u64 begin_ticks = get_ticks();
+                    spin(current_tid);
+                    wait_ticks = get_ticks() - begin_ticks;
+                }
+                m_acquire_ticks = get_ticks();
+                lock_profiler_record_acquire(get_site(), wait_ticks, contended);
+                return;
             }
+#endif
+            spin(current_tid);
         }
         //! Tries to lock the spin lock.
         //! @return Returns `true` if the spin lock is successfully locked when the function returns. Returns 
@@ -123,6 +237,13 @@ namespace Luna
                 return true;
             }
             volatile usize comp = atom_compare_exchange_usize(&tid, current_tid, 0);
+#ifdef LUNA_LOCK_PROFILER_ENABLED
+            if (comp == 0 && m_name)
+            {
+                m_acquire_ticks = get_ticks();
+                lock_profiler_record_acquire(get_site(), 0, false);
+            }
+#endif
             return comp == 0;
         }
         //! Unlocks the spin lock.
@@ -136,6 +257,12 @@ namespace Luna
             }
             else
             {
+#ifdef LUNA_LOCK_PROFILER_ENABLED
+                if (m_name)
+                {
+                    lock_profiler_record_release(get_site(), get_ticks() - m_acquire_ticks);
+                }
+#endif
                 atom_exchange_usize(&tid, 0);
             }
         }
@@ -27,9 +27,13 @@ namespace Luna
     //! If this is 0 (default), then the memory is allocated with no additional alignment requirement.In such case, the memory address is 
     //! aligned to @ref MAX_ALIGN.
     //! 
-    //! @return Returns one pointer to the allocated memory block. Returns `nullptr` if `size` is 0.
+    //! @return Returns one pointer to the allocated memory block. Returns `nullptr` if `size` is 0, or if the system is out of memory.
     //! @remark The memory allocated from this function will be freed automatically when @ref end_stack_alloc_scope is called. Never
     //! call @ref memfree on memory allocated from this function.
+    //! 
+    //! The stack of every thread starts with one small block that is allocated when `stack_alloc` is called on the thread for the first 
+    //! time, and grows by chaining extra blocks when the current block is exhausted, so large temporary buffers can be allocated
+    //! safely. Extra blocks are freed when the scope that allocates them is closed.
     //! @par Valid Usage
     //! * @ref begin_stack_alloc_scope must be called at least one time before calling this function.
     //! * If `alignment` is not `0`, `alignment` **must** be powers of 2 (like 32, 64, 128, 256, etc).
@@ -43,6 +47,12 @@ namespace Luna
     //! * `handle` must specify one valid unclosed scope.
     LUNA_RUNTIME_API void end_stack_alloc_scope(opaque_t handle);
 
+    //! Gets the maximum number of bytes that have ever been allocated from thread-local stacks at the same time.
+    //! @param[in] current_thread If `true`, returns the high-water mark of the current thread. If `false`, returns the 
+    //! maximum high-water mark of all threads.
+    //! @return Returns the high-water mark in bytes.
+    LUNA_RUNTIME_API usize get_stack_alloc_high_water_mark(bool current_thread = false);
+
     //! The RAII wrapper for stack-based allocation.
     //! @details This type opens a new stack allocation scope upon constructing, and closes such 
     //! scope upon destructing. So instead of calling @ref begin_stack_alloc_scope and @ref end_stack_alloc_scope 
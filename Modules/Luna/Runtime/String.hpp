@@ -13,6 +13,7 @@
 #include "Iterator.hpp"
 #include "MemoryUtils.hpp"
 #include "TypeInfo.hpp"
+#include "Functional.hpp"
 
 namespace Luna
 {
@@ -754,6 +755,21 @@ namespace Luna
     LUNA_RUNTIME_API typeinfo_t string_type();
     template <> struct typeof_t<String> { typeinfo_t operator()() const { return string_type(); } };
 
+    //! Hashes strings by their characters using @ref hash_bytes.
+    template <typename _Char, typename _Alloc> struct hash<BasicString<_Char, _Alloc>>
+    {
+        usize operator()(const BasicString<_Char, _Alloc>& val) const { return hash_bytes(val.data(), val.size() * sizeof(_Char)); }
+    };
+
+    //! Compares strings by their characters, so that strings can be used as keys of hash maps and hash sets.
+    template <typename _Char, typename _Alloc> struct equal_to<BasicString<_Char, _Alloc>>
+    {
+        bool operator()(const BasicString<_Char, _Alloc>& lhs, const BasicString<_Char, _Alloc>& rhs) const
+        {
+            return lhs.size() == rhs.size() && !memcmp(lhs.data(), rhs.data(), lhs.size() * sizeof(_Char));
+        }
+    };
+
     //! Creates one string that contains the formatted text.
     //! @param[out] str The string instance to receive the formatted string.
     //! If this instance is not empty, existing content will be overwritten.
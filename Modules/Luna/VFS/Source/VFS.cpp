@@ -10,7 +10,7 @@
 #include <Luna/Runtime/PlatformDefines.hpp>
 #define LUNA_VFS_API LUNA_EXPORT
 #include "VFS.hpp"
-#include <Luna/Runtime/UniquePtr.hpp>
+#include <Luna/Runtime/ConcurrentHashMap.hpp>
 #include <Luna/Runtime/Mutex.hpp>
 #include <Luna/Runtime/Module.hpp>
 #include "Drivers/PlatformFSDriver.hpp"
@@ -19,31 +19,31 @@ namespace Luna
 {
     namespace VFS
     {
-        HashMap<Name, UniquePtr<DriverDesc>> g_drivers;
+        // Drivers are looked up by every mount operation, so lookups do not take `g_driver_mutex`.
+        ConcurrentHashMap<Name, DriverDesc*> g_drivers;
         Ref<IMutex> g_driver_mutex;
         Vector<MountPair> g_mounts;
         Ref<IMutex> g_mounts_mutex;
         LUNA_VFS_API void register_driver(const Name& name, const DriverDesc& desc)
         {
             MutexGuard guard(g_driver_mutex);
-            auto iter = g_drivers.find(name);
+            DriverDesc* old = nullptr;
             // If the driver is registered, unregister it first.
-            if (iter != g_drivers.end())
+            if (g_drivers.find(name, old))
             {
-                if(iter->second.get()->on_driver_unregister) iter->second.get()->on_driver_unregister(iter->second.get()->driver_data);
-                g_drivers.erase(iter);
+                if(old->on_driver_unregister) old->on_driver_unregister(old->driver_data);
             }
-            UniquePtr<DriverDesc> d(memnew<DriverDesc>());
-            *(d.get()) = desc;
-            g_drivers.insert(make_pair(name, move(d)));
+            DriverDesc* d = memnew<DriverDesc>();
+            *d = desc;
+            g_drivers.insert_or_assign(name, d);
+            if (old) memdelete(old);
         }
 
         inline DriverDesc* find_driver(const Name& driver)
         {
-            MutexGuard guard(g_driver_mutex);
-            auto iter = g_drivers.find(driver);
-            if (iter == g_drivers.end()) return nullptr;
-            return iter->second.get();
+            DriverDesc* d = nullptr;
+            g_drivers.find(driver, d);
+            return d;
         }
 
         LUNA_VFS_API RV mount(const Name& driver, const c8* driver_path, const Path& mount_path,
@@ -299,7 +299,7 @@ namespace Luna
             virtual RV on_init() override
             {
                 g_driver_mutex = new_mutex();
-                g_mounts_mutex = new_mutex();
+                g_mounts_mutex = new_mutex("VFS/Mounts");
                 register_platform_filesystem_driver();
                 return ok;
             }
@@ -308,12 +308,12 @@ namespace Luna
                 g_mounts.clear();
                 g_mounts.shrink_to_fit();
                 g_mounts_mutex = nullptr;
-                for (auto& i : g_drivers)
+                g_drivers.for_each([](const Name& name, DriverDesc* const& d)
                 {
-                    if (i.second.get()->on_driver_unregister) i.second.get()->on_driver_unregister(i.second.get()->driver_data);
-                }
+                    if (d->on_driver_unregister) d->on_driver_unregister(d->driver_data);
+                    memdelete(d);
+                });
                 g_drivers.clear();
-                g_drivers.shrink_to_fit();
                 g_driver_mutex = nullptr;
             }
         };
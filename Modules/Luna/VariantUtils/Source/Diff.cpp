@@ -172,7 +172,7 @@ namespace Luna
         static Variant diff_array(const Variant& before, const Variant& after)
         {
             Variant result(VariantType::object);
-            result["_t"] = "a";
+            result[luname("_t")] = "a";
             usize common_head = 0;
             usize common_tail = 0;
             if (before == after) return Variant();
@@ -270,9 +270,9 @@ namespace Luna
         {
             if (delta.type() == VariantType::object)
             {
-                auto& array_magic = delta["_t"];
+                auto& array_magic = delta[luname("_t")];
                 if (before.type() == VariantType::array 
-                    && array_magic.str() == "a")
+                    && array_magic.str() == luname("a"))
                 {
                     patch_array(before, delta);
                     return;
@@ -312,9 +312,9 @@ namespace Luna
         {
             if (delta.type() == VariantType::object)
             {
-                auto& array_magic = delta["_t"];
+                auto& array_magic = delta[luname("_t")];
                 if (after.type() == VariantType::array
-                    && array_magic.str() == "a")
+                    && array_magic.str() == luname("a"))
                 {
                     revert_array(after, delta);
                     return;
@@ -414,7 +414,7 @@ namespace Luna
 
             for (auto& op : delta.key_values())
             {
-                if (op.first == "_t")
+                if (op.first == luname("_t"))
                     continue;
                 auto& value = op.second;
                 if (op.first.c_str()[0] == '_')
@@ -477,7 +477,7 @@ namespace Luna
 
             for (auto& op : delta.key_values())
             {
-                if (op.first == "_t")
+                if (op.first == luname("_t"))
                     continue;
                 auto& value = op.second;
                 if (op.first.c_str()[0] == '_')
@@ -557,7 +557,7 @@ namespace Luna
                 else if (iter->type() == VariantType::number)
                 {
                     // Array index.
-                    delta["_t"] = "a";
+                    delta[luname("_t")] = "a";
                     c8 buf[32];
                     snprintf(buf, 32, "%llu", (unsigned long long)iter->unum());
                     delta[buf] = move(child);
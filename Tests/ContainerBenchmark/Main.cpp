@@ -0,0 +1,412 @@
+/*!
+* This file is a portion of LunaSDK.
+* For conditions of distribution and use, see the disclaimer
+* and license in LICENSE.txt
+*
+* @file Main.cpp
+* @author JXMaster
+* @date 2026/10/18
+*/
+#include <Luna/Runtime/Runtime.hpp>
+#include <Luna/Runtime/Module.hpp>
+#include <Luna/Runtime/Time.hpp>
+#include <Luna/Runtime/File.hpp>
+#include <Luna/Runtime/Random.hpp>
+#include <Luna/Runtime/Variant.hpp>
+#include <Luna/Runtime/HashMap.hpp>
+#include <Luna/Runtime/UnorderedMap.hpp>
+#include <Luna/Runtime/SelfIndexedHashMap.hpp>
+#include <Luna/Runtime/Vector.hpp>
+#include <Luna/Runtime/RingDeque.hpp>
+#include <Luna/Runtime/String.hpp>
+#include <Luna/Runtime/Name.hpp>
+#include <Luna/Runtime/Hash.hpp>
+#include <Luna/Runtime/Algorithm.hpp>
+#include <Luna/VariantUtils/VariantUtils.hpp>
+#include <Luna/VariantUtils/JSON.hpp>
+#include <stdio.h>
+#include <stdlib.h>
+
+namespace Luna
+{
+    Variant g_results(VariantType::array);
+    u64 g_sink = 0;
+
+    f64 ticks_to_seconds(u64 ticks)
+    {
+        return (f64)ticks / get_ticks_per_second();
+    }
+
+    //! Records one benchmark result.
+    //! @param[in] name The name of the benchmark case.
+    //! @param[in] size The number of elements involved in this case.
+    //! @param[in] ops The number of operations performed in this case.
+    //! @param[in] seconds The time spent in seconds.
+    //! @param[in] bytes The number of bytes processed in this case, or 0 if bandwidth is not measured.
+    void add_result(const c8* name, usize size, usize ops, f64 seconds, u64 bytes = 0)
+    {
+        Variant item(VariantType::object);
+        item["name"] = name;
+        item["size"] = (u64)size;
+        item["operations"] = (u64)ops;
+        item["seconds"] = seconds;
+        f64 ops_per_second = seconds > 0.0 ? (f64)ops / seconds : 0.0;
+        f64 ns_per_op = ops ? seconds * 1000000000.0 / (f64)ops : 0.0;
+        item["ops_per_second"] = ops_per_second;
+        item["ns_per_op"] = ns_per_op;
+        if (bytes)
+        {
+            f64 bytes_per_second = seconds > 0.0 ? (f64)bytes / seconds : 0.0;
+            item["bytes"] = bytes;
+            item["bytes_per_second"] = bytes_per_second;
+            printf("%-48s size: %10llu  %12.3f ms  %10.2f ns/op  %10.2f GB/s\n", name, (unsigned long long)size, seconds * 1000.0, ns_per_op, bytes_per_second / 1000000000.0);
+        }
+        else
+        {
+            printf("%-48s size: %10llu  %12.3f ms  %10.2f ns/op\n", name, (unsigned long long)size, seconds * 1000.0, ns_per_op);
+        }
+        g_results.push_back(move(item));
+    }
+
+    template <typename _Ty>
+    void shuffle(Vector<_Ty>& values)
+    {
+        for (usize i = values.size(); i > 1; --i)
+        {
+            usize j = (usize)(random_u64() % i);
+            swap(values[i - 1], values[j]);
+        }
+    }
+
+    // Key generators. Keys generated from different indices are different.
+    template <typename _Kty> struct BenchKey;
+    template <> struct BenchKey<u64>
+    {
+        static const c8* name() { return "int"; }
+        // Scatters indices so that keys are not inserted in hash order.
+        static u64 make(u64 i) { return i * 0x9E3779B97F4A7C15ULL; }
+    };
+    template <> struct BenchKey<String>
+    {
+        static const c8* name() { return "string"; }
+        static String make(u64 i)
+        {
+            c8 buf[64];
+            snprintf(buf, 64, "benchmark_key_%llu", (unsigned long long)i);
+            return String(buf);
+        }
+    };
+    template <> struct BenchKey<Name>
+    {
+        static const c8* name() { return "name"; }
+        static Name make(u64 i)
+        {
+            c8 buf[64];
+            snprintf(buf, 64, "benchmark_key_%llu", (unsigned long long)i);
+            return Name(buf);
+        }
+    };
+
+    template <typename _Kty>
+    struct BenchElement
+    {
+        _Kty key;
+        u64 value;
+    };
+    template <typename _Kty>
+    struct BenchElementExtractKey
+    {
+        const _Kty& operator()(const BenchElement<_Kty>& v) const
+        {
+            return v.key;
+        }
+    };
+
+    // Abstracts element insertion and value access, since self-indexed maps store the key in the value.
+    template <typename _Map> struct MapOps
+    {
+        template <typename _Kty>
+        static void insert(_Map& map, const _Kty& key, u64 value)
+        {
+            map.insert(make_pair(key, value));
+        }
+        template <typename _Iter>
+        static u64 value(const _Iter& iter)
+        {
+            return iter->second;
+        }
+    };
+    template <typename _Kty> struct MapOps<SelfIndexedHashMap<_Kty, BenchElement<_Kty>, BenchElementExtractKey<_Kty>>>
+    {
+        static void insert(SelfIndexedHashMap<_Kty, BenchElement<_Kty>, BenchElementExtractKey<_Kty>>& map, const _Kty& key, u64 value)
+        {
+            map.insert(BenchElement<_Kty>{ key, value });
+        }
+        template <typename _Iter>
+        static u64 value(const _Iter& iter)
+        {
+            return iter->value;
+        }
+    };
+
+    template <typename _Map, typename _Kty>
+    void bench_map(const c8* map_name, const Vector<_Kty>& keys, const Vector<_Kty>& missing_keys, f32 max_load_factor)
+    {
+        using ops = MapOps<_Map>;
+        usize n = keys.size();
+        Vector<_Kty> lookup_keys = keys;
+        shuffle(lookup_keys);
+        c8 name[128];
+        _Map map;
+        map.max_load_factor(max_load_factor);
+        u64 begin = get_ticks();
+        for (usize i = 0; i < n; ++i)
+        {
+            ops::insert(map, keys[i], (u64)i);
+        }
+        u64 end = get_ticks();
+        snprintf(name, 128, "%s/%s/lf%.2f/insert", map_name, BenchKey<_Kty>::name(), max_load_factor);
+        add_result(name, n, n, ticks_to_seconds(end - begin));
+        u64 sum = 0;
+        begin = get_ticks();
+        for (const _Kty& key : lookup_keys)
+        {
+            auto iter = map.find(key);
+            if (iter != map.end()) sum += ops::value(iter);
+        }
+        end = get_ticks();
+        g_sink += sum;
+        snprintf(name, 128, "%s/%s/lf%.2f/find_hit", map_name, BenchKey<_Kty>::name(), max_load_factor);
+        add_result(name, n, n, ticks_to_seconds(end - begin));
+        usize found = 0;
+        begin = get_ticks();
+        for (const _Kty& key : missing_keys)
+        {
+            if (map.find(key) != map.end()) ++found;
+        }
+        end = get_ticks();
+        g_sink += found;
+        snprintf(name, 128, "%s/%s/lf%.2f/find_miss", map_name, BenchKey<_Kty>::name(), max_load_factor);
+        add_result(name, n, missing_keys.size(), ticks_to_seconds(end - begin));
+        usize erased = 0;
+        begin = get_ticks();
+        for (const _Kty& key : lookup_keys)
+        {
+            erased += map.erase(key);
+        }
+        end = get_ticks();
+        g_sink += erased;
+        snprintf(name, 128, "%s/%s/lf%.2f/erase", map_name, BenchKey<_Kty>::name(), max_load_factor);
+        add_result(name, n, n, ticks_to_seconds(end - begin));
+    }
+
+    template <typename _Kty>
+    void bench_maps(usize n)
+    {
+        Vector<_Kty> keys;
+        Vector<_Kty> missing_keys;
+        keys.reserve(n);
+        missing_keys.reserve(n);
+        for (usize i = 0; i < n; ++i)
+        {
+            keys.push_back(BenchKey<_Kty>::make(i));
+            missing_keys.push_back(BenchKey<_Kty>::make(i + n));
+        }
+        const f32 load_factors[] = { 0.5f, 0.75f, 0.875f };
+        for (f32 lf : load_factors)
+        {
+            bench_map<HashMap<_Kty, u64>>("HashMap", keys, missing_keys, lf);
+            bench_map<UnorderedMap<_Kty, u64>>("UnorderedMap", keys, missing_keys, lf);
+            bench_map<SelfIndexedHashMap<_Kty, BenchElement<_Kty>, BenchElementExtractKey<_Kty>>>("SelfIndexedHashMap", keys, missing_keys, lf);
+        }
+    }
+
+    template <typename _Ty>
+    void bench_vector_push(const c8* type_name, usize n, _Ty(*make)(u64))
+    {
+        c8 name[128];
+        {
+            // Grows the vector from empty, including all reallocations.
+            Vector<_Ty> v;
+            u64 begin = get_ticks();
+            for (usize i = 0; i < n; ++i) v.push_back(make(i));
+            u64 end = get_ticks();
+            g_sink += v.size();
+            snprintf(name, 128, "Vector/%s/push_back", type_name);
+            add_result(name, n, n, ticks_to_seconds(end - begin));
+        }
+        {
+            Vector<_Ty> v;
+            v.reserve(n);
+            u64 begin = get_ticks();
+            for (usize i = 0; i < n; ++i) v.push_back(make(i));
+            u64 end = get_ticks();
+            g_sink += v.size();
+            snprintf(name, 128, "Vector/%s/push_back_reserved", type_name);
+            add_result(name, n, n, ticks_to_seconds(end - begin));
+        }
+    }
+
+    void bench_ring_deque(usize n)
+    {
+        {
+            RingDeque<u64> q;
+            u64 begin = get_ticks();
+            for (usize i = 0; i < n; ++i) q.push_back(i);
+            u64 end = get_ticks();
+            add_result("RingDeque/int/push_back", n, n, ticks_to_seconds(end - begin));
+            u64 sum = 0;
+            begin = get_ticks();
+            while (!q.empty())
+            {
+                sum += q.front();
+                q.pop_front();
+            }
+            end = get_ticks();
+            g_sink += sum;
+            add_result("RingDeque/int/pop_front", n, n, ticks_to_seconds(end - begin));
+        }
+        {
+            // Keeps a fixed number of elements in the queue, so that the ring buffer wraps around without growing.
+            constexpr usize QUEUE_SIZE = 64;
+            RingDeque<u64> q;
+            for (usize i = 0; i < QUEUE_SIZE; ++i) q.push_back(i);
+            u64 sum = 0;
+            u64 begin = get_ticks();
+            for (usize i = 0; i < n; ++i)
+            {
+                sum += q.front();
+                q.pop_front();
+                q.push_back(i);
+            }
+            u64 end = get_ticks();
+            g_sink += sum;
+            add_result("RingDeque/int/steady_queue", n, n, ticks_to_seconds(end - begin));
+        }
+        {
+            RingDeque<String> q;
+            u64 begin = get_ticks();
+            for (usize i = 0; i < n; ++i)
+            {
+                q.push_front(BenchKey<String>::make(i));
+                if (q.size() > 1024) q.pop_back();
+            }
+            u64 end = get_ticks();
+            g_sink += q.size();
+            add_result("RingDeque/string/push_front_pop_back", n, n, ticks_to_seconds(end - begin));
+        }
+    }
+
+    void bench_memhash(usize total_bytes)
+    {
+        const usize block_sizes[] = { 16, 64, 256, 4096, 65536 };
+        Vector<u8> data(65536);
+        for (usize i = 0; i < data.size(); ++i) data[i] = (u8)random_u32();
+        for (usize block_size : block_sizes)
+        {
+            usize num_blocks = max<usize>(total_bytes / block_size, 1);
+            usize h = 0;
+            u64 begin = get_ticks();
+            for (usize i = 0; i < num_blocks; ++i)
+            {
+                h = memhash(data.data() + (i * block_size) % (data.size() - block_size + 1), block_size, h);
+            }
+            u64 end = get_ticks();
+            g_sink += h;
+            c8 name[128];
+            snprintf(name, 128, "memhash/%llu", (unsigned long long)block_size);
+            add_result(name, block_size, num_blocks, ticks_to_seconds(end - begin), (u64)num_blocks * block_size);
+        }
+    }
+
+    void bench_sort_case(const c8* case_name, const Vector<u64>& input)
+    {
+        // Sorts several copies so that small inputs are measured with enough precision.
+        usize repeat = max<usize>(1000000 / max<usize>(input.size(), 1), 1);
+        Vector<Vector<u64>> copies(repeat, input);
+        u64 begin = get_ticks();
+        for (auto& v : copies) sort(v.begin(), v.end());
+        u64 end = get_ticks();
+        for (auto& v : copies) g_sink += v.empty() ? 0 : v[v.size() / 2];
+        c8 name[128];
+        snprintf(name, 128, "sort/int/%s", case_name);
+        add_result(name, input.size(), input.size() * repeat, ticks_to_seconds(end - begin));
+    }
+
+    void bench_sort(usize n)
+    {
+        Vector<u64> v(n);
+        for (usize i = 0; i < n; ++i) v[i] = random_u64();
+        bench_sort_case("random", v);
+        for (usize i = 0; i < n; ++i) v[i] = i;
+        bench_sort_case("sorted", v);
+        for (usize i = 0; i < n; ++i) v[i] = n - i;
+        bench_sort_case("reversed", v);
+        for (usize i = 0; i < n; ++i) v[i] = random_u64() % 16;
+        bench_sort_case("few_unique", v);
+        // Ascending then descending, which degrades naive median-of-three pivot selection.
+        for (usize i = 0; i < n; ++i) v[i] = i < n / 2 ? i : n - i;
+        bench_sort_case("organ_pipe", v);
+        for (usize i = 0; i < n; ++i) v[i] = i % 32;
+        bench_sort_case("sawtooth", v);
+        // Sorted with 1% of elements swapped randomly.
+        for (usize i = 0; i < n; ++i) v[i] = i;
+        for (usize i = 0; i < n / 100; ++i) swap(v[random_u64() % n], v[random_u64() % n]);
+        bench_sort_case("nearly_sorted", v);
+    }
+
+    RV write_results(const c8* output_path)
+    {
+        lutry
+        {
+            Variant root(VariantType::object);
+            root["benchmark"] = "Container";
+            root["timestamp"] = get_utc_timestamp();
+            root["results"] = move(g_results);
+            String data = VariantUtils::write_json(root);
+            lulet(f, open_file(output_path, FileOpenFlag::write, FileCreationMode::create_always));
+            luexp(f->write(data.data(), data.size()));
+        }
+        lucatchret;
+        return ok;
+    }
+
+    void run_benchmark(usize max_size, const c8* output_path)
+    {
+        const usize sizes[] = { 1000, 100000, 1000000 };
+        for (usize n : sizes)
+        {
+            if (n > max_size) break;
+            bench_maps<u64>(n);
+            bench_maps<String>(n);
+            bench_maps<Name>(n);
+            bench_vector_push<u64>("int", n, BenchKey<u64>::make);
+            bench_vector_push<String>("string", n, BenchKey<String>::make);
+            bench_ring_deque(n);
+            bench_sort(n);
+        }
+        bench_memhash(64 * 1024 * 1024);
+        auto r = write_results(output_path);
+        if (failed(r))
+        {
+            printf("Failed to write benchmark results to %s: %s\n", output_path, explain(r.errcode()));
+            return;
+        }
+        printf("Benchmark results written to %s (sink: %llu)\n", output_path, (unsigned long long)g_sink);
+    }
+}
+
+//! Usage: ContainerBenchmark [max_size] [output_path]
+int main(int argc, const char* argv[])
+{
+    Luna::usize max_size = 1000000;
+    const char* output_path = "ContainerBenchmark.json";
+    if (argc > 1) max_size = (Luna::usize)strtoull(argv[1], nullptr, 10);
+    if (argc > 2) output_path = argv[2];
+    Luna::init();
+    lupanic_if_failed(Luna::add_modules({Luna::module_variant_utils()}));
+    lupanic_if_failed(Luna::init_modules());
+    Luna::run_benchmark(max_size, output_path);
+    Luna::close();
+    return 0;
+}
@@ -0,0 +1,346 @@
+/*!
+* This file is a portion of LunaSDK.
+* For conditions of distribution and use, see the disclaimer
+* and license in LICENSE.txt
+*
+* @file Main.cpp
+* @author JXMaster
+* @date 2026/10/18
+*/
+#include <Luna/Runtime/Runtime.hpp>
+#include <Luna/Runtime/Module.hpp>
+#include <Luna/Runtime/Time.hpp>
+#include <Luna/Runtime/File.hpp>
+#include <Luna/Runtime/Random.hpp>
+#include <Luna/Runtime/Variant.hpp>
+#include <Luna/Runtime/Reflection.hpp>
+#include <Luna/JobSystem/JobSystem.hpp>
+#include <Luna/ECS/ECS.hpp>
+#include <Luna/ECS/World.hpp>
+#include <Luna/VariantUtils/VariantUtils.hpp>
+#include <Luna/VariantUtils/JSON.hpp>
+#include <stdio.h>
+#include <stdlib.h>
+
+// Every component is 16 bytes, so that iteration bandwidth scales with the number of components.
+#define LUNA_ECS_BENCH_COMPONENT(_name, _guid) struct _name \
+{ \
+    lustruct(#_name, _guid); \
+    Luna::f32 x; \
+    Luna::f32 y; \
+    Luna::f32 z; \
+    Luna::f32 w; \
+};
+
+LUNA_ECS_BENCH_COMPONENT(BenchComponent0, "{5A0A0D2C-6A43-4E0C-9C4C-2B8E3C1F0A01}")
+LUNA_ECS_BENCH_COMPONENT(BenchComponent1, "{5A0A0D2C-6A43-4E0C-9C4C-2B8E3C1F0A02}")
+LUNA_ECS_BENCH_COMPONENT(BenchComponent2, "{5A0A0D2C-6A43-4E0C-9C4C-2B8E3C1F0A03}")
+LUNA_ECS_BENCH_COMPONENT(BenchComponent3, "{5A0A0D2C-6A43-4E0C-9C4C-2B8E3C1F0A04}")
+LUNA_ECS_BENCH_COMPONENT(BenchComponent4, "{5A0A0D2C-6A43-4E0C-9C4C-2B8E3C1F0A05}")
+LUNA_ECS_BENCH_COMPONENT(BenchComponent5, "{5A0A0D2C-6A43-4E0C-9C4C-2B8E3C1F0A06}")
+LUNA_ECS_BENCH_COMPONENT(BenchComponent6, "{5A0A0D2C-6A43-4E0C-9C4C-2B8E3C1F0A07}")
+LUNA_ECS_BENCH_COMPONENT(BenchComponent7, "{5A0A0D2C-6A43-4E0C-9C4C-2B8E3C1F0A08}")
+
+namespace Luna
+{
+    using namespace ECS;
+
+    constexpr usize NUM_BENCH_COMPONENTS = 8;
+    typeinfo_t g_components[NUM_BENCH_COMPONENTS];
+    Variant g_results(VariantType::array);
+    f64 g_sink = 0.0;
+
+    template <typename _Ty>
+    void register_bench_component(usize index)
+    {
+        g_components[index] = register_struct_type<_Ty>({
+            luproperty(_Ty, f32, x),
+            luproperty(_Ty, f32, y),
+            luproperty(_Ty, f32, z),
+            luproperty(_Ty, f32, w)
+            });
+    }
+
+    void register_bench_components()
+    {
+        register_bench_component<BenchComponent0>(0);
+        register_bench_component<BenchComponent1>(1);
+        register_bench_component<BenchComponent2>(2);
+        register_bench_component<BenchComponent3>(3);
+        register_bench_component<BenchComponent4>(4);
+        register_bench_component<BenchComponent5>(5);
+        register_bench_component<BenchComponent6>(6);
+        register_bench_component<BenchComponent7>(7);
+    }
+
+    f64 ticks_to_seconds(u64 ticks)
+    {
+        return (f64)ticks / get_ticks_per_second();
+    }
+
+    //! Records one benchmark result.
+    //! @param[in] name The name of the benchmark case.
+    //! @param[in] size The number of entities (or clusters for query cases) involved in this case.
+    //! @param[in] ops The number of operations performed in this case.
+    //! @param[in] seconds The time spent in seconds.
+    //! @param[in] bytes The number of bytes touched in this case, or 0 if bandwidth is not measured.
+    void add_result(const c8* name, usize size, usize ops, f64 seconds, u64 bytes = 0)
+    {
+        Variant item(VariantType::object);
+        item["name"] = name;
+        item["size"] = (u64)size;
+        item["operations"] = (u64)ops;
+        item["seconds"] = seconds;
+        f64 ops_per_second = seconds > 0.0 ? (f64)ops / seconds : 0.0;
+        f64 ns_per_op = ops ? seconds * 1000000000.0 / (f64)ops : 0.0;
+        item["ops_per_second"] = ops_per_second;
+        item["ns_per_op"] = ns_per_op;
+        if (bytes)
+        {
+            f64 bytes_per_second = seconds > 0.0 ? (f64)bytes / seconds : 0.0;
+            item["bytes"] = bytes;
+            item["bytes_per_second"] = bytes_per_second;
+            printf("%-28s size: %10llu  %12.3f ms  %10.2f ns/op  %10.2f GB/s\n", name, (unsigned long long)size, seconds * 1000.0, ns_per_op, bytes_per_second / 1000000000.0);
+        }
+        else
+        {
+            printf("%-28s size: %10llu  %12.3f ms  %10.2f ns/op\n", name, (unsigned long long)size, seconds * 1000.0, ns_per_op);
+        }
+        g_results.push_back(move(item));
+    }
+
+    void create_entities(IWorld* world, Cluster* cluster, usize num_entities, Vector<entity_id_t>& out_ids)
+    {
+        out_ids.clear();
+        out_ids.reserve(num_entities);
+        for (usize i = 0; i < num_entities; ++i)
+        {
+            out_ids.push_back(world->new_entity(cluster));
+        }
+    }
+
+    void shuffle_ids(Vector<entity_id_t>& ids)
+    {
+        for (usize i = ids.size(); i > 1; --i)
+        {
+            usize j = (usize)(random_u64() % i);
+            swap(ids[i - 1], ids[j]);
+        }
+    }
+
+    void bench_create_delete(usize num_entities)
+    {
+        Ref<IWorld> world = new_world();
+        Cluster* cluster = world->get_cluster({g_components, 1}, {}, true);
+        Vector<entity_id_t> ids;
+        ids.reserve(num_entities);
+        u64 begin = get_ticks();
+        for (usize i = 0; i < num_entities; ++i)
+        {
+            ids.push_back(world->new_entity(cluster));
+        }
+        u64 end = get_ticks();
+        add_result("entity_create", num_entities, num_entities, ticks_to_seconds(end - begin));
+        begin = get_ticks();
+        for (entity_id_t id : ids)
+        {
+            world->delete_entity(id);
+        }
+        end = get_ticks();
+        add_result("entity_delete", num_entities, num_entities, ticks_to_seconds(end - begin));
+        // Create again to measure creation with recycled entity IDs.
+        begin = get_ticks();
+        for (usize i = 0; i < num_entities; ++i)
+        {
+            world->new_entity(cluster);
+        }
+        end = get_ticks();
+        add_result("entity_create_recycled", num_entities, num_entities, ticks_to_seconds(end - begin));
+    }
+
+    void bench_migration(usize num_entities)
+    {
+        Ref<IWorld> world = new_world();
+        Cluster* src_cluster = world->get_cluster({g_components, 2}, {}, true);
+        Cluster* dst_cluster = world->get_cluster({g_components, 3}, {}, true);
+        Vector<entity_id_t> ids;
+        create_entities(world, src_cluster, num_entities, ids);
+        u64 begin = get_ticks();
+        for (entity_id_t id : ids)
+        {
+            lupanic_if_failed(world->set_entity_cluster(id, dst_cluster));
+        }
+        u64 end = get_ticks();
+        add_result("component_add", num_entities, num_entities, ticks_to_seconds(end - begin));
+        begin = get_ticks();
+        for (entity_id_t id : ids)
+        {
+            lupanic_if_failed(world->set_entity_cluster(id, src_cluster));
+        }
+        end = get_ticks();
+        add_result("component_remove", num_entities, num_entities, ticks_to_seconds(end - begin));
+    }
+
+    void bench_iteration(usize num_entities, usize num_components)
+    {
+        Ref<IWorld> world = new_world();
+        Cluster* cluster = world->get_cluster({g_components, num_components}, {}, true);
+        for (usize i = 0; i < num_entities; ++i)
+        {
+            world->new_entity(cluster);
+        }
+        constexpr usize NUM_PASSES = 4;
+        f32 sum = 0.0f;
+        u64 begin = get_ticks();
+        for (usize pass = 0; pass < NUM_PASSES; ++pass)
+        {
+            usize num_chunks = get_cluster_num_chunks(cluster);
+            for (usize chunk = 0; chunk < num_chunks; ++chunk)
+            {
+                usize num_chunk_entities = get_cluster_entities(cluster, chunk).size();
+                for (usize c = 0; c < num_components; ++c)
+                {
+                    const BenchComponent0* data = (const BenchComponent0*)get_cluster_components_data(cluster, chunk, g_components[c]);
+                    for (usize i = 0; i < num_chunk_entities; ++i)
+                    {
+                        sum += data[i].x + data[i].y + data[i].z + data[i].w;
+                    }
+                }
+            }
+        }
+        u64 end = get_ticks();
+        g_sink += sum;
+        c8 name[64];
+        snprintf(name, 64, "iterate_%u_components", (u32)num_components);
+        add_result(name, num_entities, num_entities * NUM_PASSES, ticks_to_seconds(end - begin),
+            (u64)num_entities * num_components * sizeof(BenchComponent0) * NUM_PASSES);
+    }
+
+    void bench_random_access(usize num_entities)
+    {
+        Ref<IWorld> world = new_world();
+        Cluster* cluster = world->get_cluster({g_components, 1}, {}, true);
+        Vector<entity_id_t> ids;
+        create_entities(world, cluster, num_entities, ids);
+        shuffle_ids(ids);
+        usize found = 0;
+        u64 begin = get_ticks();
+        for (entity_id_t id : ids)
+        {
+            auto r = world->get_entity_address(id);
+            if (succeeded(r)) found += r.get().index & 1;
+        }
+        u64 end = get_ticks();
+        g_sink += (f64)found;
+        add_result("get_entity_address_random", num_entities, num_entities, ticks_to_seconds(end - begin));
+    }
+
+    void bench_query(usize num_clusters)
+    {
+        Ref<IWorld> world = new_world();
+        // Every cluster gets one unique tag and one combination of components, so that
+        // the world contains `num_clusters` distinct clusters.
+        Vector<usize> tag_storage;
+        tag_storage.resize(num_clusters);
+        Vector<Cluster*> clusters;
+        clusters.reserve(num_clusters);
+        typeinfo_t components[NUM_BENCH_COMPONENTS];
+        for (usize i = 0; i < num_clusters; ++i)
+        {
+            usize num_components = 0;
+            usize mask = (i % ((1 << NUM_BENCH_COMPONENTS) - 1)) + 1;
+            for (usize c = 0; c < NUM_BENCH_COMPONENTS; ++c)
+            {
+                if (mask & ((usize)1 << c)) components[num_components++] = g_components[c];
+            }
+            tag_t tag = &tag_storage[i];
+            clusters.push_back(world->get_cluster({components, num_components}, {&tag, 1}, true));
+        }
+        // Measure cluster lookup by components and tags.
+        constexpr usize NUM_LOOKUPS = 100000;
+        usize found = 0;
+        u64 begin = get_ticks();
+        for (usize i = 0; i < NUM_LOOKUPS; ++i)
+        {
+            usize index = (usize)(random_u64() % num_clusters);
+            Cluster* cluster = clusters[index];
+            Span<const typeinfo_t> cluster_components = get_cluster_components(cluster);
+            Span<const tag_t> cluster_tags = get_cluster_tags(cluster);
+            if (world->get_cluster(cluster_components, cluster_tags, false) == cluster) ++found;
+        }
+        u64 end = get_ticks();
+        g_sink += (f64)found;
+        add_result("get_cluster_lookup", num_clusters, NUM_LOOKUPS, ticks_to_seconds(end - begin));
+        // Measure cluster queries that match a subset of all clusters.
+        constexpr usize NUM_QUERIES = 1000;
+        Vector<Cluster*> out_clusters;
+        begin = get_ticks();
+        for (usize i = 0; i < NUM_QUERIES; ++i)
+        {
+            out_clusters.clear();
+            world->find_clusters({g_components + (i % NUM_BENCH_COMPONENTS), 1}, {}, out_clusters);
+        }
+        end = get_ticks();
+        g_sink += (f64)out_clusters.size();
+        add_result("find_clusters", num_clusters, NUM_QUERIES, ticks_to_seconds(end - begin));
+    }
+
+    RV write_results(const c8* output_path)
+    {
+        lutry
+        {
+            Variant root(VariantType::object);
+            root["benchmark"] = "ECS";
+            root["timestamp"] = get_utc_timestamp();
+            root["results"] = move(g_results);
+            String data = VariantUtils::write_json(root);
+            lulet(f, open_file(output_path, FileOpenFlag::write, FileCreationMode::create_always));
+            luexp(f->write(data.data(), data.size()));
+        }
+        lucatchret;
+        return ok;
+    }
+
+    void run_benchmark(usize max_entities, const c8* output_path)
+    {
+        register_bench_components();
+        const usize entity_counts[] = { 10000, 100000, 1000000, 10000000 };
+        for (usize num_entities : entity_counts)
+        {
+            if (num_entities > max_entities) break;
+            bench_create_delete(num_entities);
+            bench_migration(num_entities);
+            bench_iteration(num_entities, 1);
+            bench_iteration(num_entities, 4);
+            bench_iteration(num_entities, 8);
+            bench_random_access(num_entities);
+        }
+        const usize cluster_counts[] = { 1024, 4096, 16384 };
+        for (usize num_clusters : cluster_counts)
+        {
+            bench_query(num_clusters);
+        }
+        auto r = write_results(output_path);
+        if (failed(r))
+        {
+            printf("Failed to write benchmark results to %s: %s\n", output_path, explain(r.errcode()));
+            return;
+        }
+        printf("Benchmark results written to %s\n", output_path);
+    }
+}
+
+//! Usage: ECSBenchmark [max_entities] [output_path]
+int main(int argc, const char* argv[])
+{
+    Luna::usize max_entities = 10000000;
+    const char* output_path = "ECSBenchmark.json";
+    if (argc > 1) max_entities = (Luna::usize)strtoull(argv[1], nullptr, 10);
+    if (argc > 2) output_path = argv[2];
+    Luna::init();
+    lupanic_if_failed(Luna::add_modules({Luna::module_job_system(), Luna::module_ecs(), Luna::module_variant_utils()}));
+    lupanic_if_failed(Luna::init_modules());
+    Luna::run_benchmark(max_entities, output_path);
+    Luna::close();
+    return 0;
+}
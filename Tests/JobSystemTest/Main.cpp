@@ -9,6 +9,9 @@
 */
 #include <Luna/Runtime/Thread.hpp>
 #include <Luna/JobSystem/JobSystem.hpp>
+#include <Luna/JobSystem/ParallelAlgorithm.hpp>
+#include <Luna/Runtime/Vector.hpp>
+#include <Luna/Runtime/Random.hpp>
 #include <Luna/Runtime/Time.hpp>
 #include <Luna/Runtime/Runtime.hpp>
 #include <Luna/Runtime/Module.hpp>
@@ -79,6 +82,86 @@ namespace Luna
             printf("Jon System Test 1: %u levels of jobs finished in %f milliseconds.\n", RECURSIVE_DEPTH, (f64)(end_time - begin_time) / get_ticks_per_second() * 1000.0);
         }
     }
+
+    struct ParallelSortEntry
+    {
+        u32 key;
+        u32 index;
+    };
+
+    void parallel_algorithm_test()
+    {
+        const usize sizes[] = { 0, 1, 100, 4096 * 2 - 1, 100000, 1000003 };
+        for (usize size : sizes)
+        {
+            Vector<u32> data(size);
+            for (usize i = 0; i < size; ++i) data[i] = random_u32();
+            // parallel_sort gets the same result as sort.
+            {
+                Vector<u32> a = data;
+                Vector<u32> b = data;
+                parallel_sort(a.begin(), a.end());
+                sort(b.begin(), b.end());
+                luassert_always(equal(a.begin(), a.end(), b.begin()));
+                parallel_sort(a.begin(), a.end(), [](u32 lhs, u32 rhs) { return lhs > rhs; }, 1000);
+                for (usize i = 1; i < size; ++i) luassert_always(a[i - 1] >= a[i]);
+            }
+            // parallel_stable_sort preserves the order of equal elements.
+            {
+                Vector<ParallelSortEntry> entries(size);
+                for (usize i = 0; i < size; ++i)
+                {
+                    entries[i].key = data[i] % 100;
+                    entries[i].index = (u32)i;
+                }
+                parallel_stable_sort(entries.begin(), entries.end(), [](const ParallelSortEntry& lhs, const ParallelSortEntry& rhs) { return lhs.key < rhs.key; }, 1000);
+                for (usize i = 1; i < size; ++i)
+                {
+                    luassert_always(entries[i - 1].key < entries[i].key || 
+                        (entries[i - 1].key == entries[i].key && entries[i - 1].index < entries[i].index));
+                }
+            }
+            // parallel_transform, parallel_reduce and parallel_inclusive_scan get the same results as serial loops.
+            {
+                Vector<u64> transformed(size);
+                parallel_transform(data.begin(), data.end(), transformed.begin(), [](u32 v) { return (u64)v * 3; });
+                u64 sum = 0;
+                for (usize i = 0; i < size; ++i)
+                {
+                    luassert_always(transformed[i] == (u64)data[i] * 3);
+                    sum += transformed[i];
+                }
+                luassert_always(parallel_reduce(transformed.begin(), transformed.end(), (u64)5, [](u64 a, u64 b) { return a + b; }) == sum + 5);
+                Vector<u64> scanned(size);
+                parallel_inclusive_scan(transformed.begin(), transformed.end(), scanned.begin(), [](u64 a, u64 b) { return a + b; });
+                u64 prefix = 0;
+                for (usize i = 0; i < size; ++i)
+                {
+                    prefix += transformed[i];
+                    luassert_always(scanned[i] == prefix);
+                }
+                // Scans in place.
+                parallel_inclusive_scan(transformed.begin(), transformed.end(), transformed.begin(), [](u64 a, u64 b) { return a + b; });
+                luassert_always(equal(transformed.begin(), transformed.end(), scanned.begin()));
+            }
+            // Results of floating-point reductions are deterministic.
+            {
+                Vector<f64> values(size);
+                for (usize i = 0; i < size; ++i) values[i] = random_f64(-1.0, 1.0);
+                f64 r1 = parallel_reduce(values.begin(), values.end(), 0.0, [](f64 a, f64 b) { return a + b; });
+                f64 r2 = parallel_reduce(values.begin(), values.end(), 0.0, [](f64 a, f64 b) { return a + b; });
+                luassert_always(r1 == r2);
+            }
+        }
+        {
+            Vector<u32> data(4000000);
+            for (u32& v : data) v = random_u32();
+            u64 sort_begin_time = get_ticks();
+            parallel_sort(data.begin(), data.end());
+            u64 end_time = get_ticks();
+            printf("Parallel Algorithm Test: %u elements sorted in %f milliseconds.\n", (u32)data.size(), (f64)(end_time - sort_begin_time) / get_ticks_per_second() * 1000.0);
+        }
+    }
 }
 
 int main()
@@ -87,6 +170,7 @@ int main()
     lupanic_if_failed(Luna::add_module(Luna::module_job_system()));
     lupanic_if_failed(Luna::init_modules());
     Luna::job_system_test();
+    Luna::parallel_algorithm_test();
     Luna::close();
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,70 @@
+/*!
+* This file is a portion of LunaSDK.
+* For conditions of distribution and use, see the disclaimer
+* and license in LICENSE.txt
+*
+* @file AllocationProfilerTest.cpp
+* @author JXMaster
+* @date 2026/10/18
+*/
+#include "TestCommon.hpp"
+#include <Luna/Runtime/Memory.hpp>
+#include <Luna/Runtime/AllocationProfiler.hpp>
+
+namespace Luna
+{
+    static i64 get_total_bytes(const AllocationProfile& profile)
+    {
+        i64 r = 0;
+        for (auto& site : profile.sites) r += site.bytes;
+        return r;
+    }
+
+    void allocation_profiler_test()
+    {
+        constexpr usize NUM_BLOCKS = 1024;
+        constexpr usize BLOCK_SIZE = 4096;
+        set_allocation_sampling_interval(64_kb);
+        lutest(get_allocation_sampling_interval() == 64_kb);
+        AllocationProfile base = capture_allocation_profile();
+        void* blocks[NUM_BLOCKS];
+        for (usize i = 0; i < NUM_BLOCKS; ++i)
+        {
+            blocks[i] = memalloc(BLOCK_SIZE);
+        }
+        AllocationProfile allocated = capture_allocation_profile();
+        lutest(allocated.sampling_interval == 64_kb);
+        // The estimation should be close to the real allocated size.
+        AllocationProfile diff = diff_allocation_profiles(base, allocated);
+        i64 estimated = get_total_bytes(diff);
+        i64 expected = (i64)(NUM_BLOCKS * BLOCK_SIZE);
+        lutest(estimated > expected / 2 && estimated < expected * 2);
+        for (usize i = 0; i < NUM_BLOCKS; ++i)
+        {
+            memfree(blocks[i]);
+        }
+        AllocationProfile freed = capture_allocation_profile();
+        diff = diff_allocation_profiles(allocated, freed);
+        lutest(get_total_bytes(diff) == -get_total_bytes(diff_allocation_profiles(base, allocated)));
+        String json = allocation_profile_to_json(allocated, false);
+        lutest(json.size() && json[0] == '{' && json[json.size() - 1] == '}');
+        {
+            // Blocks that fail to be reallocated are still live, so they must be kept in the profile.
+            constexpr usize NUM_LARGE_BLOCKS = 16;
+            void* large_blocks[NUM_LARGE_BLOCKS];
+            for (usize i = 0; i < NUM_LARGE_BLOCKS; ++i) large_blocks[i] = memalloc(256_kb);
+            AllocationProfile before = capture_allocation_profile();
+            for (usize i = 0; i < NUM_LARGE_BLOCKS; ++i)
+            {
+                lutest(memrealloc(large_blocks[i], (usize)-1 / 4) == nullptr);
+            }
+            AllocationProfile after = capture_allocation_profile();
+            // Other threads may allocate or free sampled blocks concurrently, so only checks that the samples of
+            // the large blocks (about 4MB in total) are not removed.
+            lutest(get_total_bytes(after) > get_total_bytes(before) - (i64)1_mb);
+            for (usize i = 0; i < NUM_LARGE_BLOCKS; ++i) memfree(large_blocks[i]);
+        }
+        set_allocation_sampling_interval(0);
+        lutest(get_allocation_sampling_interval() == 0);
+    }
+}
@@ -0,0 +1,108 @@
+/*!
+* This file is a portion of LunaSDK.
+* For conditions of distribution and use, see the disclaimer
+* and license in LICENSE.txt
+*
+* @file ArenaTest.cpp
+* @author JXMaster
+* @date 2026/10/18
+*/
+#include "TestCommon.hpp"
+#include <Luna/Runtime/Arena.hpp>
+#include <Luna/Runtime/Vector.hpp>
+#include <Luna/Runtime/HashMap.hpp>
+#include <Luna/Runtime/String.hpp>
+#include <Luna/Runtime/Thread.hpp>
+
+namespace Luna
+{
+    struct ArenaThreadTestContext
+    {
+        Arena* arena;
+        u32 thread_index;
+        u32* blocks[4096];
+    };
+
+    static void arena_test_thread(void* params)
+    {
+        ArenaThreadTestContext* ctx = (ArenaThreadTestContext*)params;
+        for (u32 i = 0; i < 4096; ++i)
+        {
+            u32* p = (u32*)ctx->arena->allocate(sizeof(u32) * 4);
+            lutest(p);
+            for (u32 j = 0; j < 4; ++j) p[j] = ctx->thread_index * 4096 + i;
+            ctx->blocks[i] = p;
+        }
+    }
+
+    void arena_test()
+    {
+        {
+            Arena arena(1_kb);
+            lutest(arena.allocate(0) == nullptr);
+            void* p = arena.allocate(100);
+            lutest(p && ((usize)p % MAX_ALIGN) == 0);
+            p = arena.allocate(7, 256);
+            lutest(p && ((usize)p % 256) == 0);
+            // Allocations larger than one block.
+            p = arena.allocate(4_kb, 64);
+            lutest(p && ((usize)p % 64) == 0);
+            memset(p, 0xCD, 4_kb);
+            usize capacity = arena.get_capacity();
+            lutest(capacity >= 5_kb);
+            // Reset keeps all blocks.
+            arena.reset();
+            lutest(arena.get_used_size() == 0);
+            for (usize i = 0; i < 16; ++i) arena.allocate(64);
+            lutest(arena.get_capacity() == capacity);
+            arena.release();
+            lutest(arena.get_capacity() == 0);
+        }
+        {
+            // Containers with arena allocator.
+            Arena arena;
+            for (u32 frame = 0; frame < 4; ++frame)
+            {
+                {
+                    Vector<u32, ArenaAllocator> v{ ArenaAllocator(arena) };
+                    for (u32 i = 0; i < 1000; ++i) v.push_back(i);
+                    for (u32 i = 0; i < 1000; ++i) lutest(v[i] == i);
+                    HashMap<u32, u32, hash<u32>, equal_to<u32>, ArenaAllocator> m{ ArenaAllocator(arena) };
+                    for (u32 i = 0; i < 1000; ++i) m.insert(make_pair(i, i * 2));
+                    for (u32 i = 0; i < 1000; ++i) lutest(m.find(i)->second == i * 2);
+                    BasicString<c8, ArenaAllocator> s{ ArenaAllocator(arena) };
+                    for (u32 i = 0; i < 100; ++i) s.append("arena");
+                    lutest(s.size() == 500);
+                    lutest(v.get_allocator() == ArenaAllocator(arena));
+                }
+                arena.reset();
+            }
+        }
+        {
+            // Thread-safe arena.
+            Arena arena(4_kb, true);
+            lutest(arena.is_thread_safe());
+            constexpr u32 NUM_THREADS = 4;
+            ArenaThreadTestContext* ctxs = (ArenaThreadTestContext*)memalloc(sizeof(ArenaThreadTestContext) * NUM_THREADS);
+            Ref<IThread> threads[NUM_THREADS];
+            for (u32 i = 0; i < NUM_THREADS; ++i)
+            {
+                ctxs[i].arena = &arena;
+                ctxs[i].thread_index = i;
+                threads[i] = new_thread(arena_test_thread, &ctxs[i]);
+            }
+            for (u32 i = 0; i < NUM_THREADS; ++i)
+            {
+                threads[i]->wait();
+            }
+            for (u32 i = 0; i < NUM_THREADS; ++i)
+            {
+                for (u32 j = 0; j < 4096; ++j)
+                {
+                    for (u32 k = 0; k < 4; ++k) lutest(ctxs[i].blocks[j][k] == i * 4096 + j);
+                }
+            }
+            memfree(ctxs);
+        }
+    }
+}
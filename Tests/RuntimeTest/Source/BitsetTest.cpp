@@ -0,0 +1,103 @@
+/*!
+* This file is a portion of LunaSDK.
+* For conditions of distribution and use, see the disclaimer
+* and license in LICENSE.txt
+*
+* @file BitsetTest.cpp
+* @author JXMaster
+* @date 2026/10/18
+*/
+#include "TestCommon.hpp"
+#include <Luna/Runtime/Bitset.hpp>
+
+namespace Luna
+{
+    void bitset_test()
+    {
+        {
+            Bitset<> bits;
+            lutest(bits.empty());
+            lutest(bits.none());
+            lutest(bits.all());
+            lutest(bits.find_first() == USIZE_MAX);
+            for (usize i = 0; i < 130; ++i) bits.push_back(i % 3 == 0);
+            lutest(bits.size() == 130);
+            lutest(bits.num_words() == 3);
+            lutest(bits.count() == 44);
+            for (usize i = 0; i < 130; ++i) lutest(bits.test(i) == (i % 3 == 0));
+            usize expected = 0;
+            for (usize i = bits.find_first(); i != USIZE_MAX; i = bits.find_next(i + 1))
+            {
+                lutest(i == expected);
+                expected += 3;
+            }
+            lutest(expected == 132);
+            expected = 0;
+            bits.for_each_set_bit([&expected](usize i)
+            {
+                lutest(i == expected);
+                expected += 3;
+            });
+            lutest(expected == 132);
+            bits.flip_all();
+            lutest(bits.count() == 86);
+            lutest(!bits.test(129));
+            lutest(bits.test(128));
+            bits.set_all();
+            lutest(bits.all());
+            lutest(bits.count() == 130);
+            bits.reset(64);
+            lutest(!bits.all());
+            lutest(bits.find_next(64) == 65);
+            bits.reset_all();
+            lutest(bits.none());
+            bits.set(129);
+            lutest(bits.find_next(1) == 129);
+            lutest(bits.find_next(130) == USIZE_MAX);
+        }
+        {
+            // Growing with `1` must fill the unused bits of the old last word.
+            Bitset<> bits(10);
+            bits.resize(200, true);
+            lutest(bits.count() == 190);
+            lutest(bits.find_first() == 10);
+            bits.resize(70);
+            lutest(bits.count() == 60);
+            bits.resize(128, false);
+            lutest(bits.count() == 60);
+            lutest(!bits.test(100));
+        }
+        {
+            // Bulk operations cover both SIMD and scalar paths.
+            constexpr usize n = 1000;
+            Bitset<> a(n);
+            Bitset<> b(n);
+            for (usize i = 0; i < n; ++i)
+            {
+                a.set(i, i % 2 == 0);
+                b.set(i, i % 3 == 0);
+            }
+            Bitset<> c = a;
+            c &= b;
+            for (usize i = 0; i < n; ++i) lutest(c.test(i) == (i % 6 == 0));
+            c = a;
+            c |= b;
+            for (usize i = 0; i < n; ++i) lutest(c.test(i) == (i % 2 == 0 || i % 3 == 0));
+            c = a;
+            c ^= b;
+            for (usize i = 0; i < n; ++i) lutest(c.test(i) == ((i % 2 == 0) != (i % 3 == 0)));
+            c = a;
+            c.and_not(b);
+            for (usize i = 0; i < n; ++i) lutest(c.test(i) == (i % 2 == 0 && i % 3 != 0));
+            lutest(a.intersects(b));
+            lutest(!c.intersects(b));
+            lutest(c.is_subset_of(a));
+            lutest(!a.is_subset_of(c));
+            lutest(c != a);
+            c |= b;
+            c.and_not(b);
+            c |= a;
+            lutest(c == a);
+        }
+    }
+}
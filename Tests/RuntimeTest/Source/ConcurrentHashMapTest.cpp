@@ -0,0 +1,113 @@
+/*!
+* This file is a portion of LunaSDK.
+* For conditions of distribution and use, see the disclaimer
+* and license in LICENSE.txt
+*
+* @file ConcurrentHashMapTest.cpp
+* @author JXMaster
+* @date 2026/10/18
+*/
+#include "TestCommon.hpp"
+#include <Luna/Runtime/ConcurrentHashMap.hpp>
+#include <Luna/Runtime/Thread.hpp>
+#include <Luna/Runtime/Name.hpp>
+
+namespace Luna
+{
+    struct ConcurrentHashMapTestContext
+    {
+        ConcurrentHashMap<u64, u64>* map;
+        volatile u32 finished;
+        usize num_errors;
+    };
+
+    static void concurrent_hash_map_reader(void* params)
+    {
+        // The value of every key must always be the key multiplied by 2 or 3.
+        ConcurrentHashMapTestContext* ctx = (ConcurrentHashMapTestContext*)params;
+        while (!ctx->finished)
+        {
+            for (u64 i = 0; i < 4096; ++i)
+            {
+                u64 v;
+                if (ctx->map->find(i, v) && v != i * 2 && v != i * 3) ++ctx->num_errors;
+            }
+            ctx->map->for_each([ctx](const u64& key, const u64& value)
+            {
+                if (value != key * 2 && value != key * 3) ++ctx->num_errors;
+            });
+        }
+    }
+
+    void concurrent_hash_map_test()
+    {
+        TestObject::reset();
+        {
+            ConcurrentHashMap<i32, TestObject> map;
+            lutest(map.empty());
+            for (i32 i = 0; i < 1000; ++i)
+            {
+                lutest(map.insert(i, TestObject(i)));
+            }
+            lutest(map.size() == 1000);
+            lutest(!map.insert(5, TestObject(100)));
+            TestObject obj;
+            lutest(map.find(5, obj));
+            lutest(obj == TestObject(5));
+            lutest(!map.find(1000, obj));
+            lutest(!map.insert_or_assign(6, TestObject(100)));
+            lutest(map.find(6, obj));
+            lutest(obj == TestObject(100));
+            lutest(map.size() == 1000);
+            for (i32 i = 0; i < 1000; i += 2)
+            {
+                lutest(map.erase(i));
+            }
+            lutest(!map.erase(0));
+            lutest(map.size() == 500);
+            lutest(!map.contains(10));
+            lutest(map.contains(11));
+            i32 sum = 0;
+            map.for_each([&sum](const i32& key, const TestObject& value)
+            {
+                lutest(key == value.m_value);
+                sum += key;
+            });
+            lutest(sum == 250000);
+            lutest(map.visit(11, [](const TestObject& value) { lutest(value == TestObject(11)); }));
+            map.clear();
+            lutest(map.empty());
+            lutest(!map.contains(11));
+            lutest(map.insert(11, TestObject(11)));
+        }
+        // Retired elements must be freed when the map is destructed.
+        lutest(TestObject::g_count == 0);
+        {
+            ConcurrentHashMap<Name, Name> map;
+            map.insert("Key", "Value");
+            Name value;
+            lutest(map.find(Name("Key"), value));
+            lutest(value == "Value");
+        }
+        {
+            // Readers do not observe torn or freed elements when elements are inserted, replaced and removed concurrently.
+            ConcurrentHashMap<u64, u64> map;
+            ConcurrentHashMapTestContext ctx;
+            ctx.map = &map;
+            ctx.finished = 0;
+            ctx.num_errors = 0;
+            Ref<IThread> t = new_thread(concurrent_hash_map_reader, &ctx);
+            for (u64 round = 0; round < 16; ++round)
+            {
+                for (u64 i = 0; i < 4096; ++i) map.insert(i, i * 2);
+                for (u64 i = 0; i < 4096; i += 3) map.insert_or_assign(i, i * 3);
+                for (u64 i = 0; i < 4096; i += 2) map.erase(i);
+                if (round % 4 == 3) map.clear();
+            }
+            ctx.finished = 1;
+            t->wait();
+            t.reset();
+            lutest(ctx.num_errors == 0);
+        }
+    }
+}
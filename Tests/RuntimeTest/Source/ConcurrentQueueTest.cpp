@@ -0,0 +1,152 @@
+/*!
+* This file is a portion of LunaSDK.
+* For conditions of distribution and use, see the disclaimer
+* and license in LICENSE.txt
+*
+* @file ConcurrentQueueTest.cpp
+* @author JXMaster
+* @date 2026/10/18
+*/
+#include "TestCommon.hpp"
+#include <Luna/Runtime/ConcurrentQueue.hpp>
+#include <Luna/Runtime/Thread.hpp>
+#include <Luna/Runtime/Vector.hpp>
+
+namespace Luna
+{
+    constexpr u64 CONCURRENT_QUEUE_TEST_COUNT = 100000;
+    constexpr u64 CONCURRENT_QUEUE_TEST_THREADS = 3;
+
+    static void spsc_queue_test_producer(void* params)
+    {
+        SPSCQueue<u64>* queue = (SPSCQueue<u64>*)params;
+        for (u64 i = 0; i < CONCURRENT_QUEUE_TEST_COUNT; ++i)
+        {
+            queue->push(i);
+        }
+    }
+
+    struct MPMCQueueTestContext
+    {
+        MPMCQueue<u64>* queue;
+        u64 producer_index;
+        u64 sum;
+        usize num_errors;
+    };
+
+    static void mpmc_queue_test_producer(void* params)
+    {
+        MPMCQueueTestContext* ctx = (MPMCQueueTestContext*)params;
+        for (u64 i = 0; i < CONCURRENT_QUEUE_TEST_COUNT; ++i)
+        {
+            ctx->queue->push((ctx->producer_index << 32) | i);
+        }
+    }
+
+    static void mpmc_queue_test_consumer(void* params)
+    {
+        // Elements of the same producer must be popped in order.
+        MPMCQueueTestContext* ctx = (MPMCQueueTestContext*)params;
+        u64 last[CONCURRENT_QUEUE_TEST_THREADS];
+        for (u64& v : last) v = U64_MAX;
+        for (u64 i = 0; i < CONCURRENT_QUEUE_TEST_COUNT; ++i)
+        {
+            u64 v;
+            ctx->queue->pop(v);
+            u64 producer = v >> 32;
+            u64 index = v & 0xFFFFFFFF;
+            if (producer >= CONCURRENT_QUEUE_TEST_THREADS || (last[producer] != U64_MAX && index <= last[producer])) ++ctx->num_errors;
+            else last[producer] = index;
+            ctx->sum += index;
+        }
+    }
+
+    void concurrent_queue_test()
+    {
+        TestObject::reset();
+        {
+            SPSCQueue<TestObject> queue(5);
+            lutest(queue.capacity() == 8);
+            lutest(queue.empty());
+            for (i32 i = 0; i < 8; ++i) lutest(queue.try_push(TestObject(i)));
+            lutest(!queue.try_push(TestObject(8)));
+            lutest(queue.size() == 8);
+            TestObject obj;
+            for (i32 i = 0; i < 5; ++i)
+            {
+                lutest(queue.try_pop(obj));
+                lutest(obj == TestObject(i));
+            }
+            // Wraps around the ring buffer.
+            for (i32 i = 8; i < 13; ++i) lutest(queue.try_emplace(i));
+            for (i32 i = 5; i < 13; ++i)
+            {
+                queue.pop(obj);
+                lutest(obj == TestObject(i));
+            }
+            lutest(!queue.try_pop(obj));
+            // Remaining elements are destructed with the queue.
+            queue.push(TestObject(1));
+            queue.push(TestObject(2));
+        }
+        lutest(TestObject::g_count == 0);
+        {
+            MPMCQueue<TestObject> queue(8);
+            lutest(queue.capacity() == 8);
+            for (i32 i = 0; i < 8; ++i) lutest(queue.try_push(TestObject(i)));
+            lutest(!queue.try_push(TestObject(8)));
+            lutest(queue.size() == 8);
+            TestObject obj;
+            for (i32 i = 0; i < 3; ++i)
+            {
+                lutest(queue.try_pop(obj));
+                lutest(obj == TestObject(i));
+            }
+            for (i32 i = 8; i < 11; ++i) lutest(queue.try_emplace(i));
+            for (i32 i = 3; i < 11; ++i)
+            {
+                queue.pop(obj);
+                lutest(obj == TestObject(i));
+            }
+            lutest(!queue.try_pop(obj));
+            lutest(queue.empty());
+            queue.push(TestObject(1));
+        }
+        lutest(TestObject::g_count == 0);
+        {
+            // Elements are transferred between threads in order.
+            SPSCQueue<u64> queue(64);
+            Ref<IThread> t = new_thread(spsc_queue_test_producer, &queue);
+            for (u64 i = 0; i < CONCURRENT_QUEUE_TEST_COUNT; ++i)
+            {
+                u64 v;
+                queue.pop(v);
+                lutest(v == i);
+            }
+            t->wait();
+        }
+        {
+            // Every element is popped exactly once.
+            MPMCQueue<u64> queue(64);
+            MPMCQueueTestContext producers[CONCURRENT_QUEUE_TEST_THREADS];
+            MPMCQueueTestContext consumers[CONCURRENT_QUEUE_TEST_THREADS];
+            Vector<Ref<IThread>> threads;
+            for (u64 i = 0; i < CONCURRENT_QUEUE_TEST_THREADS; ++i)
+            {
+                producers[i] = { &queue, i, 0, 0 };
+                consumers[i] = { &queue, i, 0, 0 };
+                threads.push_back(new_thread(mpmc_queue_test_producer, &producers[i]));
+                threads.push_back(new_thread(mpmc_queue_test_consumer, &consumers[i]));
+            }
+            for (auto& t : threads) t->wait();
+            u64 sum = 0;
+            for (auto& c : consumers)
+            {
+                lutest(c.num_errors == 0);
+                sum += c.sum;
+            }
+            lutest(sum == CONCURRENT_QUEUE_TEST_THREADS * CONCURRENT_QUEUE_TEST_COUNT * (CONCURRENT_QUEUE_TEST_COUNT - 1) / 2);
+            lutest(queue.empty());
+        }
+    }
+}
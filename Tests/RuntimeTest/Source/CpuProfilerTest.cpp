@@ -0,0 +1,245 @@
+/*!
+* This file is a portion of LunaSDK.
+* For conditions of distribution and use, see the disclaimer
+* and license in LICENSE.txt
+*
+* @file CpuProfilerTest.cpp
+* @author JXMaster
+* @date 2026/10/18
+*/
+#include "TestCommon.hpp"
+#include <Luna/Runtime/Profiler.hpp>
+#include <Luna/Runtime/Thread.hpp>
+#include <Luna/Runtime/File.hpp>
+
+namespace Luna
+{
+    static usize count_substrings(const String& str, const c8* sub)
+    {
+        usize count = 0;
+        usize sub_len = strlen(sub);
+        usize pos = str.find(sub);
+        while (pos != String::npos)
+        {
+            ++count;
+            pos = str.find(sub, pos + sub_len);
+        }
+        return count;
+    }
+
+    static const ProfilerSourceLocation g_worker_location = { "Worker", "cpu_profiler_test_thread", __FILE__, __LINE__ };
+
+    static void cpu_profiler_test_thread(void*)
+    {
+        set_profiler_thread_name("Profiler Test Worker");
+        for (u32 i = 0; i < 4; ++i)
+        {
+            CpuProfilerScope scope(&g_worker_location);
+            sleep(1);
+        }
+    }
+
+    static constexpr u64 PROFILER_TEST_EVENT = strhash64("PROFILER_TEST_EVENT");
+    static u32 g_profiler_test_next_value = 0;
+    static u32 g_profiler_test_num_events = 0;
+    static bool g_profiler_test_in_order = true;
+
+    static void profiler_test_callback(const ProfilerEvent& event)
+    {
+        if (event.id != PROFILER_TEST_EVENT) return;
+        u32 value = *(const u32*)event.data;
+        if (value != g_profiler_test_next_value) g_profiler_test_in_order = false;
+        g_profiler_test_next_value = value + 1;
+        ++g_profiler_test_num_events;
+    }
+
+    static usize g_profiler_test_self_handle = USIZE_MAX;
+    static usize g_profiler_test_added_handle = USIZE_MAX;
+    static u32 g_profiler_test_num_added_events = 0;
+
+    static void profiler_test_added_callback(const ProfilerEvent& event)
+    {
+        if (event.id == PROFILER_TEST_EVENT) ++g_profiler_test_num_added_events;
+    }
+
+    static void profiler_test_reentrant_callback(const ProfilerEvent& event)
+    {
+        if (event.id != PROFILER_TEST_EVENT || g_profiler_test_added_handle != USIZE_MAX) return;
+        // Registers and unregisters callbacks in one callback.
+        g_profiler_test_added_handle = register_profiler_callback(profiler_test_added_callback);
+        unregister_profiler_callback(g_profiler_test_self_handle);
+    }
+
+    void cpu_profiler_test()
+    {
+        {
+            // Events are dispatched asynchronously in submission order, and can be flushed explicitly.
+            usize handle = register_profiler_callback(profiler_test_callback);
+            ProfilerEventStats base = get_profiler_event_stats();
+            for (u32 i = 0; i < 1000; ++i)
+            {
+                u32* data = (u32*)allocate_profiler_event_data(sizeof(u32), alignof(u32));
+                *data = i;
+                submit_profiler_event(PROFILER_TEST_EVENT);
+            }
+            flush_profiler_events();
+            lutest(g_profiler_test_num_events == 1000);
+            lutest(g_profiler_test_in_order);
+            // Events larger than the ring buffer are dropped and counted.
+            void* data = allocate_profiler_event_data(64_mb, 0);
+            lutest(data);
+            submit_profiler_event(PROFILER_TEST_EVENT);
+            flush_profiler_events();
+            lutest(g_profiler_test_num_events == 1000);
+            ProfilerEventStats stats = get_profiler_event_stats();
+            lutest(stats.num_submitted_events >= base.num_submitted_events + 1000);
+            lutest(stats.num_dropped_events == base.num_dropped_events + 1);
+            lutest(stats.num_dispatched_events >= base.num_dispatched_events + 1000);
+            unregister_profiler_callback(handle);
+        }
+        {
+            // Callbacks can be registered and unregistered by callbacks, which take effect after the current dispatch.
+            g_profiler_test_self_handle = register_profiler_callback(profiler_test_reentrant_callback);
+            submit_profiler_event(PROFILER_TEST_EVENT);
+            flush_profiler_events();
+            lutest(g_profiler_test_added_handle != USIZE_MAX);
+            lutest(g_profiler_test_num_added_events == 0);
+            submit_profiler_event(PROFILER_TEST_EVENT);
+            flush_profiler_events();
+            lutest(g_profiler_test_num_added_events == 1);
+            unregister_profiler_callback(g_profiler_test_added_handle);
+        }
+        {
+            // Counter channels are interned by names and summarized by snapshots.
+            profiler_counter_t counter = get_profiler_counter("Test/Counter", ProfilerCounterType::counter);
+            profiler_counter_t gauge = get_profiler_counter("Test/Gauge", ProfilerCounterType::gauge);
+            lutest(counter && gauge && counter != gauge);
+            lutest(get_profiler_counter("Test/Counter", ProfilerCounterType::gauge) == counter);
+            lutest(!get_profiler_counter(Name(), ProfilerCounterType::gauge));
+            take_profiler_metrics_snapshot();
+            profiler_counter_add(counter, 3.0);
+            profiler_counter_add(counter, 4.0);
+            profiler_counter_set(gauge, 10.0);
+            profiler_counter_set(gauge, -2.0);
+            profiler_counter_add(gauge, 7.0);
+            lutest(get_profiler_counter_value(counter) == 7.0);
+            lutest(get_profiler_counter_value(gauge) == 5.0);
+            ProfilerMetricsSnapshot snapshot = take_profiler_metrics_snapshot();
+            lutest(snapshot.interval >= 0.0);
+            bool found_counter = false;
+            bool found_gauge = false;
+            bool found_memory = false;
+            for (auto& m : snapshot.counters)
+            {
+                if (m.name == Name("Test/Counter"))
+                {
+                    found_counter = true;
+                    lutest(m.type == ProfilerCounterType::counter);
+                    lutest(m.value == 7.0 && m.delta == 7.0 && m.num_updates == 2);
+                }
+                else if (m.name == Name("Test/Gauge"))
+                {
+                    found_gauge = true;
+                    lutest(m.type == ProfilerCounterType::gauge);
+                    lutest(m.value == 5.0 && m.min_value == -2.0 && m.max_value == 10.0 && m.num_updates == 3);
+                }
+                else if (m.name == Name("Memory/Allocated Bytes"))
+                {
+                    found_memory = true;
+                    lutest(m.value > 0.0);
+                }
+            }
+            lutest(found_counter && found_gauge && found_memory);
+            // The range does not include the initial value if the channel is never set to that value.
+            profiler_counter_t range_gauge = get_profiler_counter("Test/Range Gauge", ProfilerCounterType::gauge);
+            snapshot = take_profiler_metrics_snapshot();
+            for (auto& m : snapshot.counters)
+            {
+                if (m.name == Name("Test/Range Gauge"))
+                {
+                    lutest(m.min_value == 0.0 && m.max_value == 0.0 && m.num_updates == 0);
+                }
+            }
+            profiler_counter_set(range_gauge, 3.0);
+            profiler_counter_set(range_gauge, 8.0);
+            snapshot = take_profiler_metrics_snapshot();
+            for (auto& m : snapshot.counters)
+            {
+                if (m.name == Name("Test/Range Gauge"))
+                {
+                    lutest(m.min_value == 3.0 && m.max_value == 8.0 && m.num_updates == 2);
+                }
+            }
+            // The range of the next snapshot starts from the current value.
+            profiler_counter_add(gauge, 1.0);
+            snapshot = take_profiler_metrics_snapshot();
+            for (auto& m : snapshot.counters)
+            {
+                if (m.name == Name("Test/Gauge"))
+                {
+                    lutest(m.value == 6.0 && m.min_value == 5.0 && m.max_value == 6.0 && m.delta == 1.0 && m.num_updates == 1);
+                }
+            }
+            // Counter values are exported as counter tracks.
+            begin_trace_capture();
+            profiler_counter_set(gauge, 42.0);
+            String trace = end_trace_capture();
+            lutest(trace.find("{\"name\":\"Test/Gauge\",\"ph\":\"C\"") != String::npos);
+            lutest(trace.find("\"args\":{\"value\":42}") != String::npos);
+            lutest(trace.find("\"args\":{\"value\":6}") != String::npos);
+        }
+        {
+            // Scopes submitted before the capture begins are not captured.
+            static const ProfilerSourceLocation outside = { "Outside", __FUNCTION__, __FILE__, __LINE__ };
+            CpuProfilerScope scope(&outside);
+        }
+        set_profiler_thread_name("Profiler \"Main\"");
+        begin_trace_capture();
+        lutest(is_trace_capturing());
+        {
+            static const ProfilerSourceLocation outer = { "Outer", __FUNCTION__, __FILE__, __LINE__ };
+            static const ProfilerSourceLocation inner = { "Inner", __FUNCTION__, __FILE__, __LINE__ };
+            CpuProfilerScope outer_scope(&outer);
+            for (u32 i = 0; i < 3; ++i)
+            {
+                CpuProfilerScope inner_scope(&inner);
+            }
+            Ref<IThread> t = new_thread(cpu_profiler_test_thread, nullptr);
+            t->wait();
+        }
+        {
+            luprofile_scope("Macro");
+        }
+        String trace = end_trace_capture();
+        lutest(!is_trace_capturing());
+        lutest(trace.find("\"traceEvents\":[") != String::npos);
+        lutest(count_substrings(trace, "\"name\":\"Outside\"") == 0);
+        lutest(count_substrings(trace, "\"name\":\"Outer\"") == 1);
+        lutest(count_substrings(trace, "\"name\":\"Inner\"") == 3);
+        lutest(count_substrings(trace, "\"name\":\"Worker\"") == 4);
+        lutest(count_substrings(trace, "\"ph\":\"B\"") == count_substrings(trace, "\"ph\":\"E\""));
+        lutest(count_substrings(trace, "\"ph\":\"M\"") == 2);
+        lutest(trace.find("\"name\":\"Profiler \\\"Main\\\"\"") != String::npos);
+        lutest(trace.find("\"name\":\"Profiler Test Worker\"") != String::npos);
+#ifdef LUNA_CPU_PROFILER_ENABLED
+        lutest(count_substrings(trace, "\"name\":\"Macro\"") == 1);
+#endif
+        {
+            // Traces can be written to files directly.
+            begin_trace_capture();
+            {
+                static const ProfilerSourceLocation location = { "File", __FUNCTION__, __FILE__, __LINE__ };
+                CpuProfilerScope scope(&location);
+            }
+            lutest(succeeded(end_trace_capture("ProfilerTestTrace.json")));
+            auto file = open_file("ProfilerTestTrace.json", FileOpenFlag::read, FileCreationMode::open_existing);
+            lutest(succeeded(file));
+            auto data = load_file_data(file.get());
+            lutest(succeeded(data));
+            String content((const c8*)data.get().data(), data.get().size());
+            lutest(count_substrings(content, "\"name\":\"File\"") == 1);
+            file.get().reset();
+            lutest(succeeded(delete_file("ProfilerTestTrace.json")));
+        }
+    }
+}
@@ -10,9 +10,29 @@
 #include "TestCommon.hpp"
 #include <Luna/Runtime/Error.hpp>
 #include <Luna/Runtime/HashSet.hpp>
+#include <Luna/Runtime/Thread.hpp>
+#include <Luna/Runtime/Memory.hpp>
 
 namespace Luna
 {
+    static void error_thread_exit_test_thread(void*)
+    {
+        void* p = memalloc(64);
+        memfree(p);
+        // The error object is destructed when the thread exits, after thread-local profiler data are destructed.
+        set_error(BasicError::bad_arguments(), "Error of exiting thread.");
+        lutest(get_error().code == BasicError::bad_arguments());
+    }
+
+    void error_thread_exit_test()
+    {
+        for (usize i = 0; i < 4; ++i)
+        {
+            Ref<IThread> t = new_thread(error_thread_exit_test_thread, nullptr);
+            t->wait();
+        }
+    }
+
     void error_test()
     {
         /*
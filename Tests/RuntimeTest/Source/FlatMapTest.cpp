@@ -0,0 +1,121 @@
+/*!
+* This file is a portion of LunaSDK.
+* For conditions of distribution and use, see the disclaimer
+* and license in LICENSE.txt
+*
+* @file FlatMapTest.cpp
+* @author JXMaster
+* @date 2026/10/18
+*/
+#include "TestCommon.hpp"
+#include <Luna/Runtime/FlatMap.hpp>
+#include <Luna/Runtime/FlatSet.hpp>
+
+namespace Luna
+{
+    void flat_map_test()
+    {
+        TestObject::reset();
+        {
+            FlatMap<i32, TestObject> map;
+            // Keys cannot be modified through iterators.
+            static_assert(is_const_v<remove_reference_t<decltype(map.begin()->first)>>, "Keys of FlatMap must be const.");
+            lutest(map.empty());
+            // Inserts keys out of order.
+            for (i32 i = 0; i < 100; ++i)
+            {
+                i32 key = (i * 37) % 100;
+                auto r = map.insert(make_pair(key, TestObject(key)));
+                lutest(r.second);
+                lutest(r.first->first == key);
+            }
+            lutest(map.size() == 100);
+            for (i32 i = 0; i < 100; ++i)
+            {
+                lutest(map.data()[i].first == i);
+                lutest(map.data()[i].second == TestObject(i));
+            }
+            auto r = map.insert(make_pair(5, TestObject(500)));
+            lutest(!r.second);
+            lutest(r.first->second == TestObject(5));
+            r = map.insert_or_assign(5, TestObject(500));
+            lutest(!r.second);
+            lutest(r.first->second == TestObject(500));
+            r = map.insert_or_assign(100, TestObject(100));
+            lutest(r.second);
+            lutest(map.size() == 101);
+            r = map.emplace(-1, TestObject(-1));
+            lutest(r.second);
+            lutest(map.begin()->first == -1);
+            lutest(map.find(50) != map.end());
+            lutest(map.find(50)->second == TestObject(50));
+            lutest(map.find(200) == map.end());
+            lutest(map.contains(100));
+            lutest(map.count(101) == 0);
+            lutest(map.lower_bound(50)->first == 50);
+            lutest(map.upper_bound(50)->first == 51);
+            lutest(map.upper_bound(100) == map.end());
+            lutest(map.erase(50) == 1);
+            lutest(map.erase(50) == 0);
+            lutest(map.lower_bound(50)->first == 51);
+            auto iter = map.erase(map.find(10), map.find(20));
+            lutest(iter->first == 20);
+            lutest(map.size() == 91);
+            i32 last = -2;
+            for (auto& i : map)
+            {
+                lutest(i.first > last);
+                last = i.first;
+            }
+            FlatMap<i32, TestObject> map2 = map;
+            lutest(map2.size() == map.size());
+            map.clear();
+            lutest(map.empty());
+            map.swap(map2);
+            lutest(map.size() == 91);
+            lutest(map2.empty());
+        }
+        lutest(TestObject::g_count == 0);
+        {
+            // Range insertion keeps existing elements and the first element of every duplicate key.
+            FlatMap<i32, i32> map = { {3, 30}, {1, 10}, {3, 31}, {2, 20} };
+            lutest(map.size() == 3);
+            lutest(map.find(3)->second == 30);
+            Pair<i32, i32> values[] = { {5, 50}, {2, 21}, {4, 40}, {5, 51}, {0, 0} };
+            map.insert(values, values + 5);
+            lutest(map.size() == 6);
+            for (i32 i = 0; i < 6; ++i)
+            {
+                lutest(map.data()[i].first == i);
+                lutest(map.data()[i].second == i * 10);
+            }
+        }
+        {
+            FlatMap<Guid, i32> map;
+            Guid a("{5A3B9C1E-7D2F-4E8A-9B6C-1F0E2D3C4B5A}");
+            Guid b("{0C1D2E3F-4A5B-6C7D-8E9F-A0B1C2D3E4F5}");
+            map.insert_or_assign(a, 1);
+            map.insert_or_assign(b, 2);
+            lutest(map.begin()->first == b);
+            lutest(map.find(a)->second == 1);
+        }
+        {
+            FlatSet<i32> set = { 5, 3, 8, 3, 1 };
+            lutest(set.size() == 4);
+            lutest(*set.begin() == 1);
+            lutest(set.insert(4).second);
+            lutest(!set.insert(5).second);
+            lutest(set.contains(4));
+            lutest(*set.lower_bound(6) == 8);
+            lutest(set.erase(3) == 1);
+            i32 expected[] = { 1, 4, 5, 8 };
+            usize i = 0;
+            for (i32 v : set)
+            {
+                lutest(v == expected[i]);
+                ++i;
+            }
+            lutest(i == 4);
+        }
+    }
+}
@@ -14,7 +14,11 @@
 #include <Luna/Runtime/UnorderedMultiSet.hpp>
 #include <Luna/Runtime/HashMap.hpp>
 #include <Luna/Runtime/HashSet.hpp>
+#include <Luna/Runtime/FlatHashMap.hpp>
+#include <Luna/Runtime/FlatHashSet.hpp>
+#include <Luna/Runtime/SelfIndexedFlatHashMap.hpp>
 #include <Luna/Runtime/Random.hpp>
+#include <Luna/Runtime/String.hpp>
 
 namespace Luna
 {
@@ -824,4 +828,255 @@ namespace Luna
             }
         }
     }
-}
\ No newline at end of file
+
+    static u32 crc32c_reference(const void* data, usize size, u32 crc)
+    {
+        const u8* p = (const u8*)data;
+        crc = ~crc;
+        for (usize i = 0; i < size; ++i)
+        {
+            crc ^= p[i];
+            for (u32 j = 0; j < 8; ++j) crc = (crc >> 1) ^ (0x82F63B78 & (0 - (crc & 1)));
+        }
+        return ~crc;
+    }
+
+    void hash_function_test()
+    {
+        u8 data[300];
+        for (usize i = 0; i < 300; ++i) data[i] = (u8)random_u32();
+        {
+            // CRC-32C check value.
+            lutest(crc32c("123456789", 9) == 0xE3069283);
+            lutest(crc32c(nullptr, 0) == 0);
+            // All lengths and alignments produce the same result as the bitwise implementation.
+            for (usize offset = 0; offset < 8; ++offset)
+            {
+                for (usize size = 0; size < 256; ++size)
+                {
+                    lutest(crc32c(data + offset, size) == crc32c_reference(data + offset, size, 0));
+                }
+            }
+            // Checksums can be computed in multiple calls.
+            u32 crc = crc32c(data, 100);
+            crc = crc32c(data + 100, 200, crc);
+            lutest(crc == crc32c(data, 300));
+        }
+        {
+            // Compile-time and run-time string hashes produce the same result.
+            constexpr u64 h = strwyhash64("LunaSDK");
+            static_assert(h != strwyhash64("LunaSDK", 1), "strwyhash64 must be evaluated at compile time.");
+            lutest(h == wyhash64("LunaSDK", 7));
+            c8 str[208];
+            for (usize i = 0; i < 208; ++i) str[i] = (c8)(data[i] % 255 + 1);
+            for (usize offset = 0; offset < 8; ++offset)
+            {
+                for (usize size = 0; size < 200; ++size)
+                {
+                    c8 c = str[offset + size];
+                    str[offset + size] = 0;
+                    lutest(wyhash64(str + offset, size) == strwyhash64(str + offset));
+                    str[offset + size] = c;
+                }
+            }
+            // Every byte and the length affect the hash.
+            HashSet<u64> hashes;
+            for (usize size = 0; size < 200; ++size)
+            {
+                lutest(hashes.insert(wyhash64(data, size)).second);
+            }
+            u8 copy[200];
+            memcpy(copy, data, 200);
+            u64 base = wyhash64(copy, 200);
+            for (usize i = 0; i < 200; ++i)
+            {
+                copy[i] ^= 1;
+                lutest(wyhash64(copy, 200) != base);
+                copy[i] ^= 1;
+            }
+            lutest(wyhash64(data, 64, 1) != wyhash64(data, 64, 2));
+        }
+        {
+            // Strings are hashed by characters.
+            String s1 = "Hello, World!";
+            String s2 = "Hello, ";
+            s2.append("World!");
+            lutest(hash<String>()(s1) == hash<String>()(s2));
+            lutest(hash<String>()(s1) == hash_bytes(s1.c_str(), s1.size()));
+            lutest(hash<String>()(s1) != hash<String>()(String("Hello, World")));
+            HashMap<String, int> map;
+            map.insert(make_pair(s1, 1));
+            map.insert(make_pair(String("Bye"), 2));
+            lutest(map.find(s2) != map.end() && map.find(s2)->second == 1);
+        }
+    }
+
+    struct SwissTestEntry
+    {
+        u64 key;
+        u64 value;
+    };
+
+    struct SwissTestEntryExtractKey
+    {
+        const u64& operator()(const SwissTestEntry& e) const
+        {
+            return e.key;
+        }
+    };
+
+    void swiss_hash_test()
+    {
+        {
+            FlatHashSet<int> h;
+            lutest(h.empty());
+            lutest(h.hash_table_size() == 0);
+            lutest(h.begin() == h.end());
+            lutest(h.find(1) == h.end());
+            for (int i = 0; i < 100; ++i)
+            {
+                lutest(h.insert(i).second);
+                lutest(!h.insert(i).second);
+            }
+            lutest(h.size() == 100);
+            // Hash table sizes are powers of two, and the load factor is never exceeded.
+            lutest((h.hash_table_size() & (h.hash_table_size() - 1)) == 0);
+            lutest(h.load_factor() <= h.max_load_factor());
+            usize n = 0;
+            for (int v : h)
+            {
+                lutest(v >= 0 && v < 100);
+                ++n;
+            }
+            lutest(n == 100);
+            h.clear();
+            lutest(h.empty());
+            lutest(h.begin() == h.end());
+            h.shrink_to_fit();
+            lutest(h.hash_table_size() == 0);
+        }
+        {
+            // Random operations produce the same result as HashMap.
+            FlatHashMap<u64, u64> h;
+            HashMap<u64, u64> ref;
+            for (usize i = 0; i < 100000; ++i)
+            {
+                u64 key = random_u32() % 4096;
+                switch (random_u32() % 4)
+                {
+                case 0:
+                case 1:
+                {
+                    auto r1 = h.insert(make_pair(key, (u64)i));
+                    auto r2 = ref.insert(make_pair(key, (u64)i));
+                    lutest(r1.second == r2.second);
+                    lutest(r1.first->second == r2.first->second);
+                    break;
+                }
+                case 2:
+                    lutest(h.erase(key) == ref.erase(key));
+                    break;
+                case 3:
+                {
+                    auto iter = h.find(key);
+                    auto ref_iter = ref.find(key);
+                    lutest((iter == h.end()) == (ref_iter == ref.end()));
+                    if (iter != h.end()) lutest(iter->second == ref_iter->second);
+                    break;
+                }
+                }
+                lutest(h.size() == ref.size());
+            }
+            usize n = 0;
+            for (auto& i : h)
+            {
+                auto ref_iter = ref.find(i.first);
+                lutest(ref_iter != ref.end() && ref_iter->second == i.second);
+                ++n;
+            }
+            lutest(n == ref.size());
+            // Erasing while iterating visits every element once.
+            for (auto iter = h.begin(); iter != h.end();)
+            {
+                lutest(ref.erase(iter->first) == 1);
+                iter = h.erase(iter);
+            }
+            lutest(h.empty());
+            lutest(ref.empty());
+        }
+        {
+            // Inserting and erasing the same keys repeatedly does not grow the table.
+            FlatHashMap<int, int> h;
+            for (int i = 0; i < 10; ++i) h.insert(make_pair(i, i));
+            usize size = h.hash_table_size();
+            for (int i = 0; i < 100000; ++i)
+            {
+                h.insert(make_pair(100 + i, i));
+                lutest(h.erase(100 + i) == 1);
+            }
+            lutest(h.hash_table_size() == size);
+            for (int i = 0; i < 10; ++i) lutest(h.find(i)->second == i);
+        }
+        TestObject::reset();
+        {
+            FlatHashMap<int, TestObject> h;
+            h.insert(make_pair(3, TestObject(4)));
+            TestObject obj(5, false);
+            h.insert(make_pair(4, obj));
+            h.emplace(5, TestObject(6));
+            h.emplace(5, TestObject(7));
+            lutest(h.size() == 3);
+            lutest(h.find(5)->second == TestObject(6));
+            h.insert_or_assign(5, TestObject(8));
+            lutest(h.find(5)->second == TestObject(8));
+            for (int i = 10; i < 1000; ++i) h.emplace(i, TestObject(i));
+            // Copy and move.
+            FlatHashMap<int, TestObject> h2(h);
+            lutest(h2.size() == h.size());
+            for (auto& i : h) lutest(h2.find(i.first)->second == i.second);
+            FlatHashMap<int, TestObject> h3(move(h2));
+            lutest(h3.size() == h.size());
+            lutest(h2.empty());
+            h2 = h3;
+            lutest(h2.size() == h.size());
+            h3.clear();
+            h3 = move(h2);
+            lutest(h3.size() == h.size());
+            h3.swap(h2);
+            lutest(h3.empty());
+            lutest(h2.size() == h.size());
+            // Rehashing keeps elements.
+            h.max_load_factor(0.5f);
+            lutest(h.load_factor() <= 0.5f);
+            h.reserve(10000);
+            lutest(h.capacity() >= 10000);
+            lutest(h.find(4)->second == TestObject(5));
+            h.shrink_to_fit();
+            lutest(h.capacity() >= h.size());
+            for (int i = 10; i < 1000; ++i) lutest(h.find(i)->second == TestObject(i));
+        }
+        lutest(TestObject::is_clear());
+        TestObject::reset();
+        {
+            // Self-indexed maps and string keys.
+            SelfIndexedFlatHashMap<u64, SwissTestEntry, SwissTestEntryExtractKey> h;
+            for (u64 i = 0; i < 1000; ++i)
+            {
+                SwissTestEntry e = { i * 0x100000000ULL, i };
+                lutest(h.insert(e).second);
+            }
+            for (u64 i = 0; i < 1000; ++i)
+            {
+                auto iter = h.find(i * 0x100000000ULL);
+                lutest(iter != h.end() && iter->value == i);
+            }
+            lutest(h.find(1) == h.end());
+            FlatHashSet<String> s;
+            s.insert(String("Hello"));
+            s.insert(String("World"));
+            lutest(s.contains(String("Hello")));
+            lutest(!s.contains(String("Hello!")));
+            lutest(s.count(String("World")) == 1);
+        }
+    }
+}
@@ -0,0 +1,127 @@
+/*!
+* This file is a portion of LunaSDK.
+* For conditions of distribution and use, see the disclaimer
+* and license in LICENSE.txt
+*
+* @file InlineVectorTest.cpp
+* @author JXMaster
+* @date 2026/10/18
+*/
+#include "TestCommon.hpp"
+#include <Luna/Runtime/InlineVector.hpp>
+#include <Luna/Runtime/Memory.hpp>
+
+namespace Luna
+{
+    static bool is_in_object(const void* obj, usize obj_size, const void* ptr)
+    {
+        return (usize)ptr >= (usize)obj && (usize)ptr < (usize)obj + obj_size;
+    }
+
+    void inline_vector_test()
+    {
+        TestObject::reset();
+        {
+            // Elements are stored in the object until the inline capacity is exceeded.
+            InlineVector<TestObject, 4> vec1;
+            lutest(vec1.empty());
+            lutest(vec1.capacity() == 4);
+            MemoryStats base = get_memory_stats();
+            for (i32 i = 0; i < 4; ++i) vec1.push_back(TestObject(i));
+            lutest(get_memory_stats().num_allocations == base.num_allocations);
+            lutest(is_in_object(&vec1, sizeof(vec1), vec1.data()));
+            vec1.push_back(TestObject(4));
+            lutest(vec1.capacity() > 4);
+            lutest(!is_in_object(&vec1, sizeof(vec1), vec1.data()));
+            for (i32 i = 0; i < 5; ++i) lutest(vec1[i] == TestObject(i));
+
+            // Shrinks back to the inline buffer.
+            vec1.pop_back();
+            vec1.shrink_to_fit();
+            lutest(vec1.capacity() == 4);
+            lutest(is_in_object(&vec1, sizeof(vec1), vec1.data()));
+            for (i32 i = 0; i < 4; ++i) lutest(vec1[i] == TestObject(i));
+
+            // Move ctor from inline storage moves elements.
+            InlineVector<TestObject, 4> vec2(move(vec1));
+            lutest(vec1.empty());
+            lutest(vec2.size() == 4);
+            lutest(vec2[3] == TestObject(3));
+
+            // Move ctor from heap storage steals the buffer.
+            vec2.push_back(TestObject(4));
+            const TestObject* heap_data = vec2.data();
+            InlineVector<TestObject, 4> vec3(move(vec2));
+            lutest(vec2.empty());
+            lutest(vec2.capacity() == 4);
+            lutest(vec3.data() == heap_data);
+            lutest(vec3.size() == 5);
+
+            // Copy ctor and copy assignment.
+            InlineVector<TestObject, 4> vec4 = vec3;
+            lutest(vec4.size() == 5);
+            lutest(vec4[4] == TestObject(4));
+            vec4 = vec4;
+            lutest(vec4.size() == 5);
+            InlineVector<TestObject, 4> vec5 = { TestObject(1), TestObject(2) };
+            vec4 = vec5;
+            lutest(vec4.size() == 2);
+            lutest(vec4[1] == TestObject(2));
+
+            // Move assignment between inline and heap storage.
+            vec5 = move(vec3);
+            lutest(vec5.size() == 5);
+            lutest(vec3.empty());
+            vec3 = move(vec4);
+            lutest(vec3.size() == 2);
+            lutest(vec3[0] == TestObject(1));
+
+            // Swap.
+            vec3.swap(vec5);
+            lutest(vec3.size() == 5);
+            lutest(vec5.size() == 2);
+        }
+        lutest(TestObject::g_count == 0);
+        {
+            // Insert and erase across the inline capacity.
+            InlineVector<TestObject, 8> vec;
+            for (i32 i = 0; i < 6; ++i) vec.push_back(TestObject(i));
+            vec.insert(vec.begin() + 2, 5, TestObject(100));
+            lutest(vec.size() == 11);
+            lutest(vec[1] == TestObject(1));
+            lutest(vec[2] == TestObject(100));
+            lutest(vec[6] == TestObject(100));
+            lutest(vec[7] == TestObject(2));
+            vec.erase(vec.begin() + 2, vec.begin() + 7);
+            lutest(vec.size() == 6);
+            for (i32 i = 0; i < 6; ++i) lutest(vec[i] == TestObject(i));
+            vec.emplace(vec.begin(), -1);
+            lutest(vec.front() == TestObject(-1));
+            vec.swap_erase(vec.begin());
+            lutest(vec.front() == TestObject(5));
+            vec.resize(20, TestObject(3));
+            lutest(vec.size() == 20);
+            lutest(vec.back() == TestObject(3));
+            vec.resize(2);
+            lutest(vec.size() == 2);
+            vec.clear();
+            lutest(vec.empty());
+        }
+        lutest(TestObject::g_count == 0);
+        lutest(TestObject::g_magic_error_count == 0);
+        {
+            // Objects that cannot be copied are moved when the buffer is relocated.
+            InlineVector<TestObject, 2> vec;
+            for (i32 i = 0; i < 16; ++i) vec.emplace_back(i, true);
+            InlineVector<TestObject, 2> vec2 = move(vec);
+            vec2.resize(1);
+            vec2.shrink_to_fit();
+            InlineVector<TestObject, 2> vec3;
+            vec3 = move(vec2);
+            lutest(vec3.size() == 1);
+            lutest(vec3[0].m_value == 0);
+        }
+        lutest(TestObject::g_count == 0);
+        lutest(TestObject::g_magic_error_count == 0);
+    }
+}
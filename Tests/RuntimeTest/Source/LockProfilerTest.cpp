@@ -0,0 +1,130 @@
+/*!
+* This file is a portion of LunaSDK.
+* For conditions of distribution and use, see the disclaimer
+* and license in LICENSE.txt
+*
+* @file LockProfilerTest.cpp
+* @author JXMaster
+* @date 2026/10/18
+*/
+#include "TestCommon.hpp"
+#include <Luna/Runtime/Profiler.hpp>
+#include <Luna/Runtime/LockProfiler.hpp>
+#include <Luna/Runtime/SpinLock.hpp>
+#include <Luna/Runtime/Mutex.hpp>
+#include <Luna/Runtime/Thread.hpp>
+#include <Luna/Runtime/Time.hpp>
+#include <Luna/Runtime/Reflection.hpp>
+
+namespace Luna
+{
+    static bool find_lock_contention_stats(const c8* name, LockContentionStats& out)
+    {
+        auto stats = get_lock_contention_stats();
+        for (auto& s : stats)
+        {
+            if (!strcmp(s.name, name))
+            {
+                out = s;
+                return true;
+            }
+        }
+        return false;
+    }
+
+#ifdef LUNA_LOCK_PROFILER_ENABLED
+    struct LockProfilerTestContext
+    {
+        SpinLock spin_lock { "Test/SpinLock" };
+        Ref<IMutex> mutex;
+        volatile u32 started = 0;
+    };
+#endif
+
+    void lock_profiler_test()
+    {
+        {
+            // Sites are interned by name strings rather than pointers.
+            c8 name[] = "Test/Manual";
+            lock_profiler_site_t site = get_lock_profiler_site("Test/Manual");
+            lutest(site);
+            lutest(get_lock_profiler_site(name) == site);
+            lutest(get_lock_profiler_site(nullptr) == nullptr);
+            u64 one_ms = (u64)(get_ticks_per_second() / 1000.0);
+            lock_profiler_record_acquire(site, 0, false);
+            lock_profiler_record_release(site, one_ms);
+            lock_profiler_record_acquire(site, one_ms, true);
+            lock_profiler_record_release(site, one_ms * 2);
+            LockContentionStats stats;
+            lutest(find_lock_contention_stats("Test/Manual", stats));
+            lutest(stats.num_acquires == 2);
+            lutest(stats.num_contended_acquires == 1);
+            lutest(stats.max_wait_time > 0.0009 && stats.max_wait_time < 0.0011);
+            lutest(stats.max_hold_time > 0.0019 && stats.max_hold_time < 0.0021);
+            lutest(stats.total_hold_time > 0.0029 && stats.total_hold_time < 0.0031);
+            // 1000 microseconds are in [512, 1024).
+            lutest(stats.wait_time_histogram[10] == 1);
+            u64 num_waits = 0;
+            for (u32 i = 0; i < NUM_LOCK_WAIT_TIME_BUCKETS; ++i) num_waits += stats.wait_time_histogram[i];
+            lutest(num_waits == 1);
+            // Locks are sorted by wait time and can be truncated.
+            auto top = get_lock_contention_stats(1);
+            lutest(top.size() <= 1);
+            if (!top.empty()) lutest(top[0].total_wait_time >= stats.total_wait_time);
+        }
+#ifdef LUNA_LOCK_PROFILER_ENABLED
+        {
+            // Waits of named locks are recorded when other threads own the lock.
+            LockProfilerTestContext ctx;
+            ctx.mutex = new_mutex("Test/Mutex");
+            ctx.spin_lock.lock();
+            ctx.mutex->wait();
+            // Recursive acquisitions are recorded once.
+            ctx.mutex->wait();
+            Ref<IThread> t = new_thread([](void* params)
+            {
+                LockProfilerTestContext* ctx = (LockProfilerTestContext*)params;
+                atom_exchange_u32(&ctx->started, 1);
+                ctx->mutex->wait();
+                ctx->mutex->unlock();
+                ctx->spin_lock.lock();
+                ctx->spin_lock.unlock();
+            }, &ctx);
+            while (!ctx.started) yield_current_thread();
+            sleep(20);
+            ctx.mutex->unlock();
+            ctx.mutex->unlock();
+            sleep(20);
+            ctx.spin_lock.unlock();
+            t->wait();
+            LockContentionStats stats;
+            lutest(find_lock_contention_stats("Test/SpinLock", stats));
+            lutest(stats.num_acquires == 2);
+            lutest(stats.num_contended_acquires == 1);
+            lutest(stats.max_wait_time > 0.0);
+            lutest(stats.max_hold_time >= stats.max_wait_time);
+            lutest(find_lock_contention_stats("Test/Mutex", stats));
+            lutest(stats.num_acquires == 2);
+            lutest(stats.num_contended_acquires == 1);
+            lutest(stats.max_hold_time > 0.0);
+        }
+        {
+            // Recursive acquisitions of internal OS mutexes are recorded once.
+            reset_lock_contention_stats();
+            StructureTypeDesc desc;
+            desc.guid = Guid("{5e0b6f3c-2d8e-4b7a-9c1f-6a4d3e2b1c0f}");
+            desc.name = "LockProfilerTestType";
+            desc.size = sizeof(u32);
+            desc.alignment = alignof(u32);
+            // `register_struct_type` looks up the type by name with the type registry lock acquired.
+            lutest(register_struct_type(desc));
+            LockContentionStats stats;
+            lutest(find_lock_contention_stats("Runtime/Type Registry", stats));
+            lutest(stats.num_acquires == 1);
+        }
+#endif
+        reset_lock_contention_stats();
+        LockContentionStats stats;
+        lutest(!find_lock_contention_stats("Test/Manual", stats));
+    }
+}
@@ -0,0 +1,207 @@
+/*!
+* This file is a portion of LunaSDK.
+* For conditions of distribution and use, see the disclaimer
+* and license in LICENSE.txt
+*
+* @file MemoryTest.cpp
+* @author JXMaster
+* @date 2026/10/18
+*/
+#include "TestCommon.hpp"
+#include <Luna/Runtime/Memory.hpp>
+#include <Luna/Runtime/Thread.hpp>
+#include <Luna/Runtime/Random.hpp>
+
+namespace Luna
+{
+    static void test_memory_block(usize size, usize alignment)
+    {
+        byte_t* p = (byte_t*)memalloc(size, alignment);
+        lutest(p);
+        lutest(((usize)p % max<usize>(alignment, MAX_ALIGN)) == 0);
+        lutest(memsize(p, alignment) >= size);
+        memset(p, 0xCD, size);
+        memfree(p, alignment);
+    }
+
+    struct MemoryThreadTestContext
+    {
+        void* blocks[1024];
+    };
+
+    static void memory_test_thread(void* params)
+    {
+        // Frees blocks allocated by the main thread, and allocates blocks that will be freed by the main thread.
+        MemoryThreadTestContext* ctx = (MemoryThreadTestContext*)params;
+        for (usize i = 0; i < 1024; ++i)
+        {
+            lutest(*(usize*)ctx->blocks[i] == i);
+            memfree(ctx->blocks[i]);
+            ctx->blocks[i] = memalloc(16 + (i % 64) * 16);
+            *(usize*)ctx->blocks[i] = i;
+        }
+    }
+
+    void memory_test()
+    {
+        // Sizes around size class boundaries and the large block threshold.
+        const usize sizes[] = { 1, 8, 15, 16, 17, 100, 128, 129, 1000, 1024, 1025, 4096, 8191, 8192, 8193, 65536, 1_mb };
+        const usize alignments[] = { 0, 4, 16, 32, 64, 128, 256, 512, 4096 };
+        for (usize size : sizes)
+        {
+            for (usize alignment : alignments)
+            {
+                test_memory_block(size, alignment);
+            }
+        }
+        {
+            // Random allocation and deallocation, the data of every live block must not be overwritten.
+            constexpr usize NUM_BLOCKS = 4096;
+            void* blocks[NUM_BLOCKS] = { nullptr };
+            usize block_sizes[NUM_BLOCKS] = { 0 };
+            for (usize round = 0; round < 65536; ++round)
+            {
+                usize i = random_u32() % NUM_BLOCKS;
+                if (blocks[i])
+                {
+                    byte_t v = (byte_t)i;
+                    for (usize j = 0; j < block_sizes[i]; ++j)
+                    {
+                        lutest(((byte_t*)blocks[i])[j] == v);
+                    }
+                    memfree(blocks[i]);
+                    blocks[i] = nullptr;
+                }
+                else
+                {
+                    block_sizes[i] = 1 + random_u32() % 2048;
+                    blocks[i] = memalloc(block_sizes[i]);
+                    memset(blocks[i], (byte_t)i, block_sizes[i]);
+                }
+            }
+            for (usize i = 0; i < NUM_BLOCKS; ++i)
+            {
+                memfree(blocks[i]);
+            }
+        }
+        {
+            // Blocks can be freed on threads other than the allocating thread.
+            MemoryThreadTestContext ctx;
+            for (usize i = 0; i < 1024; ++i)
+            {
+                ctx.blocks[i] = memalloc(16 + (i % 64) * 16);
+                *(usize*)ctx.blocks[i] = i;
+            }
+            Ref<IThread> t = new_thread(memory_test_thread, &ctx);
+            t->wait();
+            t.reset();
+            for (usize i = 0; i < 1024; ++i)
+            {
+                lutest(*(usize*)ctx.blocks[i] == i);
+                memfree(ctx.blocks[i]);
+            }
+        }
+        {
+            // memrealloc keeps data.
+            u32* p = (u32*)memalloc(sizeof(u32) * 4);
+            for (u32 i = 0; i < 4; ++i) p[i] = i;
+            p = (u32*)memrealloc(p, sizeof(u32) * 4096);
+            for (u32 i = 0; i < 4; ++i) lutest(p[i] == i);
+            memfree(p);
+        }
+        {
+            // memrealloc keeps data and alignment when growing large and over-aligned blocks.
+            const usize alignments[] = { 0, 64, 4096 };
+            for (usize alignment : alignments)
+            {
+                usize size = 1024;
+                u32* p = (u32*)memalloc(size * sizeof(u32), alignment);
+                for (u32 i = 0; i < size; ++i) p[i] = i;
+                while (size < 4_mb)
+                {
+                    size *= 4;
+                    p = (u32*)memrealloc(p, size * sizeof(u32), alignment);
+                    lutest(p);
+                    lutest(((usize)p % max<usize>(alignment, MAX_ALIGN)) == 0);
+                    lutest(memsize(p, alignment) >= size * sizeof(u32));
+                    for (u32 i = 0; i < size / 4; ++i) lutest(p[i] == i);
+                    for (u32 i = size / 4; i < size; ++i) p[i] = i;
+                }
+                memfree(p, alignment);
+            }
+        }
+        {
+            // Huge page blocks are tracked until they are freed, and can be resized.
+            HugePageStats base = get_huge_page_stats();
+            usize size = 3_mb;
+            u32* p = (u32*)memalloc_huge_pages(size * sizeof(u32) / 4, 64);
+            lutest(p);
+            lutest(((usize)p % 64) == 0);
+            lutest(memsize(p, 64) >= size);
+            for (u32 i = 0; i < size / 4; ++i) p[i] = i;
+            HugePageStats stats = get_huge_page_stats();
+            lutest(stats.num_blocks == base.num_blocks + 1);
+            lutest(stats.mapped_bytes >= base.mapped_bytes + size);
+            lutest(stats.transparent_huge_page_bytes + stats.explicit_huge_page_bytes >=
+                base.transparent_huge_page_bytes + base.explicit_huge_page_bytes);
+            p = (u32*)memrealloc(p, size * 2, 64);
+            lutest(p);
+            lutest(memsize(p, 64) >= size * 2);
+            for (u32 i = 0; i < size / 4; ++i) lutest(p[i] == i);
+            memfree(p, 64);
+            stats = get_huge_page_stats();
+            lutest(stats.num_blocks == base.num_blocks);
+            lutest(stats.mapped_bytes == base.mapped_bytes);
+        }
+        {
+            // Allocations above the threshold are mapped directly if huge pages are supported.
+            usize threshold = get_huge_page_threshold();
+            set_huge_page_threshold(1_mb);
+            HugePageStats base = get_huge_page_stats();
+            void* p = memalloc(2_mb);
+            lutest(p);
+            memset(p, 0xCD, 2_mb);
+            HugePageStats stats = get_huge_page_stats();
+            if (stats.huge_page_size)
+            {
+                lutest(stats.num_blocks == base.num_blocks + 1);
+            }
+            else
+            {
+                lutest(get_huge_page_threshold() == 0);
+                lutest(stats.num_blocks == base.num_blocks);
+            }
+            memfree(p);
+            lutest(get_huge_page_stats().num_blocks == base.num_blocks);
+            set_huge_page_threshold(threshold);
+        }
+        {
+            // Memory statistics track allocations of all threads.
+            // Other threads may allocate concurrently, so only lower bounds are checked.
+            MemoryStats base = get_memory_stats();
+            void* blocks[256];
+            for (usize i = 0; i < 256; ++i) blocks[i] = memalloc(1_kb);
+            void* large = memalloc(768_kb);
+            MemoryStats stats = get_memory_stats();
+            lutest(stats.num_allocations >= base.num_allocations + 257);
+            lutest(stats.allocated_bytes >= base.allocated_bytes + 256_kb + 768_kb);
+            lutest(stats.peak_allocated_bytes >= stats.allocated_bytes);
+            // The system heap may report 1KB blocks slightly larger than 1KB, which falls into the next bucket.
+            lutest(stats.size_histogram[6] + stats.size_histogram[7] >= base.size_histogram[6] + base.size_histogram[7] + 256);
+            lutest(stats.size_histogram[16] >= base.size_histogram[16] + 1);
+            // Blocks freed on other threads are subtracted from the total.
+            Ref<IThread> t = new_thread([](void* params)
+            {
+                void** blocks = (void**)params;
+                for (usize i = 0; i < 256; ++i) memfree(blocks[i]);
+            }, blocks);
+            t->wait();
+            t.reset();
+            memfree(large);
+            stats = get_memory_stats();
+            lutest(stats.num_frees >= base.num_frees + 257);
+            lutest(stats.allocated_bytes <= base.allocated_bytes + 64_kb);
+            lutest(stats.peak_allocated_bytes >= base.allocated_bytes + 768_kb);
+        }
+    }
+}
@@ -9,9 +9,29 @@
 */
 #include "TestCommon.hpp"
 #include <Luna/Runtime/Name.hpp>
+#include <Luna/Runtime/Thread.hpp>
 
 namespace Luna
 {
+    static void name_test_thread(void* params)
+    {
+        // Interns and releases names concurrently with other threads.
+        const c8** interned = (const c8**)params;
+        char str[16];
+        for (int round = 0; round < 100; ++round)
+        {
+            for (int i = 0; i < 256; ++i)
+            {
+                snprintf(str, 16, u8"Shared%d", i);
+                Name n(str);
+                lutest(n.c_str() == interned[i]);
+                snprintf(str, 16, u8"Temp%d", i);
+                Name t(str);
+                lutest(!strcmp(t.c_str(), str));
+            }
+        }
+    }
+
     void name_test()
     {
         // name object test.
@@ -53,5 +73,56 @@ namespace Luna
             Name n("Sample");
         }
 
+        // Names interned from multiple threads.
+        {
+            Name shared[256];
+            const c8* interned[256];
+            for (int i = 0; i < 256; ++i)
+            {
+                snprintf(str, 16, u8"Shared%d", i);
+                shared[i] = str;
+                interned[i] = shared[i].c_str();
+            }
+            Ref<IThread> threads[4];
+            for (auto& t : threads) t = new_thread(name_test_thread, interned);
+            for (auto& t : threads) t->wait();
+            // Names released by all threads can be interned again.
+            Name temp("Temp0");
+            lutest(temp.size() == 5);
+            lutest(temp.id() == (name_id_t)wyhash64("Temp0", 5));
+        }
+
+        // Name literals.
+        {
+            static_assert(NameLiteral("Thomas").size == 6, "Name literal size must be computed at compile time.");
+            static_assert(NameLiteral("Thomas").id == (name_id_t)strwyhash64("Thomas"), "Name literal ID must be computed at compile time.");
+            lutest(NameLiteral("Thomas").id == name1.id());
+            lutest(Name(NameLiteral("Thomas")) == name1);
+            lutest(Name(NameLiteral("")).empty());
+            lutest(luname("Thomas") == name1);
+            lutest(luname(u8"\u4e2d\u6587") == Name(u8"\u4e2d\u6587"));
+            lutest(luname(u8"\u4e2d\u6587").id() == (name_id_t)wyhash64(u8"\u4e2d\u6587", 6));
+            // Every call site interns the name once.
+            const Name* site = nullptr;
+            for (int i = 0; i < 16; ++i)
+            {
+                const Name& n = luname("Jack");
+                lutest(n == name2);
+                if (site) lutest(&n == site);
+                site = &n;
+            }
+        }
+
+        // Long names are stored out of chunks.
+        {
+            String long_str;
+            for (int i = 0; i < 1000; ++i) long_str.push_back((c8)('a' + i % 26));
+            Name n1(long_str);
+            Name n2(long_str);
+            lutest(n1 == n2);
+            lutest(n1.size() == 1000);
+            lutest(!strcmp(n1.c_str(), long_str.c_str()));
+        }
+
     }
 }
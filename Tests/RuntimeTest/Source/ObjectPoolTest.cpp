@@ -0,0 +1,83 @@
+/*!
+* This file is a portion of LunaSDK.
+* For conditions of distribution and use, see the disclaimer
+* and license in LICENSE.txt
+*
+* @file ObjectPoolTest.cpp
+* @author JXMaster
+* @date 2026/10/18
+*/
+#include "TestCommon.hpp"
+#include <Luna/Runtime/Object.hpp>
+#include <Luna/Runtime/Ref.hpp>
+#include <Luna/Runtime/Thread.hpp>
+
+namespace Luna
+{
+    struct PooledTestObject
+    {
+        lustruct("PooledTestObject", "{5B0B6D7A-8C1E-4E4B-9C8F-2E2A4F0E7C31}");
+        u64 m_values[4];
+        static i32 g_count;
+        PooledTestObject() { ++g_count; }
+        ~PooledTestObject() { --g_count; }
+    };
+    i32 PooledTestObject::g_count = 0;
+
+    static void object_pool_test_thread(void* params)
+    {
+        // Objects created on other threads are cached by those threads.
+        for (u32 i = 0; i < 100; ++i)
+        {
+            Ref<PooledTestObject> obj = new_object<PooledTestObject>();
+            lutest(obj);
+        }
+    }
+
+    void object_pool_test()
+    {
+        typeinfo_t type = register_pooled_boxed_type<PooledTestObject>(16);
+        ObjectPoolStats stats;
+        lutest(get_object_pool_stats(type, stats));
+        lutest(stats.live_objects == 0);
+        {
+            Ref<PooledTestObject> objs[32];
+            for (u32 i = 0; i < 32; ++i)
+            {
+                objs[i] = new_object<PooledTestObject>();
+                for (u32 j = 0; j < 4; ++j) objs[i]->m_values[j] = i;
+            }
+            lutest(PooledTestObject::g_count == 32);
+            lutest(get_object_pool_stats(type, stats));
+            lutest(stats.live_objects == 32);
+            lutest(stats.heap_allocations == 32);
+            for (u32 i = 0; i < 32; ++i)
+            {
+                for (u32 j = 0; j < 4; ++j) lutest(objs[i]->m_values[j] == i);
+            }
+        }
+        lutest(PooledTestObject::g_count == 0);
+        lutest(get_object_pool_stats(type, stats));
+        lutest(stats.live_objects == 0);
+        // Some blocks are cached by the thread, others are moved to the central list.
+        lutest(stats.cached_objects > 0 && stats.cached_objects <= 32);
+        {
+            // Objects are reused from the pool.
+            Ref<PooledTestObject> obj = new_object<PooledTestObject>();
+            WeakRef<PooledTestObject> weak = obj;
+            lutest(get_object_pool_stats(type, stats));
+            lutest(stats.reused_allocations == 1);
+            obj.reset();
+            // The block is not returned until the weak reference is released.
+            lutest(get_object_pool_stats(type, stats));
+            lutest(stats.live_objects == 1);
+        }
+        Ref<IThread> t = new_thread(object_pool_test_thread, nullptr);
+        t->wait();
+        t.reset();
+        lutest(get_object_pool_stats(type, stats));
+        lutest(stats.live_objects == 0);
+        // Objects of non-pooled types do not have pools.
+        lutest(!get_object_pool_stats(typeof<Name>(), stats));
+    }
+}
@@ -0,0 +1,184 @@
+/*!
+* This file is a portion of LunaSDK.
+* For conditions of distribution and use, see the disclaimer
+* and license in LICENSE.txt
+*
+* @file SortTest.cpp
+* @author JXMaster
+* @date 2026/10/18
+*/
+#include "TestCommon.hpp"
+#include <Luna/Runtime/Vector.hpp>
+#include <Luna/Runtime/Random.hpp>
+
+namespace Luna
+{
+    struct SortTestEntry
+    {
+        u32 key;
+        u32 index;
+    };
+
+    // Counts comparisons so that quadratic behavior can be detected.
+    struct SortCountingLess
+    {
+        usize* count;
+        bool operator()(i32 lhs, i32 rhs) const
+        {
+            ++(*count);
+            return lhs < rhs;
+        }
+    };
+
+    static void fill_sort_pattern(Vector<i32>& v, usize size, u32 pattern)
+    {
+        v.resize(size);
+        for (usize i = 0; i < size; ++i)
+        {
+            switch (pattern)
+            {
+            case 0: v[i] = (i32)random_u32(); break;              // Random.
+            case 1: v[i] = (i32)i; break;                         // Sorted.
+            case 2: v[i] = (i32)(size - i); break;                // Reverse sorted.
+            case 3: v[i] = 7; break;                              // All equal.
+            case 4: v[i] = (i32)(random_u32() % 4); break;        // Few unique values.
+            case 5: v[i] = (i32)(i < size / 2 ? i : size - i); break; // Organ pipe.
+            case 6: v[i] = (i32)(i % 16); break;                  // Saw tooth.
+            default: v[i] = (i32)(i ^ 0x55); break;
+            }
+        }
+    }
+
+    static bool is_sorted_i32(const Vector<i32>& v)
+    {
+        for (usize i = 1; i < v.size(); ++i)
+        {
+            if (v[i] < v[i - 1]) return false;
+        }
+        return true;
+    }
+
+    void sort_test()
+    {
+        const usize sizes[] = { 0, 1, 2, 3, 10, 23, 24, 25, 100, 129, 1000, 10000 };
+        {
+            // Sorts different patterns, the number of comparisons must be O(n log n).
+            Vector<i32> v;
+            for (usize size : sizes)
+            {
+                for (u32 pattern = 0; pattern < 8; ++pattern)
+                {
+                    fill_sort_pattern(v, size, pattern);
+                    usize count = 0;
+                    sort(v.begin(), v.end(), SortCountingLess{ &count });
+                    lutest(is_sorted_i32(v));
+                    usize log2_size = 1;
+                    while (((usize)1 << log2_size) < size) ++log2_size;
+                    lutest(count <= 4 * size * log2_size + 64);
+                    fill_sort_pattern(v, size, pattern);
+                    sort(v.begin(), v.end());
+                    lutest(is_sorted_i32(v));
+                }
+            }
+            // Sorted and reverse-sorted ranges are sorted in linear time.
+            fill_sort_pattern(v, 10000, 1);
+            usize count = 0;
+            sort(v.begin(), v.end(), SortCountingLess{ &count });
+            lutest(count < 3 * 10000);
+        }
+        {
+            // Sorts objects that are moved rather than copied.
+            i64 count = TestObject::g_count;
+            {
+                Vector<TestObject> v;
+                for (usize i = 0; i < 1000; ++i) v.emplace_back((i32)(random_u32() % 100), true);
+                sort(v.begin(), v.end());
+                for (usize i = 1; i < v.size(); ++i) lutest(!(v[i] < v[i - 1]));
+                stable_sort(v.begin(), v.end(), [](const TestObject& lhs, const TestObject& rhs) { return lhs.m_value > rhs.m_value; });
+                for (usize i = 1; i < v.size(); ++i) lutest(v[i - 1].m_value >= v[i].m_value);
+            }
+            lutest(TestObject::g_count == count);
+            lutest(TestObject::g_magic_error_count == 0);
+        }
+        {
+            // stable_sort preserves the order of equal elements.
+            Vector<SortTestEntry> v;
+            for (usize size : sizes)
+            {
+                v.resize(size);
+                for (usize i = 0; i < size; ++i)
+                {
+                    v[i].key = random_u32() % 16;
+                    v[i].index = (u32)i;
+                }
+                stable_sort(v.begin(), v.end(), [](const SortTestEntry& lhs, const SortTestEntry& rhs) { return lhs.key < rhs.key; });
+                for (usize i = 1; i < size; ++i)
+                {
+                    lutest(v[i - 1].key < v[i].key || (v[i - 1].key == v[i].key && v[i - 1].index < v[i].index));
+                }
+            }
+        }
+        {
+            // radix_sort sorts integers and floating-point numbers, and preserves the order of equal keys.
+            for (usize size : sizes)
+            {
+                Vector<u64> u(size);
+                Vector<i32> i(size);
+                Vector<f32> f(size);
+                Vector<f64> d(size);
+                for (usize j = 0; j < size; ++j)
+                {
+                    u[j] = random_u64() >> (j % 64);
+                    i[j] = (i32)random_u32();
+                    f[j] = random_f32(-1000.0f, 1000.0f);
+                    d[j] = random_f64(-1e10, 1e10);
+                }
+                if (size > 3)
+                {
+                    f[0] = 0.0f;
+                    f[1] = -0.0f;
+                    f[2] = -FLT_MAX;
+                    f[3] = FLT_MAX;
+                }
+                Vector<u64> u2 = u;
+                Vector<i32> i2 = i;
+                Vector<f32> f2 = f;
+                Vector<f64> d2 = d;
+                radix_sort(u.begin(), u.end());
+                radix_sort(i.begin(), i.end());
+                radix_sort(f.begin(), f.end());
+                radix_sort(d.begin(), d.end());
+                sort(u2.begin(), u2.end());
+                sort(i2.begin(), i2.end());
+                sort(f2.begin(), f2.end());
+                sort(d2.begin(), d2.end());
+                lutest(equal(u.begin(), u.end(), u2.begin()));
+                lutest(equal(i.begin(), i.end(), i2.begin()));
+                // `0.0f` and `-0.0f` compare equal, so only compares order here.
+                for (usize j = 1; j < size; ++j) lutest(!(f[j] < f[j - 1]));
+                lutest(equal(d.begin(), d.end(), d2.begin()));
+            }
+            Vector<SortTestEntry> v(10000);
+            for (usize j = 0; j < v.size(); ++j)
+            {
+                v[j].key = random_u32() % 1000;
+                v[j].index = (u32)j;
+            }
+            radix_sort(v.begin(), v.end(), [](const SortTestEntry& e) { return e.key; });
+            for (usize j = 1; j < v.size(); ++j)
+            {
+                lutest(v[j - 1].key < v[j].key || (v[j - 1].key == v[j].key && v[j - 1].index < v[j].index));
+            }
+            // Objects are relocated between the range and the buffer.
+            i64 count = TestObject::g_count;
+            {
+                Vector<TestObject> objs;
+                for (usize j = 0; j < 1000; ++j) objs.emplace_back((i32)(random_u32() % 100) - 50, true);
+                radix_sort(objs.begin(), objs.end(), [](const TestObject& o) { return o.m_value; });
+                for (usize j = 1; j < objs.size(); ++j) lutest(objs[j - 1].m_value <= objs[j].m_value);
+                for (auto& o : objs) lutest(o.m_magic == MAGIC_VALUE);
+            }
+            lutest(TestObject::g_count == count);
+        }
+    }
+}
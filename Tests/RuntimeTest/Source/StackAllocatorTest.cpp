@@ -0,0 +1,57 @@
+/*!
+* This file is a portion of LunaSDK.
+* For conditions of distribution and use, see the disclaimer
+* and license in LICENSE.txt
+*
+* @file StackAllocatorTest.cpp
+* @author JXMaster
+* @date 2026/10/18
+*/
+#include "TestCommon.hpp"
+#include <Luna/Runtime/StackAllocator.hpp>
+
+namespace Luna
+{
+    void stack_allocator_test()
+    {
+        {
+            StackAllocator alloc;
+            lutest(alloc.allocate(0) == nullptr);
+            u32* a = (u32*)alloc.allocate(sizeof(u32) * 16);
+            for (u32 i = 0; i < 16; ++i) a[i] = i;
+            {
+                // Allocations larger than the first block grow the stack.
+                StackAllocator alloc2;
+                byte_t* big = (byte_t*)alloc2.allocate(16_mb, 256);
+                lutest(big && ((usize)big % 256) == 0);
+                memset(big, 0xCD, 16_mb);
+                for (u32 i = 0; i < 64; ++i)
+                {
+                    byte_t* p = (byte_t*)alloc2.allocate(100_kb);
+                    lutest(p);
+                    memset(p, (byte_t)i, 100_kb);
+                }
+                lutest(get_stack_alloc_high_water_mark(true) >= 16_mb + 6400_kb);
+            }
+            // Memory allocated in the outer scope is not affected.
+            for (u32 i = 0; i < 16; ++i) lutest(a[i] == i);
+            u32* b = (u32*)alloc.allocate(sizeof(u32) * 16);
+            lutest(b && b != a);
+        }
+        {
+            // Memory can be reused after the scope is closed.
+            void* p1;
+            void* p2;
+            {
+                StackAllocator alloc;
+                p1 = alloc.allocate(64);
+            }
+            {
+                StackAllocator alloc;
+                p2 = alloc.allocate(64);
+            }
+            lutest(p1 == p2);
+        }
+        lutest(get_stack_alloc_high_water_mark() >= get_stack_alloc_high_water_mark(true));
+    }
+}
@@ -25,6 +25,7 @@ namespace Luna
 
     usize get_allocated_memory()
     {
+        flush_profiler_events();
         return g_allocated_memory;
     }
     void memory_profiler_callback(const ProfilerEvent& event)
@@ -40,8 +41,7 @@ namespace Luna
             case ProfilerEventId::MEMORY_DEALLOCATE:
             {
                 ProfilerEventData::MemoryDeallocate* data = (ProfilerEventData::MemoryDeallocate*)event.data;
-                usize allocated = memsize(data->ptr);
-                g_allocated_memory -= allocated;
+                g_allocated_memory -= data->size;
                 break;
             }
             default: break;
@@ -16,14 +16,22 @@
 namespace Luna
 {
     void vector_test();
+    void inline_vector_test();
     void open_hash_test();
     void robin_hood_hash_test();
+    void swiss_hash_test();
+    void concurrent_hash_map_test();
+    void concurrent_queue_test();
+    void flat_map_test();
+    void bitset_test();
+    void hash_function_test();
     void name_test();
     void ring_deque_test();
     void string_test();
     void path_test();
     void list_test();
     void error_test();
+    void error_thread_exit_test();
     void tuple_test();
     void variant_test();
     void time_test();
@@ -34,6 +42,14 @@ namespace Luna
     void invoke_test();
     void function_test();
     void unicode_test();
+    void memory_test();
+    void allocation_profiler_test();
+    void arena_test();
+    void stack_allocator_test();
+    void object_pool_test();
+    void cpu_profiler_test();
+    void lock_profiler_test();
+    void sort_test();
 
     // STL test framework modified from EASTL.
 
@@ -16,13 +16,28 @@ void run()
 {
     set_log_to_platform_enabled(true);
     auto handle = register_profiler_callback(memory_profiler_callback);
+    memory_test();
+    allocation_profiler_test();
+    arena_test();
+    stack_allocator_test();
+    object_pool_test();
+    cpu_profiler_test();
+    lock_profiler_test();
     array_test();
     vector_test();
+    inline_vector_test();
+    sort_test();
     open_hash_test();
     ring_deque_test();
     string_test();
     list_test();
     robin_hood_hash_test();
+    swiss_hash_test();
+    concurrent_hash_map_test();
+    concurrent_queue_test();
+    flat_map_test();
+    bitset_test();
+    hash_function_test();
     tuple_test();
     name_test();
     path_test();
@@ -36,12 +51,23 @@ void run()
     function_test();
     unicode_test();
     unregister_profiler_callback(handle);
+    // Tests that require no profiler callback to be registered.
+    error_thread_exit_test();
 }
 
 int main()
 {
-    init();
+    InitDesc desc;
+    desc.heap_allocator = HeapAllocatorType::size_class;
+    init(desc);
     run();
     close();
+    // Names cached by `luname` must be interned again after the runtime is initialized again.
+    init();
+    lutest(get_heap_allocator_type() == HeapAllocatorType::system);
+    memory_test();
+    name_test();
+    path_test();
+    close();
     return 0;
 }
\ No newline at end of file
@@ -8,5 +8,7 @@ if is_plat("windows", "macosx", "linux") then
     includes("ImGuiTest")
     includes("JobSystemTest")
     includes("ECSTest")
+    includes("ECSBenchmark")
+    includes("ContainerBenchmark")
     includes("AHITest")
 end
\ No newline at end of file
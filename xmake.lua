@@ -102,6 +102,27 @@ option("memory_profiler")
     add_defines("LUNA_ENABLE_MEMORY_PROFILER")
 option_end()
 
+option("cpu_profiler")
+    set_default(false)
+    set_showmenu(true)
+    set_description("Whether to forcly enable CPU scope profiling markers for LunaSDK.")
+    add_defines("LUNA_ENABLE_CPU_PROFILER")
+option_end()
+
+option("lock_profiler")
+    set_default(false)
+    set_showmenu(true)
+    set_description("Whether to enable lock contention profiling for named locks of LunaSDK.")
+    add_defines("LUNA_ENABLE_LOCK_PROFILER")
+option_end()
+
+option("profiler_counters")
+    set_default(false)
+    set_showmenu(true)
+    set_description("Whether to enable profiler counter updates on hot paths of LunaSDK modules.")
+    add_defines("LUNA_ENABLE_PROFILER_COUNTERS")
+option_end()
+
 function get_default_rhi_api()
     local default_rhi_api = nil
     if is_plat("windows") then
@@ -142,7 +163,7 @@ elseif is_config("rhi_api", "D3D12") then
 end
 
 function add_luna_sdk_options()
-    add_options("shared", "api_validation", "thread_safe_assertion", "memory_profiler", "rhi_api")
+    add_options("shared", "api_validation", "thread_safe_assertion", "memory_profiler", "cpu_profiler", "lock_profiler", "profiler_counters", "rhi_api")
     -- API validation is always enabled in debug mode.
     if has_config("api_validation") or is_mode("debug") then
         add_defines("LUNA_ENABLE_API_VALIDATION")